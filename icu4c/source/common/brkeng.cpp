@@ -81,7 +81,8 @@ UnhandledEngine::findBreaks( UText *text,
                                  int32_t endPos,
                                  UBool reverse,
                                  int32_t breakType,
-                                 UStack &/*foundBreaks*/ ) const {
+                                 UStack &/*foundBreaks*/,
+                                 DictionaryBreakWorkspace * /*workspace*/ ) const {
     if (breakType >= 0 && breakType < (int32_t)(sizeof(fHandled)/sizeof(fHandled[0]))) {
         UChar32 c = utext_current32(text); 
         if (reverse) {
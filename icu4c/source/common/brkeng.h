@@ -18,6 +18,7 @@ U_NAMESPACE_BEGIN
 class UnicodeSet;
 class UStack;
 class DictionaryMatcher;
+class DictionaryBreakWorkspace;
 
 /*******************************************************************
  * LanguageBreakEngine
@@ -69,6 +70,7 @@ class LanguageBreakEngine : public UMemory {
   * direction.
   * @param breakType The type of break desired, or -1.
   * @param foundBreaks An allocated C array of the breaks found, if any
+  * @param workspace Scratch buffers that the caller reuses across calls, or NULL
   * @return The number of breaks found.
   */
   virtual int32_t findBreaks( UText *text,
@@ -76,7 +78,8 @@ class LanguageBreakEngine : public UMemory {
                               int32_t endPos,
                               UBool reverse,
                               int32_t breakType,
-                              UStack &foundBreaks ) const = 0;
+                              UStack &foundBreaks,
+                              DictionaryBreakWorkspace *workspace ) const = 0;
 
 };
 
@@ -194,6 +197,7 @@ class UnhandledEngine : public LanguageBreakEngine {
   * direction.
   * @param breakType The type of break desired, or -1.
   * @param foundBreaks An allocated C array of the breaks found, if any
+  * @param workspace Scratch buffers that the caller reuses across calls, or NULL
   * @return The number of breaks found.
   */
   virtual int32_t findBreaks( UText *text,
@@ -201,7 +205,8 @@ class UnhandledEngine : public LanguageBreakEngine {
                               int32_t endPos,
                               UBool reverse,
                               int32_t breakType,
-                              UStack &foundBreaks ) const;
+                              UStack &foundBreaks,
+                              DictionaryBreakWorkspace *workspace ) const;
 
  /**
   * <p>Tell the engine to handle a particular character and break type.</p>
@@ -480,6 +480,33 @@ int32_t BreakIterator::getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UE
     return 1;
 }
 
+// The default implementation of getBoundaries iterates through the virtual API;
+// RuleBasedBreakIterator overrides it with a faster loop.
+int32_t BreakIterator::getBoundaries(int32_t start, int32_t *dest, int32_t *ruleStatuses,
+                                     int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (capacity > 0 && dest == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t length = 0;
+    if (capacity == 0) {
+        return 0;
+    }
+    for (int32_t pos = following(start); pos != DONE; pos = next()) {
+        dest[length] = pos;
+        if (ruleStatuses != NULL) {
+            ruleStatuses[length] = getRuleStatus();
+        }
+        if (++length == capacity) {
+            break;
+        }
+    }
+    return length;
+}
+
 BreakIterator::BreakIterator (const Locale& valid, const Locale& actual) {
   U_LOCALE_BASED(locBased, (*this));
   locBased.setLocaleIDs(valid, actual);
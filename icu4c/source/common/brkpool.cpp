@@ -0,0 +1,221 @@
+/*
+*******************************************************************************
+* Copyright (C) 2016, International Business Machines
+* Corporation and others.  All Rights Reserved.
+*******************************************************************************
+* brkpool.cpp
+*
+* Thread-safe pool of break iterators, keyed by break type and locale.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_BREAK_ITERATION
+
+#include "unicode/brkpool.h"
+#include "unicode/utext.h"
+#include "charstr.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "mutex.h"
+#include "uhash.h"
+#include "umutex.h"
+#include "uvector.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/**
+ * Per-key pool state: A prototype iterator which is never handed out,
+ * and a stack of released iterators ready for reuse.
+ * New iterators are clones of the prototype and share its rule data.
+ */
+class BreakIteratorPoolEntry : public UMemory {
+public:
+    BreakIteratorPoolEntry(BreakIterator *adoptedPrototype, UErrorCode &errorCode)
+            : prototype(adoptedPrototype), idle(uprv_deleteUObject, NULL, errorCode) {}
+    ~BreakIteratorPoolEntry() { delete prototype; }
+
+    BreakIterator *prototype;
+    UVector idle;
+};
+
+BreakIterator *createIterator(UBreakIteratorType type, const Locale &locale, UErrorCode &errorCode) {
+    switch(type) {
+    case UBRK_CHARACTER:
+        return BreakIterator::createCharacterInstance(locale, errorCode);
+    case UBRK_WORD:
+        return BreakIterator::createWordInstance(locale, errorCode);
+    case UBRK_LINE:
+        return BreakIterator::createLineInstance(locale, errorCode);
+    case UBRK_SENTENCE:
+        return BreakIterator::createSentenceInstance(locale, errorCode);
+#ifndef U_HIDE_DEPRECATED_API
+    case UBRK_TITLE:
+        return BreakIterator::createTitleInstance(locale, errorCode);
+#endif
+    default:
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+}
+
+}  // namespace
+
+U_CDECL_BEGIN
+
+static void U_CALLCONV
+deleteBreakIteratorPoolEntry(void *obj) {
+    delete static_cast<BreakIteratorPoolEntry *>(obj);
+}
+
+static int32_t U_CALLCONV
+hashBreakIteratorPointer(const UHashTok key) {
+    uintptr_t p = (uintptr_t)key.pointer;
+    // Heap pointers are aligned; drop the low bits which are always zero.
+    return (int32_t)((p >> 4) ^ (p >> 19));
+}
+
+static UBool U_CALLCONV
+compareBreakIteratorPointers(const UHashTok key1, const UHashTok key2) {
+    return key1.pointer == key2.pointer;
+}
+
+U_CDECL_END
+
+static UMutex gBreakIteratorPoolMutex = U_MUTEX_INITIALIZER;
+
+BreakIteratorPool::BreakIteratorPool(int32_t maxIdlePerKey, UErrorCode &status)
+        : fEntries(NULL), fInUse(NULL), fMaxIdle(maxIdlePerKey) {
+    if(U_FAILURE(status)) { return; }
+    if(maxIdlePerKey < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    fEntries = uhash_open(uhash_hashChars, uhash_compareChars, NULL, &status);
+    fInUse = uhash_open(hashBreakIteratorPointer, compareBreakIteratorPointers, NULL, &status);
+    if(U_FAILURE(status)) { return; }
+    uhash_setKeyDeleter(fEntries, uprv_free);
+    uhash_setValueDeleter(fEntries, deleteBreakIteratorPoolEntry);
+}
+
+BreakIteratorPool::~BreakIteratorPool() {
+    uhash_close(fInUse);
+    uhash_close(fEntries);
+}
+
+BreakIterator *
+BreakIteratorPool::acquire(UBreakIteratorType type, const Locale &locale, UErrorCode &status) {
+    if(U_FAILURE(status)) { return NULL; }
+    if(fEntries == NULL || fInUse == NULL) {
+        status = U_INVALID_STATE_ERROR;
+        return NULL;
+    }
+    if(type < 0 || type >= UBRK_COUNT) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    // The key is the type number followed by the full locale ID,
+    // which includes keywords like "lb" and "ss" that select different rules.
+    CharString key;
+    key.append((char)('0' + type), status).append('_', status).append(locale.getName(), status);
+    if(U_FAILURE(status)) { return NULL; }
+
+    BreakIteratorPoolEntry *entry;
+    BreakIterator *result = NULL;
+    {
+        Mutex lock(&gBreakIteratorPoolMutex);
+        entry = static_cast<BreakIteratorPoolEntry *>(uhash_get(fEntries, key.data()));
+        if(entry != NULL && !entry->idle.isEmpty()) {
+            result = static_cast<BreakIterator *>(entry->idle.orphanElementAt(entry->idle.size() - 1));
+            uhash_put(fInUse, result, entry, &status);
+            if(U_FAILURE(status)) {
+                delete result;
+                return NULL;
+            }
+            return result;
+        }
+    }
+
+    if(entry == NULL) {
+        // Load the locale data outside of the lock.
+        // If another thread creates the same entry meanwhile, we use that one.
+        LocalPointer<BreakIterator> prototype(createIterator(type, locale, status));
+        if(U_FAILURE(status)) { return NULL; }
+        // Once allocated, the entry owns the prototype even if its construction fails.
+        LocalPointer<BreakIteratorPoolEntry> newEntry(
+            new BreakIteratorPoolEntry(prototype.getAlias(), status), status);
+        if(newEntry.isValid()) { prototype.orphan(); }
+        if(U_FAILURE(status)) { return NULL; }
+        char *ownedKey = uprv_strdup(key.data());
+        if(ownedKey == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return NULL;
+        }
+        Mutex lock(&gBreakIteratorPoolMutex);
+        entry = static_cast<BreakIteratorPoolEntry *>(uhash_get(fEntries, key.data()));
+        if(entry == NULL) {
+            entry = newEntry.orphan();
+            uhash_put(fEntries, ownedKey, entry, &status);
+            if(U_FAILURE(status)) { return NULL; }
+        } else {
+            uprv_free(ownedKey);
+        }
+    }
+
+    // The prototype is only ever cloned, which does not modify it,
+    // so it is safe to clone it outside of the lock.
+    result = entry->prototype->clone();
+    if(result == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    Mutex lock(&gBreakIteratorPoolMutex);
+    uhash_put(fInUse, result, entry, &status);
+    if(U_FAILURE(status)) {
+        delete result;
+        return NULL;
+    }
+    return result;
+}
+
+void
+BreakIteratorPool::release(BreakIterator *bi) {
+    if(bi == NULL) { return; }
+    // Drop the caller's text and any boundaries cached for it,
+    // so that the next user starts out as with a new iterator.
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UText ut = UTEXT_INITIALIZER;
+    utext_openUChars(&ut, NULL, 0, &errorCode);
+    bi->setText(&ut, errorCode);
+    utext_close(&ut);
+
+    BreakIteratorPoolEntry *entry = NULL;
+    if(fInUse != NULL) {
+        Mutex lock(&gBreakIteratorPoolMutex);
+        entry = static_cast<BreakIteratorPoolEntry *>(uhash_remove(fInUse, bi));
+        if(entry != NULL && U_SUCCESS(errorCode) && entry->idle.size() < fMaxIdle) {
+            entry->idle.addElement(bi, errorCode);
+            if(U_SUCCESS(errorCode)) { return; }
+        }
+    }
+    delete bi;
+}
+
+int32_t
+BreakIteratorPool::countIdle() const {
+    if(fEntries == NULL) { return 0; }
+    Mutex lock(&gBreakIteratorPoolMutex);
+    int32_t count = 0;
+    int32_t pos = UHASH_FIRST;
+    const UHashElement *element;
+    while((element = uhash_nextElement(fEntries, &pos)) != NULL) {
+        count += static_cast<const BreakIteratorPoolEntry *>(element->value.pointer)->idle.size();
+    }
+    return count;
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_BREAK_ITERATION
@@ -14,6 +14,8 @@
 #include "unicode/uniset.h"
 #include "unicode/chariter.h"
 #include "unicode/ubrk.h"
+#include "unicode/ustring.h"
+#include "unicode/utf16.h"
 #include "uvectr32.h"
 #include "uvector.h"
 #include "uassert.h"
@@ -23,6 +25,19 @@
 
 U_NAMESPACE_BEGIN
 
+/*
+ ******************************************************************
+ * DictionaryBreakWorkspace
+ */
+
+DictionaryBreakWorkspace::DictionaryBreakWorkspace(UErrorCode &status)
+        : fInputMap(status), fNormalizedMap(status), fCodePointMap(status),
+          fBestSnlp(status), fPrev(status), fBoundaries(status) {
+}
+
+DictionaryBreakWorkspace::~DictionaryBreakWorkspace() {
+}
+
 /*
  ******************************************************************
  */
@@ -46,7 +61,8 @@ DictionaryBreakEngine::findBreaks( UText *text,
                                  int32_t endPos,
                                  UBool reverse,
                                  int32_t breakType,
-                                 UStack &foundBreaks ) const {
+                                 UStack &foundBreaks,
+                                 DictionaryBreakWorkspace *workspace ) const {
     int32_t result = 0;
 
     // Find the span of characters included in the set.
@@ -87,7 +103,7 @@ DictionaryBreakEngine::findBreaks( UText *text,
         rangeEnd = current;
     }
     if (breakType >= 0 && breakType < 32 && (((uint32_t)1 << breakType) & fTypes)) {
-        result = divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks);
+        result = divideUpDictionaryRange(text, rangeStart, rangeEnd, foundBreaks, workspace);
         utext_setNativeIndex(text, current);
     }
     
@@ -246,7 +262,8 @@ int32_t
 ThaiBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
                                                 int32_t rangeEnd,
-                                                UStack &foundBreaks ) const {
+                                                UStack &foundBreaks,
+                                                DictionaryBreakWorkspace * /*workspace*/ ) const {
     utext_setNativeIndex(text, rangeStart);
     utext_moveIndex32(text, THAI_MIN_WORD_SPAN);
     if (utext_getNativeIndex(text) >= rangeEnd) {
@@ -485,7 +502,8 @@ int32_t
 LaoBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
                                                 int32_t rangeEnd,
-                                                UStack &foundBreaks ) const {
+                                                UStack &foundBreaks,
+                                                DictionaryBreakWorkspace * /*workspace*/ ) const {
     if ((rangeEnd - rangeStart) < LAO_MIN_WORD_SPAN) {
         return 0;       // Not enough characters for two words
     }
@@ -678,7 +696,8 @@ int32_t
 BurmeseBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
                                                 int32_t rangeEnd,
-                                                UStack &foundBreaks ) const {
+                                                UStack &foundBreaks,
+                                                DictionaryBreakWorkspace * /*workspace*/ ) const {
     if ((rangeEnd - rangeStart) < BURMESE_MIN_WORD_SPAN) {
         return 0;       // Not enough characters for two words
     }
@@ -883,7 +902,8 @@ int32_t
 KhmerBreakEngine::divideUpDictionaryRange( UText *text,
                                                 int32_t rangeStart,
                                                 int32_t rangeEnd,
-                                                UStack &foundBreaks ) const {
+                                                UStack &foundBreaks,
+                                                DictionaryBreakWorkspace * /*workspace*/ ) const {
     if ((rangeEnd - rangeStart) < KHMER_MIN_WORD_SPAN) {
         return 0;       // Not enough characters for two words
     }
@@ -1127,26 +1147,38 @@ static inline int32_t utext_i32_flag(int32_t bitIndex) {
  * @param rangeStart The start of the range of dictionary characters
  * @param rangeEnd The end of the range of dictionary characters
  * @param foundBreaks Output of C array of int32_t break positions, or 0
+ * @param workspace Scratch buffers that the caller reuses across calls, or NULL
  * @return The number of breaks found
  */
 int32_t 
 CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         int32_t rangeStart,
         int32_t rangeEnd,
-        UStack &foundBreaks ) const {
+        UStack &foundBreaks,
+        DictionaryBreakWorkspace *workspace ) const {
     if (rangeStart >= rangeEnd) {
         return 0;
     }
 
-    // UnicodeString version of input UText, NFKC normalized if necessary.
-    UnicodeString inString;
+    UErrorCode     status      = U_ZERO_ERROR;
 
-    // inputMap[inStringIndex] = corresponding native index from UText inText.
-    // If NULL then mapping is 1:1
-    LocalPointer<UVector32>     inputMap;
+    // Without a workspace from the caller, use a temporary one.
+    LocalPointer<DictionaryBreakWorkspace> localWorkspace;
+    if (workspace == NULL) {
+        localWorkspace.adoptInsteadAndCheckErrorCode(new DictionaryBreakWorkspace(status), status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        workspace = localWorkspace.getAlias();
+    }
 
-    UErrorCode     status      = U_ZERO_ERROR;
+    // UTF-16 version of the input UText range, NFKC normalized if necessary.
+    const UChar   *inString;
+    int32_t        inLength;
 
+    // inputMap[inString index] = corresponding native index from UText inText.
+    // If NULL then mapping is 1:1
+    const UVector32 *inputMap = NULL;
 
     // if UText has the input string as one contiguous UTF-16 chunk
     if ((inText->providerProperties & utext_i32_flag(UTEXT_PROVIDER_STABLE_CHUNKS)) &&
@@ -1155,137 +1187,149 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
          inText->nativeIndexingLimit >= rangeEnd - inText->chunkNativeStart) {
 
         // Input UText is in one contiguous UTF-16 chunk.
-        // Use Read-only aliasing UnicodeString.
-        inString.setTo(FALSE,
-                       inText->chunkContents + rangeStart - inText->chunkNativeStart,
-                       rangeEnd - rangeStart);
+        // Read it in place.
+        inString = inText->chunkContents + rangeStart - inText->chunkNativeStart;
+        inLength = rangeEnd - rangeStart;
     } else {
-        // Copy the text from the original inText (UText) to inString (UnicodeString).
-        // Create a map from UnicodeString indices -> UText offsets.
+        // Copy the text from the original inText (UText) to the workspace string.
+        // Create a map from string indices -> UText offsets.
+        UnicodeString &input = workspace->fInput;
+        UVector32 &map = workspace->fInputMap;
+        input.remove();
+        map.removeAllElements();
         utext_setNativeIndex(inText, rangeStart);
         int32_t limit = rangeEnd;
         U_ASSERT(limit <= utext_nativeLength(inText));
         if (limit > utext_nativeLength(inText)) {
             limit = utext_nativeLength(inText);
         }
-        inputMap.adoptInsteadAndCheckErrorCode(new UVector32(status), status);
-        if (U_FAILURE(status)) {
-            return 0;
-        }
         while (utext_getNativeIndex(inText) < limit) {
             int32_t nativePosition = utext_getNativeIndex(inText);
             UChar32 c = utext_next32(inText);
             U_ASSERT(c != U_SENTINEL);
-            inString.append(c);
-            while (inputMap->size() < inString.length()) {
-                inputMap->addElement(nativePosition, status);
+            input.append(c);
+            while (map.size() < input.length()) {
+                map.addElement(nativePosition, status);
             }
         }
-        inputMap->addElement(limit, status);
+        map.addElement(limit, status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        inString = input.getBuffer();
+        inLength = input.length();
+        inputMap = &map;
     }
 
-
-    if (!nfkcNorm2->isNormalized(inString, status)) {
-        UnicodeString normalizedInput;
+    // Most input is already in NFKC. The quick check span is known to be normalized,
+    // and it ends at a normalization boundary; only the rest needs to be normalized.
+    int32_t spanEnd = nfkcNorm2->spanQuickCheckYes(UnicodeString(FALSE, inString, inLength), status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (spanEnd < inLength) {
+        UnicodeString &normalizedInput = workspace->fNormalized;
+        UnicodeString &normalizedFragment = workspace->fNormalizedFragment;
         //  normalizedMap[normalizedInput position] ==  original UText position.
-        LocalPointer<UVector32> normalizedMap(new UVector32(status), status);
-        if (U_FAILURE(status)) {
-            return 0;
+        UVector32 &normalizedMap = workspace->fNormalizedMap;
+        normalizedInput.setTo(inString, spanEnd);
+        normalizedMap.removeAllElements();
+        for (int32_t i = 0; i < spanEnd; ++i) {
+            normalizedMap.addElement(inputMap != NULL ? inputMap->elementAti(i) : i+rangeStart, status);
         }
-        
-        UnicodeString fragment;
-        UnicodeString normalizedFragment;
-        for (int32_t srcI = 0; srcI < inString.length();) {  // Once per normalization chunk
-            fragment.remove();
+
+        for (int32_t srcI = spanEnd; srcI < inLength;) {  // Once per normalization chunk
             int32_t fragmentStartI = srcI;
-            UChar32 c = inString.char32At(srcI);
-            for (;;) {
-                fragment.append(c);
-                srcI = inString.moveIndex32(srcI, 1);
-                if (srcI == inString.length()) {
-                    break;
-                }
-                c = inString.char32At(srcI);
+            U16_FWD_1(inString, srcI, inLength);
+            while (srcI < inLength) {
+                UChar32 c;
+                U16_GET(inString, 0, srcI, inLength, c);
                 if (nfkcNorm2->hasBoundaryBefore(c)) {
                     break;
                 }
+                U16_FWD_1(inString, srcI, inLength);
             }
-            nfkcNorm2->normalize(fragment, normalizedFragment, status);
+            nfkcNorm2->normalize(UnicodeString(FALSE, inString + fragmentStartI, srcI - fragmentStartI),
+                                 normalizedFragment, status);
             normalizedInput.append(normalizedFragment);
 
             // Map every position in the normalized chunk to the start of the chunk
             //   in the original input.
-            int32_t fragmentOriginalStart = inputMap.isValid() ?
+            int32_t fragmentOriginalStart = inputMap != NULL ?
                     inputMap->elementAti(fragmentStartI) : fragmentStartI+rangeStart;
-            while (normalizedMap->size() < normalizedInput.length()) {
-                normalizedMap->addElement(fragmentOriginalStart, status);
+            while (normalizedMap.size() < normalizedInput.length()) {
+                normalizedMap.addElement(fragmentOriginalStart, status);
                 if (U_FAILURE(status)) {
                     break;
                 }
             }
         }
-        U_ASSERT(normalizedMap->size() == normalizedInput.length());
-        int32_t nativeEnd = inputMap.isValid() ?
-                inputMap->elementAti(inString.length()) : inString.length()+rangeStart;
-        normalizedMap->addElement(nativeEnd, status);
+        U_ASSERT(U_FAILURE(status) || normalizedMap.size() == normalizedInput.length());
+        int32_t nativeEnd = inputMap != NULL ?
+                inputMap->elementAti(inLength) : inLength+rangeStart;
+        normalizedMap.addElement(nativeEnd, status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
 
-        inputMap.moveFrom(normalizedMap);
-        inString.moveFrom(normalizedInput);
+        inString = normalizedInput.getBuffer();
+        inLength = normalizedInput.length();
+        inputMap = &normalizedMap;
     }
 
-    int32_t numCodePts = inString.countChar32();
-    if (numCodePts != inString.length()) {
+    int32_t numCodePts = u_countChar32(inString, inLength);
+    if (numCodePts != inLength) {
         // There are supplementary characters in the input.
         // The dictionary will produce boundary positions in terms of code point indexes,
         //   not in terms of code unit string indexes.
         // Use the inputMap mechanism to take care of this in addition to indexing differences
         //    from normalization and/or UTF-8 input.
-        UBool hadExistingMap = inputMap.isValid();
-        if (!hadExistingMap) {
-            inputMap.adoptInsteadAndCheckErrorCode(new UVector32(status), status);
-            if (U_FAILURE(status)) {
-                return 0;
-            }
-        }
-        int32_t cpIdx = 0;
-        for (int32_t cuIdx = 0; ; cuIdx = inString.moveIndex32(cuIdx, 1)) {
-            U_ASSERT(cuIdx >= cpIdx);
-            if (hadExistingMap) {
-                inputMap->setElementAt(inputMap->elementAti(cuIdx), cpIdx);
-            } else {
-                inputMap->addElement(cuIdx+rangeStart, status);
-            }
-            cpIdx++;
-            if (cuIdx == inString.length()) {
+        UVector32 &codePointMap = workspace->fCodePointMap;
+        codePointMap.removeAllElements();
+        int32_t cuIdx = 0;
+        for (;;) {
+            codePointMap.addElement(inputMap != NULL ? inputMap->elementAti(cuIdx) : cuIdx+rangeStart, status);
+            if (cuIdx == inLength) {
                break;
             }
+            U16_FWD_1(inString, cuIdx, inLength);
         }
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        inputMap = &codePointMap;
     }
-                
+
     // bestSnlp[i] is the snlp of the best segmentation of the first i
     // code points in the range to be matched.
-    UVector32 bestSnlp(numCodePts + 1, status);
-    bestSnlp.addElement(0, status);
-    for(int32_t i = 1; i <= numCodePts; i++) {
-        bestSnlp.addElement(kuint32max, status);
-    }
-
-
     // prev[i] is the index of the last CJK code point in the previous word in 
     // the best segmentation of the first i characters.
-    UVector32 prev(numCodePts + 1, status);
-    for(int32_t i = 0; i <= numCodePts; i++){
-        prev.addElement(-1, status);
+    // Both live in the workspace, which keeps their memory for the next call.
+    workspace->fBestSnlp.setSize(numCodePts + 1);
+    workspace->fPrev.setSize(numCodePts + 1);
+    if (workspace->fBestSnlp.size() != numCodePts + 1 || workspace->fPrev.size() != numCodePts + 1) {
+        return 0;
+    }
+    uint32_t *bestSnlp = (uint32_t *)workspace->fBestSnlp.getBuffer();
+    int32_t *prev = workspace->fPrev.getBuffer();
+    bestSnlp[0] = 0;
+    prev[0] = -1;
+    for(int32_t i = 1; i <= numCodePts; i++) {
+        bestSnlp[i] = kuint32max;
+        prev[i] = -1;
     }
 
+    // The dictionary returns at most one match per word length, so maxWordSize
+    // entries plus one for a single-character fallback are enough.
     const int32_t maxWordSize = 20;
-    UVector32 values(numCodePts, status);
-    values.setSize(numCodePts);
-    UVector32 lengths(numCodePts, status);
-    lengths.setSize(numCodePts);
+    int32_t values[maxWordSize + 1];
+    int32_t lengths[maxWordSize + 1];
 
     UText fu = UTEXT_INITIALIZER;
-    utext_openUnicodeString(&fu, &inString, &status);
+    utext_openUChars(&fu, inString, inLength, &status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
 
     // Dynamic programming to find the best segmentation.
 
@@ -1293,15 +1337,18 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     //                ix is the corresponding string (code unit) index.
     //    They differ when the string contains supplementary characters.
     int32_t ix = 0;
-    for (int32_t i = 0;  i < numCodePts;  ++i, ix = inString.moveIndex32(ix, 1)) {
-        if ((uint32_t)bestSnlp.elementAti(i) == kuint32max) {
+    int32_t nextIx = 0;
+    for (int32_t i = 0;  i < numCodePts;  ++i, ix = nextIx) {
+        UChar32 c;
+        U16_NEXT(inString, nextIx, inLength, c);
+        if (bestSnlp[i] == kuint32max) {
             continue;
         }
 
         int32_t count;
         utext_setNativeIndex(&fu, ix);
-        count = fDictionary->matches(&fu, maxWordSize, numCodePts,
-                             NULL, lengths.getBuffer(), values.getBuffer(), NULL);
+        count = fDictionary->matches(&fu, maxWordSize, maxWordSize,
+                             NULL, lengths, values, NULL);
                              // Note: lengths is filled with code point lengths
                              //       The NULL parameter is the ignored code unit lengths.
 
@@ -1310,18 +1357,18 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // with the highest value possible, i.e. the least likely to occur.
         // Exclude Korean characters from this treatment, as they should be left
         // together by default.
-        if ((count == 0 || lengths.elementAti(0) != 1) &&
-                !fHangulWordSet.contains(inString.char32At(ix))) {
-            values.setElementAt(maxSnlp, count);   // 255
-            lengths.setElementAt(1, count++);
+        if ((count == 0 || lengths[0] != 1) &&
+                !fHangulWordSet.contains(c)) {
+            values[count] = maxSnlp;   // 255
+            lengths[count++] = 1;
         }
 
         for (int32_t j = 0; j < count; j++) {
-            uint32_t newSnlp = (uint32_t)bestSnlp.elementAti(i) + (uint32_t)values.elementAti(j);
-            int32_t ln_j_i = lengths.elementAti(j) + i;
-            if (newSnlp < (uint32_t)bestSnlp.elementAti(ln_j_i)) {
-                bestSnlp.setElementAt(newSnlp, ln_j_i);
-                prev.setElementAt(i, ln_j_i);
+            uint32_t newSnlp = bestSnlp[i] + (uint32_t)values[j];
+            int32_t ln_j_i = lengths[j] + i;
+            if (newSnlp < bestSnlp[ln_j_i]) {
+                bestSnlp[ln_j_i] = newSnlp;
+                prev[ln_j_i] = i;
             }
         }
 
@@ -1332,21 +1379,27 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // specified in the katakanaCost table according to its length.
 
         bool is_prev_katakana = false;
-        bool is_katakana = isKatakana(inString.char32At(ix));
+        bool is_katakana = isKatakana(c);
         int32_t katakanaRunLength = 1;
         if (!is_prev_katakana && is_katakana) {
-            int32_t j = inString.moveIndex32(ix, 1);
+            int32_t j = nextIx;
             // Find the end of the continuous run of Katakana characters
-            while (j < inString.length() && katakanaRunLength < kMaxKatakanaGroupLength &&
-                    isKatakana(inString.char32At(j))) {
-                j = inString.moveIndex32(j, 1);
+            while (j < inLength && katakanaRunLength < kMaxKatakanaGroupLength) {
+                int32_t k = j;
+                UChar32 d;
+                U16_NEXT(inString, k, inLength, d);
+                if (!isKatakana(d)) {
+                    break;
+                }
+                j = k;
                 katakanaRunLength++;
             }
             if (katakanaRunLength < kMaxKatakanaGroupLength) {
-                uint32_t newSnlp = bestSnlp.elementAti(i) + getKatakanaCost(katakanaRunLength);
-                if (newSnlp < (uint32_t)bestSnlp.elementAti(j)) {
-                    bestSnlp.setElementAt(newSnlp, j);
-                    prev.setElementAt(i, i+katakanaRunLength);  // prev[j] = i;
+                uint32_t newSnlp = bestSnlp[i] + getKatakanaCost(katakanaRunLength);
+                int32_t runEnd = i + katakanaRunLength;
+                if (newSnlp < bestSnlp[runEnd]) {
+                    bestSnlp[runEnd] = newSnlp;
+                    prev[runEnd] = i;
                 }
             }
         }
@@ -1358,19 +1411,20 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     // prev[numCodePts] is guaranteed to be meaningful.
     // We'll first push in the reverse order, i.e.,
     // t_boundary[0] = numCodePts, and afterwards do a swap.
-    UVector32 t_boundary(numCodePts+1, status);
+    UVector32 &t_boundary = workspace->fBoundaries;
+    t_boundary.removeAllElements();
 
     int32_t numBreaks = 0;
     // No segmentation found, set boundary to end of range
-    if ((uint32_t)bestSnlp.elementAti(numCodePts) == kuint32max) {
+    if (bestSnlp[numCodePts] == kuint32max) {
         t_boundary.addElement(numCodePts, status);
         numBreaks++;
     } else {
-        for (int32_t i = numCodePts; i > 0; i = prev.elementAti(i)) {
+        for (int32_t i = numCodePts; i > 0; i = prev[i]) {
             t_boundary.addElement(i, status);
             numBreaks++;
         }
-        U_ASSERT(prev.elementAti(t_boundary.elementAti(numBreaks - 1)) == 0);
+        U_ASSERT(U_FAILURE(status) || prev[t_boundary.elementAti(numBreaks - 1)] == 0);
     }
 
     // Add a break for the start of the dictionary range if there is not one
@@ -1379,20 +1433,21 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         t_boundary.addElement(0, status);
         numBreaks++;
     }
+    if (U_FAILURE(status)) {
+        return 0;
+    }
 
     // Now that we're done, convert positions in t_boundary[] (indices in 
     // the normalized input string) back to indices in the original input UText
     // while reversing t_boundary and pushing values to foundBreaks.
     for (int32_t i = numBreaks-1; i >= 0; i--) {
         int32_t cpPos = t_boundary.elementAti(i);
-        int32_t utextPos =  inputMap.isValid() ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
+        int32_t utextPos =  inputMap != NULL ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
         // Boundaries are added to foundBreaks output in ascending order.
         U_ASSERT(foundBreaks.size() == 0 ||foundBreaks.peeki() < utextPos);
         foundBreaks.push(utextPos, status);
     }
 
-    // inString goes out of scope
-    // inputMap goes out of scope
     return numBreaks;
 }
 #endif
@@ -10,15 +10,54 @@
 
 #include "unicode/utypes.h"
 #include "unicode/uniset.h"
+#include "unicode/unistr.h"
 #include "unicode/utext.h"
 
 #include "brkeng.h"
+#include "uvectr32.h"
 
 U_NAMESPACE_BEGIN
 
 class DictionaryMatcher;
 class Normalizer2;
 
+/*******************************************************************
+ * DictionaryBreakWorkspace
+ */
+
+/**
+ * <p>Scratch buffers for dictionary break engines, owned by the caller
+ * (normally a RuleBasedBreakIterator) and passed to each findBreaks() call.
+ * The engines themselves stay stateless, so that they can be shared between
+ * threads, while repeated segmentation reuses the same memory.
+ * The buffers only grow; UVector32 and UnicodeString grow geometrically.</p>
+ */
+class DictionaryBreakWorkspace : public UMemory {
+ public:
+  DictionaryBreakWorkspace(UErrorCode &status);
+  ~DictionaryBreakWorkspace();
+
+  /** Copy of the input range if it is not in one contiguous UTF-16 chunk. */
+  UnicodeString fInput;
+  /** NFKC form of the input range if it is not already NFKC. */
+  UnicodeString fNormalized;
+  /** One normalized fragment of the input. */
+  UnicodeString fNormalizedFragment;
+  /** Maps from fInput, fNormalized and code point indexes to native text indexes. */
+  UVector32     fInputMap;
+  UVector32     fNormalizedMap;
+  UVector32     fCodePointMap;
+  /** Viterbi decoding: best cost and previous word start for each code point index. */
+  UVector32     fBestSnlp;
+  UVector32     fPrev;
+  /** Boundaries of the best segmentation, from last to first. */
+  UVector32     fBoundaries;
+
+ private:
+  DictionaryBreakWorkspace(const DictionaryBreakWorkspace &other);  // forbid copying
+  DictionaryBreakWorkspace &operator=(const DictionaryBreakWorkspace &other);
+};
+
 /*******************************************************************
  * DictionaryBreakEngine
  */
@@ -89,6 +128,7 @@ class DictionaryBreakEngine : public LanguageBreakEngine {
    * direction.
    * @param breakType The type of break desired, or -1.
    * @param foundBreaks An allocated C array of the breaks found, if any
+   * @param workspace Scratch buffers that the caller reuses across calls, or NULL
    * @return The number of breaks found.
    */
   virtual int32_t findBreaks( UText *text,
@@ -96,7 +136,8 @@ class DictionaryBreakEngine : public LanguageBreakEngine {
                               int32_t endPos,
                               UBool reverse,
                               int32_t breakType,
-                              UStack &foundBreaks ) const;
+                              UStack &foundBreaks,
+                              DictionaryBreakWorkspace *workspace ) const;
 
  protected:
 
@@ -121,12 +162,14 @@ class DictionaryBreakEngine : public LanguageBreakEngine {
   * @param rangeStart The start of the range of dictionary characters
   * @param rangeEnd The end of the range of dictionary characters
   * @param foundBreaks Output of C array of int32_t break positions, or 0
+  * @param workspace Scratch buffers that the caller reuses across calls, or NULL
   * @return The number of breaks found
   */
   virtual int32_t divideUpDictionaryRange( UText *text,
                                            int32_t rangeStart,
                                            int32_t rangeEnd,
-                                           UStack &foundBreaks ) const = 0;
+                                           UStack &foundBreaks,
+                                           DictionaryBreakWorkspace *workspace ) const = 0;
 
 };
 
@@ -178,12 +221,14 @@ class ThaiBreakEngine : public DictionaryBreakEngine {
   * @param rangeStart The start of the range of dictionary characters
   * @param rangeEnd The end of the range of dictionary characters
   * @param foundBreaks Output of C array of int32_t break positions, or 0
+  * @param workspace Scratch buffers that the caller reuses across calls, or NULL
   * @return The number of breaks found
   */
   virtual int32_t divideUpDictionaryRange( UText *text,
                                            int32_t rangeStart,
                                            int32_t rangeEnd,
-                                           UStack &foundBreaks ) const;
+                                           UStack &foundBreaks,
+                                           DictionaryBreakWorkspace *workspace ) const;
 
 };
 
@@ -234,12 +279,14 @@ class LaoBreakEngine : public DictionaryBreakEngine {
   * @param rangeStart The start of the range of dictionary characters
   * @param rangeEnd The end of the range of dictionary characters
   * @param foundBreaks Output of C array of int32_t break positions, or 0
+  * @param workspace Scratch buffers that the caller reuses across calls, or NULL
   * @return The number of breaks found
   */
   virtual int32_t divideUpDictionaryRange( UText *text,
                                            int32_t rangeStart,
                                            int32_t rangeEnd,
-                                           UStack &foundBreaks ) const;
+                                           UStack &foundBreaks,
+                                           DictionaryBreakWorkspace *workspace ) const;
 
 };
 
@@ -290,12 +337,14 @@ class BurmeseBreakEngine : public DictionaryBreakEngine {
   * @param rangeStart The start of the range of dictionary characters 
   * @param rangeEnd The end of the range of dictionary characters 
   * @param foundBreaks Output of C array of int32_t break positions, or 0 
+  * @param workspace Scratch buffers that the caller reuses across calls, or NULL
   * @return The number of breaks found 
   */ 
   virtual int32_t divideUpDictionaryRange( UText *text, 
                                            int32_t rangeStart, 
                                            int32_t rangeEnd, 
-                                           UStack &foundBreaks ) const; 
+                                           UStack &foundBreaks,
+                                           DictionaryBreakWorkspace *workspace ) const; 
  
 }; 
  
@@ -346,12 +395,14 @@ class KhmerBreakEngine : public DictionaryBreakEngine {
   * @param rangeStart The start of the range of dictionary characters 
   * @param rangeEnd The end of the range of dictionary characters 
   * @param foundBreaks Output of C array of int32_t break positions, or 0 
+  * @param workspace Scratch buffers that the caller reuses across calls, or NULL
   * @return The number of breaks found 
   */ 
   virtual int32_t divideUpDictionaryRange( UText *text, 
                                            int32_t rangeStart, 
                                            int32_t rangeEnd, 
-                                           UStack &foundBreaks ) const; 
+                                           UStack &foundBreaks,
+                                           DictionaryBreakWorkspace *workspace ) const; 
  
 }; 
  
@@ -410,12 +461,14 @@ class CjkBreakEngine : public DictionaryBreakEngine {
      * @param rangeStart The start of the range of dictionary characters
      * @param rangeEnd The end of the range of dictionary characters
      * @param foundBreaks Output of C array of int32_t break positions, or 0
+     * @param workspace Scratch buffers that the caller reuses across calls, or NULL
      * @return The number of breaks found
      */
   virtual int32_t divideUpDictionaryRange( UText *text,
           int32_t rangeStart,
           int32_t rangeEnd,
-          UStack &foundBreaks ) const;
+          UStack &foundBreaks,
+          DictionaryBreakWorkspace *workspace ) const;
 
 };
 
@@ -247,6 +247,94 @@ FilteredNormalizer2::spanQuickCheckYes(const UnicodeString &s, UErrorCode &error
     return s.length();
 }
 
+// UTF-8 versions: The in-filter spans are passed to the wrapped normalizer's
+// UTF-8 functions, and the rest is copied or skipped without conversion.
+void
+FilteredNormalizer2::normalizeUTF8(const StringPiece &src, ByteSink &sink,
+                                   UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return;
+    }
+    const char *s=src.data();
+    int32_t length=src.length();
+    USetSpanCondition spanCondition=USET_SPAN_SIMPLE;
+    for(int32_t prevSpanLimit=0; prevSpanLimit<length;) {
+        int32_t spanLimit=
+            prevSpanLimit+set.spanUTF8(s+prevSpanLimit, length-prevSpanLimit, spanCondition);
+        int32_t spanLength=spanLimit-prevSpanLimit;
+        if(spanCondition==USET_SPAN_NOT_CONTAINED) {
+            if(spanLength!=0) {
+                sink.Append(s+prevSpanLimit, spanLength);
+            }
+            spanCondition=USET_SPAN_SIMPLE;
+        } else {
+            if(spanLength!=0) {
+                norm2.normalizeUTF8(StringPiece(s+prevSpanLimit, spanLength), sink, errorCode);
+                if(U_FAILURE(errorCode)) {
+                    break;
+                }
+            }
+            spanCondition=USET_SPAN_NOT_CONTAINED;
+        }
+        prevSpanLimit=spanLimit;
+    }
+}
+
+UBool
+FilteredNormalizer2::isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return FALSE;
+    }
+    const char *sArray=s.data();
+    int32_t length=s.length();
+    USetSpanCondition spanCondition=USET_SPAN_SIMPLE;
+    for(int32_t prevSpanLimit=0; prevSpanLimit<length;) {
+        int32_t spanLimit=
+            prevSpanLimit+set.spanUTF8(sArray+prevSpanLimit, length-prevSpanLimit, spanCondition);
+        if(spanCondition==USET_SPAN_NOT_CONTAINED) {
+            spanCondition=USET_SPAN_SIMPLE;
+        } else {
+            if( !norm2.isNormalizedUTF8(StringPiece(sArray+prevSpanLimit, spanLimit-prevSpanLimit),
+                                        errorCode) ||
+                U_FAILURE(errorCode)
+            ) {
+                return FALSE;
+            }
+            spanCondition=USET_SPAN_NOT_CONTAINED;
+        }
+        prevSpanLimit=spanLimit;
+    }
+    return TRUE;
+}
+
+int32_t
+FilteredNormalizer2::spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return 0;
+    }
+    const char *sArray=s.data();
+    int32_t length=s.length();
+    USetSpanCondition spanCondition=USET_SPAN_SIMPLE;
+    for(int32_t prevSpanLimit=0; prevSpanLimit<length;) {
+        int32_t spanLimit=
+            prevSpanLimit+set.spanUTF8(sArray+prevSpanLimit, length-prevSpanLimit, spanCondition);
+        if(spanCondition==USET_SPAN_NOT_CONTAINED) {
+            spanCondition=USET_SPAN_SIMPLE;
+        } else {
+            int32_t yesLimit=
+                prevSpanLimit+
+                norm2.spanQuickCheckYesUTF8(
+                    StringPiece(sArray+prevSpanLimit, spanLimit-prevSpanLimit), errorCode);
+            if(U_FAILURE(errorCode) || yesLimit<spanLimit) {
+                return yesLimit;
+            }
+            spanCondition=USET_SPAN_NOT_CONTAINED;
+        }
+        prevSpanLimit=spanLimit;
+    }
+    return length;
+}
+
 UBool
 FilteredNormalizer2::hasBoundaryBefore(UChar32 c) const {
     return !set.contains(c) || norm2.hasBoundaryBefore(c);
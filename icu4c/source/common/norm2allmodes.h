@@ -56,6 +56,11 @@ public:
     normalize(const UChar *src, const UChar *limit,
               ReorderingBuffer &buffer, UErrorCode &errorCode) const = 0;
 
+    virtual void
+    normalizeBatch(const UChar *const srcs[], const int32_t srcLengths[], int32_t count,
+                   UnicodeString &dest, int32_t destStarts[], int32_t destLengths[],
+                   UErrorCode &errorCode) const;
+
     // normalize and append
     virtual UnicodeString &
     normalizeSecondAndAppend(UnicodeString &first,
@@ -179,6 +184,52 @@ public:
         return UNORM_YES;
     }
 
+    // UTF-8
+    virtual void
+    normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return;
+        }
+        const uint8_t *s=reinterpret_cast<const uint8_t *>(src.data());
+        if(s==NULL && src.length()!=0) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        normalizeUTF8(s, s+src.length(), sink, errorCode);
+    }
+    virtual void
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit,
+                  ByteSink &sink, UErrorCode &errorCode) const = 0;
+
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return FALSE;
+        }
+        const uint8_t *sArray=reinterpret_cast<const uint8_t *>(s.data());
+        if(sArray==NULL && s.length()!=0) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return FALSE;
+        }
+        const uint8_t *sLimit=sArray+s.length();
+        return sLimit==spanQuickCheckYesUTF8(sArray, sLimit, errorCode);
+    }
+    virtual int32_t
+    spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return 0;
+        }
+        const uint8_t *sArray=reinterpret_cast<const uint8_t *>(s.data());
+        if(sArray==NULL && s.length()!=0) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        return (int32_t)(spanQuickCheckYesUTF8(sArray, sArray+s.length(), errorCode)-sArray);
+    }
+    virtual const uint8_t *
+    spanQuickCheckYesUTF8(const uint8_t *src, const uint8_t *limit,
+                          UErrorCode &errorCode) const = 0;
+
     const Normalizer2Impl &impl;
 };
 
@@ -205,6 +256,17 @@ private:
         return impl.decompose(src, limit, NULL, errorCode);
     }
     using Normalizer2WithImpl::spanQuickCheckYes;  // Avoid warning about hiding base class function.
+    virtual void
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit,
+                  ByteSink &sink, UErrorCode &errorCode) const {
+        impl.decomposeUTF8(src, limit, &sink, errorCode);
+    }
+    using Normalizer2WithImpl::normalizeUTF8;  // Avoid warning about hiding base class function.
+    virtual const uint8_t *
+    spanQuickCheckYesUTF8(const uint8_t *src, const uint8_t *limit, UErrorCode &errorCode) const {
+        return impl.decomposeUTF8(src, limit, NULL, errorCode);
+    }
+    using Normalizer2WithImpl::spanQuickCheckYesUTF8;  // Avoid warning about hiding base class function.
     virtual UNormalizationCheckResult getQuickCheck(UChar32 c) const {
         return impl.isDecompYes(impl.getNorm16(c)) ? UNORM_YES : UNORM_NO;
     }
@@ -269,6 +331,29 @@ private:
         return impl.composeQuickCheck(src, limit, onlyContiguous, NULL);
     }
     using Normalizer2WithImpl::spanQuickCheckYes;  // Avoid warning about hiding base class function.
+    virtual void
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit,
+                  ByteSink &sink, UErrorCode &errorCode) const {
+        impl.composeUTF8(src, limit, onlyContiguous, TRUE, &sink, errorCode);
+    }
+    using Normalizer2WithImpl::normalizeUTF8;  // Avoid warning about hiding base class function.
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return FALSE;
+        }
+        const uint8_t *sArray=reinterpret_cast<const uint8_t *>(s.data());
+        if(sArray==NULL && s.length()!=0) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return FALSE;
+        }
+        return impl.composeUTF8(sArray, sArray+s.length(), onlyContiguous, FALSE, NULL, errorCode);
+    }
+    virtual const uint8_t *
+    spanQuickCheckYesUTF8(const uint8_t *src, const uint8_t *limit, UErrorCode &) const {
+        return impl.composeQuickCheckUTF8(src, limit, onlyContiguous, NULL);
+    }
+    using Normalizer2WithImpl::spanQuickCheckYesUTF8;  // Avoid warning about hiding base class function.
     virtual UNormalizationCheckResult getQuickCheck(UChar32 c) const {
         return impl.getCompQuickCheck(impl.getNorm16(c));
     }
@@ -308,6 +393,17 @@ private:
         return impl.makeFCD(src, limit, NULL, errorCode);
     }
     using Normalizer2WithImpl::spanQuickCheckYes;  // Avoid warning about hiding base class function.
+    virtual void
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit,
+                  ByteSink &sink, UErrorCode &errorCode) const {
+        impl.makeFCDUTF8(src, limit, &sink, errorCode);
+    }
+    using Normalizer2WithImpl::normalizeUTF8;  // Avoid warning about hiding base class function.
+    virtual const uint8_t *
+    spanQuickCheckYesUTF8(const uint8_t *src, const uint8_t *limit, UErrorCode &errorCode) const {
+        return impl.makeFCDUTF8(src, limit, NULL, errorCode);
+    }
+    using Normalizer2WithImpl::spanQuickCheckYesUTF8;  // Avoid warning about hiding base class function.
     virtual UBool hasBoundaryBefore(UChar32 c) const { return impl.hasFCDBoundaryBefore(c); }
     virtual UBool hasBoundaryAfter(UChar32 c) const { return impl.hasFCDBoundaryAfter(c); }
     virtual UBool isInert(UChar32 c) const { return impl.isFCDInert(c); }
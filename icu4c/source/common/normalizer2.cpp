@@ -21,6 +21,7 @@
 #include "unicode/normalizer2.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm.h"
+#include "unicode/ustring.h"
 #include "cstring.h"
 #include "mutex.h"
 #include "norm2allmodes.h"
@@ -54,6 +55,71 @@ Normalizer2::getCombiningClass(UChar32 /*c*/) const {
     return 0;
 }
 
+void
+Normalizer2::normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return;
+    }
+    UnicodeString dest16;
+    normalize(UnicodeString::fromUTF8(src), dest16, errorCode);
+    if(U_SUCCESS(errorCode)) {
+        dest16.toUTF8(sink);
+    }
+}
+
+UBool
+Normalizer2::isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return FALSE;
+    }
+    return isNormalized(UnicodeString::fromUTF8(s), errorCode);
+}
+
+int32_t
+Normalizer2::spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return 0;
+    }
+    int32_t index16=spanQuickCheckYes(UnicodeString::fromUTF8(s), errorCode);
+    return Normalizer2Impl::getUTF8Index(reinterpret_cast<const uint8_t *>(s.data()),
+                                         s.length(), index16);
+}
+
+void
+Normalizer2::normalizeBatch(const UChar *const srcs[], const int32_t srcLengths[], int32_t count,
+                            UnicodeString &dest, int32_t destStarts[], int32_t destLengths[],
+                            UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return;
+    }
+    if(count<0 || (count>0 && (srcs==NULL || destStarts==NULL || destLengths==NULL))) {
+        errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    dest.remove();
+    UnicodeString s, normalized;
+    for(int32_t i=0; i<count; ++i) {
+        int32_t length= srcLengths!=NULL ? srcLengths[i] : -1;
+        if(srcs[i]==NULL ? length!=0 : length<-1) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        s.setTo(length<0, srcs[i], length);  // read-only alias
+        if(spanQuickCheckYes(s, errorCode)==s.length()) {
+            destStarts[i]=-1;
+            destLengths[i]=s.length();
+        } else {
+            normalize(s, normalized, errorCode);
+            destStarts[i]=dest.length();
+            destLengths[i]=normalized.length();
+            dest.append(normalized);
+        }
+        if(U_FAILURE(errorCode)) {
+            return;
+        }
+    }
+}
+
 // Normalizer2 implementation for the old UNORM_NONE.
 class NoopNormalizer2 : public Normalizer2 {
     virtual ~NoopNormalizer2();
@@ -114,6 +180,20 @@ class NoopNormalizer2 : public Normalizer2 {
     spanQuickCheckYes(const UnicodeString &s, UErrorCode &) const {
         return s.length();
     }
+    virtual void
+    normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const {
+        if(U_SUCCESS(errorCode) && src.length()!=0) {
+            sink.Append(src.data(), src.length());
+        }
+    }
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &, UErrorCode &) const {
+        return TRUE;
+    }
+    virtual int32_t
+    spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &) const {
+        return s.length();
+    }
     virtual UBool hasBoundaryBefore(UChar32) const { return TRUE; }
     virtual UBool hasBoundaryAfter(UChar32) const { return TRUE; }
     virtual UBool isInert(UChar32) const { return TRUE; }
@@ -123,6 +203,69 @@ NoopNormalizer2::~NoopNormalizer2() {}
 
 Normalizer2WithImpl::~Normalizer2WithImpl() {}
 
+void
+Normalizer2WithImpl::normalizeBatch(const UChar *const srcs[], const int32_t srcLengths[],
+                                    int32_t count, UnicodeString &dest,
+                                    int32_t destStarts[], int32_t destLengths[],
+                                    UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return;
+    }
+    if(count<0 || (count>0 && (srcs==NULL || destStarts==NULL || destLengths==NULL))) {
+        errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    dest.remove();
+    // All strings are normalized into dest via one ReorderingBuffer.
+    // Each one starts with a reordering limit so that its combining marks
+    // are not reordered into the previous string's result.
+    ReorderingBuffer buffer(impl, dest);
+    if(!buffer.init(0, errorCode)) {
+        return;
+    }
+    for(int32_t i=0; i<count; ++i) {
+        const UChar *src=srcs[i];
+        int32_t length= srcLengths!=NULL ? srcLengths[i] : -1;
+        if(src==NULL ? length!=0 : length<-1) {
+            errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        if(length<0) {
+            length=u_strlen(src);
+        }
+        if(length==0) {
+            // Do not pass src==limit==NULL to the impl, which would treat it as NUL-terminated.
+            destStarts[i]=-1;
+            destLengths[i]=0;
+            continue;
+        }
+        const UChar *limit=src+length;
+        const UChar *spanLimit=spanQuickCheckYes(src, limit, errorCode);
+        if(spanLimit!=limit) {
+            UChar *start=buffer.getLimit();
+            buffer.setReorderingLimit(start);
+            int32_t startIndex=buffer.length();
+            // The quick check span ends at a boundary and need not be normalized again.
+            buffer.appendZeroCC(src, spanLimit, errorCode);
+            normalize(spanLimit, limit, buffer, errorCode);
+            if(U_FAILURE(errorCode)) {
+                return;
+            }
+            // A "maybe" result might still turn out to be normalized.
+            start=buffer.getStart()+startIndex;  // The buffer might have been reallocated.
+            int32_t resultLength=(int32_t)(buffer.getLimit()-start);
+            if(resultLength!=length || u_memcmp(start, src, length)!=0) {
+                destStarts[i]=startIndex;
+                destLengths[i]=resultLength;
+                continue;
+            }
+            buffer.setReorderingLimit(start);
+        }
+        destStarts[i]=-1;
+        destLengths[i]=length;
+    }
+}
+
 DecomposeNormalizer2::~DecomposeNormalizer2() {}
 
 ComposeNormalizer2::~ComposeNormalizer2() {}
@@ -479,6 +622,26 @@ unorm2_spanQuickCheckYes(const UNormalizer2 *norm2,
     return ((const Normalizer2 *)norm2)->spanQuickCheckYes(sString, *pErrorCode);
 }
 
+U_CAPI int32_t U_EXPORT2
+unorm2_normalizeBatch(const UNormalizer2 *norm2,
+                      const UChar *const *srcs, const int32_t *srcLengths, int32_t count,
+                      UChar *dest, int32_t capacity,
+                      int32_t *destStarts, int32_t *destLengths,
+                      UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(dest==NULL ? capacity!=0 : capacity<0) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    UnicodeString destString(dest, 0, capacity);
+    ((const Normalizer2 *)norm2)->normalizeBatch(srcs, srcLengths, count,
+                                                 destString, destStarts, destLengths,
+                                                 *pErrorCode);
+    return destString.extract(dest, capacity, *pErrorCode);
+}
+
 U_CAPI UBool U_EXPORT2
 unorm2_hasBoundaryBefore(const UNormalizer2 *norm2, UChar32 c) {
     return ((const Normalizer2 *)norm2)->hasBoundaryBefore(c);
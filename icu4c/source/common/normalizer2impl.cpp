@@ -22,6 +22,7 @@
 #include "unicode/udata.h"
 #include "unicode/ustring.h"
 #include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "cmemory.h"
 #include "mutex.h"
 #include "normalizer2impl.h"
@@ -31,6 +32,19 @@
 #include "utrie2.h"
 #include "uvector.h"
 
+// SSE2 is part of the x86-64 baseline, so the compiler predefines one of these
+// wherever it can be used without extra flags.
+#if !defined(U_NORM2_USE_SSE2)
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+#       define U_NORM2_USE_SSE2 1
+#   else
+#       define U_NORM2_USE_SSE2 0
+#   endif
+#endif
+#if U_NORM2_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 U_NAMESPACE_BEGIN
 
 // ReorderingBuffer -------------------------------------------------------- ***
@@ -417,6 +431,35 @@ Normalizer2Impl::addCanonIterPropertyStarts(const USetAdder *sa, UErrorCode &err
     }
 }
 
+/**
+ * Skips code units below minNoCP which need no data lookup.
+ * Tests 8 code units at a time where SSE2 is available;
+ * Latin text spends most of its time in this loop.
+ * @return the first code unit >=minNoCP, or limit
+ */
+static inline const UChar *
+spanBelowMinNoCP(const UChar *src, const UChar *limit, UChar32 minNoCP) {
+#if U_NORM2_USE_SSE2
+    if(0<minNoCP && minNoCP<=0xffff) {
+        // v<minNoCP <=> saturated (v-(minNoCP-1))==0
+        const __m128i minNoCPMinus1=_mm_set1_epi16((short)(minNoCP-1));
+        const __m128i zero=_mm_setzero_si128();
+        while((limit-src)>=8) {
+            __m128i units=_mm_loadu_si128((const __m128i *)src);
+            __m128i isLow=_mm_cmpeq_epi16(_mm_subs_epu16(units, minNoCPMinus1), zero);
+            if(_mm_movemask_epi8(isLow)!=0xffff) {
+                break;  // the scalar loop finds the exact position
+            }
+            src+=8;
+        }
+    }
+#endif
+    while(src!=limit && *src<minNoCP) {
+        ++src;
+    }
+    return src;
+}
+
 const UChar *
 Normalizer2Impl::copyLowPrefixFromNulTerminated(const UChar *src,
                                                 UChar32 minNeedDataCP,
@@ -499,9 +542,9 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
         for(prevSrc=src; src!=limit;) {
-            if( (c=*src)<minNoCP ||
-                isMostDecompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoCP) {
+                src=spanBelowMinNoCP(src+1, limit, minNoCP);
+            } else if(isMostDecompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else if(!U16_IS_SURROGATE(c)) {
                 break;
@@ -1118,9 +1161,9 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
         for(prevSrc=src; src!=limit;) {
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                src=spanBelowMinNoCP(src+1, limit, minNoMaybeCP);
+            } else if(isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else if(!U16_IS_SURROGATE(c)) {
                 break;
@@ -1365,9 +1408,9 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
             if(src==limit) {
                 return src;
             }
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                src=spanBelowMinNoCP(src+1, limit, minNoMaybeCP);
+            } else if(isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else if(!U16_IS_SURROGATE(c)) {
                 break;
@@ -1652,8 +1695,8 @@ Normalizer2Impl::makeFCD(const UChar *src, const UChar *limit,
         // count code units with lccc==0
         for(prevSrc=src; src!=limit;) {
             if((c=*src)<MIN_CCC_LCCC_CP) {
-                prevFCD16=~c;
-                ++src;
+                src=spanBelowMinNoCP(src+1, limit, MIN_CCC_LCCC_CP);
+                prevFCD16=~*(src-1);
             } else if(!singleLeadMightHaveNonZeroFCD16(c)) {
                 prevFCD16=0;
                 ++src;
@@ -1804,6 +1847,239 @@ const UChar *Normalizer2Impl::findNextFCDBoundary(const UChar *p, const UChar *l
     return p;
 }
 
+// UTF-8 ------------------------------------------------------------------- ***
+
+const uint8_t *
+Normalizer2Impl::decomposeUTF8(const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, UErrorCode &errorCode) const {
+    return processUTF8(UTF8_DECOMPOSE, sink!=NULL ? UTF8_NORMALIZE : UTF8_SPAN_YES,
+                       src, limit, sink, NULL, errorCode);
+}
+
+UBool
+Normalizer2Impl::composeUTF8(const uint8_t *src, const uint8_t *limit,
+                             UBool onlyContiguous,
+                             UBool doCompose,
+                             ByteSink *sink,
+                             UErrorCode &errorCode) const {
+    UTF8Form form=onlyContiguous ? UTF8_COMPOSE_CONTIGUOUS : UTF8_COMPOSE;
+    if(doCompose) {
+        processUTF8(form, UTF8_NORMALIZE, src, limit, sink, NULL, errorCode);
+        return TRUE;
+    } else {
+        return limit==processUTF8(form, UTF8_IS_NORMALIZED, src, limit, NULL, NULL, errorCode);
+    }
+}
+
+const uint8_t *
+Normalizer2Impl::composeQuickCheckUTF8(const uint8_t *src, const uint8_t *limit,
+                                       UBool onlyContiguous,
+                                       UNormalizationCheckResult *pQCResult) const {
+    UErrorCode errorCode=U_ZERO_ERROR;
+    return processUTF8(onlyContiguous ? UTF8_COMPOSE_CONTIGUOUS : UTF8_COMPOSE,
+                       pQCResult!=NULL ? UTF8_QUICK_CHECK : UTF8_SPAN_YES,
+                       src, limit, NULL, pQCResult, errorCode);
+}
+
+const uint8_t *
+Normalizer2Impl::makeFCDUTF8(const uint8_t *src, const uint8_t *limit,
+                             ByteSink *sink, UErrorCode &errorCode) const {
+    return processUTF8(UTF8_FCD, sink!=NULL ? UTF8_NORMALIZE : UTF8_SPAN_YES,
+                       src, limit, sink, NULL, errorCode);
+}
+
+int32_t
+Normalizer2Impl::getUTF8Index(const uint8_t *s, int32_t length, int32_t index16) {
+    int32_t i=0;
+    while(index16>0 && i<length) {
+        UChar32 c;
+        U8_NEXT(s, i, length, c);
+        index16-= c>0xffff ? 2 : 1;  // c<0: one U+FFFD
+    }
+    return i;
+}
+
+// TRUE if c passes the quick check with ccc=0 (and lccc=0 for FCD)
+// and therefore has a normalization boundary before it.
+UBool Normalizer2Impl::isUTF8QuickCheckYes(UTF8Form form, UChar32 c) const {
+    switch(form) {
+    case UTF8_DECOMPOSE:
+        return c<minDecompNoCP || isMostDecompYesAndZeroCC(getNorm16(c));
+    case UTF8_FCD:
+        return c<MIN_CCC_LCCC_CP || getFCD16(c)<=0xff;
+    default:
+        return c<minCompNoMaybeCP || isCompYesAndZeroCC(getNorm16(c));
+    }
+}
+
+/*
+ * Shared implementation of the UTF-8 functions.
+ *
+ * The fast loop skips code points that pass the quick check with ccc=0
+ * (isUTF8QuickCheckYes()) without converting them.
+ * When it finds one that does not, then it collects the segment up to
+ * the next such code point, converts only that segment to UTF-16
+ * and lets the UTF-16 code handle it.
+ * For composition and FCD, the segment also includes the preceding "yes"
+ * code point because that might combine with, or need to be reordered
+ * relative to, the following text.
+ *
+ * UTF8_NORMALIZE: Unchanged text is written to the sink lazily and in bulk,
+ * so that normalized input results in a single Append() of the whole input.
+ * Returns limit.
+ * UTF8_IS_NORMALIZED: Returns limit if the text is normalized.
+ * UTF8_SPAN_YES, UTF8_QUICK_CHECK: Returns the end of the quick check "yes" span.
+ * (For UTF8_QUICK_CHECK, *pQCResult must be UNORM_YES.)
+ */
+const uint8_t *
+Normalizer2Impl::processUTF8(UTF8Form form, UTF8Action action,
+                             const uint8_t *src, const uint8_t *limit,
+                             ByteSink *sink, UNormalizationCheckResult *pQCResult,
+                             UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return src;
+    }
+    UChar32 minNoCP;
+    if(form==UTF8_DECOMPOSE) {
+        minNoCP=minDecompNoCP;
+    } else if(form==UTF8_FCD) {
+        minNoCP=MIN_CCC_LCCC_CP;
+    } else {
+        minNoCP=minCompNoMaybeCP;
+    }
+    // Bytes below this value are ASCII characters below minNoCP.
+    uint8_t minNoByte= minNoCP<0x80 ? (uint8_t)minNoCP : 0x80;
+    const uint8_t *pending=src;  // start of the unchanged text not yet written to the sink
+    UnicodeString segment16, dest16;  // reused for all segments
+
+    while(src!=limit) {
+        // Skip the code points that pass the quick check.
+        const uint8_t *lastYes=NULL;
+        while(src!=limit) {
+            if(*src<minNoByte) {
+                lastYes=src++;
+                continue;
+            }
+            const uint8_t *cpStart=src;
+            UBool isYes;
+            if(form==UTF8_FCD) {
+                int32_t i=0;
+                UChar32 c;
+                U8_NEXT(src, i, (int32_t)(limit-src), c);
+                src+=i;
+                isYes= c<MIN_CCC_LCCC_CP || getFCD16(c)<=0xff;
+            } else {
+                uint16_t norm16;
+                UTRIE2_U8_NEXT16(normTrie, src, limit, norm16);
+                isYes= form==UTF8_DECOMPOSE ?
+                    isMostDecompYesAndZeroCC(norm16) : isCompYesAndZeroCC(norm16);
+            }
+            if(isYes) {
+                lastYes=cpStart;
+                continue;
+            }
+            // The trie looks up stray trail bytes as if they were U+0080..U+00BF.
+            // Ill-formed sequences are inert: Skip them, and
+            // do not let the next segment start before them.
+            int32_t i=0;
+            UChar32 c;
+            U8_NEXT(cpStart, i, (int32_t)(limit-cpStart), c);
+            if(c<0) {
+                src=cpStart+i;
+                lastYes=NULL;
+                continue;
+            }
+            src=cpStart;
+            break;
+        }
+        if(src==limit) {
+            break;
+        }
+
+        // src is at a code point that fails the quick check.
+        const uint8_t *segStart=src;
+        if(form!=UTF8_DECOMPOSE && lastYes!=NULL) {
+            // lastYes might be an ill-formed sequence that the trie looked up as inert.
+            int32_t i=0;
+            UChar32 c;
+            U8_NEXT(lastYes, i, (int32_t)(limit-lastYes), c);
+            if(c>=0) {
+                segStart=lastYes;
+            }
+        }
+        segment16.remove();
+        const uint8_t *p=segStart;
+        while(p!=limit) {
+            int32_t i=0;
+            UChar32 c;
+            U8_NEXT(p, i, (int32_t)(limit-p), c);
+            if(p>src && (c<0 || isUTF8QuickCheckYes(form, c))) {
+                break;
+            }
+            segment16.append(c);
+            p+=i;
+        }
+        const uint8_t *segLimit=p;
+        if(segment16.isBogus()) {
+            errorCode=U_MEMORY_ALLOCATION_ERROR;
+            return segStart;
+        }
+        const UChar *s16=segment16.getBuffer();
+        const UChar *s16Limit=s16+segment16.length();
+
+        if(action==UTF8_SPAN_YES || action==UTF8_QUICK_CHECK) {
+            const UChar *yesLimit;
+            if(form==UTF8_DECOMPOSE) {
+                yesLimit=decompose(s16, s16Limit, NULL, errorCode);
+            } else if(form==UTF8_FCD) {
+                yesLimit=makeFCD(s16, s16Limit, NULL, errorCode);
+            } else {
+                yesLimit=composeQuickCheck(s16, s16Limit, form==UTF8_COMPOSE_CONTIGUOUS, pQCResult);
+            }
+            if(yesLimit!=s16Limit) {
+                if(pQCResult!=NULL) {
+                    *pQCResult=UNORM_NO;
+                }
+                return segStart+getUTF8Index(segStart, (int32_t)(segLimit-segStart),
+                                             (int32_t)(yesLimit-s16));
+            }
+        } else {
+            dest16.remove();
+            {
+                ReorderingBuffer buffer(*this, dest16);
+                if(!buffer.init(segment16.length(), errorCode)) {
+                    return segStart;
+                }
+                if(form==UTF8_DECOMPOSE) {
+                    decompose(s16, s16Limit, &buffer, errorCode);
+                } else if(form==UTF8_FCD) {
+                    makeFCD(s16, s16Limit, &buffer, errorCode);
+                } else {
+                    compose(s16, s16Limit, form==UTF8_COMPOSE_CONTIGUOUS, TRUE, buffer, errorCode);
+                }
+            }  // The ReorderingBuffer destructor finalizes dest16.
+            if(U_FAILURE(errorCode)) {
+                return segStart;
+            }
+            if(dest16!=segment16) {
+                if(action==UTF8_IS_NORMALIZED) {
+                    return segStart;
+                }
+                if(pending!=segStart) {
+                    sink->Append((const char *)pending, (int32_t)(segStart-pending));
+                }
+                dest16.toUTF8(*sink);
+                pending=segLimit;
+            }
+        }
+        src=segLimit;
+    }
+    if(action==UTF8_NORMALIZE && pending!=limit) {
+        sink->Append((const char *)pending, (int32_t)(limit-pending));
+    }
+    return limit;
+}
+
 // CanonicalIterator data -------------------------------------------------- ***
 
 CanonIterData::CanonIterData(UErrorCode &errorCode) :
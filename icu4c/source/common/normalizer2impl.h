@@ -21,6 +21,7 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/bytestream.h"
 #include "unicode/normalizer2.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm.h"
@@ -463,6 +464,36 @@ public:
                           ReorderingBuffer &buffer,
                           UErrorCode &errorCode) const;
 
+    // UTF-8 versions of the functions above.
+    // The text is split into segments between code points which pass the quick check
+    // with ccc=0. Those code points are copied to the sink in bulk, without conversion;
+    // only the segments between them are converted to UTF-16 and
+    // handled by the UTF-16 functions.
+    // Ill-formed UTF-8 is normalization-inert and copied unchanged.
+    // sink!=NULL: normalize, returns limit
+    // sink==NULL: spanQuickCheckYes, returns the end of the "yes" span
+    const uint8_t *decomposeUTF8(const uint8_t *src, const uint8_t *limit,
+                                 ByteSink *sink, UErrorCode &errorCode) const;
+    // doCompose: normalize
+    // !doCompose: isNormalized (sink must be NULL)
+    UBool composeUTF8(const uint8_t *src, const uint8_t *limit,
+                      UBool onlyContiguous,
+                      UBool doCompose,
+                      ByteSink *sink,
+                      UErrorCode &errorCode) const;
+    const uint8_t *composeQuickCheckUTF8(const uint8_t *src, const uint8_t *limit,
+                                         UBool onlyContiguous,
+                                         UNormalizationCheckResult *pQCResult) const;
+    const uint8_t *makeFCDUTF8(const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, UErrorCode &errorCode) const;
+
+    /**
+     * Returns the number of UTF-8 bytes in s[0..length[ that correspond to
+     * the first index16 UTF-16 code units of the same text.
+     * Each ill-formed sequence counts as one U+FFFD.
+     */
+    static int32_t getUTF8Index(const uint8_t *s, int32_t length, int32_t index16);
+
     UBool hasDecompBoundary(UChar32 c, UBool before) const;
     UBool isDecompInert(UChar32 c) const { return isDecompYesAndZeroCC(getNorm16(c)); }
 
@@ -575,6 +606,14 @@ private:
     const UChar *findPreviousCompBoundary(const UChar *start, const UChar *p) const;
     const UChar *findNextCompBoundary(const UChar *p, const UChar *limit) const;
 
+    enum UTF8Form { UTF8_DECOMPOSE, UTF8_COMPOSE, UTF8_COMPOSE_CONTIGUOUS, UTF8_FCD };
+    enum UTF8Action { UTF8_NORMALIZE, UTF8_IS_NORMALIZED, UTF8_SPAN_YES, UTF8_QUICK_CHECK };
+    UBool isUTF8QuickCheckYes(UTF8Form form, UChar32 c) const;
+    const uint8_t *processUTF8(UTF8Form form, UTF8Action action,
+                               const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, UNormalizationCheckResult *pQCResult,
+                               UErrorCode &errorCode) const;
+
     const UChar *findPreviousFCDBoundary(const UChar *start, const UChar *p) const;
     const UChar *findNextFCDBoundary(const UChar *p, const UChar *limit) const;
 
@@ -0,0 +1,199 @@
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  normalizer2stream.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Chunked normalization with a bounded amount of held-back text.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_NORMALIZATION
+
+#include "unicode/normalizer2.h"
+#include "unicode/unistr.h"
+#include "unicode/unorm2.h"
+#include "unicode/utf16.h"
+#include "cmemory.h"
+
+U_NAMESPACE_BEGIN
+
+Normalizer2Stream::~Normalizer2Stream() {}
+
+UnicodeString &
+Normalizer2Stream::normalizeChunk(const UnicodeString &chunk, UnicodeString &dest,
+                                  UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) {
+        return dest;
+    }
+    if(&chunk==&dest || chunk.isBogus()) {
+        errorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return dest;
+    }
+    int32_t prevLength=pending.length();
+    pending.append(chunk);
+    int32_t length=pending.length();
+    if(length==0) {
+        return dest;
+    }
+    const UChar *p=pending.getBuffer();
+    int32_t limit=length;
+    if(U16_IS_LEAD(p[limit-1])) {
+        --limit;  // It might pair with a trail surrogate at the start of the next chunk.
+    }
+    // Find the last normalization boundary.
+    // The held-back text has no boundary except at its start,
+    // so we only look at the new text and at a code point straddling the old end.
+    int32_t boundary=0;
+    if(limit>0) {
+        int32_t i=limit;
+        UChar32 c;
+        U16_PREV(p, 0, i, c);
+        if(norm2.hasBoundaryAfter(c)) {
+            // Nothing that follows can change the text so far.
+            boundary=limit;
+        } else {
+            int32_t minIndex= prevLength>1 ? prevLength-1 : 1;  // A boundary at 0 is useless.
+            for(;;) {
+                if(norm2.hasBoundaryBefore(c)) {
+                    boundary=i;
+                    break;
+                }
+                if(i<=minIndex) {
+                    break;
+                }
+                U16_PREV(p, 0, i, c);
+            }
+        }
+    }
+    if(boundary>0) {
+        norm2.normalize(pending.tempSubString(0, boundary), normalized, errorCode);
+        if(U_FAILURE(errorCode)) {
+            return dest;
+        }
+        dest.append(normalized);
+        pending.remove(0, boundary);
+    }
+    return dest;
+}
+
+UnicodeString &
+Normalizer2Stream::finish(UnicodeString &dest, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) {
+        return dest;
+    }
+    if(!pending.isEmpty()) {
+        norm2.normalize(pending, normalized, errorCode);
+        if(U_FAILURE(errorCode)) {
+            return dest;
+        }
+        dest.append(normalized);
+        pending.remove();
+    }
+    return dest;
+}
+
+U_NAMESPACE_END
+
+// C API ------------------------------------------------------------------- ***
+
+U_NAMESPACE_USE
+
+/**
+ * Normalizer2Stream plus the normalized text that did not yet fit
+ * into the caller's target buffer.
+ */
+struct UNormalizer2Stream : public UMemory {
+    UNormalizer2Stream(const Normalizer2 &n2) : stream(n2), overflowStart(0) {}
+
+    Normalizer2Stream stream;
+    UnicodeString overflow;
+    int32_t overflowStart;
+};
+
+U_CAPI UNormalizer2Stream * U_EXPORT2
+unorm2_openStream(const UNormalizer2 *norm2, UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return NULL;
+    }
+    if(norm2==NULL) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    UNormalizer2Stream *stream=new UNormalizer2Stream(*(const Normalizer2 *)norm2);
+    if(stream==NULL) {
+        *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+    }
+    return stream;
+}
+
+U_CAPI void U_EXPORT2
+unorm2_closeStream(UNormalizer2Stream *stream) {
+    delete stream;
+}
+
+U_CAPI void U_EXPORT2
+unorm2_resetStream(UNormalizer2Stream *stream) {
+    stream->stream.reset();
+    stream->overflow.remove();
+    stream->overflowStart=0;
+}
+
+U_CAPI void U_EXPORT2
+unorm2_normalizeStream(UNormalizer2Stream *stream,
+                       UChar **target, const UChar *targetLimit,
+                       const UChar **source, const UChar *sourceLimit,
+                       UBool flush,
+                       UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    if( stream==NULL || target==NULL || source==NULL ||
+        (*target==NULL ? targetLimit!=NULL : targetLimit<*target) ||
+        (*source==NULL ? sourceLimit!=NULL : sourceLimit<*source)
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    UnicodeString &overflow=stream->overflow;
+    if(*source<sourceLimit) {
+        // Read-only alias of the input chunk.
+        UnicodeString chunk(FALSE, *source, (int32_t)(sourceLimit-*source));
+        stream->stream.normalizeChunk(chunk, overflow, *pErrorCode);
+        if(U_FAILURE(*pErrorCode)) {
+            return;
+        }
+        *source=sourceLimit;
+    }
+    if(flush) {
+        stream->stream.finish(overflow, *pErrorCode);
+        if(U_FAILURE(*pErrorCode)) {
+            return;
+        }
+    }
+    // Write as much of the normalized text as fits.
+    int32_t length=overflow.length()-stream->overflowStart;
+    int32_t capacity=(int32_t)(targetLimit-*target);
+    if(length>capacity) {
+        overflow.extract(stream->overflowStart, capacity, *target);
+        *target+=capacity;
+        stream->overflowStart+=capacity;
+        *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+    } else {
+        if(length>0) {
+            overflow.extract(stream->overflowStart, length, *target);
+            *target+=length;
+        }
+        overflow.remove();
+        stream->overflowStart=0;
+    }
+}
+
+#endif  // !UCONFIG_NO_NORMALIZATION
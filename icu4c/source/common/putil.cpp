@@ -322,6 +322,34 @@ uprv_getRawUTCtime()
 #endif
 }
 
+U_CAPI double U_EXPORT2
+uprv_getMonotonicMillis()
+{
+#if U_PLATFORM_USES_ONLY_WIN32_API
+
+    LARGE_INTEGER counter, frequency;
+    if (QueryPerformanceCounter(&counter) && QueryPerformanceFrequency(&frequency)) {
+        return (double)counter.QuadPart * U_MILLIS_PER_SECOND / (double)frequency.QuadPart;
+    }
+    return (double)GetTickCount();
+#elif defined(CLOCK_MONOTONIC)
+
+    struct timespec monotonicTime;
+    if (clock_gettime(CLOCK_MONOTONIC, &monotonicTime) == 0) {
+        return (double)monotonicTime.tv_sec * U_MILLIS_PER_SECOND + monotonicTime.tv_nsec / 1000000.0;
+    }
+    return uprv_getRawUTCtime();
+#elif HAVE_GETTIMEOFDAY
+
+    struct timeval posixTime;
+    gettimeofday(&posixTime, NULL);
+    return (double)posixTime.tv_sec * U_MILLIS_PER_SECOND + posixTime.tv_usec / 1000.0;
+#else
+
+    return uprv_getRawUTCtime();
+#endif
+}
+
 /*-----------------------------------------------------------------------------
   IEEE 754
   These methods detect and return NaN and infinity values for doubles
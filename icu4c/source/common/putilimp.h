@@ -495,6 +495,15 @@ U_INTERNAL UDate U_EXPORT2 uprv_getUTCtime(void);
  */
 U_INTERNAL UDate U_EXPORT2 uprv_getRawUTCtime(void);
 
+/**
+ * Get a time in milliseconds, with sub-millisecond precision where available,
+ * for measuring elapsed time. The clock does not jump with changes of the
+ * system time; its starting point is unspecified.
+ * @return the time measured in milliseconds
+ * @internal
+ */
+U_INTERNAL double U_EXPORT2 uprv_getMonotonicMillis(void);
+
 /**
  * Determine whether a pathname is absolute or not, as defined by the platform.
  * @param path Pathname to test
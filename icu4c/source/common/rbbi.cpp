@@ -21,13 +21,17 @@
 #include "unicode/uchriter.h"
 #include "unicode/udata.h"
 #include "unicode/uclean.h"
+#include "unicode/utf8.h"
+#include "unicode/utf16.h"
 #include "rbbidata.h"
 #include "rbbirb.h"
+#include "utext_imp.h"
 #include "cmemory.h"
 #include "cstring.h"
 #include "umutex.h"
 #include "ucln_cmn.h"
 #include "brkeng.h"
+#include "dictbe.h"
 
 #include "uassert.h"
 #include "uvector.h"
@@ -50,6 +54,110 @@ U_NAMESPACE_BEGIN
 #define STOP_STATE  0
 
 
+//-----------------------------------------------------------------------------
+//
+//   RBBIBoundaryCache   Ring buffer of boundaries found by earlier calls,
+//                       together with their rule status indexes.
+//                       The entries are consecutive: entry i+1 is always the
+//                       boundary immediately following entry i. This lets
+//                       following() and preceding() find a result in the cached
+//                       range with a binary search, and lets next() and previous()
+//                       step through it without running the state machine again.
+//
+//-----------------------------------------------------------------------------
+class RBBIBoundaryCache : public UMemory {
+public:
+    enum {
+        CAPACITY = 128      // Must be a power of 2.
+    };
+
+    RBBIBoundaryCache() : fIndex(-1), fStart(0), fCount(0) {}
+
+    void clear() {
+        fIndex = -1;
+        fStart = 0;
+        fCount = 0;
+    }
+
+    int32_t count() const { return fCount; }
+    int32_t positionAt(int32_t i) const { return fPositions[(fStart + i) & (CAPACITY - 1)]; }
+    int32_t statusAt(int32_t i) const { return fStatuses[(fStart + i) & (CAPACITY - 1)]; }
+    void setStatusAt(int32_t i, int32_t status) { fStatuses[(fStart + i) & (CAPACITY - 1)] = status; }
+
+    /** Returns the index of the last entry at or before pos, or -1 if there is none. */
+    int32_t indexAtOrBefore(int32_t pos) const {
+        int32_t start = 0;
+        int32_t limit = fCount;
+        while (start < limit) {
+            int32_t mid = (start + limit) / 2;
+            if (positionAt(mid) <= pos) {
+                start = mid + 1;
+            } else {
+                limit = mid;
+            }
+        }
+        return start - 1;
+    }
+
+    /** Replaces the contents with the one boundary pos, and makes it the current entry. */
+    void restart(int32_t pos, int32_t status) {
+        fIndex = 0;
+        fStart = 0;
+        fCount = 1;
+        fPositions[0] = pos;
+        fStatuses[0]  = status;
+    }
+
+    /** Adds the boundary following the last entry. Drops the first entry if full. */
+    void append(int32_t pos, int32_t status) {
+        if (fCount == CAPACITY) {
+            fStart = (fStart + 1) & (CAPACITY - 1);
+            --fCount;
+            if (fIndex >= 0) {
+                --fIndex;       // -1 if the current entry was dropped
+            }
+        }
+        int32_t i = (fStart + fCount) & (CAPACITY - 1);
+        fPositions[i] = pos;
+        fStatuses[i]  = status;
+        ++fCount;
+    }
+
+    /** Adds the boundary preceding the first entry. Drops the last entry if full. */
+    void prepend(int32_t pos, int32_t status) {
+        if (fCount == CAPACITY) {
+            --fCount;
+            if (fIndex == fCount) {
+                fIndex = -1;
+            }
+        }
+        fStart = (fStart + CAPACITY - 1) & (CAPACITY - 1);
+        fPositions[fStart] = pos;
+        fStatuses[fStart]  = status;
+        ++fCount;
+        if (fIndex >= 0) {
+            ++fIndex;
+        }
+    }
+
+    /** The entry for the current iteration position, or -1 if that position is not cached. */
+    int32_t fIndex;
+
+private:
+    int32_t fPositions[CAPACITY];
+    int32_t fStatuses[CAPACITY];    // Rule status index, or -1 if not known yet.
+    int32_t fStart;
+    int32_t fCount;
+};
+
+// fillBoundaryCache() adds at most this many boundaries to reach a requested
+// offset; farther away it is faster to start over at the offset.
+static const int32_t kMaxBoundaryCacheSteps = 8;
+
+// Assumed distance between boundaries before there are enough cached ones to measure it.
+static const int32_t kDefaultBoundaryGap = 8;
+
+
 UOBJECT_DEFINE_RTTI_IMPLEMENTATION(RuleBasedBreakIterator)
 
 
@@ -216,6 +324,10 @@ RuleBasedBreakIterator::~RuleBasedBreakIterator() {
         delete fUnhandledBreakEngine;
         fUnhandledBreakEngine = NULL;
     }
+    delete fBoundaryCache;
+    fBoundaryCache = NULL;
+    delete fDictionaryWorkspace;
+    fDictionaryWorkspace = NULL;
 }
 
 /**
@@ -228,6 +340,9 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
         return *this;
     }
     reset();    // Delete break cache information
+    if (fBoundaryCache != NULL) {
+        fBoundaryCache->clear();
+    }
     fBreakType = that.fBreakType;
     if (fLanguageBreakEngines != NULL) {
         delete fLanguageBreakEngines;
@@ -288,6 +403,8 @@ void RuleBasedBreakIterator::init() {
     fUnhandledBreakEngine    = NULL;
     fNumCachedBreakPositions = 0;
     fPositionInCache         = 0;
+    fBoundaryCache           = new RBBIBoundaryCache();   // Optional; NULL disables it.
+    fDictionaryWorkspace     = NULL;
 
 #ifdef RBBI_DEBUG
     static UBool debugInitDone = FALSE;
@@ -362,6 +479,9 @@ void RuleBasedBreakIterator::setText(UText *ut, UErrorCode &status) {
         return;
     }
     reset();
+    if (fBoundaryCache != NULL) {
+        fBoundaryCache->clear();
+    }
     fText = utext_clone(fText, ut, FALSE, TRUE, &status);
 
     // Set up a dummy CharacterIterator to be returned if anyone
@@ -444,6 +564,9 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
     fCharIter = newText;
     UErrorCode status = U_ZERO_ERROR;
     reset();
+    if (fBoundaryCache != NULL) {
+        fBoundaryCache->clear();
+    }
     if (newText==NULL || newText->startIndex() != 0) {   
         // startIndex !=0 wants to be an error, but there's no way to report it.
         // Make the iterator text be an empty string.
@@ -463,6 +586,9 @@ void
 RuleBasedBreakIterator::setText(const UnicodeString& newText) {
     UErrorCode status = U_ZERO_ERROR;
     reset();
+    if (fBoundaryCache != NULL) {
+        fBoundaryCache->clear();
+    }
     fText = utext_openConstUnicodeString(fText, &newText, &status);
 
     // Set up a character iterator on the string.  
@@ -529,6 +655,7 @@ int32_t RuleBasedBreakIterator::first(void) {
     //    return BreakIterator::DONE;
 
     utext_setNativeIndex(fText, 0);
+    syncBoundaryCacheIndex();
     return 0;
 }
 
@@ -547,6 +674,7 @@ int32_t RuleBasedBreakIterator::last(void) {
     fLastStatusIndexValid = FALSE;
     int32_t pos = (int32_t)utext_nativeLength(fText);
     utext_setNativeIndex(fText, pos);
+    syncBoundaryCacheIndex();
     return pos;
 }
 
@@ -577,6 +705,114 @@ int32_t RuleBasedBreakIterator::next(int32_t n) {
  * @return The position of the first boundary after this one.
  */
 int32_t RuleBasedBreakIterator::next(void) {
+    // If the boundary cache already has the following boundary, just step to it.
+    RBBIBoundaryCache *cache = fBoundaryCache;
+    if (cache != NULL && cache->fIndex >= 0 && cache->fIndex + 1 < cache->count()) {
+        return setFromBoundaryCache(cache->fIndex + 1);
+    }
+
+    int32_t startPos    = current();
+    int32_t startStatus = fLastStatusIndexValid ? fLastRuleStatusIndex : -1;
+    syncDictionaryCache();
+    // Steps through the dictionary cache leave the rule status as it was,
+    // so that status must not be cached for the new position.
+    UBool keepsStatus = fCachedBreakPositions != NULL && fPositionInCache < fNumCachedBreakPositions - 1;
+    int32_t result = nextBoundary();
+    if (cache != NULL && result != BreakIterator::DONE) {
+        // Either extend the cached run of boundaries past its last one,
+        // or start a new run from where we were.
+        if (cache->fIndex < 0) {
+            cache->restart(startPos, startStatus);
+        }
+        cache->append(result, (fLastStatusIndexValid && !keepsStatus) ? fLastRuleStatusIndex : -1);
+        cache->fIndex = cache->count() - 1;
+    }
+    return result;
+}
+
+/**
+ * Advances the iterator backwards, to the last boundary preceding this one.
+ * @return The position of the last boundary position preceding this one.
+ */
+int32_t RuleBasedBreakIterator::previous(void) {
+    RBBIBoundaryCache *cache = fBoundaryCache;
+    if (cache != NULL && cache->fIndex > 0) {
+        return setFromBoundaryCache(cache->fIndex - 1);
+    }
+
+    int32_t startPos    = current();
+    int32_t startStatus = fLastStatusIndexValid ? fLastRuleStatusIndex : -1;
+    syncDictionaryCache();
+    int32_t result = previousBoundary();
+    if (cache != NULL && result != BreakIterator::DONE) {
+        if (cache->fIndex < 0) {
+            cache->restart(startPos, startStatus);
+        }
+        // The status from reverse iteration need not match the one from forward iteration,
+        // which is what next() and following() return, so leave it to be computed on demand.
+        cache->prepend(result, -1);
+        cache->fIndex = 0;
+    }
+    return result;
+}
+
+/**
+ * Sets the iterator to refer to the first boundary position following
+ * the specified position.
+ * @offset The position from which to begin searching for a break position.
+ * @return The position of the first break after the current position.
+ */
+int32_t RuleBasedBreakIterator::following(int32_t offset) {
+    RBBIBoundaryCache *cache = fBoundaryCache;
+    if (cache != NULL && fText != NULL && offset >= 0 && offset < utext_nativeLength(fText)) {
+        // Move requested offset to a code point start, as followingBoundary() does.
+        utext_setNativeIndex(fText, offset);
+        offset = (int32_t)utext_getNativeIndex(fText);
+        if (fillBoundaryCache(offset, offset + 1)) {
+            return setFromBoundaryCache(cache->indexAtOrBefore(offset) + 1);
+        }
+    }
+
+    int32_t result = followingBoundary(offset);
+    syncBoundaryCacheIndex();
+    if (cache != NULL && cache->fIndex < 0 && result != BreakIterator::DONE) {
+        // Start a new run of cached boundaries here. The status is left to be
+        // computed on demand because results from the dictionary cache do not set it.
+        cache->restart(result, -1);
+    }
+    return result;
+}
+
+/**
+ * Sets the iterator to refer to the last boundary position before the
+ * specified position.
+ * @offset The position to begin searching for a break from.
+ * @return The position of the last boundary before the starting position.
+ */
+int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
+    RBBIBoundaryCache *cache = fBoundaryCache;
+    if (cache != NULL && fText != NULL && offset > 0 && offset <= utext_nativeLength(fText)) {
+        // An offset that is not on a code point boundary is handled by precedingBoundary(),
+        // which moves it up to the following code point.
+        utext_setNativeIndex(fText, offset);
+        if (utext_getNativeIndex(fText) == offset && fillBoundaryCache(offset - 1, offset)) {
+            return setFromBoundaryCache(cache->indexAtOrBefore(offset - 1));
+        }
+    }
+
+    int32_t result = precedingBoundary(offset);
+    syncBoundaryCacheIndex();
+    if (cache != NULL && cache->fIndex < 0 && result != BreakIterator::DONE) {
+        cache->restart(result, -1);
+    }
+    return result;
+}
+
+/**
+ * Advances the iterator to the next boundary position, without the boundary cache.
+ * @return The position of the first boundary after this one.
+ */
+int32_t RuleBasedBreakIterator::nextBoundary() {
     // if we have cached break positions and we're still in the range
     // covered by them, just move one step forward in the cache
     if (fCachedBreakPositions != NULL) {
@@ -601,10 +837,11 @@ int32_t RuleBasedBreakIterator::next(void) {
 }
 
 /**
- * Advances the iterator backwards, to the last boundary preceding this one.
+ * Advances the iterator backwards, to the last boundary preceding this one,
+ * without the boundary cache.
  * @return The position of the last boundary position preceding this one.
  */
-int32_t RuleBasedBreakIterator::previous(void) {
+int32_t RuleBasedBreakIterator::previousBoundary() {
     int32_t result;
     int32_t startPos;
 
@@ -666,7 +903,7 @@ int32_t RuleBasedBreakIterator::previous(void) {
     // point is our return value
 
     for (;;) {
-        result         = next();
+        result         = nextBoundary();
         if (result == BreakIterator::DONE || result >= start) {
             break;
         }
@@ -696,17 +933,17 @@ int32_t RuleBasedBreakIterator::previous(void) {
 
 /**
  * Sets the iterator to refer to the first boundary position following
- * the specified position.
+ * the specified position, without the boundary cache.
  * @offset The position from which to begin searching for a break position.
  * @return The position of the first break after the current position.
  */
-int32_t RuleBasedBreakIterator::following(int32_t offset) {
+int32_t RuleBasedBreakIterator::followingBoundary(int32_t offset) {
     // if the offset passed in is already past the end of the text,
     // just return DONE; if it's before the beginning, return the
     // text's starting offset
     if (fText == NULL || offset >= utext_nativeLength(fText)) {
         last();
-        return next();
+        return nextBoundary();
     }
     else if (offset < 0) {
         return first();
@@ -754,9 +991,9 @@ int32_t RuleBasedBreakIterator::following(int32_t offset) {
         (void)UTEXT_NEXT32(fText);
         // handlePrevious will move most of the time to < 1 boundary away
         handlePrevious(fData->fSafeRevTable);
-        int32_t result = next();
+        int32_t result = nextBoundary();
         while (result <= offset) {
-            result = next();
+            result = nextBoundary();
         }
         return result;
     }
@@ -769,17 +1006,17 @@ int32_t RuleBasedBreakIterator::following(int32_t offset) {
         // previous will give result 0 or 1 boundary away from offset,
         // most of the time
         // we have to
-        int32_t oldresult = previous();
+        int32_t oldresult = previousBoundary();
         while (oldresult > offset) {
-            int32_t result = previous();
+            int32_t result = previousBoundary();
             if (result <= offset) {
                 return oldresult;
             }
             oldresult = result;
         }
-        int32_t result = next();
+        int32_t result = nextBoundary();
         if (result <= offset) {
-            return next();
+            return nextBoundary();
         }
         return result;
     }
@@ -795,12 +1032,12 @@ int32_t RuleBasedBreakIterator::following(int32_t offset) {
     utext_setNativeIndex(fText, offset);
     if (offset==0 || 
         (offset==1  && utext_getNativeIndex(fText)==0)) {
-        return next();
+        return nextBoundary();
     }
-    result = previous();
+    result = previousBoundary();
 
     while (result != BreakIterator::DONE && result <= offset) {
-        result = next();
+        result = nextBoundary();
     }
 
     return result;
@@ -808,11 +1045,11 @@ int32_t RuleBasedBreakIterator::following(int32_t offset) {
 
 /**
  * Sets the iterator to refer to the last boundary position before the
- * specified position.
+ * specified position, without the boundary cache.
  * @offset The position to begin searching for a break from.
  * @return The position of the last boundary before the starting position.
  */
-int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
+int32_t RuleBasedBreakIterator::precedingBoundary(int32_t offset) {
     // if the offset passed in is already past the end of the text,
     // just return DONE; if it's before the beginning, return the
     // text's starting offset
@@ -880,7 +1117,7 @@ int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
         handleNext(fData->fSafeFwdTable);
         int32_t result = (int32_t)UTEXT_GETNATIVEINDEX(fText);
         while (result >= offset) {
-            result = previous();
+            result = previousBoundary();
         }
         return result;
     }
@@ -899,24 +1136,24 @@ int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
         // next will give result 0 or 1 boundary away from offset,
         // most of the time
         // we have to
-        int32_t oldresult = next();
+        int32_t oldresult = nextBoundary();
         while (oldresult < offset) {
-            int32_t result = next();
+            int32_t result = nextBoundary();
             if (result >= offset) {
                 return oldresult;
             }
             oldresult = result;
         }
-        int32_t result = previous();
+        int32_t result = previousBoundary();
         if (result >= offset) {
-            return previous();
+            return previousBoundary();
         }
         return result;
     }
 
     // old rule syntax
     utext_setNativeIndex(fText, offset);
-    return previous();
+    return previousBoundary();
 }
 
 /**
@@ -985,15 +1222,77 @@ enum RBBIRunMode {
 
 //-----------------------------------------------------------------------------------
 //
-//  handleNext(stateTable)
-//     This method is the actual implementation of the rbbi next() method. 
-//     This method initializes the state machine to state 1
-//     and advances through the text character by character until we reach the end
-//     of the text or the state machine transitions to state 0.  We update our return
-//     value every time the state machine passes through an accepting state.
+//  Text input for runStateMachine().
+//     The forward state machine loop is instantiated for each of these, so that
+//     the common cases of a contiguous UTF-16 or UTF-8 string are read directly
+//     rather than through the UText access functions.
+//     next()  returns the next code point, or U_SENTINEL at the end of the text.
+//     index() returns the native index following the last code point returned.
 //
 //-----------------------------------------------------------------------------------
-int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
+class RBBIUTextInput {
+public:
+    RBBIUTextInput(UText *ut) : fUT(ut) {}
+    inline UChar32 next() { return UTEXT_NEXT32(fUT); }
+    inline int32_t index() const { return (int32_t)UTEXT_GETNATIVEINDEX(fUT); }
+private:
+    UText *fUT;
+};
+
+class RBBIUTF16Input {
+public:
+    RBBIUTF16Input(const UChar *s, int32_t length, int32_t start)
+            : fS(s), fLength(length), fIndex(start) {}
+    inline UChar32 next() {
+        if (fIndex >= fLength) {
+            return U_SENTINEL;
+        }
+        UChar32 c;
+        U16_NEXT(fS, fIndex, fLength, c);
+        return c;
+    }
+    inline int32_t index() const { return fIndex; }
+private:
+    const UChar *fS;
+    int32_t      fLength;
+    int32_t      fIndex;
+};
+
+class RBBIUTF8Input {
+public:
+    RBBIUTF8Input(const char *s, int32_t length, int32_t start)
+            : fS((const uint8_t *)s), fLength(length), fIndex(start) {}
+    inline UChar32 next() {
+        if (fIndex >= fLength) {
+            return U_SENTINEL;
+        }
+        // Ill-formed sequences map to U+FFFD, as in the UTF-8 UText provider.
+        UChar32 c;
+        U8_NEXT_OR_FFFD(fS, fIndex, fLength, c);
+        return c;
+    }
+    inline int32_t index() const { return fIndex; }
+private:
+    const uint8_t *fS;
+    int32_t        fLength;
+    int32_t        fIndex;
+};
+
+
+//-----------------------------------------------------------------------------------
+//
+//  runStateMachine(data, statetable, input, ...)
+//     The forward state machine loop of handleNext().
+//     Starts at the current input position and returns the boundary found,
+//     or BreakIterator::DONE if the input is already at its end.
+//     ruleStatusIndex receives the rule status index of the boundary,
+//     and dictionaryCharCount is incremented for each dictionary character seen.
+//
+//-----------------------------------------------------------------------------------
+template<typename Input>
+static int32_t runStateMachine(const RBBIDataWrapper *data, const RBBIStateTable *statetable,
+                               Input &input, int32_t &ruleStatusIndexOut,
+                               uint32_t &dictionaryCharCountOut) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIRunMode         mode;
@@ -1004,28 +1303,24 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
     int32_t             lookaheadTagIdx = 0;
     int32_t             result          = 0;
     int32_t             initialPosition = 0;
+    int32_t             firstCharLimit  = 0;
     int32_t             lookaheadResult = 0;
     UBool               lookAheadHardBreak = (statetable->fFlags & RBBI_LOOKAHEAD_HARD_BREAK) != 0;
     const char         *tableData       = statetable->fTableData;
     uint32_t            tableRowLen     = statetable->fRowLen;
-
-    #ifdef RBBI_DEBUG
-        if (fTrace) {
-            RBBIDebugPuts("Handle Next   pos   char  state category");
-        }
-    #endif
-
-    // No matter what, handleNext alway correctly sets the break tag value.
-    fLastStatusIndexValid = TRUE;
-    fLastRuleStatusIndex = 0;
+    const uint16_t     *asciiCategories = data->fAsciiCategories;
+    // Work on local copies of the output values so that they can stay in registers.
+    int32_t             ruleStatusIndex = ruleStatusIndexOut;
+    uint32_t            dictionaryCharCount = dictionaryCharCountOut;
 
     // if we're already at the end of the text, return DONE.
-    initialPosition = (int32_t)UTEXT_GETNATIVEINDEX(fText); 
+    initialPosition = input.index();
     result          = initialPosition;
-    c               = UTEXT_NEXT32(fText);
-    if (fData == NULL || c==U_SENTINEL) {
+    c               = input.next();
+    if (c==U_SENTINEL) {
         return BreakIterator::DONE;
     }
+    firstCharLimit  = input.index();
 
     //  Set the initial state for the state machine
     state = START_STATE;
@@ -1055,7 +1350,7 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
                     // Treat this as if the look-ahead condition had been met, and return
                     //  the match at the / position from the look-ahead rule.
                     result               = lookaheadResult;
-                    fLastRuleStatusIndex = lookaheadTagIdx;
+                    ruleStatusIndex      = lookaheadTagIdx;
                     lookaheadStatus = 0;
                 } 
                 break;
@@ -1073,10 +1368,15 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
         if (mode == RBBI_RUN) {
             // look up the current character's character category, which tells us
             // which column in the state table to look at.
+            // ASCII categories come from a table filled in when the rules were loaded.
             // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
             //        not the size of the character going in, which is a UChar32.
             //
-            UTRIE_GET16(&fData->fTrie, c, category);
+            if ((uint32_t)c < 0x80) {
+                category = asciiCategories[c];
+            } else {
+                UTRIE_GET16(&data->fTrie, c, category);
+            }
 
             // Check the dictionary bit in the character's category.
             //    Counter is only used by dictionary based iterators (subclasses).
@@ -1084,7 +1384,7 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
             //    in their category values.
             //
             if ((category & 0x4000) != 0)  {
-                fDictionaryCharCount++;
+                dictionaryCharCount++;
                 //  And off the dictionary flag bit.
                 category &= ~0x4000;
             }
@@ -1092,7 +1392,7 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
 
        #ifdef RBBI_DEBUG
             if (fTrace) {
-                RBBIDebugPrintf("             %4ld   ", utext_getNativeIndex(fText));
+                RBBIDebugPrintf("             %4ld   ", (long)input.index());
                 if (0x20<=c && c<0x7f) {
                     RBBIDebugPrintf("\"%c\"  ", c);
                 } else {
@@ -1108,7 +1408,7 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
         // Note: fNextState is defined as uint16_t[2], but we are casting
         // a generated RBBI table to RBBIStateTableRow and some tables
         // actually have more than 2 categories.
-        U_ASSERT(category<fData->fHeader->fCatCount);
+        U_ASSERT(category<data->fHeader->fCatCount);
         state = row->fNextState[category];  /*Not accessing beyond memory*/
         row = (RBBIStateTableRow *)
             // (statetable->fTableData + (statetable->fRowLen * state));
@@ -1118,9 +1418,9 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
         if (row->fAccepting == -1) {
             // Match found, common case.
             if (mode != RBBI_START) {
-                result = (int32_t)UTEXT_GETNATIVEINDEX(fText);
+                result = input.index();
             }
-            fLastRuleStatusIndex = row->fTagIdx;   // Remember the break status (tag) values.
+            ruleStatusIndex = row->fTagIdx;   // Remember the break status (tag) values.
         }
 
         if (row->fLookAhead != 0) {
@@ -1128,11 +1428,12 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
                 && row->fAccepting == lookaheadStatus) {
                 // Lookahead match is completed.  
                 result               = lookaheadResult;
-                fLastRuleStatusIndex = lookaheadTagIdx;
+                ruleStatusIndex      = lookaheadTagIdx;
                 lookaheadStatus      = 0;
                 // TODO:  make a standalone hard break in a rule work.
                 if (lookAheadHardBreak) {
-                    UTEXT_SETNATIVEINDEX(fText, result);
+                    ruleStatusIndexOut = ruleStatusIndex;
+                    dictionaryCharCountOut = dictionaryCharCount;
                     return result;
                 }
                 // Look-ahead completed, but other rules may match further.  Continue on
@@ -1140,7 +1441,7 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
                 goto continueOn;
             }
 
-            int32_t  r = (int32_t)UTEXT_GETNATIVEINDEX(fText);
+            int32_t  r = input.index();
             lookaheadResult = r;
             lookaheadStatus = row->fLookAhead;
             lookaheadTagIdx = row->fTagIdx;
@@ -1167,7 +1468,7 @@ continueOn:
         //    the input position.  The next iteration will be processing the
         //    first real input character.
         if (mode == RBBI_RUN) {
-            c = UTEXT_NEXT32(fText);
+            c = input.next();
         } else {
             if (mode == RBBI_START) {
                 mode = RBBI_RUN;
@@ -1183,9 +1484,58 @@ continueOn:
     //   (This really indicates a defect in the break rules.  They should always match
     //    at least one character.)
     if (result == initialPosition) {
-        UTEXT_SETNATIVEINDEX(fText, initialPosition);
-        UTEXT_NEXT32(fText);
-        result = (int32_t)UTEXT_GETNATIVEINDEX(fText);
+        result = firstCharLimit;
+    }
+    ruleStatusIndexOut = ruleStatusIndex;
+    dictionaryCharCountOut = dictionaryCharCount;
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------------
+//
+//  handleNext(stateTable)
+//     This method is the actual implementation of the rbbi next() method. 
+//     This method initializes the state machine to state 1
+//     and advances through the text character by character until we reach the end
+//     of the text or the state machine transitions to state 0.  We update our return
+//     value every time the state machine passes through an accepting state.
+//
+//     Text that is one contiguous UTF-16 or UTF-8 string is read directly;
+//     other text is read through the UText.
+//
+//-----------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
+    #ifdef RBBI_DEBUG
+        if (fTrace) {
+            RBBIDebugPuts("Handle Next   pos   char  state category");
+        }
+    #endif
+
+    // No matter what, handleNext alway correctly sets the break tag value.
+    fLastStatusIndexValid = TRUE;
+    fLastRuleStatusIndex = 0;
+
+    if (fData == NULL) {
+        return BreakIterator::DONE;
+    }
+
+    int32_t result;
+    int32_t length;
+    const UChar *s16;
+    const char *s8;
+    if ((s16 = utext_getContiguousUTF16(fText, &length)) != NULL) {
+        RBBIUTF16Input input(s16, length, (int32_t)UTEXT_GETNATIVEINDEX(fText));
+        result = runStateMachine(fData, statetable, input, fLastRuleStatusIndex, fDictionaryCharCount);
+    } else if ((s8 = utext_getUTF8Contents(fText, &length)) != NULL) {
+        RBBIUTF8Input input(s8, length, (int32_t)UTEXT_GETNATIVEINDEX(fText));
+        result = runStateMachine(fData, statetable, input, fLastRuleStatusIndex, fDictionaryCharCount);
+    } else {
+        RBBIUTextInput input(fText);
+        result = runStateMachine(fData, statetable, input, fLastRuleStatusIndex, fDictionaryCharCount);
+    }
+    if (result == BreakIterator::DONE) {
+        return result;
     }
 
     // Leave the iterator at our result position.
@@ -1423,6 +1773,112 @@ RuleBasedBreakIterator::reset()
 }
 
 
+//-------------------------------------------------------------------------------
+//
+//   Boundary cache helpers
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::setFromBoundaryCache(int32_t i) {
+    RBBIBoundaryCache *cache = fBoundaryCache;
+    cache->fIndex = i;
+    int32_t pos    = cache->positionAt(i);
+    int32_t status = cache->statusAt(i);
+    utext_setNativeIndex(fText, pos);
+    if (status >= 0) {
+        fLastRuleStatusIndex  = status;
+        fLastStatusIndexValid = TRUE;
+    } else {
+        fLastStatusIndexValid = FALSE;
+    }
+    return pos;
+}
+
+
+UBool RuleBasedBreakIterator::fillBoundaryCache(int32_t lo, int32_t hi) {
+    RBBIBoundaryCache *cache = fBoundaryCache;
+    int32_t count = cache->count();
+    if (count == 0) {
+        return FALSE;
+    }
+    int32_t first = cache->positionAt(0);
+    int32_t last  = cache->positionAt(count - 1);
+    if (first <= lo && hi <= last) {
+        return TRUE;
+    }
+
+    // Only extend the cached boundaries if the range is a few boundaries beyond them.
+    int32_t gap = count >= 2 ? (last - first) / (count - 1) : kDefaultBoundaryGap;
+    if (gap < 1) {
+        gap = 1;
+    }
+    int32_t steps = 0;
+    if (hi > last) {
+        if (hi - last > gap * (kMaxBoundaryCacheSteps / 2)) {
+            return FALSE;
+        }
+        while (hi > cache->positionAt(cache->count() - 1)) {
+            if (++steps > kMaxBoundaryCacheSteps) {
+                return FALSE;
+            }
+            setFromBoundaryCache(cache->count() - 1);
+            syncDictionaryCache();
+            UBool keepsStatus = fCachedBreakPositions != NULL && fPositionInCache < fNumCachedBreakPositions - 1;
+            int32_t pos = nextBoundary();
+            if (pos == BreakIterator::DONE) {
+                return FALSE;
+            }
+            cache->append(pos, (fLastStatusIndexValid && !keepsStatus) ? fLastRuleStatusIndex : -1);
+        }
+    } else {
+        if (first - lo > gap * (kMaxBoundaryCacheSteps / 2)) {
+            return FALSE;
+        }
+        while (lo < cache->positionAt(0)) {
+            if (++steps > kMaxBoundaryCacheSteps) {
+                return FALSE;
+            }
+            setFromBoundaryCache(0);
+            syncDictionaryCache();
+            int32_t pos = previousBoundary();
+            if (pos == BreakIterator::DONE) {
+                return FALSE;
+            }
+            cache->prepend(pos, -1);    // See previous().
+        }
+    }
+    return cache->positionAt(0) <= lo && hi <= cache->positionAt(cache->count() - 1);
+}
+
+
+void RuleBasedBreakIterator::syncBoundaryCacheIndex() {
+    RBBIBoundaryCache *cache = fBoundaryCache;
+    if (cache == NULL) {
+        return;
+    }
+    int32_t pos = current();
+    int32_t i = cache->indexAtOrBefore(pos);
+    cache->fIndex = (i >= 0 && cache->positionAt(i) == pos) ? i : -1;
+}
+
+
+void RuleBasedBreakIterator::syncDictionaryCache() {
+    if (fCachedBreakPositions == NULL) {
+        return;
+    }
+    int32_t pos = current();
+    if (fPositionInCache < fNumCachedBreakPositions && fCachedBreakPositions[fPositionInCache] == pos) {
+        return;
+    }
+    for (int32_t i = 0; i < fNumCachedBreakPositions; ++i) {
+        if (fCachedBreakPositions[i] == pos) {
+            fPositionInCache = i;
+            return;
+        }
+    }
+    reset();
+}
+
+
 
 //-------------------------------------------------------------------------------
 //
@@ -1446,17 +1902,22 @@ void RuleBasedBreakIterator::makeRuleStatusValid() {
             fLastStatusIndexValid = TRUE;
         } else {
             //  Not at start of text.  Find status the tedious way.
+            //  Bypass the boundary cache, which has no status for this position either.
             int32_t pa = current();
-            previous();
+            syncDictionaryCache();
+            previousBoundary();
             if (fNumCachedBreakPositions > 0) {
                 reset();                // Blow off the dictionary cache
             }
-            int32_t pb = next();
+            int32_t pb = nextBoundary();
             if (pa != pb) {
                 // note: the if (pa != pb) test is here only to eliminate warnings for
                 //       unused local variables on gcc.  Logically, it isn't needed.
                 U_ASSERT(pa == pb);
             }
+            if (fBoundaryCache != NULL && fBoundaryCache->fIndex >= 0 && fLastStatusIndexValid) {
+                fBoundaryCache->setStatusAt(fBoundaryCache->fIndex, fLastRuleStatusIndex);
+            }
         }
     }
     U_ASSERT(fLastRuleStatusIndex >= 0  &&  fLastRuleStatusIndex < fData->fStatusMaxIdx);
@@ -1503,6 +1964,54 @@ int32_t RuleBasedBreakIterator::getRuleStatusVec(
 
 
 
+//-------------------------------------------------------------------------------
+//
+//   getBoundaries()       Bulk forward iteration. Finds the first boundary with
+//                         following(), then calls nextBoundary() directly, skipping
+//                         the virtual next() and the boundary cache bookkeeping.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::getBoundaries(int32_t start, int32_t *dest, int32_t *ruleStatuses,
+                                              int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (capacity > 0 && dest == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (capacity == 0) {
+        return 0;
+    }
+    int32_t pos = following(start);
+    if (pos == BreakIterator::DONE) {
+        return 0;
+    }
+    dest[0] = pos;
+    if (ruleStatuses != NULL) {
+        ruleStatuses[0] = getRuleStatus();
+    }
+    int32_t length = 1;
+
+    // The boundary cache is not updated in the loop, only re-synchronized at the end.
+    if (fBoundaryCache != NULL) {
+        fBoundaryCache->fIndex = -1;
+    }
+    syncDictionaryCache();
+    while (length < capacity && (pos = nextBoundary()) != BreakIterator::DONE) {
+        dest[length] = pos;
+        if (ruleStatuses != NULL) {
+            makeRuleStatusValid();
+            ruleStatuses[length] =
+                fData->fRuleStatusTable[fLastRuleStatusIndex + fData->fRuleStatusTable[fLastRuleStatusIndex]];
+        }
+        ++length;
+    }
+    syncBoundaryCacheIndex();
+    return length;
+}
+
+
 //-------------------------------------------------------------------------------
 //
 //   getBinaryRules        Access to the compiled form of the rules,
@@ -1676,7 +2185,17 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
         // Ask the language object if there are any breaks. It will leave the text
         // pointer on the other side of its range, ready to search for the next one.
         if (lbe != NULL) {
-            foundBreakCount += lbe->findBreaks(fText, rangeStart, rangeEnd, FALSE, fBreakType, breaks);
+            if (fDictionaryWorkspace == NULL) {
+                // Optional; without it, the engines use temporary buffers.
+                UErrorCode workspaceStatus = U_ZERO_ERROR;
+                fDictionaryWorkspace = new DictionaryBreakWorkspace(workspaceStatus);
+                if (U_FAILURE(workspaceStatus)) {
+                    delete fDictionaryWorkspace;
+                    fDictionaryWorkspace = NULL;
+                }
+            }
+            foundBreakCount += lbe->findBreaks(fText, rangeStart, rangeEnd, FALSE, fBreakType, breaks,
+                                               fDictionaryWorkspace);
         }
         
         // Reload the loop variables for the next go-round
@@ -1709,13 +2228,13 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
                 fCachedBreakPositions[out] = endPos;
             }
             // If there are breaks, then by definition, we are replacing the original
-            // proposed break by one of the breaks we found. Use following() and
-            // preceding() to do the work. They should never recurse in this case.
+            // proposed break by one of the breaks we found. Use followingBoundary() and
+            // precedingBoundary() to do the work. They should never recurse in this case.
             if (reverse) {
-                return preceding(endPos);
+                return precedingBoundary(endPos);
             }
             else {
-                return following(startPos);
+                return followingBoundary(startPos);
             }
         }
         // If the allocation failed, just fall through to the "no breaks found" case.
@@ -1867,6 +2386,9 @@ RuleBasedBreakIterator::getLanguageBreakEngine(UChar32 c) {
 void RuleBasedBreakIterator::setBreakType(int32_t type) {
     fBreakType = type;
     reset();
+    if (fBoundaryCache != NULL) {
+        fBoundaryCache->clear();    // Dictionary breaks may differ.
+    }
 }
 
 U_NAMESPACE_END
@@ -138,6 +138,9 @@ void RBBIDataWrapper::init(const RBBIDataHeader *data, UErrorCode &status) {
         return;
     }
     fTrie.getFoldingOffset=getFoldingOffset;
+    for (UChar32 c = 0; c < UPRV_LENGTHOF(fAsciiCategories); ++c) {
+        UTRIE_GET16(&fTrie, c, fAsciiCategories[c]);
+    }
 
 
     fRuleSource   = (UChar *)((char *)data + fHeader->fRuleSource);
@@ -181,6 +181,9 @@ public:
 
     UTrie               fTrie;
 
+    /* Trie values (character categories) of U+0000..U+007F, looked up once at load time. */
+    uint16_t            fAsciiCategories[0x80];
+
 private:
     u_atomic_int32_t    fRefCount;
     UDataMemory  *fUDataMem;
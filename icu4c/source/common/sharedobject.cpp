@@ -12,6 +12,11 @@ U_NAMESPACE_BEGIN
 
 SharedObject::~SharedObject() {}
 
+int32_t
+SharedObject::getApproximateSize() const {
+    return (int32_t)sizeof(SharedObject);
+}
+
 UnifiedCacheBase::~UnifiedCacheBase() {}
 
 void
@@ -23,9 +28,9 @@ SharedObject::addRef(UBool fromWithinCache) const {
     if (umtx_atomic_inc(&hardRefCount) == 1 && cachePtr != NULL) {
         // If this object is cached, and the hardRefCount goes from 0 to 1,
         // then the increment must happen from within the cache while the
-        // cache global mutex is locked. In this way, we can be rest assured
+        // mutex of the cache shard is locked. In this way, we can be rest assured
         // that data races can't happen if the cache performs some task if
-        // the hardRefCount is zero while the global cache mutex is locked.
+        // the hardRefCount is zero while that mutex is locked.
         U_ASSERT(fromWithinCache);
         cachePtr->incrementItemsInUse();
     }
@@ -53,12 +58,12 @@ SharedObject::removeRef(UBool fromWithinCache) const {
 void
 SharedObject::addSoftRef() const {
     umtx_atomic_inc(&totalRefCount);
-    ++softRefCount;
+    umtx_atomic_inc(&softRefCount);
 }
 
 void
 SharedObject::removeSoftRef() const {
-    --softRefCount;
+    umtx_atomic_dec(&softRefCount);
     if (umtx_atomic_dec(&totalRefCount) == 0) {
         delete this;
     }
@@ -69,6 +74,11 @@ SharedObject::getRefCount() const {
     return umtx_loadAcquire(totalRefCount);
 }
 
+int32_t
+SharedObject::getSoftRefCount() const {
+    return umtx_loadAcquire(softRefCount);
+}
+
 int32_t
 SharedObject::getHardRefCount() const {
     return umtx_loadAcquire(hardRefCount);
@@ -76,6 +76,15 @@ public:
 
     virtual ~SharedObject();
 
+    /**
+     * Returns the approximate number of bytes of memory retained by this
+     * object, including the memory it owns but not the memory it shares
+     * with other objects. UnifiedCache uses this for its memory budget.
+     * The default implementation returns the size of a SharedObject.
+     * Subclasses that own a lot of memory should override it.
+     */
+    virtual int32_t getApproximateSize() const;
+
     /**
      * Increments the number of references to this object. Thread-safe.
      */
@@ -84,14 +93,14 @@ public:
     /**
      * Increments the number of references to this object.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the mutex of a cache shard is held.
      */
     void addRefWhileHoldingCacheLock() const { addRef(TRUE); }
 
     /**
      * Increments the number of soft references to this object.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the mutex of a cache shard is held.
      */
     void addSoftRef() const;
 
@@ -103,14 +112,14 @@ public:
     /**
      * Decrements the number of references to this object.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the mutex of a cache shard is held.
      */
     void removeRefWhileHoldingCacheLock() const { removeRef(TRUE); }
 
     /**
      * Decrements the number of soft references to this object.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the mutex of a cache shard is held.
      */
     void removeSoftRef() const;
 
@@ -121,11 +130,11 @@ public:
     int32_t getRefCount() const;
 
     /**
-     * Returns the count of soft references only.
+     * Returns the count of soft references only. Uses a memory barrier.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the mutex of a cache shard is held.
      */
-    int32_t getSoftRefCount() const { return softRefCount; }
+    int32_t getSoftRefCount() const;
 
     /**
      * Returns the count of hard references only. Uses a memory barrier.
@@ -148,9 +157,9 @@ public:
     /**
      * If noSoftReferences() == TRUE then this object has no soft references.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the mutex of a cache shard is held.
      */
-    UBool noSoftReferences() const { return (softRefCount == 0); }
+    UBool noSoftReferences() const { return (getSoftRefCount() == 0); }
 
     /**
      * Deletes this object if it has no references or soft references.
@@ -219,8 +228,9 @@ public:
 private:
     mutable u_atomic_int32_t totalRefCount;
 
-    // Any thread modifying softRefCount must hold the global cache mutex
-    mutable int32_t softRefCount;
+    // Any thread modifying softRefCount must hold a cache shard mutex.
+    // It is atomic because a value can be cached under keys in different shards.
+    mutable u_atomic_int32_t softRefCount;
 
     mutable u_atomic_int32_t hardRefCount;
     mutable const UnifiedCacheBase *cachePtr;
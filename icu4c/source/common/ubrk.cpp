@@ -271,6 +271,22 @@ ubrk_getRuleStatusVec(UBreakIterator *bi, int32_t *fillInVec, int32_t capacity,
 }
 
 
+U_CAPI int32_t U_EXPORT2
+ubrk_getBoundaries(UBreakIterator *bi, int32_t start,
+                   int32_t *boundaries, int32_t *ruleStatuses, int32_t capacity,
+                   UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    if (bi == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    return ((BreakIterator*)bi)->getBoundaries(start, boundaries, ruleStatuses, capacity, *status);
+}
+
+
 U_CAPI const char* U_EXPORT2
 ubrk_getLocaleByType(const UBreakIterator *bi,
                      ULocDataLocaleType type,
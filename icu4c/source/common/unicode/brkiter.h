@@ -336,6 +336,31 @@ public:
     */
     virtual int32_t getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UErrorCode &status);
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft method since it is virtual. */
+    /**
+     * Stores the boundaries following position <code>start</code> into an array,
+     * as if by following(start) and then repeated next() calls,
+     * and optionally the status value of each boundary, as from getRuleStatus().
+     * Stops at the end of the text or when the array is full.
+     * The iterator is left at the last boundary that was stored, so that iteration
+     * can continue from there, with next() or with another call to this function.
+     * <p>
+     * For a RuleBasedBreakIterator this is much faster than calling next()
+     * and getRuleStatus() for each boundary.
+     *
+     * @param start        The position after which to find boundaries.
+     * @param dest         Receives the boundary positions in ascending order.
+     * @param ruleStatuses Receives the status value for each boundary, or NULL if
+     *                     they are not needed. Must have room for capacity values.
+     * @param capacity     The number of values that fit into dest.
+     * @param status       Receives error codes.
+     * @return The number of boundaries stored. Smaller than capacity only if
+     *         the end of the text was reached.
+     * @draft ICU 57
+     */
+    virtual int32_t getBoundaries(int32_t start, int32_t *dest, int32_t *ruleStatuses,
+                                  int32_t capacity, UErrorCode &status);
+
     /**
      * Create BreakIterator for word-breaks using the given locale.
      * Returns an instance of a BreakIterator implementing word breaks.
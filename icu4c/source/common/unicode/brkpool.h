@@ -0,0 +1,122 @@
+/*
+********************************************************************************
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+********************************************************************************
+*/
+
+#ifndef BRKPOOL_H
+#define BRKPOOL_H
+
+#include "unicode/utypes.h"
+
+/**
+ * \file
+ * \brief C++ API: BreakIteratorPool, a thread-safe pool of reusable break iterators.
+ */
+
+#if !UCONFIG_NO_BREAK_ITERATION
+
+#include "unicode/brkiter.h"
+#include "unicode/locid.h"
+#include "unicode/ubrk.h"
+#include "unicode/uobject.h"
+
+struct UHashtable;
+typedef struct UHashtable UHashtable;
+
+#ifndef U_HIDE_DRAFT_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * A thread-safe pool of BreakIterator instances, keyed by break type and locale.
+ *
+ * Creating a BreakIterator loads and resolves locale data, which is much more
+ * expensive than the iteration itself when each iterator is used for only a short
+ * piece of text. A BreakIteratorPool creates one iterator per key,
+ * and hands out clones of it which share its immutable rule data.
+ * Iterators that are returned to the pool are reset and handed out again.
+ *
+ * An iterator obtained from acquire() is used by one thread at a time, like any
+ * other BreakIterator. The pool itself may be used concurrently by any number of threads.
+ *
+ * \code
+ *     BreakIterator *bi = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+ *     if (U_SUCCESS(status)) {
+ *         bi->setText(text);
+ *         for (int32_t p = bi->first(); p != BreakIterator::DONE; p = bi->next()) { ... }
+ *         pool.release(bi);
+ *     }
+ * \endcode
+ *
+ * @draft ICU 57
+ */
+class U_COMMON_API BreakIteratorPool : public UObject {
+public:
+    /**
+     * Constructs an empty pool.
+     * @param maxIdlePerKey the maximum number of released iterators kept per type and locale;
+     *                      further released iterators are deleted. Must not be negative.
+     * @param status Receives any error.
+     * @draft ICU 57
+     */
+    BreakIteratorPool(int32_t maxIdlePerKey, UErrorCode &status);
+
+    /**
+     * Destructor. Deletes all idle iterators.
+     * Iterators that are still acquired are not deleted;
+     * they become owned by their callers, who must delete them
+     * instead of releasing them to this pool.
+     * @draft ICU 57
+     */
+    virtual ~BreakIteratorPool();
+
+    /**
+     * Returns a break iterator for the given type and locale.
+     * The iterator is positioned at the start of empty text,
+     * as if just created by the corresponding BreakIterator factory method.
+     * It is owned by the pool and must be returned with release().
+     * @param type the type of break iterator
+     * @param locale the locale whose rules to use
+     * @param status Receives any error. U_ILLEGAL_ARGUMENT_ERROR if the type is not valid.
+     * @return the iterator, or NULL if an error occurred
+     * @draft ICU 57
+     */
+    BreakIterator *acquire(UBreakIteratorType type, const Locale &locale, UErrorCode &status);
+
+    /**
+     * Returns an iterator to the pool.
+     * The pool drops its reference to the iterator's text before keeping it for reuse.
+     * The caller must not use the iterator after this call.
+     * An iterator that was not obtained from this pool is deleted.
+     * @param bi the iterator; NULL is ignored
+     * @draft ICU 57
+     */
+    void release(BreakIterator *bi);
+
+    /**
+     * Returns the number of released iterators currently kept for reuse, for all keys.
+     * @return the number of idle iterators
+     * @draft ICU 57
+     */
+    int32_t countIdle() const;
+
+private:
+    BreakIteratorPool(const BreakIteratorPool &other);  // forbid copying of this class
+    BreakIteratorPool &operator=(const BreakIteratorPool &other);  // forbid copying of this class
+
+    /** Type+locale key string to internal pool entry. */
+    UHashtable *fEntries;
+    /** Acquired BreakIterator pointer to the entry it was acquired from. */
+    UHashtable *fInUse;
+    int32_t fMaxIdle;
+};
+
+U_NAMESPACE_END
+
+#endif  /* U_HIDE_DRAFT_API */
+
+#endif  /* !UCONFIG_NO_BREAK_ITERATION */
+
+#endif  /* BRKPOOL_H */
@@ -26,6 +26,8 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/bytestream.h"
+#include "unicode/stringpiece.h"
 #include "unicode/uniset.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm2.h"
@@ -382,6 +384,97 @@ public:
     virtual int32_t
     spanQuickCheckYes(const UnicodeString &s, UErrorCode &errorCode) const = 0;
 
+    /**
+     * Normalizes a UTF-8 string and writes the result to a ByteSink.
+     * Unchanged portions of the input are copied to the sink as they are,
+     * and already-normalized input is written with a single sink.Append(src).
+     * Ill-formed UTF-8 byte sequences are normalization-inert
+     * and copied to the sink unchanged.
+     *
+     * The default implementation converts the input to UTF-16, calls normalize()
+     * and converts the result back to UTF-8 (with U+FFFD for ill-formed sequences).
+     * The standard implementations work on the UTF-8 text directly.
+     * @param src source UTF-8 string
+     * @param sink normalized UTF-8 output is appended to this ByteSink
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 57
+     */
+    virtual void
+    normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const;
+
+    /**
+     * Tests if the UTF-8 string is normalized.
+     * Same as isNormalized() but for UTF-8 input.
+     * Ill-formed UTF-8 byte sequences are normalization-inert.
+     *
+     * The default implementation converts the input to UTF-16 and calls isNormalized().
+     * @param s input UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return TRUE if s is normalized
+     * @draft ICU 57
+     */
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const;
+
+    /**
+     * Returns the end of the normalized substring of the input UTF-8 string,
+     * as a byte index.
+     * Same as spanQuickCheckYes() but for UTF-8 input.
+     * The returned index is at a normalization boundary, and
+     * the bytes before it can be copied while only the rest needs to be normalized.
+     *
+     * The default implementation converts the input to UTF-16, calls spanQuickCheckYes()
+     * and maps the resulting index back to a UTF-8 index.
+     * @param s input UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return "yes" span end index in bytes
+     * @draft ICU 57
+     */
+    virtual int32_t
+    spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const;
+
+    /**
+     * Normalizes many strings in one call, for example many short keys.
+     * The normalized forms of strings that are not already normalized are
+     * stored one after another in dest, which is cleared first;
+     * its capacity is reused across calls.
+     * Strings that are already normalized are not copied.
+     *
+     * On output, for each index i,
+     * - if destStarts[i]<0, then srcs[i] is already normalized
+     *   and destLengths[i] is its length;
+     * - otherwise its normalized form is the dest substring
+     *   of destLengths[i] UChars starting at destStarts[i].
+     *
+     * The default implementation calls spanQuickCheckYes() and normalize()
+     * for each string.
+     * @param srcs array of count input strings, which must not alias dest
+     * @param srcLengths array of count string lengths, or -1 for NUL-terminated strings;
+     *                   can be NULL if all input strings are NUL-terminated
+     * @param count number of input strings
+     * @param dest destination string; its contents are replaced by the normalized strings
+     * @param destStarts output array of count start indexes in dest, or -1 for unchanged strings
+     * @param destLengths output array of count result lengths
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 57
+     */
+    virtual void
+    normalizeBatch(const UChar *const srcs[], const int32_t srcLengths[], int32_t count,
+                   UnicodeString &dest, int32_t destStarts[], int32_t destLengths[],
+                   UErrorCode &errorCode) const;
+
     /**
      * Tests if the character always has a normalization boundary before it,
      * regardless of context.
@@ -607,6 +700,46 @@ public:
     virtual int32_t
     spanQuickCheckYes(const UnicodeString &s, UErrorCode &errorCode) const;
 
+    /**
+     * Normalizes a UTF-8 string and writes the result to a ByteSink.
+     * For details see the Normalizer2 base class documentation.
+     * @param src source UTF-8 string
+     * @param sink normalized UTF-8 output is appended to this ByteSink
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 57
+     */
+    virtual void
+    normalizeUTF8(const StringPiece &src, ByteSink &sink, UErrorCode &errorCode) const;
+    /**
+     * Tests if the UTF-8 string is normalized.
+     * For details see the Normalizer2 base class documentation.
+     * @param s input UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return TRUE if s is normalized
+     * @draft ICU 57
+     */
+    virtual UBool
+    isNormalizedUTF8(const StringPiece &s, UErrorCode &errorCode) const;
+    /**
+     * Returns the end of the normalized substring of the input UTF-8 string.
+     * For details see the Normalizer2 base class documentation.
+     * @param s input UTF-8 string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return "yes" span end index in bytes
+     * @draft ICU 57
+     */
+    virtual int32_t
+    spanQuickCheckYesUTF8(const StringPiece &s, UErrorCode &errorCode) const;
+
     /**
      * Tests if the character always has a normalization boundary before it,
      * regardless of context.
@@ -652,6 +785,93 @@ private:
     const UnicodeSet &set;
 };
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Normalizes text which arrives in arbitrary chunks,
+ * for example while reading a large file.
+ * Each call to normalizeChunk() appends the normalized form of all of the text
+ * up to the last normalization boundary (see hasBoundaryBefore())
+ * and holds back only the rest, which might still interact with the next chunk.
+ * Call finish() after the last chunk to normalize and append the held-back text.
+ *
+ * The result is the same as normalizing the concatenation of all chunks at once.
+ * Memory use is bounded by the longest sequence of text without a boundary,
+ * which is normally one base character plus its combining marks.
+ *
+ * An instance is not thread-safe; use one per stream.
+ * @draft ICU 57
+ */
+class U_COMMON_API Normalizer2Stream : public UObject {
+public:
+    /**
+     * Constructs a stream object for the given normalizer.
+     * The normalizer is aliased and must not be deleted while this object is used.
+     * @param n2 the Normalizer2 instance, for example Normalizer2::getNFCInstance()
+     * @draft ICU 57
+     */
+    Normalizer2Stream(const Normalizer2 &n2) : norm2(n2) {}
+
+    /**
+     * Destructor.
+     * @draft ICU 57
+     */
+    virtual ~Normalizer2Stream();
+
+    /**
+     * Normalizes as much of the held-back text plus the chunk as can be
+     * normalized without seeing the following text, appends it to dest,
+     * and holds back the rest.
+     * The chunk may end in the middle of a surrogate pair.
+     * @param chunk the next piece of input text
+     * @param dest destination string; the stable normalized text is appended
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return dest
+     * @draft ICU 57
+     */
+    UnicodeString &
+    normalizeChunk(const UnicodeString &chunk, UnicodeString &dest, UErrorCode &errorCode);
+
+    /**
+     * Normalizes the held-back text, appends it to dest,
+     * and resets this object for a new stream.
+     * @param dest destination string; the remaining normalized text is appended
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return dest
+     * @draft ICU 57
+     */
+    UnicodeString &
+    finish(UnicodeString &dest, UErrorCode &errorCode);
+
+    /**
+     * Discards the held-back text and resets this object for a new stream.
+     * @draft ICU 57
+     */
+    void reset() { pending.remove(); }
+
+    /**
+     * Returns the number of UChars of input which are being held back
+     * until more text or finish().
+     * @return the held-back length
+     * @draft ICU 57
+     */
+    int32_t getPendingLength() const { return pending.length(); }
+
+private:
+    Normalizer2Stream(const Normalizer2Stream &other);  // no copy constructor
+    Normalizer2Stream &operator=(const Normalizer2Stream &other);  // no assignment operator
+
+    const Normalizer2 &norm2;
+    UnicodeString pending;
+    UnicodeString normalized;
+};
+#endif  /* U_HIDE_DRAFT_API */
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_NORMALIZATION
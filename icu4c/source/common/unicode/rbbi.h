@@ -43,6 +43,8 @@ class  UStack;
 class  LanguageBreakEngine;
 class  UnhandledEngine;
 struct RBBIStateTable;
+class  RBBIBoundaryCache;
+class  DictionaryBreakWorkspace;
 
 
 
@@ -164,6 +166,24 @@ protected:
      * @internal
      */
     int32_t             fBreakType;
+
+    /**
+     * Recently found boundaries and their rule status values, in a ring buffer
+     * of consecutive boundaries around the current iteration position.
+     * Reused by next(), previous(), following(), preceding() and isBoundary()
+     * while the iteration stays near text that has already been analyzed.
+     * NULL if it could not be allocated; the iterator then works without it.
+     * @internal
+     */
+    RBBIBoundaryCache   *fBoundaryCache;
+
+    /**
+     * Scratch buffers reused by the dictionary break engines each time
+     * checkDictionary() segments a range of dictionary characters.
+     * Created on first use.
+     * @internal
+     */
+    DictionaryBreakWorkspace *fDictionaryWorkspace;
     
 protected:
     //=======================================================================
@@ -557,6 +577,17 @@ public:
     */
     virtual int32_t getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UErrorCode &status);
 
+    /**
+     * Stores the boundaries following position <code>start</code> into an array,
+     * and optionally their rule status values.
+     * Runs the state machine in a loop, without the per-boundary overhead
+     * of calling next() and getRuleStatus().
+     * @see BreakIterator::getBoundaries
+     * @draft ICU 57
+     */
+    virtual int32_t getBoundaries(int32_t start, int32_t *dest, int32_t *ruleStatuses,
+                                  int32_t capacity, UErrorCode &status);
+
     /**
      * Returns a unique class ID POLYMORPHICALLY.  Pure virtual override.
      * This method is to implement a simple version of RTTI, since not all
@@ -763,6 +794,48 @@ private:
      */
     void makeRuleStatusValid();
 
+    /**
+     * The uncached implementations of next(), previous(), following() and preceding().
+     * They maintain the dictionary cache but do not use or update fBoundaryCache.
+     * @internal
+     */
+    int32_t nextBoundary();
+    /** @internal */
+    int32_t previousBoundary();
+    /** @internal */
+    int32_t followingBoundary(int32_t offset);
+    /** @internal */
+    int32_t precedingBoundary(int32_t offset);
+
+    /**
+     * Sets the iteration position and rule status from boundary cache entry i.
+     * @internal
+     */
+    int32_t setFromBoundaryCache(int32_t i);
+
+    /**
+     * Makes fBoundaryCache cover at least the boundaries from one at or before lo
+     * to one at or after hi, adding boundaries with the uncached functions.
+     * @return TRUE if the cache covers the range.
+     * @internal
+     */
+    UBool fillBoundaryCache(int32_t lo, int32_t hi);
+
+    /**
+     * Sets the boundary cache's current entry to the one for the current position, if any.
+     * @internal
+     */
+    void syncBoundaryCacheIndex();
+
+    /**
+     * Points the dictionary cache at the current position, or drops it
+     * if the position is not one of its breaks.
+     * Needed before uncached iteration because the boundary cache
+     * moves the position without going through the dictionary cache.
+     * @internal
+     */
+    void syncDictionaryCache();
+
 };
 
 //------------------------------------------------------------------------------
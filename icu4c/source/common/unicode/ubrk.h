@@ -505,6 +505,36 @@ ubrk_getRuleStatus(UBreakIterator *bi);
 U_STABLE  int32_t U_EXPORT2
 ubrk_getRuleStatusVec(UBreakIterator *bi, int32_t *fillInVec, int32_t capacity, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Stores the boundaries following position <code>start</code> into an array,
+ * as if by ubrk_following(start) and then repeated ubrk_next() calls,
+ * and optionally the status value of each boundary, as from ubrk_getRuleStatus().
+ * Stops at the end of the text or when the array is full.
+ * The iterator is left at the last boundary that was stored.
+ * <p>
+ * Much faster than calling ubrk_next() for each boundary. To process a whole text,
+ * call this function with start=0, and then with the last boundary from the
+ * previous call until it returns less than <code>capacity</code>.
+ * Position 0 is always a boundary and is not stored.
+ *
+ * @param bi           The break iterator to use.
+ * @param start        The position after which to find boundaries.
+ * @param boundaries   Receives the boundary positions in ascending order.
+ * @param ruleStatuses Receives the status value for each boundary, or NULL if
+ *                     they are not needed. Must have room for capacity values.
+ * @param capacity     The number of values that fit into boundaries.
+ * @param status       Receives error codes.
+ * @return The number of boundaries stored. Smaller than capacity only if
+ *         the end of the text was reached.
+ * @draft ICU 57
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_getBoundaries(UBreakIterator *bi, int32_t start,
+                   int32_t *boundaries, int32_t *ruleStatuses, int32_t capacity,
+                   UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Return the locale of the break iterator. You can choose between the valid and
  * the actual locale.
@@ -489,6 +489,47 @@ unorm2_spanQuickCheckYes(const UNormalizer2 *norm2,
                          const UChar *s, int32_t length,
                          UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Normalizes many strings in one call, for example many short keys.
+ * The normalized forms of strings that are not already normalized are
+ * written one after another into dest.
+ * Strings that are already normalized are not copied.
+ *
+ * On output, for each index i,
+ * - if destStarts[i]<0, then srcs[i] is already normalized
+ *   and destLengths[i] is its length;
+ * - otherwise its normalized form is the dest substring
+ *   of destLengths[i] UChars starting at destStarts[i].
+ *
+ * Supports preflighting: If the normalized strings do not fit into dest,
+ * then the error code is set to U_BUFFER_OVERFLOW_ERROR
+ * and the required capacity is returned.
+ * The destStarts[] and destLengths[] are set even in this case.
+ * @param norm2 UNormalizer2 instance
+ * @param srcs array of count input strings, which must not overlap with dest
+ * @param srcLengths array of count string lengths, or -1 for NUL-terminated strings;
+ *                   can be NULL if all input strings are NUL-terminated
+ * @param count number of input strings
+ * @param dest destination buffer; can be NULL if capacity==0
+ * @param capacity number of UChars that can be written to dest
+ * @param destStarts output array of count start indexes in dest, or -1 for unchanged strings
+ * @param destLengths output array of count result lengths
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return total length of the normalized strings written to dest
+ * @draft ICU 57
+ */
+U_DRAFT int32_t U_EXPORT2
+unorm2_normalizeBatch(const UNormalizer2 *norm2,
+                      const UChar *const *srcs, const int32_t *srcLengths, int32_t count,
+                      UChar *dest, int32_t capacity,
+                      int32_t *destStarts, int32_t *destLengths,
+                      UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Tests if the character always has a normalization boundary before it,
  * regardless of context.
@@ -524,6 +565,107 @@ unorm2_hasBoundaryAfter(const UNormalizer2 *norm2, UChar32 c);
 U_STABLE UBool U_EXPORT2
 unorm2_isInert(const UNormalizer2 *norm2, UChar32 c);
 
+#ifndef U_HIDE_DRAFT_API
+
+struct UNormalizer2Stream;
+/**
+ * C typedef for struct UNormalizer2Stream.
+ * Normalizes text which arrives in arbitrary chunks.
+ * For details see the Normalizer2Stream C++ class.
+ * @draft ICU 57
+ */
+typedef struct UNormalizer2Stream UNormalizer2Stream;
+
+/**
+ * Opens a stream normalizer for the given UNormalizer2 instance.
+ * The UNormalizer2 is aliased and must not be closed while the stream is used.
+ * @param norm2 UNormalizer2 instance
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @return the new UNormalizer2Stream, if successful
+ * @draft ICU 57
+ */
+U_DRAFT UNormalizer2Stream * U_EXPORT2
+unorm2_openStream(const UNormalizer2 *norm2, UErrorCode *pErrorCode);
+
+/**
+ * Closes a UNormalizer2Stream.
+ * @param stream UNormalizer2Stream to be closed
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+unorm2_closeStream(UNormalizer2Stream *stream);
+
+/**
+ * Discards all held-back input and pending output,
+ * and resets the stream for new text.
+ * @param stream UNormalizer2Stream instance
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+unorm2_resetStream(UNormalizer2Stream *stream);
+
+/**
+ * Normalizes the next chunk of text.
+ * Works like ucnv_toUnicode(): All of the source text is consumed and *source
+ * is set to sourceLimit. As much normalized text as is stable is written
+ * to the target, and *target is advanced past it.
+ * The end of the source text that might still interact with the next chunk
+ * is held back inside the stream.
+ *
+ * If the target buffer is too small, then the function sets
+ * U_BUFFER_OVERFLOW_ERROR and keeps the rest of the output.
+ * Call again with more target space (and with *source==sourceLimit)
+ * to get the rest of the output.
+ *
+ * Set flush to TRUE with the last chunk (or with an empty chunk)
+ * to normalize and write all held-back text.
+ * When a flush call succeeds, the stream is reset for new text.
+ *
+ * The concatenation of all output is the same as normalizing the
+ * concatenation of all source chunks at once.
+ * @param stream UNormalizer2Stream instance
+ * @param target I/O parameter: pointer to the output buffer pointer
+ * @param targetLimit pointer just after the end of the output buffer
+ * @param source I/O parameter: pointer to the input buffer pointer
+ * @param sourceLimit pointer just after the end of the input chunk
+ * @param flush TRUE if this is the end of the input
+ * @param pErrorCode Standard ICU error code. Its input value must
+ *                   pass the U_SUCCESS() test, or else the function returns
+ *                   immediately. Check for U_FAILURE() on output or use with
+ *                   function chaining. (See User Guide for details.)
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+unorm2_normalizeStream(UNormalizer2Stream *stream,
+                       UChar **target, const UChar *targetLimit,
+                       const UChar **source, const UChar *sourceLimit,
+                       UBool flush,
+                       UErrorCode *pErrorCode);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUNormalizer2StreamPointer
+ * "Smart pointer" class, closes a UNormalizer2Stream via unorm2_closeStream().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 57
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUNormalizer2StreamPointer, UNormalizer2Stream, unorm2_closeStream);
+
+U_NAMESPACE_END
+
+#endif
+
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Option bit for unorm_compare:
  * Both input strings are assumed to fulfill FCD conditions.
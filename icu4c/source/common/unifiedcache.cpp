@@ -14,11 +14,26 @@
 #include "mutex.h"
 #include "uassert.h"
 #include "ucln_cmn.h"
+#include "charstr.h"
+#include "cstring.h"
+#include "putilimp.h"
+
+// x may expand to a braced initializer with commas,
+// so it must not be passed on to another macro.
+#define SHARD_INITIALIZERS_16(x) \
+    x, x, x, x, x, x, x, x, \
+    x, x, x, x, x, x, x, x
 
 static icu::UnifiedCache *gCache = NULL;
 static icu::SharedObject *gNoValue = NULL;
-static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
-static UConditionVar gInProgressValueAddedCond = U_CONDITION_INITIALIZER;
+// One mutex and one condition variable per cache shard.
+// The number of initializers must match UnifiedCache::SHARD_COUNT.
+static UMutex gCacheMutex[icu::UnifiedCache::SHARD_COUNT] = {
+    SHARD_INITIALIZERS_16(U_MUTEX_INITIALIZER)
+};
+static UConditionVar gInProgressValueAddedCond[icu::UnifiedCache::SHARD_COUNT] = {
+    SHARD_INITIALIZERS_16(U_CONDITION_INITIALIZER)
+};
 static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
 static const int32_t MAX_EVICT_ITERATIONS = 10;
 
@@ -63,6 +78,12 @@ ucache_deleteKey(void *obj) {
     delete p;
 }
 
+U_CAPI void U_EXPORT2
+ucache_deleteStats(void *obj) {
+    UnifiedCacheStats *p = (UnifiedCacheStats *) obj;
+    delete p;
+}
+
 CacheKeyBase::~CacheKeyBase() {
 }
 
@@ -100,25 +121,47 @@ UnifiedCache *UnifiedCache::getInstance(UErrorCode &status) {
 }
 
 UnifiedCache::UnifiedCache(UErrorCode &status) :
-        fHashtable(NULL),
-        fEvictPos(UHASH_FIRST),
+        fEvictShard(0),
+        fKeyCount(0),
         fItemsInUseCount(0),
         fMaxUnused(DEFAULT_MAX_UNUSED),
         fMaxPercentageOfInUse(DEFAULT_PERCENTAGE_OF_IN_USE),
-        fAutoEvictedCount(0) {
+        fStatsEnabled(0),
+        fByteCount(0),
+        fMaxBytes(0) {
+    for (int32_t i = 0; i < SHARD_COUNT; ++i) {
+        Shard &shard = fShards[i];
+        shard.fHashtable = NULL;
+        shard.fEvictPos = UHASH_FIRST;
+        shard.fAutoEvictedCount = 0;
+        shard.fStats = NULL;
+    }
     if (U_FAILURE(status)) {
         return;
     }
     U_ASSERT(gNoValue != NULL);
-    fHashtable = uhash_open(
-            &ucache_hashKeys,
-            &ucache_compareKeys,
-            NULL,
-            &status);
-    if (U_FAILURE(status)) {
-        return;
+    for (int32_t i = 0; i < SHARD_COUNT; ++i) {
+        UHashtable *hashtable = uhash_open(
+                &ucache_hashKeys,
+                &ucache_compareKeys,
+                NULL,
+                &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        uhash_setKeyDeleter(hashtable, &ucache_deleteKey);
+        fShards[i].fHashtable = hashtable;
+        UHashtable *stats = uhash_open(
+                &uhash_hashChars,
+                &uhash_compareChars,
+                NULL,
+                &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        uhash_setValueDeleter(stats, &ucache_deleteStats);
+        fShards[i].fStats = stats;
     }
-    uhash_setKeyDeleter(fHashtable, &ucache_deleteKey);
 }
 
 void UnifiedCache::setEvictionPolicy(
@@ -130,33 +173,208 @@ void UnifiedCache::setEvictionPolicy(
         status = U_ILLEGAL_ARGUMENT_ERROR;
         return;
     }
-    Mutex lock(&gCacheMutex);
-    fMaxUnused = count;
-    fMaxPercentageOfInUse = percentageOfInUseItems;
+    umtx_storeRelease(fMaxUnused, count);
+    umtx_storeRelease(fMaxPercentageOfInUse, percentageOfInUseItems);
+}
+
+void UnifiedCache::setMemoryBudget(int32_t maxBytes, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (maxBytes < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    umtx_storeRelease(fMaxBytes, maxBytes);
+}
+
+int32_t UnifiedCache::byteCount() const {
+    return umtx_loadAcquire(fByteCount);
 }
 
 int32_t UnifiedCache::unusedCount() const {
-    Mutex lock(&gCacheMutex);
-    return uhash_count(fHashtable) - fItemsInUseCount;
+    return umtx_loadAcquire(fKeyCount) - umtx_loadAcquire(fItemsInUseCount);
 }
 
 int64_t UnifiedCache::autoEvictedCount() const {
-    Mutex lock(&gCacheMutex);
-    return fAutoEvictedCount;
+    int64_t count = 0;
+    for (int32_t i = 0; i < SHARD_COUNT; ++i) {
+        Mutex lock(&gCacheMutex[i]);
+        count += fShards[i].fAutoEvictedCount;
+    }
+    return count;
 }
 
 int32_t UnifiedCache::keyCount() const {
-    Mutex lock(&gCacheMutex);
-    return uhash_count(fHashtable);
+    return umtx_loadAcquire(fKeyCount);
 }
 
-void UnifiedCache::flush() const {
-    Mutex lock(&gCacheMutex);
+void UnifiedCache::setStatsEnabled(UBool enabled) {
+    umtx_storeRelease(fStatsEnabled, enabled ? 1 : 0);
+}
+
+int32_t UnifiedCache::getStats(
+        UnifiedCacheStats *dest, int32_t capacity, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (dest == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    // Merge the statistics of all shards by key type.
+    UHashtable *merged = uhash_open(
+            &uhash_hashChars, &uhash_compareChars, NULL, &status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    uhash_setValueDeleter(merged, &ucache_deleteStats);
+    for (int32_t i = 0; i < SHARD_COUNT && U_SUCCESS(status); ++i) {
+        const Shard &shard = fShards[i];
+        Mutex lock(&gCacheMutex[i]);
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        while ((element = uhash_nextElement(shard.fStats, &pos)) != NULL) {
+            const UnifiedCacheStats *stats =
+                    (const UnifiedCacheStats *) element->value.pointer;
+            UnifiedCacheStats *sum =
+                    (UnifiedCacheStats *) uhash_get(merged, stats->keyType);
+            if (sum == NULL) {
+                sum = new UnifiedCacheStats();
+                if (sum == NULL) {
+                    status = U_MEMORY_ALLOCATION_ERROR;
+                    break;
+                }
+                sum->keyType = stats->keyType;
+                uhash_put(merged, (void *) sum->keyType, sum, &status);
+                if (U_FAILURE(status)) {
+                    break;
+                }
+            }
+            sum->lookups += stats->lookups;
+            sum->hits += stats->hits;
+            sum->misses += stats->misses;
+            sum->inProgressWaits += stats->inProgressWaits;
+            sum->evictions += stats->evictions;
+            sum->creationMillis += stats->creationMillis;
+        }
+        pos = UHASH_FIRST;
+        while (U_SUCCESS(status) &&
+                (element = uhash_nextElement(shard.fHashtable, &pos)) != NULL) {
+            const char *keyType =
+                    typeid(*(const CacheKeyBase *) element->key.pointer).name();
+            UnifiedCacheStats *sum = (UnifiedCacheStats *) uhash_get(merged, keyType);
+            if (sum == NULL) {
+                sum = new UnifiedCacheStats();
+                if (sum == NULL) {
+                    status = U_MEMORY_ALLOCATION_ERROR;
+                    break;
+                }
+                sum->keyType = keyType;
+                uhash_put(merged, (void *) keyType, sum, &status);
+                if (U_FAILURE(status)) {
+                    break;
+                }
+            }
+            ++sum->entryCount;
+            sum->byteCount += ((const CacheKeyBase *) element->key.pointer)->fSize;
+        }
+    }
+    int32_t count = uhash_count(merged);
+    if (U_SUCCESS(status)) {
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        for (int32_t i = 0;
+                i < capacity && (element = uhash_nextElement(merged, &pos)) != NULL;
+                ++i) {
+            dest[i] = *(const UnifiedCacheStats *) element->value.pointer;
+        }
+        if (count > capacity) {
+            status = U_BUFFER_OVERFLOW_ERROR;
+        }
+    }
+    uhash_close(merged);
+    return count;
+}
 
+void UnifiedCache::resetStats() const {
+    for (int32_t i = 0; i < SHARD_COUNT; ++i) {
+        Mutex lock(&gCacheMutex[i]);
+        uhash_removeAll(fShards[i].fStats);
+    }
+}
+
+CharString &UnifiedCache::getSnapshot(CharString &dest, UErrorCode &status) const {
+    char buffer[256];
+    for (int32_t i = 0; i < SHARD_COUNT && U_SUCCESS(status); ++i) {
+        Mutex lock(&gCacheMutex[i]);
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        while (U_SUCCESS(status) &&
+                (element = uhash_nextElement(fShards[i].fHashtable, &pos)) != NULL) {
+            const CacheKeyBase *key = (const CacheKeyBase *) element->key.pointer;
+            const SharedObject *value =
+                    (const SharedObject *) element->value.pointer;
+            dest.append(typeid(*key).name(), status).append('\t', status);
+            dest.append(key->writeDescription(buffer, UPRV_LENGTHOF(buffer)), status);
+            dest.append('\t', status);
+            if (_inProgress(value, key->fCreationStatus)) {
+                dest.append("in progress", status);
+            } else {
+                dest.append(u_errorName(key->fCreationStatus), status);
+            }
+            dest.append('\t', status);
+            T_CString_integerToString(buffer, value->getRefCount(), 10);
+            dest.append(buffer, status).append('\t', status);
+            T_CString_integerToString(buffer, value->getSoftRefCount(), 10);
+            dest.append(buffer, status).append('\t', status);
+            dest.append(key->fIsMaster ? "master" : "-", status).append('\t', status);
+            T_CString_integerToString(buffer, key->fSize, 10);
+            dest.append(buffer, status).append('\n', status);
+        }
+    }
+    return dest;
+}
+
+// Returns the statistics for the type of key, creating them if necessary.
+// On entry, the mutex of the shard must be held.
+// Returns NULL if statistics are disabled or could not be allocated.
+UnifiedCacheStats *UnifiedCache::_getStats(
+        Shard &shard, const CacheKeyBase &key) const {
+    if (umtx_loadAcquire(fStatsEnabled) == 0) {
+        return NULL;
+    }
+    const char *keyType = typeid(key).name();
+    UnifiedCacheStats *stats = (UnifiedCacheStats *) uhash_get(shard.fStats, keyType);
+    if (stats == NULL) {
+        stats = new UnifiedCacheStats();
+        if (stats == NULL) {
+            return NULL;
+        }
+        stats->keyType = keyType;
+        UErrorCode status = U_ZERO_ERROR;
+        uhash_put(shard.fStats, (void *) keyType, stats, &status);
+        if (U_FAILURE(status)) {
+            return NULL;  // uhash_put() deleted stats.
+        }
+    }
+    return stats;
+}
+
+void UnifiedCache::flush() const {
     // Use a loop in case cache items that are flushed held hard references to
     // other cache items making those additional cache items eligible for
     // flushing.
-    while (_flush(FALSE));
+    UBool flushed;
+    do {
+        flushed = FALSE;
+        for (int32_t i = 0; i < SHARD_COUNT; ++i) {
+            Mutex lock(&gCacheMutex[i]);
+            if (_flush(i, FALSE)) {
+                flushed = TRUE;
+            }
+        }
+    } while (flushed);
 }
 
 #ifdef UNIFIED_CACHE_DEBUG
@@ -173,19 +391,24 @@ void UnifiedCache::dump() {
 }
 
 void UnifiedCache::dumpContents() const {
-    Mutex lock(&gCacheMutex);
-    _dumpContents();
+    int32_t cnt = 0;
+    for (int32_t i = 0; i < SHARD_COUNT; ++i) {
+        Mutex lock(&gCacheMutex[i]);
+        _dumpContents(i, cnt);
+    }
+    fprintf(stderr, "Unified Cache: %d out of a total of %d still have hard references\n", cnt, keyCount());
 }
 
-// Dumps content of cache.
-// On entry, gCacheMutex must be held.
-// On exit, cache contents dumped to stderr.
-void UnifiedCache::_dumpContents() const {
+// Dumps content of one cache shard.
+// On entry, gCacheMutex[shardIndex] must be held.
+// On exit, shard contents dumped to stderr, and cnt incremented by the
+// number of entries with hard references.
+void UnifiedCache::_dumpContents(int32_t shardIndex, int32_t &cnt) const {
+    UHashtable *hashtable = fShards[shardIndex].fHashtable;
     int32_t pos = UHASH_FIRST;
-    const UHashElement *element = uhash_nextElement(fHashtable, &pos);
+    const UHashElement *element = uhash_nextElement(hashtable, &pos);
     char buffer[256];
-    int32_t cnt = 0;
-    for (; element != NULL; element = uhash_nextElement(fHashtable, &pos)) {
+    for (; element != NULL; element = uhash_nextElement(hashtable, &pos)) {
         const SharedObject *sharedObject =
                 (const SharedObject *) element->value.pointer;
         const CacheKeyBase *key =
@@ -202,51 +425,70 @@ void UnifiedCache::_dumpContents() const {
                     sharedObject->getSoftRefCount());
         }
     }
-    fprintf(stderr, "Unified Cache: %d out of a total of %d still have hard references\n", cnt, uhash_count(fHashtable));
 }
 #endif
 
 UnifiedCache::~UnifiedCache() {
     // Try our best to clean up first.
     flush();
-    {
-        // Now all that should be left in the cache are entries that refer to
-        // each other and entries with hard references from outside the cache. 
-        // Nothing we can do about these so proceed to wipe out the cache.
-        Mutex lock(&gCacheMutex);
-        _flush(TRUE);
+    // Now all that should be left in the cache are entries that refer to
+    // each other and entries with hard references from outside the cache. 
+    // Nothing we can do about these so proceed to wipe out the cache.
+    for (int32_t i = 0; i < SHARD_COUNT; ++i) {
+        if (fShards[i].fHashtable == NULL) {
+            continue;
+        }
+        {
+            Mutex lock(&gCacheMutex[i]);
+            _flush(i, TRUE);
+        }
+        uhash_close(fShards[i].fHashtable);
+        uhash_close(fShards[i].fStats);
     }
-    uhash_close(fHashtable);
 }
 
-// Returns the next element in the cache round robin style.
-// On entry, gCacheMutex must be held.
-const UHashElement *
-UnifiedCache::_nextElement() const {
-    const UHashElement *element = uhash_nextElement(fHashtable, &fEvictPos);
-    if (element == NULL) {
-        fEvictPos = UHASH_FIRST;
-        return uhash_nextElement(fHashtable, &fEvictPos);
+// Returns the shard for a key.
+int32_t UnifiedCache::_getShardIndex(const CacheKeyBase &key) {
+    uint32_t hash = (uint32_t) key.hashCode();
+    // Mix the high bits into the low bits that select the shard.
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return (int32_t) (hash & (SHARD_COUNT - 1));
+}
+
+// Removes an element from a shard and releases its value.
+// On entry, the mutex of the shard must be held.
+void UnifiedCache::_removeElement(
+        Shard &shard, const UHashElement *element) const {
+    const SharedObject *sharedObject =
+            (const SharedObject *) element->value.pointer;
+    int32_t size = ((const CacheKeyBase *) element->key.pointer)->fSize;
+    uhash_removeElement(shard.fHashtable, element);
+    umtx_atomic_dec(&fKeyCount);
+    if (size != 0) {
+        umtx_atomic_add(&fByteCount, -size);
     }
-    return element;
+    sharedObject->removeSoftRef();
 }
 
-// Flushes the contents of the cache. If cache values hold references to other
-// cache values then _flush should be called in a loop until it returns FALSE.
-// On entry, gCacheMutex must be held.
+// Flushes the contents of one cache shard. If cache values hold references
+// to other cache values then _flush should be called in a loop until it
+// returns FALSE.
+// On entry, gCacheMutex[shardIndex] must be held.
 // On exit, those values with are evictable are flushed. If all is true
 // then every value is flushed even if it is not evictable.
-// Returns TRUE if any value in cache was flushed or FALSE otherwise.
-UBool UnifiedCache::_flush(UBool all) const {
+// Returns TRUE if any value in the shard was flushed or FALSE otherwise.
+UBool UnifiedCache::_flush(int32_t shardIndex, UBool all) const {
+    Shard &shard = fShards[shardIndex];
     UBool result = FALSE;
-    int32_t origSize = uhash_count(fHashtable);
-    for (int32_t i = 0; i < origSize; ++i) {
-        const UHashElement *element = _nextElement();
+    if (shard.fHashtable == NULL) {
+        return result;  // The constructor failed.
+    }
+    int32_t pos = UHASH_FIRST;
+    const UHashElement *element;
+    while ((element = uhash_nextElement(shard.fHashtable, &pos)) != NULL) {
         if (all || _isEvictable(element)) {
-            const SharedObject *sharedObject =
-                    (const SharedObject *) element->value.pointer;
-            uhash_removeElement(fHashtable, element);
-            sharedObject->removeSoftRef();
+            _removeElement(shard, element);
             result = TRUE;
         }
     }
@@ -254,49 +496,84 @@ UBool UnifiedCache::_flush(UBool all) const {
 }
 
 // Computes how many items should be evicted.
-// On entry, gCacheMutex must be held.
 // Returns number of items that should be evicted or a value <= 0 if no
 // items need to be evicted.
 int32_t UnifiedCache::_computeCountOfItemsToEvict() const {
+    int32_t itemsInUseCount = umtx_loadAcquire(fItemsInUseCount);
     int32_t maxPercentageOfInUseCount =
-            fItemsInUseCount * fMaxPercentageOfInUse / 100;
-    int32_t maxUnusedCount = fMaxUnused;
+            itemsInUseCount * umtx_loadAcquire(fMaxPercentageOfInUse) / 100;
+    int32_t maxUnusedCount = umtx_loadAcquire(fMaxUnused);
     if (maxUnusedCount < maxPercentageOfInUseCount) {
         maxUnusedCount = maxPercentageOfInUseCount;
     }
-    return uhash_count(fHashtable) - fItemsInUseCount - maxUnusedCount;
+    return umtx_loadAcquire(fKeyCount) - itemsInUseCount - maxUnusedCount;
+}
+
+// Returns TRUE if the values in the cache take up more memory than allowed
+// by setMemoryBudget().
+UBool UnifiedCache::_isOverMemoryBudget() const {
+    int32_t maxBytes = umtx_loadAcquire(fMaxBytes);
+    return maxBytes > 0 && umtx_loadAcquire(fByteCount) > maxBytes;
 }
 
 // Run an eviction slice.
-// On entry, gCacheMutex must be held.
+// On entry, no gCacheMutex may be held.
 // _runEvictionSlice runs a slice of the evict pipeline by examining the next
 // 10 entries in the cache round robin style evicting them if they are eligible.
+// It continues with the next shard when it reaches the end of one,
+// and it locks only one shard at a time.
+// When only the memory budget is exceeded, the slice works like a clock:
+// an eligible entry that was used since the last visit gets a second chance.
 void UnifiedCache::_runEvictionSlice() const {
     int32_t maxItemsToEvict = _computeCountOfItemsToEvict();
-    if (maxItemsToEvict <= 0) {
+    if (maxItemsToEvict <= 0 && !_isOverMemoryBudget()) {
         return;
     }
-    for (int32_t i = 0; i < MAX_EVICT_ITERATIONS; ++i) {
-        const UHashElement *element = _nextElement();
-        if (_isEvictable(element)) {
-            const SharedObject *sharedObject =
-                    (const SharedObject *) element->value.pointer;
-            uhash_removeElement(fHashtable, element);
-            sharedObject->removeSoftRef();
-            ++fAutoEvictedCount;
-            if (--maxItemsToEvict == 0) {
+    int32_t iterations = 0;
+    // Visit each shard at most once, plus the starting one again
+    // for the entries before its eviction position.
+    for (int32_t i = 0; i <= SHARD_COUNT && iterations < MAX_EVICT_ITERATIONS; ++i) {
+        int32_t shardIndex = umtx_loadAcquire(fEvictShard);
+        Shard &shard = fShards[shardIndex];
+        Mutex lock(&gCacheMutex[shardIndex]);
+        for (; iterations < MAX_EVICT_ITERATIONS; ++iterations) {
+            const UHashElement *element =
+                    uhash_nextElement(shard.fHashtable, &shard.fEvictPos);
+            if (element == NULL) {
+                shard.fEvictPos = UHASH_FIRST;
+                umtx_storeRelease(
+                        fEvictShard, (shardIndex + 1) & (SHARD_COUNT - 1));
                 break;
             }
+            if (_isEvictable(element)) {
+                const CacheKeyBase *theKey =
+                        (const CacheKeyBase *) element->key.pointer;
+                if (maxItemsToEvict <= 0 && theKey->fRecentlyUsed) {
+                    theKey->fRecentlyUsed = FALSE;
+                    continue;
+                }
+                UnifiedCacheStats *stats = _getStats(shard, *theKey);
+                if (stats != NULL) {
+                    ++stats->evictions;
+                }
+                _removeElement(shard, element);
+                ++shard.fAutoEvictedCount;
+                if (--maxItemsToEvict <= 0 && !_isOverMemoryBudget()) {
+                    return;
+                }
+            }
         }
     }
 }
 
 
 // Places a new value and creationStatus in the cache for the given key.
-// On entry, gCacheMutex must be held. key must not exist in the cache. 
+// On entry, gCacheMutex[shardIndex] must be held. key must not exist in the
+// cache. 
 // On exit, value and creation status placed under key. Soft reference added
 // to value on successful add. On error sets status.
 void UnifiedCache::_putNew(
+        int32_t shardIndex,
         const CacheKeyBase &key, 
         const SharedObject *value,
         const UErrorCode creationStatus,
@@ -310,40 +587,53 @@ void UnifiedCache::_putNew(
         return;
     }
     keyToAdopt->fCreationStatus = creationStatus;
+    keyToAdopt->fRecentlyUsed = TRUE;
     if (value->noSoftReferences()) {
         _registerMaster(keyToAdopt, value);
     }
-    uhash_put(fHashtable, keyToAdopt, (void *) value, &status);
+    uhash_put(fShards[shardIndex].fHashtable, keyToAdopt, (void *) value, &status);
     if (U_SUCCESS(status)) {
         value->addSoftRef();
+        umtx_atomic_inc(&fKeyCount);
     }
 }
 
 // Places value and status at key if there is no value at key or if cache
 // entry for key is in progress. Otherwise, it leaves the current value and
-// status there.
-// On entry. gCacheMutex must not be held. value must be
+// status there. creationMillis is the time it took to create value,
+// for the statistics.
+// On entry. no gCacheMutex may be held. value must be
 // included in the reference count of the object to which it points.
 // On exit, value and status are changed to what was already in the cache if
 // something was there and not in progress. Otherwise, value and status are left
 // unchanged in which case they are placed in the cache on a best-effort basis.
 // Caller must call removeRef() on value.
 void UnifiedCache::_putIfAbsentAndGet(
+        int32_t shardIndex,
         const CacheKeyBase &key,
+        double creationMillis,
         const SharedObject *&value,
         UErrorCode &status) const {
-    Mutex lock(&gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
-    if (element != NULL && !_inProgress(element)) {
-        _fetch(element, value, status);
-        return;
-    }
-    if (element == NULL) {
-        UErrorCode putError = U_ZERO_ERROR;
-        // best-effort basis only.
-        _putNew(key, value, status, putError);
-    } else {
-        _put(element, value, status);
+    {
+        Shard &shard = fShards[shardIndex];
+        Mutex lock(&gCacheMutex[shardIndex]);
+        UnifiedCacheStats *stats = _getStats(shard, key);
+        if (stats != NULL) {
+            stats->creationMillis += creationMillis;
+        }
+        const UHashElement *element = uhash_find(shard.fHashtable, &key);
+        if (element != NULL && !_inProgress(element)) {
+            ((const CacheKeyBase *) element->key.pointer)->fRecentlyUsed = TRUE;
+            _fetch(element, value, status);
+            return;
+        }
+        if (element == NULL) {
+            UErrorCode putError = U_ZERO_ERROR;
+            // best-effort basis only.
+            _putNew(shardIndex, key, value, status, putError);
+        } else {
+            _put(shardIndex, element, value, status);
+        }
     }
     // Run an eviction slice. This will run even if we added a master entry
     // which doesn't increase the unused count, but that is still o.k
@@ -351,8 +641,8 @@ void UnifiedCache::_putIfAbsentAndGet(
 }
 
 // Attempts to fetch value and status for key from cache.
-// On entry, gCacheMutex must not be held value must be NULL and status must
-// be U_ZERO_ERROR.
+// On entry, gCacheMutex[shardIndex] must not be held value must be NULL and
+// status must be U_ZERO_ERROR.
 // On exit, either returns FALSE (In this
 // case caller should try to create the object) or returns TRUE with value
 // pointing to the fetched value and status set to fetched status. When
@@ -360,27 +650,45 @@ void UnifiedCache::_putIfAbsentAndGet(
 // entry could not be made but value will remain unchanged. When TRUE is
 // returned, caler must call removeRef() on value.
 UBool UnifiedCache::_poll(
+        int32_t shardIndex,
         const CacheKeyBase &key,
         const SharedObject *&value,
         UErrorCode &status) const {
     U_ASSERT(value == NULL);
     U_ASSERT(status == U_ZERO_ERROR);
-    Mutex lock(&gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
+    Shard &shard = fShards[shardIndex];
+    Mutex lock(&gCacheMutex[shardIndex]);
+    UnifiedCacheStats *stats = _getStats(shard, key);
+    if (stats != NULL) {
+        ++stats->lookups;
+    }
+    const UHashElement *element = uhash_find(shard.fHashtable, &key);
+    if (element != NULL && _inProgress(element) && stats != NULL) {
+        ++stats->inProgressWaits;
+    }
     while (element != NULL && _inProgress(element)) {
-        umtx_condWait(&gInProgressValueAddedCond, &gCacheMutex);
-        element = uhash_find(fHashtable, &key);
+        umtx_condWait(&gInProgressValueAddedCond[shardIndex], &gCacheMutex[shardIndex]);
+        element = uhash_find(shard.fHashtable, &key);
     }
+    // Another thread might have reset the statistics while we waited.
+    stats = _getStats(shard, key);
     if (element != NULL) {
+        if (stats != NULL) {
+            ++stats->hits;
+        }
+        ((const CacheKeyBase *) element->key.pointer)->fRecentlyUsed = TRUE;
         _fetch(element, value, status);
         return TRUE;
     }
-    _putNew(key, gNoValue, U_ZERO_ERROR, status);
+    if (stats != NULL) {
+        ++stats->misses;
+    }
+    _putNew(shardIndex, key, gNoValue, U_ZERO_ERROR, status);
     return FALSE;
 }
 
 // Gets value out of cache.
-// On entry. gCacheMutex must not be held. value must be NULL. status
+// On entry. no gCacheMutex may be held. value must be NULL. status
 // must be U_ZERO_ERROR.
 // On exit. value and status set to what is in cache at key or on cache
 // miss the key's createObject() is called and value and status are set to
@@ -395,7 +703,8 @@ void UnifiedCache::_get(
         UErrorCode &status) const {
     U_ASSERT(value == NULL);
     U_ASSERT(status == U_ZERO_ERROR);
-    if (_poll(key, value, status)) {
+    int32_t shardIndex = _getShardIndex(key);
+    if (_poll(shardIndex, key, value, status)) {
         if (value == gNoValue) {
             SharedObject::clearPtr(value);
         }
@@ -404,51 +713,60 @@ void UnifiedCache::_get(
     if (U_FAILURE(status)) {
         return;
     }
+    UBool statsEnabled = umtx_loadAcquire(fStatsEnabled) != 0;
+    double start = statsEnabled ? uprv_getMonotonicMillis() : 0.0;
     value = key.createObject(creationContext, status);
+    double creationMillis = statsEnabled ? uprv_getMonotonicMillis() - start : 0.0;
     U_ASSERT(value == NULL || value->hasHardReferences());
     U_ASSERT(value != NULL || status != U_ZERO_ERROR);
     if (value == NULL) {
         SharedObject::copyPtr(gNoValue, value);
     }
-    _putIfAbsentAndGet(key, value, status);
+    _putIfAbsentAndGet(shardIndex, key, creationMillis, value, status);
     if (value == gNoValue) {
         SharedObject::clearPtr(value);
     }
 }
 
 void UnifiedCache::decrementItemsInUseWithLockingAndEviction() const {
-    Mutex mutex(&gCacheMutex);
     decrementItemsInUse();
     _runEvictionSlice();
 }
 
 void UnifiedCache::incrementItemsInUse() const {
-    ++fItemsInUseCount;
+    umtx_atomic_inc(&fItemsInUseCount);
 }
 
 void UnifiedCache::decrementItemsInUse() const {
-    --fItemsInUseCount;
+    umtx_atomic_dec(&fItemsInUseCount);
 }
 
 // Register a master cache entry.
-// On entry, gCacheMutex must be held.
+// On entry, the mutex of the shard with the entry must be held.
 // On exit, items in use count incremented, entry is marked as a master
-// entry, and value registered with cache so that subsequent calls to
+// entry, the size of the value is counted for the memory budget,
+// and value registered with cache so that subsequent calls to
 // addRef() and removeRef() on it correctly updates items in use count
 void UnifiedCache::_registerMaster(
         const CacheKeyBase *theKey, const SharedObject *value) const {
     theKey->fIsMaster = TRUE;
-    ++fItemsInUseCount;
+    int32_t size = value->getApproximateSize();
+    if (size > 0) {
+        theKey->fSize = size;
+        umtx_atomic_add(&fByteCount, size);
+    }
+    umtx_atomic_inc(&fItemsInUseCount);
     value->registerWithCache(this);
 }
 
 // Store a value and error in given hash entry.
-// On entry, gCacheMutex must be held. Hash entry element must be in progress.
-// value must be non NULL.
+// On entry, gCacheMutex[shardIndex] must be held. Hash entry element must be
+// in progress. value must be non NULL.
 // On Exit, soft reference added to value. value and status stored in hash
 // entry. Soft reference removed from previous stored value. Waiting
 // threads notified.
 void UnifiedCache::_put(
+        int32_t shardIndex,
         const UHashElement *element, 
         const SharedObject *value,
         const UErrorCode status) const {
@@ -456,6 +774,7 @@ void UnifiedCache::_put(
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     const SharedObject *oldValue = (const SharedObject *) element->value.pointer;
     theKey->fCreationStatus = status;
+    theKey->fRecentlyUsed = TRUE;
     if (value->noSoftReferences()) {
         _registerMaster(theKey, value);
     }
@@ -466,7 +785,7 @@ void UnifiedCache::_put(
 
     // Tell waiting threads that we replace in-progress status with
     // an error.
-    umtx_condBroadcast(&gInProgressValueAddedCond);
+    umtx_condBroadcast(&gInProgressValueAddedCond[shardIndex]);
 }
 
 void
@@ -492,7 +811,7 @@ UnifiedCache::clearPtr(const SharedObject *&ptr) {
 
 
 // Fetch value and error code from a particular hash entry.
-// On entry, gCacheMutex must be held. value must be either NULL or must be
+// On entry, the mutex of the shard with the entry must be held. value must be either NULL or must be
 // included in the ref count of the object to which it points.
 // On exit, value and status set to what is in the hash entry. Caller must
 // eventually call removeRef on value.
@@ -512,7 +831,7 @@ void UnifiedCache::_fetch(
 }
 
 // Determine if given hash entry is in progress.
-// On entry, gCacheMutex must be held.
+// On entry, the mutex of the shard with the entry must be held.
 UBool UnifiedCache::_inProgress(const UHashElement *element) {
     const SharedObject *value = NULL;
     UErrorCode status = U_ZERO_ERROR;
@@ -527,14 +846,14 @@ UBool UnifiedCache::_inProgress(const UHashElement *element) {
 }
 
 // Determine if given hash entry is in progress.
-// On entry, gCacheMutex must be held.
+// On entry, the mutex of the shard with the entry must be held.
 UBool UnifiedCache::_inProgress(
         const SharedObject *theValue, UErrorCode creationStatus) {
     return (theValue == gNoValue && creationStatus == U_ZERO_ERROR);
 }
 
 // Determine if given hash entry is eligible for eviction.
-// On entry, gCacheMutex must be held.
+// On entry, the mutex of the shard with the entry must be held.
 UBool UnifiedCache::_isEvictable(const UHashElement *element) {
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     const SharedObject *theValue =
@@ -25,6 +25,7 @@ struct UHashElement;
 
 U_NAMESPACE_BEGIN
 
+class CharString;
 class UnifiedCache;
 
 /**
@@ -32,13 +33,16 @@ class UnifiedCache;
  */
 class U_COMMON_API CacheKeyBase : public UObject {
  public:
-   CacheKeyBase() : fCreationStatus(U_ZERO_ERROR), fIsMaster(FALSE) {}
+   CacheKeyBase()
+           : fCreationStatus(U_ZERO_ERROR), fIsMaster(FALSE),
+             fRecentlyUsed(FALSE), fSize(0) {}
 
    /**
     * Copy constructor. Needed to support cloning.
     */
    CacheKeyBase(const CacheKeyBase &other) 
-           : UObject(other), fCreationStatus(other.fCreationStatus), fIsMaster(FALSE) { }
+           : UObject(other), fCreationStatus(other.fCreationStatus), fIsMaster(FALSE),
+             fRecentlyUsed(FALSE), fSize(0) { }
    virtual ~CacheKeyBase();
 
    /**
@@ -87,6 +91,10 @@ class U_COMMON_API CacheKeyBase : public UObject {
  private:
    mutable UErrorCode fCreationStatus;
    mutable UBool fIsMaster;
+   // Set on each lookup, cleared by eviction for the memory budget.
+   mutable UBool fRecentlyUsed;
+   // Approximate size of the value, counted only for master entries.
+   mutable int32_t fSize;
    friend class UnifiedCache;
 };
 
@@ -173,10 +181,76 @@ class LocaleCacheKey : public CacheKey<T> {
 
 };
 
+/**
+ * Statistics for the cache entries with keys of one type,
+ * for example LocaleCacheKey<SharedNumberFormat>.
+ * Used to tune the eviction policy. See UnifiedCache::getStats().
+ */
+struct U_COMMON_API UnifiedCacheStats : public UMemory {
+   UnifiedCacheStats()
+           : keyType(NULL), lookups(0), hits(0), misses(0),
+             inProgressWaits(0), evictions(0), creationMillis(0.0),
+             entryCount(0), byteCount(0) {}
+
+   /**
+    * The name of the key type as returned by typeid().name().
+    * Not owned; valid for the lifetime of the program.
+    */
+   const char *keyType;
+
+   /**
+    * Number of get() calls.
+    */
+   int64_t lookups;
+
+   /**
+    * Number of lookups that found a value or an error in the cache.
+    */
+   int64_t hits;
+
+   /**
+    * Number of lookups that did not find an entry in the cache
+    * and called CacheKeyBase::createObject().
+    */
+   int64_t misses;
+
+   /**
+    * Number of lookups that waited for another thread to create the value.
+    */
+   int64_t inProgressWaits;
+
+   /**
+    * Number of entries that were evicted automatically.
+    */
+   int64_t evictions;
+
+   /**
+    * Total time spent in CacheKeyBase::createObject(), in milliseconds.
+    */
+   double creationMillis;
+
+   /**
+    * Number of entries currently in the cache.
+    */
+   int32_t entryCount;
+
+   /**
+    * Approximate number of bytes held by the values currently in the cache.
+    * See SharedObject::getApproximateSize().
+    */
+   int64_t byteCount;
+};
+
 /**
  * The unified cache. A singleton type.
  * Design doc here:
  * https://docs.google.com/document/d/1RwGQJs4N4tawNbf809iYDRCvXoMKqDJihxzYt1ysmd8/edit?usp=sharing
+ *
+ * The cache is split into shards by key hash code. Each shard has its own
+ * hash table, mutex and condition variable, so that lookups of different
+ * keys from different threads rarely contend for the same lock.
+ * The in-use and key counts are global, and eviction visits the shards
+ * in turn, so the eviction policy applies to the cache as a whole.
  */
 class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
  public:
@@ -326,6 +400,29 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
            int32_t count, int32_t percentageOfInUseItems, UErrorCode &status);
 
 
+   /**
+    * Sets a limit on the approximate memory held by the values in the cache,
+    * as reported by SharedObject::getApproximateSize(). While the values
+    * take up more than maxBytes, eviction slices evict unused entries,
+    * skipping entries that were looked up since the last time the eviction
+    * reached them. This approximates evicting the least recently used
+    * entries first.
+    *
+    * The memory budget applies in addition to setEvictionPolicy().
+    * Values that are in use cannot be evicted, so the cache may stay over
+    * budget for as long as clients hold on to them.
+    *
+    * maxBytes == 0 means no limit, which is the default.
+    * If maxBytes is negative, setMemoryBudget sets status to
+    * U_ILLEGAL_ARGUMENT_ERROR.
+    */
+   void setMemoryBudget(int32_t maxBytes, UErrorCode &status);
+
+   /**
+    * Returns the approximate number of bytes held by the values in this cache.
+    */
+   int32_t byteCount() const;
+
    /**
     * Returns how many entries have been auto evicted during the lifetime
     * of this cache. This only includes auto evicted entries, not
@@ -339,49 +436,112 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     */
    int32_t unusedCount() const;
 
+   /**
+    * Turns the collection of per-key-type statistics on or off.
+    * Statistics are off by default because they add a little work to
+    * each lookup. Turning them off keeps the statistics collected so far.
+    */
+   void setStatsEnabled(UBool enabled);
+
+   /**
+    * Fetches the statistics for each key type, in no particular order.
+    * The entry counts are always collected. The other values are collected
+    * only while statistics are enabled.
+    *
+    * @param dest     the array to fill in; can be NULL if capacity==0
+    * @param capacity the number of UnifiedCacheStats that fit into dest
+    * @param status   Set to U_BUFFER_OVERFLOW_ERROR if there are more
+    *                 key types than fit into dest.
+    * @return the number of key types
+    */
+   int32_t getStats(
+           UnifiedCacheStats *dest, int32_t capacity, UErrorCode &status) const;
+
+   /**
+    * Sets all statistics except for the entry counts back to zero.
+    */
+   void resetStats() const;
+
+   /**
+    * Appends a description of each cache entry to dest, one line per entry
+    * with tab-separated fields: key type, key description, creation status,
+    * total reference count, soft reference count, "master" or "-",
+    * and the approximate size of the value for master entries or 0.
+    * The creation status of an entry whose value is still being created
+    * is "in progress".
+    */
+   CharString &getSnapshot(CharString &dest, UErrorCode &status) const;
+
    virtual void incrementItemsInUse() const;
    virtual void decrementItemsInUseWithLockingAndEviction() const;
    virtual void decrementItemsInUse() const;
    virtual ~UnifiedCache();
+
+   /**
+    * Number of shards. Must be a power of 2.
+    */
+   static const int32_t SHARD_COUNT = 16;
  private:
-   UHashtable *fHashtable;
-   mutable int32_t fEvictPos;
-   mutable int32_t fItemsInUseCount;
-   int32_t fMaxUnused;
-   int32_t fMaxPercentageOfInUse;
-   mutable int64_t fAutoEvictedCount;
+   /**
+    * One part of the cache. Guarded by the mutex with the same index.
+    */
+   struct Shard {
+       UHashtable *fHashtable;
+       int32_t fEvictPos;
+       int64_t fAutoEvictedCount;
+       // Maps key type names to UnifiedCacheStats.
+       UHashtable *fStats;
+   };
+   mutable Shard fShards[SHARD_COUNT];
+   mutable u_atomic_int32_t fEvictShard;
+   mutable u_atomic_int32_t fKeyCount;
+   mutable u_atomic_int32_t fItemsInUseCount;
+   mutable u_atomic_int32_t fMaxUnused;
+   mutable u_atomic_int32_t fMaxPercentageOfInUse;
+   mutable u_atomic_int32_t fStatsEnabled;
+   mutable u_atomic_int32_t fByteCount;
+   mutable u_atomic_int32_t fMaxBytes;
    UnifiedCache(const UnifiedCache &other);
    UnifiedCache &operator=(const UnifiedCache &other);
-   UBool _flush(UBool all) const;
+   static int32_t _getShardIndex(const CacheKeyBase &key);
+   UBool _flush(int32_t shardIndex, UBool all) const;
    void _get(
            const CacheKeyBase &key,
            const SharedObject *&value,
            const void *creationContext,
            UErrorCode &status) const;
    UBool _poll(
+           int32_t shardIndex,
            const CacheKeyBase &key,
            const SharedObject *&value,
            UErrorCode &status) const;
    void _putNew(
+           int32_t shardIndex,
            const CacheKeyBase &key,
            const SharedObject *value,
            const UErrorCode creationStatus,
            UErrorCode &status) const;
    void _putIfAbsentAndGet(
+           int32_t shardIndex,
            const CacheKeyBase &key,
+           double creationMillis,
            const SharedObject *&value,
            UErrorCode &status) const;
-   const UHashElement *_nextElement() const;
+   UnifiedCacheStats *_getStats(
+           Shard &shard, const CacheKeyBase &key) const;
+   void _removeElement(Shard &shard, const UHashElement *element) const;
    int32_t _computeCountOfItemsToEvict() const;
+   UBool _isOverMemoryBudget() const;
    void _runEvictionSlice() const;
    void _registerMaster( 
         const CacheKeyBase *theKey, const SharedObject *value) const;
    void _put(
+           int32_t shardIndex,
            const UHashElement *element,
            const SharedObject *value,
            const UErrorCode status) const;
 #ifdef UNIFIED_CACHE_DEBUG
-   void _dumpContents() const;
+   void _dumpContents(int32_t shardIndex, int32_t &cnt) const;
 #endif
    static void copyPtr(const SharedObject *src, const SharedObject *&dest);
    static void clearPtr(const SharedObject *&ptr);
@@ -23,6 +23,7 @@
 #include "unicode/utf8.h"
 #include "unicode/utf16.h"
 #include "ustr_imp.h"
+#include "utext_imp.h"
 #include "cmemory.h"
 #include "cstring.h"
 #include "uassert.h"
@@ -93,6 +94,20 @@ utext_isLengthExpensive(const UText *ut) {
 }
 
 
+U_CFUNC const UChar *
+utext_getContiguousUTF16(UText *ut, int32_t *pLength) {
+    if (ut->chunkNativeStart == 0 &&
+            ut->chunkNativeLimit == ut->chunkLength &&
+            ut->nativeIndexingLimit == ut->chunkLength &&
+            !utext_isLengthExpensive(ut) &&
+            utext_nativeLength(ut) == ut->chunkLength) {
+        *pLength = ut->chunkLength;
+        return ut->chunkContents;
+    }
+    return NULL;
+}
+
+
 U_CAPI int64_t U_EXPORT2
 utext_getNativeIndex(const UText *ut) {
     if(ut->chunkOffset <= ut->nativeIndexingLimit) {
@@ -1643,6 +1658,15 @@ utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status) {
 
 }
 
+U_CFUNC const char *
+utext_getUTF8Contents(UText *ut, int32_t *pLength) {
+    if (ut == NULL || ut->pFuncs != &utf8Funcs) {
+        return NULL;
+    }
+    *pLength = (int32_t)utf8TextLength(ut);
+    return (const char *)ut->context;
+}
+
 
 
 
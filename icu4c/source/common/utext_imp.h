@@ -0,0 +1,52 @@
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  utext_imp.h
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Internal UText functions for code that can work directly on
+*   the string behind a UText.
+*/
+
+#ifndef __UTEXT_IMP_H__
+#define __UTEXT_IMP_H__
+
+#include "unicode/utypes.h"
+#include "unicode/utext.h"
+
+/**
+ * Returns the whole text as one contiguous UTF-16 string if the UText
+ * currently holds all of it in its chunk, and native indexes are UTF-16 indexes.
+ * Otherwise returns NULL.
+ * The string is owned by the UText and is valid until the UText is
+ * modified, moved to a different chunk, or closed.
+ *
+ * @param ut the UText
+ * @param pLength receives the string length if the return value is not NULL
+ * @return the UTF-16 string, or NULL
+ * @internal
+ */
+U_CFUNC const UChar *
+utext_getContiguousUTF16(UText *ut, int32_t *pLength);
+
+/**
+ * Returns the UTF-8 string that the UText was opened on
+ * if it is a UText from utext_openUTF8(), otherwise NULL.
+ * Native indexes are byte offsets into this string.
+ * If the string is NUL-terminated, this scans for the length.
+ *
+ * @param ut the UText
+ * @param pLength receives the string length if the return value is not NULL
+ * @return the UTF-8 string, or NULL
+ * @internal
+ */
+U_CFUNC const char *
+utext_getUTF8Contents(UText *ut, int32_t *pLength);
+
+#endif
@@ -15,15 +15,19 @@
 #include "unicode/normalizer2.h"
 #include "unicode/tblcoll.h"
 #include "unicode/uchar.h"
+#include "unicode/uiter.h"
 #include "unicode/ulocdata.h"
 #include "unicode/uniset.h"
 #include "unicode/uobject.h"
 #include "unicode/usetiter.h"
 #include "unicode/utf16.h"
 
+#include "charstr.h"
 #include "cmemory.h"
 #include "cstring.h"
+#include "sharedobject.h"
 #include "uassert.h"
+#include "unifiedcache.h"
 #include "uvector.h"
 #include "uvectr64.h"
 
@@ -121,51 +125,108 @@ int32_t binarySearch(const UVector &list, const UnicodeString &s, const Collator
 // The BucketList is not in the anonymous namespace because only Clang
 // seems to support its use in other classes from there.
 // However, we also don't need U_I18N_API because it is not used from outside the i18n library.
-class BucketList : public UObject {
+// It is a SharedObject so that ImmutableIndex instances can share a cached BucketList.
+class BucketList : public SharedObject {
 public:
-    BucketList(UVector *bucketList, UVector *publicBucketList)
-            : bucketList_(bucketList), immutableVisibleList_(publicBucketList) {
+    BucketList(UVector *bucketList, UVector *publicBucketList,
+               const Collator &collatorPrimaryOnly, UErrorCode &errorCode)
+            : bucketList_(bucketList), immutableVisibleList_(publicBucketList),
+              maxBoundaryKeyLength_(0) {
         int32_t displayIndex = 0;
         for (int32_t i = 0; i < publicBucketList->size(); ++i) {
             getBucket(*publicBucketList, i)->displayIndex_ = displayIndex++;
         }
+        initBoundaryKeys(collatorPrimaryOnly, errorCode);
     }
 
     // The virtual destructor must not be inline.
     // See ticket #8454 for details.
     virtual ~BucketList();
 
+    static BucketList *createInstance(const Locale &locale, UErrorCode &errorCode);
+
     int32_t getBucketCount() const {
         return immutableVisibleList_->size();
     }
 
     int32_t getBucketIndex(const UnicodeString &name, const Collator &collatorPrimaryOnly,
-                           UErrorCode &errorCode) {
-        // binary search
-        int32_t start = 0;
-        int32_t limit = bucketList_->size();
+                           UErrorCode &errorCode) const {
+        MaybeStackArray<uint8_t, 40> nameKey;
+        if (!getNameKey(name, collatorPrimaryOnly, nameKey, errorCode)) { return 0; }
+        return getDisplayIndex(findBucket(nameKey.getAlias(), 0, bucketList_->size()));
+    }
+
+    void getBucketIndexes(const UnicodeString names[], int32_t count, int32_t indexes[],
+                          const Collator &collatorPrimaryOnly, UErrorCode &errorCode) const;
+
+    /** All of the buckets, visible and invisible. */
+    UVector *bucketList_;
+    /** Just the visible buckets. */
+    UVector *immutableVisibleList_;
+
+private:
+    void initBoundaryKeys(const Collator &collatorPrimaryOnly, UErrorCode &errorCode);
+
+    /**
+     * Writes the first maxBoundaryKeyLength_ bytes of the primary sort key of the name,
+     * padded with 00 bytes if the sort key is shorter.
+     * A sort key contains no 00 bytes except for its terminator,
+     * so comparing these bytes with a whole boundary sort key
+     * yields the same result as comparing the strings.
+     */
+    UBool getNameKey(const UnicodeString &name, const Collator &collatorPrimaryOnly,
+                     MaybeStackArray<uint8_t, 40> &nameKey, UErrorCode &errorCode) const {
+        if (U_FAILURE(errorCode)) { return FALSE; }
+        if (maxBoundaryKeyLength_ > nameKey.getCapacity() &&
+                nameKey.resize(maxBoundaryKeyLength_) == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+        UCharIterator iter;
+        uiter_setString(&iter, name.getBuffer(), name.length());
+        uint32_t state[2] = { 0, 0 };
+        collatorPrimaryOnly.internalNextSortKeyPart(
+            &iter, state, nameKey.getAlias(), maxBoundaryKeyLength_, errorCode);
+        return U_SUCCESS(errorCode);
+    }
+
+    /** Compares a name key with the lower boundary of bucket i. */
+    int32_t compareWithBoundary(const uint8_t *nameKey, int32_t i) const {
+        int32_t start = boundaryKeyStarts_[i];
+        return uprv_memcmp(nameKey, boundaryKeys_.data() + start,
+                           boundaryKeyStarts_[i + 1] - start);
+    }
+
+    /**
+     * Binary search for the last bucket in [start, limit[
+     * whose lower boundary is less than or equal to the name.
+     * The name must not be less than the lower boundary of bucket start.
+     */
+    int32_t findBucket(const uint8_t *nameKey, int32_t start, int32_t limit) const {
         while ((start + 1) < limit) {
             int32_t i = (start + limit) / 2;
-            const AlphabeticIndex::Bucket *bucket = getBucket(*bucketList_, i);
-            UCollationResult nameVsBucket =
-                collatorPrimaryOnly.compare(name, bucket->lowerBoundary_, errorCode);
-            if (nameVsBucket < 0) {
+            if (compareWithBoundary(nameKey, i) < 0) {
                 limit = i;
             } else {
                 start = i;
             }
         }
-        const AlphabeticIndex::Bucket *bucket = getBucket(*bucketList_, start);
+        return start;
+    }
+
+    int32_t getDisplayIndex(int32_t i) const {
+        const AlphabeticIndex::Bucket *bucket = getBucket(*bucketList_, i);
         if (bucket->displayBucket_ != NULL) {
             bucket = bucket->displayBucket_;
         }
         return bucket->displayIndex_;
     }
 
-    /** All of the buckets, visible and invisible. */
-    UVector *bucketList_;
-    /** Just the visible buckets. */
-    UVector *immutableVisibleList_;
+    /** Concatenated primary sort keys of the lower boundaries, each with its 00 terminator. */
+    CharString boundaryKeys_;
+    /** Start of each bucket's boundary key in boundaryKeys_, plus the total length. */
+    MaybeStackArray<int32_t, 40> boundaryKeyStarts_;
+    int32_t maxBoundaryKeyLength_;
 };
 
 BucketList::~BucketList() {
@@ -175,8 +236,115 @@ BucketList::~BucketList() {
     }
 }
 
+void BucketList::initBoundaryKeys(const Collator &collatorPrimaryOnly, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return; }
+    int32_t count = bucketList_->size();
+    if (count >= boundaryKeyStarts_.getCapacity() &&
+            boundaryKeyStarts_.resize(count + 1) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    MaybeStackArray<uint8_t, 40> key;
+    for (int32_t i = 0; i < count; ++i) {
+        boundaryKeyStarts_[i] = boundaryKeys_.length();
+        const UnicodeString &boundary = getBucket(*bucketList_, i)->lowerBoundary_;
+        int32_t length = collatorPrimaryOnly.getSortKey(
+            boundary, key.getAlias(), key.getCapacity());
+        if (length > key.getCapacity()) {
+            if (key.resize(length) == NULL) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return;
+            }
+            length = collatorPrimaryOnly.getSortKey(boundary, key.getAlias(), length);
+        }
+        if (length == 0) {
+            errorCode = U_INTERNAL_PROGRAM_ERROR;
+            return;
+        }
+        boundaryKeys_.append(reinterpret_cast<const char *>(key.getAlias()), length, errorCode);
+        if (length > maxBoundaryKeyLength_) {
+            maxBoundaryKeyLength_ = length;
+        }
+    }
+    boundaryKeyStarts_[count] = boundaryKeys_.length();
+}
+
+void BucketList::getBucketIndexes(const UnicodeString names[], int32_t count, int32_t indexes[],
+                                  const Collator &collatorPrimaryOnly,
+                                  UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) { return; }
+    if (count < 0 || (count > 0 && (names == NULL || indexes == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    MaybeStackArray<uint8_t, 40> nameKey;
+    int32_t bucketCount = bucketList_->size();
+    int32_t prev = 0;
+    for (int32_t n = 0; n < count; ++n) {
+        if (!getNameKey(names[n], collatorPrimaryOnly, nameKey, errorCode)) { return; }
+        const uint8_t *key = nameKey.getAlias();
+        // Names are often sorted or clustered:
+        // Try the previous name's bucket and the ones after it first.
+        int32_t i;
+        if (prev == 0 || compareWithBoundary(key, prev) >= 0) {
+            if ((prev + 1) == bucketCount || compareWithBoundary(key, prev + 1) < 0) {
+                i = prev;
+            } else {
+                i = findBucket(key, prev + 1, bucketCount);
+            }
+        } else {
+            i = findBucket(key, 0, prev);
+        }
+        indexes[n] = getDisplayIndex(i);
+        prev = i;
+    }
+}
+
+BucketList *BucketList::createInstance(const Locale &locale, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return NULL; }
+    AlphabeticIndex index(locale, errorCode);
+    if (U_FAILURE(errorCode)) { return NULL; }
+    return index.createBucketList(errorCode);
+}
+
+template<> U_I18N_API
+const BucketList *LocaleCacheKey<BucketList>::createObject(
+        const void * /*unused*/, UErrorCode &errorCode) const {
+    BucketList *result = BucketList::createInstance(fLoc, errorCode);
+    if (U_FAILURE(errorCode)) {
+        return NULL;
+    }
+    result->addRef();
+    return result;
+}
+
+AlphabeticIndex::ImmutableIndex *
+AlphabeticIndex::ImmutableIndex::createInstance(const Locale &locale, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return NULL; }
+    // Same primary-strength collator as in AlphabeticIndex::init().
+    LocalPointer<Collator> coll(Collator::createInstance(locale, errorCode));
+    if (U_FAILURE(errorCode)) { return NULL; }
+    if (dynamic_cast<RuleBasedCollator *>(coll.getAlias()) == NULL) {
+        errorCode = U_UNSUPPORTED_ERROR;
+        return NULL;
+    }
+    coll->setAttribute(UCOL_STRENGTH, UCOL_PRIMARY, errorCode);
+    const BucketList *bucketList = NULL;
+    UnifiedCache::getByLocale(locale, bucketList, errorCode);
+    if (U_FAILURE(errorCode)) { return NULL; }
+    ImmutableIndex *immIndex = new ImmutableIndex(bucketList, coll.getAlias());
+    if (immIndex == NULL) {
+        bucketList->removeRef();
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    // The ImmutableIndex adopted the collator and our reference to the BucketList.
+    coll.orphan();
+    return immIndex;
+}
+
 AlphabeticIndex::ImmutableIndex::~ImmutableIndex() {
-    delete buckets_;
+    buckets_->removeRef();
     delete collatorPrimaryOnly_;
 }
 
@@ -191,6 +359,13 @@ AlphabeticIndex::ImmutableIndex::getBucketIndex(
     return buckets_->getBucketIndex(name, *collatorPrimaryOnly_, errorCode);
 }
 
+void
+AlphabeticIndex::ImmutableIndex::getBucketIndexes(
+        const UnicodeString names[], int32_t count, int32_t indexes[],
+        UErrorCode &errorCode) const {
+    buckets_->getBucketIndexes(names, count, indexes, *collatorPrimaryOnly_, errorCode);
+}
+
 const AlphabeticIndex::Bucket *
 AlphabeticIndex::ImmutableIndex::getBucket(int32_t index) const {
     if (0 <= index && index < buckets_->getBucketCount()) {
@@ -270,7 +445,7 @@ AlphabeticIndex::ImmutableIndex *AlphabeticIndex::buildImmutableIndex(UErrorCode
         return NULL;
     }
     // The ImmutableIndex adopted its parameter objects.
-    immutableBucketList.orphan();
+    immutableBucketList.orphan()->addRef();
     coll.orphan();
     return immIndex;
 }
@@ -542,12 +717,17 @@ BucketList *AlphabeticIndex::createBucketList(UErrorCode &errorCode) const {
     if (U_FAILURE(errorCode)) { return NULL; }
     if (bucketList->size() == 1) {
         // No real labels, show only the underflow label.
-        BucketList *bl = new BucketList(bucketList.getAlias(), bucketList.getAlias());
+        BucketList *bl = new BucketList(bucketList.getAlias(), bucketList.getAlias(),
+                                        *collatorPrimaryOnly_, errorCode);
         if (bl == NULL) {
             errorCode = U_MEMORY_ALLOCATION_ERROR;
             return NULL;
         }
         bucketList.orphan();
+        if (U_FAILURE(errorCode)) {
+            delete bl;
+            return NULL;
+        }
         return bl;
     }
     // overflow bucket
@@ -574,12 +754,17 @@ BucketList *AlphabeticIndex::createBucketList(UErrorCode &errorCode) const {
 
     if (U_FAILURE(errorCode)) { return NULL; }
     if (!hasInvisibleBuckets) {
-        BucketList *bl = new BucketList(bucketList.getAlias(), bucketList.getAlias());
+        BucketList *bl = new BucketList(bucketList.getAlias(), bucketList.getAlias(),
+                                        *collatorPrimaryOnly_, errorCode);
         if (bl == NULL) {
             errorCode = U_MEMORY_ALLOCATION_ERROR;
             return NULL;
         }
         bucketList.orphan();
+        if (U_FAILURE(errorCode)) {
+            delete bl;
+            return NULL;
+        }
         return bl;
     }
     // Merge inflow buckets that are visually adjacent.
@@ -613,13 +798,18 @@ BucketList *AlphabeticIndex::createBucketList(UErrorCode &errorCode) const {
         }
     }
     if (U_FAILURE(errorCode)) { return NULL; }
-    BucketList *bl = new BucketList(bucketList.getAlias(), publicBucketList.getAlias());
+    BucketList *bl = new BucketList(bucketList.getAlias(), publicBucketList.getAlias(),
+                                    *collatorPrimaryOnly_, errorCode);
     if (bl == NULL) {
         errorCode = U_MEMORY_ALLOCATION_ERROR;
         return NULL;
     }
     bucketList.orphan();
     publicBucketList.orphan();
+    if (U_FAILURE(errorCode)) {
+        delete bl;
+        return NULL;
+    }
     return bl;
 }
 
@@ -11,6 +11,7 @@
 
 #include "unicode/basictz.h"
 #include "gregoimp.h"
+#include "putilimp.h"
 #include "uvector.h"
 #include "cmemory.h"
 
@@ -544,6 +545,52 @@ error:
     transitionRules = NULL;
 }
 
+void
+BasicTimeZone::getOffsets(const UDate dates[], int32_t count,
+                          int32_t rawOffsets[], int32_t dstOffsets[], UErrorCode& status) const {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && (dates == NULL || rawOffsets == NULL || dstOffsets == NULL))) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // The offsets found for intervalStart apply until the next transition.
+    UDate intervalStart = 0;
+    UDate intervalLimit = 0;
+    int32_t raw = 0, dst = 0;
+    // Number of dates that reused the current interval, and how many more
+    // lookups to do without computing an interval when that did not pay off.
+    int32_t intervalHits = 0;
+    int32_t lookupsWithoutInterval = 0;
+    TimeZoneTransition tzt;
+    for (int32_t i = 0; i < count; ++i) {
+        UDate date = dates[i];
+        if (intervalStart <= date && date < intervalLimit) {
+            ++intervalHits;
+        } else {
+            getOffset(date, FALSE, raw, dst, status);
+            if (U_FAILURE(status)) {
+                return;
+            }
+            if (intervalLimit > intervalStart && intervalHits == 0) {
+                lookupsWithoutInterval = 16;
+            }
+            intervalStart = intervalLimit = 0;
+            if (lookupsWithoutInterval > 0) {
+                --lookupsWithoutInterval;
+            } else if (i + 1 < count && dates[i + 1] > date) {
+                // The dates look ascending: Find out how far these offsets apply.
+                intervalStart = date;
+                intervalLimit = getNextTransition(date, FALSE, tzt) ? tzt.getTime() : uprv_getInfinity();
+                intervalHits = 0;
+            }
+        }
+        rawOffsets[i] = raw;
+        dstOffsets[i] = dst;
+    }
+}
+
 void
 BasicTimeZone::getOffsetFromLocal(UDate /*date*/, int32_t /*nonExistingTimeOpt*/, int32_t /*duplicatedTimeOpt*/,
                             int32_t& /*rawOffset*/, int32_t& /*dstOffset*/, UErrorCode& status) const {
@@ -35,6 +35,7 @@
 #include "collationdata.h"
 #include "collationdatabuilder.h"
 #include "collationfastlatin.h"
+#include "collationfastlatinbuilder.h"
 #include "collationroot.h"
 #include "collationrootelements.h"
 #include "collationruleparser.h"
@@ -44,6 +45,7 @@
 #include "normalizer2impl.h"
 #include "uassert.h"
 #include "ucol_imp.h"
+#include "unifiedcache.h"
 #include "utf16collationiterator.h"
 
 U_NAMESPACE_BEGIN
@@ -70,6 +72,70 @@ BundleImporter::getRules(
     CollationLoader::loadRules(localeID, collationType, rules, errorCode);
 }
 
+/**
+ * Cache key for a tailoring built from a rule string.
+ * The tailoring depends only on the rules:
+ * Strength and decomposition mode arguments are applied
+ * as attributes after building.
+ */
+class CollationRulesCacheKey : public CacheKey<CollationCacheEntry> {
+public:
+    CollationRulesCacheKey(const UnicodeString &r) : rules(r) {}
+    CollationRulesCacheKey(const CollationRulesCacheKey &other)
+            : CacheKey<CollationCacheEntry>(other), rules(other.rules) {}
+    virtual ~CollationRulesCacheKey();
+    virtual int32_t hashCode() const {
+        return 37 * CacheKey<CollationCacheEntry>::hashCode() + rules.hashCode();
+    }
+    virtual UBool operator==(const CacheKeyBase &other) const {
+        if(this == &other) {
+            return TRUE;
+        }
+        if(!CacheKey<CollationCacheEntry>::operator==(other)) {
+            return FALSE;
+        }
+        // We know that this and other are of same class if we get this far.
+        return rules == static_cast<const CollationRulesCacheKey &>(other).rules;
+    }
+    virtual CacheKeyBase *clone() const {
+        return new CollationRulesCacheKey(*this);
+    }
+    virtual char *writeDescription(char *buffer, int32_t bufLen) const {
+        // The start of the rules, lossy but good enough for debugging.
+        rules.extract(0, rules.length(), buffer, bufLen, US_INV);
+        buffer[bufLen - 1] = 0;
+        return buffer;
+    }
+    virtual const CollationCacheEntry *createObject(
+            const void * /*unused*/, UErrorCode &errorCode) const;
+
+private:
+    UnicodeString rules;
+};
+
+CollationRulesCacheKey::~CollationRulesCacheKey() {}
+
+const CollationCacheEntry *
+CollationRulesCacheKey::createObject(const void * /*unused*/, UErrorCode &errorCode) const {
+    const CollationTailoring *base = CollationRoot::getRoot(errorCode);
+    if(U_FAILURE(errorCode)) { return NULL; }
+    CollationBuilder builder(base, errorCode);
+    UVersionInfo noVersion = { 0, 0, 0, 0 };
+    BundleImporter importer;
+    LocalPointer<CollationTailoring> t(builder.parseAndBuild(rules, noVersion,
+                                                             &importer, NULL, errorCode));
+    if(U_FAILURE(errorCode)) { return NULL; }
+    t->actualLocale.setToBogus();
+    CollationCacheEntry *entry = new CollationCacheEntry(t->actualLocale, t.getAlias());
+    if(entry == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    t.orphan();
+    entry->addRef();
+    return entry;
+}
+
 }  // namespace
 
 // RuleBasedCollator implementation ---------------------------------------- ***
@@ -153,6 +219,33 @@ RuleBasedCollator::RuleBasedCollator(const UnicodeString &rules,
     internalBuildTailoring(rules, UCOL_DEFAULT, UCOL_DEFAULT, &parseError, &reason, errorCode);
 }
 
+uint64_t
+RuleBasedCollator::getRulesCacheKey(const UnicodeString &rules,
+                                    UColAttributeValue strength,
+                                    UColAttributeValue decompositionMode,
+                                    UErrorCode &errorCode) {
+    const CollationTailoring *root = CollationRoot::getRoot(errorCode);
+    if(U_FAILURE(errorCode)) { return 0; }
+    // Same as getVersion() on the root collator.
+    uint8_t bytes[7];
+    uprv_memcpy(bytes, root->version, 4);
+    bytes[0] += (UCOL_RUNTIME_VERSION << 4) + (UCOL_RUNTIME_VERSION >> 4);
+    bytes[4] = U_IS_BIG_ENDIAN;
+    bytes[5] = (uint8_t)strength;
+    bytes[6] = (uint8_t)decompositionMode;
+    // 64-bit FNV-1a, as documented for ucol_getRulesCacheKey().
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    for(int32_t i = 0; i < UPRV_LENGTHOF(bytes); ++i) {
+        hash = (hash ^ bytes[i]) * UINT64_C(0x100000001b3);
+    }
+    const UChar *s = rules.getBuffer();
+    for(int32_t i = 0; i < rules.length(); ++i) {
+        hash = (hash ^ (s[i] & 0xff)) * UINT64_C(0x100000001b3);
+        hash = (hash ^ (s[i] >> 8)) * UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
 void
 RuleBasedCollator::internalBuildTailoring(const UnicodeString &rules,
                                           int32_t strength,
@@ -162,21 +255,48 @@ RuleBasedCollator::internalBuildTailoring(const UnicodeString &rules,
     const CollationTailoring *base = CollationRoot::getRoot(errorCode);
     if(U_FAILURE(errorCode)) { return; }
     if(outReason != NULL) { outReason->remove(); }
-    CollationBuilder builder(base, errorCode);
-    UVersionInfo noVersion = { 0, 0, 0, 0 };
-    BundleImporter importer;
-    LocalPointer<CollationTailoring> t(builder.parseAndBuild(rules, noVersion,
-                                                             &importer,
-                                                             outParseError, errorCode));
-    if(U_FAILURE(errorCode)) {
-        const char *reason = builder.getErrorReason();
-        if(reason != NULL && outReason != NULL) {
-            *outReason = UnicodeString(reason, -1, US_INV);
+    // Share the tailoring with other collators built from the same rules.
+    const UnifiedCache *cache = UnifiedCache::getInstance(errorCode);
+    if(U_FAILURE(errorCode)) { return; }
+    const CollationCacheEntry *entry = NULL;
+    UErrorCode cacheErrorCode = U_ZERO_ERROR;
+    cache->get(CollationRulesCacheKey(rules), entry, cacheErrorCode);
+    if(U_SUCCESS(cacheErrorCode)) {
+        if(outParseError != NULL) {
+            outParseError->line = 0;
+            outParseError->offset = -1;
+            outParseError->preContext[0] = 0;
+            outParseError->postContext[0] = 0;
         }
+        U_ASSERT(settings == NULL && data == NULL && tailoring == NULL && cacheEntry == NULL);
+        cacheEntry = entry;  // get() added a reference
+        tailoring = entry->tailoring;
+        data = tailoring->data;
+        settings = tailoring->settings;
+        settings->addRef();
+        validLocale = entry->validLocale;
+        actualLocaleIsSameAsValid = FALSE;
+    } else if(cacheErrorCode == U_MEMORY_ALLOCATION_ERROR) {
+        errorCode = cacheErrorCode;
         return;
+    } else {
+        // The rules are invalid. Build again, for the parse error and reason.
+        CollationBuilder builder(base, errorCode);
+        UVersionInfo noVersion = { 0, 0, 0, 0 };
+        BundleImporter importer;
+        LocalPointer<CollationTailoring> t(builder.parseAndBuild(rules, noVersion,
+                                                                 &importer,
+                                                                 outParseError, errorCode));
+        if(U_FAILURE(errorCode)) {
+            const char *reason = builder.getErrorReason();
+            if(reason != NULL && outReason != NULL) {
+                *outReason = UnicodeString(reason, -1, US_INV);
+            }
+            return;
+        }
+        t->actualLocale.setToBogus();
+        adoptTailoring(t.orphan(), errorCode);
     }
-    t->actualLocale.setToBogus();
-    adoptTailoring(t.orphan(), errorCode);
     // Set attributes after building the collator,
     // to keep the default settings consistent with the rule string.
     if(strength != UCOL_DEFAULT) {
@@ -273,6 +393,10 @@ CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
         if(U_FAILURE(errorCode)) { return NULL; }
         if(fastLatinEnabled) { dataBuilder->enableFastLatin(); }
         dataBuilder->build(*tailoring->ownedData, errorCode);
+        if(fastLatinEnabled) {
+            CollationFastLatinBuilder::buildScriptTables(
+                *tailoring->ownedData, tailoring->fastScriptTables, errorCode);
+        }
         tailoring->builder = dataBuilder;
         dataBuilder = NULL;
     } else {
@@ -282,6 +406,9 @@ CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
         tailoring->data, ownedSettings,
         ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastLatin::getScriptOptions(
+        tailoring->data, ownedSettings,
+        ownedSettings.fastScriptOptions, UPRV_LENGTHOF(ownedSettings.fastScriptOptions));
     tailoring->rules = ruleString;
     tailoring->rules.getTerminatedBuffer();  // ensure NUL-termination
     tailoring->setVersion(base->version, rulesVersion);
@@ -1656,6 +1783,19 @@ ucol_openRules(const UChar *rules, int32_t rulesLength,
     return coll->toUCollator();
 }
 
+U_CAPI uint64_t U_EXPORT2
+ucol_getRulesCacheKey(const UChar *rules, int32_t rulesLength,
+                      UColAttributeValue normalizationMode, UCollationStrength strength,
+                      UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) { return 0; }
+    if(rules == NULL && rulesLength != 0) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    UnicodeString r((UBool)(rulesLength < 0), rules, rulesLength);
+    return RuleBasedCollator::getRulesCacheKey(r, strength, normalizationMode, *pErrorCode);
+}
+
 static const int32_t internalBufferSize = 512;
 
 // The @internal ucol_getUnsafeSet() was moved here from ucol_sit.cpp
@@ -61,7 +61,10 @@ struct U_I18N_API CollationData : public UMemory {
               unsafeBackwardSet(NULL),
               fastLatinTable(NULL), fastLatinTableLength(0),
               numScripts(0), scriptsIndex(NULL), scriptStarts(NULL), scriptStartsLength(0),
-              rootElements(NULL), rootElementsLength(0) {}
+              rootElements(NULL), rootElementsLength(0) {
+        fastScriptTables[0] = fastScriptTables[1] = NULL;
+        fastScriptTableLengths[0] = fastScriptTableLengths[1] = 0;
+    }
 
     uint32_t getCE32(UChar32 c) const {
         return UTRIE2_GET32(trie, c);
@@ -211,6 +214,13 @@ struct U_I18N_API CollationData : public UMemory {
      */
     const uint16_t *fastLatinTable;
     int32_t fastLatinTableLength;
+    /**
+     * Fast tables for text in small alphabetic scripts (Greek, Cyrillic),
+     * in the same format as the fast Latin table.
+     * Built at load time, see CollationFastLatin::NUM_SCRIPT_TABLES.
+     */
+    const uint16_t *fastScriptTables[2];
+    int32_t fastScriptTableLengths[2];
 
     /**
      * Data for scripts and reordering groups.
@@ -21,6 +21,7 @@
 #include "collationdata.h"
 #include "collationdatareader.h"
 #include "collationfastlatin.h"
+#include "collationfastlatinbuilder.h"
 #include "collationkeys.h"
 #include "collationrootelements.h"
 #include "collationsettings.h"
@@ -410,14 +411,23 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
         return;
     }
 
+    if(data != NULL && data->fastLatinTable != NULL) {
+        CollationFastLatinBuilder::buildScriptTables(*data, tailoring.fastScriptTables, errorCode);
+        if(U_FAILURE(errorCode)) { return; }
+    }
+
     const CollationSettings &ts = *tailoring.settings;
     int32_t options = inIndexes[IX_OPTIONS] & 0xffff;
     uint16_t fastLatinPrimaries[CollationFastLatin::LATIN_LIMIT];
     int32_t fastLatinOptions = CollationFastLatin::getOptions(
             tailoring.data, ts, fastLatinPrimaries, UPRV_LENGTHOF(fastLatinPrimaries));
+    int32_t fastScriptOptions[CollationFastLatin::NUM_SCRIPT_TABLES];
+    CollationFastLatin::getScriptOptions(
+            tailoring.data, ts, fastScriptOptions, UPRV_LENGTHOF(fastScriptOptions));
     if(options == ts.options && ts.variableTop != 0 &&
             reorderCodesLength == ts.reorderCodesLength &&
             uprv_memcmp(reorderCodes, ts.reorderCodes, reorderCodesLength * 4) == 0 &&
+            uprv_memcmp(fastScriptOptions, ts.fastScriptOptions, sizeof(fastScriptOptions)) == 0 &&
             fastLatinOptions == ts.fastLatinOptions &&
             (fastLatinOptions < 0 ||
                 uprv_memcmp(fastLatinPrimaries, ts.fastLatinPrimaries,
@@ -448,6 +458,9 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     settings->fastLatinOptions = CollationFastLatin::getOptions(
         tailoring.data, *settings,
         settings->fastLatinPrimaries, UPRV_LENGTHOF(settings->fastLatinPrimaries));
+    CollationFastLatin::getScriptOptions(
+        tailoring.data, *settings,
+        settings->fastScriptOptions, UPRV_LENGTHOF(settings->fastScriptOptions));
 }
 
 UBool U_CALLCONV
@@ -29,6 +29,53 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
     U_ASSERT(capacity == LATIN_LIMIT);
     if(capacity != LATIN_LIMIT) { return -1; }
 
+    UBool digitsAreReordered;
+    int32_t miniVarTop = getMiniVarTop(data, settings, table, USCRIPT_LATIN, digitsAreReordered);
+    if(miniVarTop < 0) { return -1; }
+
+    table += (table[0] & 0xff);  // skip the header
+    for(UChar32 c = 0; c < LATIN_LIMIT; ++c) {
+        uint32_t p = table[c];
+        if(p >= MIN_SHORT) {
+            p &= SHORT_PRIMARY_MASK;
+        } else if(p > (uint32_t)miniVarTop) {
+            p &= LONG_PRIMARY_MASK;
+        } else {
+            p = 0;
+        }
+        primaries[c] = (uint16_t)p;
+    }
+    if(digitsAreReordered || (settings.options & CollationSettings::NUMERIC) != 0) {
+        // Bail out for digits.
+        for(UChar32 c = 0x30; c <= 0x39; ++c) { primaries[c] = 0; }
+    }
+
+    // Shift the miniVarTop above other options.
+    return (miniVarTop << 16) | settings.options;
+}
+
+void
+CollationFastLatin::getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                     int32_t *options, int32_t capacity) {
+    U_ASSERT(capacity == NUM_SCRIPT_TABLES);
+    for(int32_t i = 0; i < capacity; ++i) {
+        options[i] = -1;
+        const uint16_t *table = i < NUM_SCRIPT_TABLES ? data->fastScriptTables[i] : NULL;
+        if(table == NULL) { continue; }
+        UBool digitsAreReordered;
+        int32_t miniVarTop = getMiniVarTop(data, settings, table, getScriptForTableIndex(i),
+                                           digitsAreReordered);
+        // Without precomputed primaries, the compare functions cannot
+        // bail out for reordered digits.
+        if(miniVarTop < 0 || digitsAreReordered) { continue; }
+        options[i] = (miniVarTop << 16) | settings.options;
+    }
+}
+
+int32_t
+CollationFastLatin::getMiniVarTop(const CollationData *data, const CollationSettings &settings,
+                                  const uint16_t *table, int32_t script,
+                                  UBool &digitsAreReordered) {
     uint32_t miniVarTop;
     if((settings.options & CollationSettings::ALTERNATE_MASK) == 0) {
         // No mini primaries are variable, set a variableTop just below the
@@ -43,7 +90,7 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
         miniVarTop = table[i];
     }
 
-    UBool digitsAreReordered = FALSE;
+    digitsAreReordered = FALSE;
     if(settings.hasReordering()) {
         uint32_t prevStart = 0;
         uint32_t beforeDigitStart = 0;
@@ -59,7 +106,7 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
                 digitStart = start;
             } else if(start != 0) {
                 if(start < prevStart) {
-                    // The permutation affects the groups up to Latin.
+                    // The permutation affects the groups up to the table's script.
                     return -1;
                 }
                 // In the future, there might be a special group between digits & Latin.
@@ -69,38 +116,19 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
                 prevStart = start;
             }
         }
-        uint32_t latinStart = data->getFirstPrimaryForGroup(USCRIPT_LATIN);
-        latinStart = settings.reorder(latinStart);
-        if(latinStart < prevStart) {
+        uint32_t scriptStart = data->getFirstPrimaryForGroup(script);
+        scriptStart = settings.reorder(scriptStart);
+        if(scriptStart < prevStart) {
             return -1;
         }
         if(afterDigitStart == 0) {
-            afterDigitStart = latinStart;
+            afterDigitStart = scriptStart;
         }
         if(!(beforeDigitStart < digitStart && digitStart < afterDigitStart)) {
             digitsAreReordered = TRUE;
         }
     }
-
-    table += (table[0] & 0xff);  // skip the header
-    for(UChar32 c = 0; c < LATIN_LIMIT; ++c) {
-        uint32_t p = table[c];
-        if(p >= MIN_SHORT) {
-            p &= SHORT_PRIMARY_MASK;
-        } else if(p > miniVarTop) {
-            p &= LONG_PRIMARY_MASK;
-        } else {
-            p = 0;
-        }
-        primaries[c] = (uint16_t)p;
-    }
-    if(digitsAreReordered || (settings.options & CollationSettings::NUMERIC) != 0) {
-        // Bail out for digits.
-        for(UChar32 c = 0x30; c <= 0x39; ++c) { primaries[c] = 0; }
-    }
-
-    // Shift the miniVarTop above other options.
-    return ((int32_t)miniVarTop << 16) | settings.options;
+    return (int32_t)miniVarTop;
 }
 
 int32_t
@@ -113,6 +141,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
     U_ASSERT((table[0] >> 8) == VERSION);
+    UChar32 blockStart = getBlockStart(table);
     table += (table[0] & 0xff);  // skip the header
     uint32_t variableTop = (uint32_t)options >> 16;  // see getOptions()
     options &= 0xffff;  // needed for CollationSettings::getStrength() to work
@@ -143,7 +172,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 leftPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
-                leftPair = lookup(table, c);
+                leftPair = lookup(table, blockStart, c);
             }
             if(leftPair >= MIN_SHORT) {
                 leftPair &= SHORT_PRIMARY_MASK;
@@ -152,7 +181,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -174,7 +203,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 rightPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
-                rightPair = lookup(table, c);
+                rightPair = lookup(table, blockStart, c);
             }
             if(rightPair >= MIN_SHORT) {
                 rightPair &= SHORT_PRIMARY_MASK;
@@ -183,7 +212,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -225,7 +254,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     leftPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
-                    leftPair = lookup(table, c);
+                    leftPair = lookup(table, blockStart, c);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -234,7 +263,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -250,7 +279,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     rightPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
-                    rightPair = lookup(table, c);
+                    rightPair = lookup(table, blockStart, c);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -259,7 +288,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -296,9 +325,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, blockStart, c);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -309,9 +338,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, blockStart, c);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -349,9 +378,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, blockStart, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -362,9 +391,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, blockStart, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -405,9 +434,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, blockStart, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -418,9 +447,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, blockStart, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -449,6 +478,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
     U_ASSERT((table[0] >> 8) == VERSION);
+    UChar32 blockStart = getBlockStart(table);
     table += (table[0] & 0xff);  // skip the header
     uint32_t variableTop = (uint32_t)options >> 16;  // see RuleBasedCollator::getFastLatinOptions()
     options &= 0xffff;  // needed for CollationSettings::getStrength() to work
@@ -488,7 +518,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 if(leftPair != 0) { break; }
                 leftPair = table[c];
             } else {
-                leftPair = lookupUTF8(table, c, left, leftIndex, leftLength);
+                leftPair = lookupUTF8(table, blockStart, c, left, leftIndex, leftLength);
             }
             if(leftPair >= MIN_SHORT) {
                 leftPair &= SHORT_PRIMARY_MASK;
@@ -497,7 +527,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -525,7 +555,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 if(rightPair != 0) { break; }
                 rightPair = table[c];
             } else {
-                rightPair = lookupUTF8(table, c, right, rightIndex, rightLength);
+                rightPair = lookupUTF8(table, blockStart, c, right, rightIndex, rightLength);
             }
             if(rightPair >= MIN_SHORT) {
                 rightPair &= SHORT_PRIMARY_MASK;
@@ -534,7 +564,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -576,7 +606,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 } else if(c <= LATIN_MAX_UTF8_LEAD) {
                     leftPair = table[((c - 0xc2) << 6) + left[leftIndex++]];
                 } else {
-                    leftPair = lookupUTF8Unsafe(table, c, left, leftIndex);
+                    leftPair = lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -585,7 +615,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -601,7 +631,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 } else if(c <= LATIN_MAX_UTF8_LEAD) {
                     rightPair = table[((c - 0xc2) << 6) + right[rightIndex++]];
                 } else {
-                    rightPair = lookupUTF8Unsafe(table, c, right, rightIndex);
+                    rightPair = lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -610,7 +640,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -647,9 +677,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -660,9 +690,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -700,9 +730,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -713,9 +743,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -756,9 +786,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -769,9 +799,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -794,10 +824,12 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
 }
 
 uint32_t
-CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
+CollationFastLatin::lookup(const uint16_t *table, UChar32 blockStart, UChar32 c) {
     U_ASSERT(c > LATIN_MAX);
     if(PUNCT_START <= c && c < PUNCT_LIMIT) {
         return table[c - PUNCT_START + LATIN_LIMIT];
+    } else if((uint32_t)(c - blockStart) < (uint32_t)SCRIPT_BLOCK_LENGTH) {
+        return table[c - blockStart - SCRIPT_BLOCK_LENGTH];  // at the end of the header
     } else if(c == 0xfffe) {
         return MERGE_WEIGHT;
     } else if(c == 0xffff) {
@@ -808,10 +840,21 @@ CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
 }
 
 uint32_t
-CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
+CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength) {
     // The caller handled ASCII and valid/supported Latin.
     U_ASSERT(c > 0x7f);
+    if(c < 0xe0) {
+        uint8_t t;
+        if(0xc2 <= c && sIndex != sLength && 0x80 <= (t = s8[sIndex]) && t <= 0xbf) {
+            c = ((c - 0xc2) << 6) + t;
+            if((uint32_t)(c - blockStart) < (uint32_t)SCRIPT_BLOCK_LENGTH) {
+                ++sIndex;
+                return table[c - blockStart - SCRIPT_BLOCK_LENGTH];  // at the end of the header
+            }
+        }
+        return BAIL_OUT;
+    }
     int32_t i2 = sIndex + 1;
     if(i2 < sLength || sLength < 0) {
         uint8_t t1 = s8[sIndex];
@@ -831,13 +874,16 @@ CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
 }
 
 uint32_t
-CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex) {
     // The caller handled ASCII.
     // The string is well-formed and contains only supported characters.
     U_ASSERT(c > 0x7f);
     if(c <= LATIN_MAX_UTF8_LEAD) {
         return table[((c - 0xc2) << 6) + s8[sIndex++]];  // 0080..017F
+    } else if(c < 0xe0) {
+        c = ((c - 0xc2) << 6) + s8[sIndex++];  // script block
+        return table[c - blockStart - SCRIPT_BLOCK_LENGTH];
     }
     uint8_t t2 = s8[sIndex + 1];
     sIndex += 2;
@@ -851,7 +897,7 @@ CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
 }
 
 uint32_t
-CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+CollationFastLatin::nextPair(const uint16_t *table, UChar32 blockStart, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength) {
     if(ce >= MIN_LONG || ce < CONTRACTION) {
         return ce;  // simple or special mini CE
@@ -877,6 +923,8 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                         c2 = c2 - PUNCT_START + LATIN_LIMIT;  // 2000..203F -> 0180..01BF
                     } else if(c2 == 0xfffe || c2 == 0xffff) {
                         c2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
+                    } else if((uint32_t)(c2 - blockStart) < (uint32_t)SCRIPT_BLOCK_LENGTH) {
+                        c2 = -1;  // Contraction suffixes do not start in the script block.
                     } else {
                         return BAIL_OUT;
                     }
@@ -889,6 +937,11 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                             0x80 <= (t = s8[nextIndex]) && t <= 0xbf) {
                         c2 = ((c2 - 0xc2) << 6) + t;  // 0080..017F
                         ++nextIndex;
+                    } else if(c2 < 0xe0 && 0xc2 <= c2 && nextIndex != sLength &&
+                            0x80 <= (t = s8[nextIndex]) && t <= 0xbf &&
+                            (uint32_t)(((c2 - 0xc2) << 6) + t - blockStart) <
+                                (uint32_t)SCRIPT_BLOCK_LENGTH) {
+                        c2 = -1;  // Contraction suffixes do not start in the script block.
                     } else {
                         int32_t i2 = nextIndex + 1;
                         if(i2 < sLength || sLength < 0) {
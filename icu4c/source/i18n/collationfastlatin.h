@@ -16,6 +16,8 @@
 
 #if !UCONFIG_NO_COLLATION
 
+#include "unicode/uscript.h"
+
 U_NAMESPACE_BEGIN
 
 struct CollationData;
@@ -44,6 +46,22 @@ public:
     // excludes U+FFFE & U+FFFF
     static const int32_t NUM_FAST_CHARS = LATIN_LIMIT + (PUNCT_LIMIT - PUNCT_START);
 
+    /**
+     * Script tables support the same characters as the Latin table
+     * plus one block of code points for a small alphabetic script.
+     * The letters of the Latin script are not supported in a script table,
+     * so that there are enough mini primaries for the script's letters.
+     * Script tables are built at load time and are not serialized.
+     */
+    static const int32_t NUM_SCRIPT_TABLES = 2;
+    static const int32_t SCRIPT_BLOCK_LENGTH = 0x80;
+    /** Script table 0 is for Greek U+0380..U+03FF, table 1 for Cyrillic U+0400..U+047F. */
+    static const int32_t FIRST_SCRIPT_BLOCK_START = 0x380;
+    static const int32_t SCRIPT_BLOCKS_LIMIT =
+            FIRST_SCRIPT_BLOCK_START + NUM_SCRIPT_TABLES * SCRIPT_BLOCK_LENGTH;
+    /** Header index of the script block start; the block's mini CEs follow it. */
+    static const int32_t SCRIPT_BLOCK_START_INDEX = 5;
+
     // Note on the supported weight ranges:
     // Analysis of UCA 6.3 and CLDR 23 non-search tailorings shows that
     // the CEs for characters in the above ranges, excluding expansions with length >2,
@@ -199,6 +217,34 @@ public:
         }
     }
 
+    /**
+     * Returns the index of the script table whose block contains c, or -1.
+     */
+    static inline int32_t getScriptTableIndex(UChar32 c) {
+        if(FIRST_SCRIPT_BLOCK_START <= c && c < SCRIPT_BLOCKS_LIMIT) {
+            return (c - FIRST_SCRIPT_BLOCK_START) / SCRIPT_BLOCK_LENGTH;
+        } else {
+            return -1;
+        }
+    }
+
+    /**
+     * Returns the index of the script table whose block contains
+     * the characters with this UTF-8 lead byte, or -1.
+     */
+    static inline int32_t getScriptTableIndexUTF8(uint8_t lead) {
+        // U+0380..U+047F have lead bytes CE..D1.
+        if(0xce <= lead && lead <= 0xd1) {
+            return (lead - 0xce) >> 1;
+        } else {
+            return -1;
+        }
+    }
+
+    static inline int32_t getScriptForTableIndex(int32_t i) {
+        return i == 0 ? USCRIPT_GREEK : USCRIPT_CYRILLIC;
+    }
+
     /**
      * Computes the options value for the compare functions
      * and writes the precomputed primary weights.
@@ -208,6 +254,17 @@ public:
     static int32_t getOptions(const CollationData *data, const CollationSettings &settings,
                               uint16_t *primaries, int32_t capacity);
 
+    /**
+     * Computes the options values for the compare functions
+     * with each of the data's script tables.
+     * Writes -1 for a table that is missing or not supported for the settings.
+     * The script tables do not use precomputed primary weights;
+     * the compare functions must be called with an array of LATIN_LIMIT zeros instead.
+     * The capacity must be NUM_SCRIPT_TABLES.
+     */
+    static void getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                 int32_t *options, int32_t capacity);
+
     static int32_t compareUTF16(const uint16_t *table, const uint16_t *primaries, int32_t options,
                                 const UChar *left, int32_t leftLength,
                                 const UChar *right, int32_t rightLength);
@@ -217,13 +274,28 @@ public:
                                const uint8_t *right, int32_t rightLength);
 
 private:
-    static uint32_t lookup(const uint16_t *table, UChar32 c);
-    static uint32_t lookupUTF8(const uint16_t *table, UChar32 c,
+    /**
+     * Returns the mini variable top for the table,
+     * or -1 if the reordering affects the special groups or the table's script.
+     */
+    static int32_t getMiniVarTop(const CollationData *data, const CollationSettings &settings,
+                                 const uint16_t *table, int32_t script,
+                                 UBool &digitsAreReordered);
+
+    /** Returns the start of the table's script block, or 0 if it has none. */
+    static inline UChar32 getBlockStart(const uint16_t *table) {
+        return (table[0] & 0xff) > SCRIPT_BLOCK_START_INDEX ? table[SCRIPT_BLOCK_START_INDEX] : 0;
+    }
+
+    // The table has been advanced past the header.
+    // The script block's mini CEs are at the end of the header.
+    static uint32_t lookup(const uint16_t *table, UChar32 blockStart, UChar32 c);
+    static uint32_t lookupUTF8(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength);
-    static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+    static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex);
 
-    static uint32_t nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+    static uint32_t nextPair(const uint16_t *table, UChar32 blockStart, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength);
 
     static inline uint32_t getPrimaries(uint32_t variableTop, uint32_t pair) {
@@ -301,6 +373,22 @@ private:
  *   for when there is no contraction match.
  *
  * -----------------
+ * Script tables
+ *
+ * A script table has the same format, with a longer header:
+ *
+ * uint16_t blockStart -- at SCRIPT_BLOCK_START_INDEX, the first code point of the script block
+ * uint16_t blockMiniCEs[SCRIPT_BLOCK_LENGTH]
+ *   A mini CE for each character of the script block, like miniCEs[].
+ *   They are at the end of the header, so that the rest of the table
+ *   has the same layout as the Latin table.
+ *
+ * Contraction suffixes never start with a script block character;
+ * a contraction whose suffix would start with one bails out for its first character.
+ * Script tables are built at runtime and never serialized,
+ * so they do not change the format version.
+ *
+ * -----------------
  * Changes for version 2 (ICU 55)
  *
  * Special reorder groups do not necessarily start on whole primary lead bytes any more.
@@ -89,6 +89,7 @@ CollationFastLatinBuilder::CollationFastLatinBuilder(UErrorCode &errorCode)
           contractionCEs(errorCode), uniqueCEs(errorCode),
           miniCEs(NULL),
           firstDigitPrimary(0), firstLatinPrimary(0), lastLatinPrimary(0),
+          script(USCRIPT_LATIN), blockStart(0), firstScriptPrimary(0), lastScriptPrimary(0),
           firstShortPrimary(0), shortPrimaryOverflow(FALSE),
           headerLength(0) {
 }
@@ -99,6 +100,70 @@ CollationFastLatinBuilder::~CollationFastLatinBuilder() {
 
 UBool
 CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorCode) {
+    script = USCRIPT_LATIN;
+    blockStart = 0;
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::forScript(const CollationData &data, int32_t tableIndex,
+                                     UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(tableIndex < 0 || CollationFastLatin::NUM_SCRIPT_TABLES <= tableIndex) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    script = CollationFastLatin::getScriptForTableIndex(tableIndex);
+    blockStart = CollationFastLatin::FIRST_SCRIPT_BLOCK_START +
+            tableIndex * CollationFastLatin::SCRIPT_BLOCK_LENGTH;
+    return build(data, errorCode);
+}
+
+void
+CollationFastLatinBuilder::buildScriptTables(CollationData &data, UnicodeString &storage,
+                                             UErrorCode &errorCode) {
+    int32_t starts[CollationFastLatin::NUM_SCRIPT_TABLES];
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        data.fastScriptTables[i] = NULL;
+        data.fastScriptTableLengths[i] = 0;
+        starts[i] = -1;
+    }
+    if(U_FAILURE(errorCode)) { return; }
+    const CollationData *base = data.base;
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        CollationFastLatinBuilder builder(errorCode);
+        if(!builder.forScript(data, i, errorCode)) {
+            if(U_FAILURE(errorCode)) { return; }
+            continue;
+        }
+        const uint16_t *table = builder.getTable();
+        int32_t length = builder.lengthOfTable();
+        if(base != NULL && length == base->fastScriptTableLengths[i] &&
+                uprv_memcmp(table, base->fastScriptTables[i], length * 2) == 0) {
+            // Same table as in the base, use that one instead.
+            data.fastScriptTables[i] = base->fastScriptTables[i];
+            data.fastScriptTableLengths[i] = length;
+            continue;
+        }
+        starts[i] = storage.length();
+        storage.append(reinterpret_cast<const UChar *>(table), length);
+        data.fastScriptTableLengths[i] = length;
+    }
+    if(storage.isBogus()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    // Set the pointers only after the storage is complete.
+    const uint16_t *buffer = reinterpret_cast<const uint16_t *>(storage.getBuffer());
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        if(starts[i] >= 0) {
+            data.fastScriptTables[i] = buffer + starts[i];
+        }
+    }
+}
+
+UBool
+CollationFastLatinBuilder::build(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     if(!result.isEmpty()) {  // This builder is not reusable.
         errorCode = U_INVALID_STATE_ERROR;
@@ -113,7 +178,7 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
     if(shortPrimaryOverflow) {
         // Give digits long mini primaries,
         // so that there are more short primaries for letters.
-        firstShortPrimary = firstLatinPrimary;
+        firstShortPrimary = firstScriptPrimary;
         resetCEs();
         getCEs(data, errorCode);
         if(!encodeUniqueCEs(errorCode)) { return FALSE; }
@@ -149,11 +214,28 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
         }
         result.append(0);  // reserve a slot for this group
     }
+    if(blockStart != 0) {
+        result.append((UChar)blockStart);
+        for(int32_t i = 0; i < CollationFastLatin::SCRIPT_BLOCK_LENGTH; ++i) {
+            result.append(0);  // reserve the script block mini CEs
+        }
+        headerLength = result.length();
+        result.setCharAt(0, (UChar)((CollationFastLatin::VERSION << 8) | headerLength));
+    }
 
     firstDigitPrimary = data.getFirstPrimaryForGroup(UCOL_REORDER_CODE_DIGIT);
     firstLatinPrimary = data.getFirstPrimaryForGroup(USCRIPT_LATIN);
     lastLatinPrimary = data.getLastPrimaryForGroup(USCRIPT_LATIN);
-    if(firstDigitPrimary == 0 || firstLatinPrimary == 0) {
+    if(script == USCRIPT_LATIN) {
+        firstScriptPrimary = firstLatinPrimary;
+        lastScriptPrimary = lastLatinPrimary;
+    } else {
+        firstScriptPrimary = data.getFirstPrimaryForGroup(script);
+        lastScriptPrimary = data.getLastPrimaryForGroup(script);
+    }
+    if(firstDigitPrimary == 0 || firstLatinPrimary == 0 || firstScriptPrimary == 0 ||
+            // The script must sort after Latin in the base order.
+            firstScriptPrimary < firstLatinPrimary) {
         // missing data
         return FALSE;
     }
@@ -207,6 +289,9 @@ CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCo
         if(c == CollationFastLatin::LATIN_LIMIT) {
             c = CollationFastLatin::PUNCT_START;
         } else if(c == CollationFastLatin::PUNCT_LIMIT) {
+            if(blockStart == 0) { break; }
+            c = (UChar)blockStart;
+        } else if(blockStart != 0 && c == blockStart + CollationFastLatin::SCRIPT_BLOCK_LENGTH) {
             break;
         }
         const CollationData *d;
@@ -301,8 +386,9 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
     // We do not support an ignorable ce0 unless it is completely ignorable.
     uint32_t p0 = (uint32_t)(ce0 >> 32);
     if(p0 == 0) { return FALSE; }
-    // We only support primaries up to the Latin script.
-    if(p0 > lastLatinPrimary) { return FALSE; }
+    // We only support primaries up to the Latin script,
+    // or special and digit primaries plus those of the table's script.
+    if(!isSupportedPrimary(p0)) { return FALSE; }
     // We support non-common secondary and case weights only together with short primaries.
     uint32_t lower32_0 = (uint32_t)ce0;
     if(p0 < firstShortPrimary) {
@@ -345,6 +431,14 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
     // Since the original ce32 is not a prefix mapping,
     // the default ce32 must not be another contraction.
     U_ASSERT(!Collation::isContractionCE32(ce32));
+    if(blockStart != 0) {
+        // The fastpath does not look for script block characters in contraction lists.
+        UCharsTrie::Iterator suffixes(p + 2, 0, errorCode);
+        while(suffixes.next(errorCode)) {
+            if(isInBlock(suffixes.getString().charAt(0))) { return FALSE; }
+        }
+        if(U_FAILURE(errorCode)) { return FALSE; }
+    }
     int32_t contractionIndex = contractionCEs.size();
     if(getCEsFromCE32(data, U_SENTINEL, ce32, errorCode)) {
         addContractionEntry(CollationFastLatin::CONTR_CHAR_MASK, ce0, ce1, errorCode);
@@ -562,12 +656,12 @@ CollationFastLatinBuilder::encodeUniqueCEs(UErrorCode &errorCode) {
 UBool
 CollationFastLatinBuilder::encodeCharCEs(UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
-    int32_t miniCEsStart = result.length();
     for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
         result.append(0);  // initialize to completely ignorable
     }
     int32_t indexBase = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    int32_t numChars = getNumChars();
+    for(int32_t i = 0; i < numChars; ++i) {
         int64_t ce = charCEs[i][0];
         if(isContractionCharCE(ce)) { continue; }  // defer contraction
         uint32_t miniCE = encodeTwoCEs(ce, charCEs[i][1]);
@@ -583,7 +677,7 @@ CollationFastLatinBuilder::encodeCharCEs(UErrorCode &errorCode) {
                 miniCE = CollationFastLatin::EXPANSION | expansionIndex;
             }
         }
-        result.setCharAt(miniCEsStart + i, (UChar)miniCE);
+        result.setCharAt(getMiniCEIndex(i), (UChar)miniCE);
     }
     return U_SUCCESS(errorCode);
 }
@@ -595,12 +689,13 @@ CollationFastLatinBuilder::encodeContractions(UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     int32_t indexBase = headerLength + CollationFastLatin::NUM_FAST_CHARS;
     int32_t firstContractionIndex = result.length();
-    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+    int32_t numChars = getNumChars();
+    for(int32_t i = 0; i < numChars; ++i) {
         int64_t ce = charCEs[i][0];
         if(!isContractionCharCE(ce)) { continue; }
         int32_t contractionIndex = result.length() - indexBase;
         if(contractionIndex > (int32_t)CollationFastLatin::INDEX_MASK) {
-            result.setCharAt(headerLength + i, CollationFastLatin::BAIL_OUT);
+            result.setCharAt(getMiniCEIndex(i), CollationFastLatin::BAIL_OUT);
             continue;
         }
         UBool firstTriple = TRUE;
@@ -624,7 +719,7 @@ CollationFastLatinBuilder::encodeContractions(UErrorCode &errorCode) {
         // Note: There is a chance that this new contraction list is the same as a previous one,
         // and if so, then we could truncate the result and reuse the other list.
         // However, that seems unlikely.
-        result.setCharAt(headerLength + i,
+        result.setCharAt(getMiniCEIndex(i),
                          (UChar)(CollationFastLatin::CONTRACTION | contractionIndex));
     }
     if(result.length() > firstContractionIndex) {
@@ -32,6 +32,20 @@ public:
     ~CollationFastLatinBuilder();
 
     UBool forData(const CollationData &data, UErrorCode &errorCode);
+    /**
+     * Builds a script table, see CollationFastLatin::NUM_SCRIPT_TABLES.
+     * @param tableIndex 0..CollationFastLatin::NUM_SCRIPT_TABLES-1
+     */
+    UBool forScript(const CollationData &data, int32_t tableIndex, UErrorCode &errorCode);
+
+    /**
+     * Builds all of the script tables for the data, appends them to the storage,
+     * and sets the data's fastScriptTables[] and fastScriptTableLengths[].
+     * A table that is the same as in the base data is shared instead.
+     * A table that cannot be built is set to NULL.
+     */
+    static void buildScriptTables(CollationData &data, UnicodeString &storage,
+                                  UErrorCode &errorCode);
 
     const uint16_t *getTable() const {
         return reinterpret_cast<const uint16_t *>(result.getBuffer());
@@ -42,8 +56,31 @@ private:
     // space, punct, symbol, currency (not digit)
     enum { NUM_SPECIAL_GROUPS = UCOL_REORDER_CODE_CURRENCY - UCOL_REORDER_CODE_FIRST + 1 };
 
+    UBool build(const CollationData &data, UErrorCode &errorCode);
     UBool loadGroups(const CollationData &data, UErrorCode &errorCode);
     UBool inSameGroup(uint32_t p, uint32_t q) const;
+    /** Special groups, digits, and the letters of the table's script. */
+    UBool isSupportedPrimary(uint32_t p) const {
+        return p <= lastScriptPrimary && (p < firstLatinPrimary || firstScriptPrimary <= p);
+    }
+    UBool isInBlock(UChar32 c) const {
+        return blockStart != 0 &&
+            (uint32_t)(c - blockStart) < (uint32_t)CollationFastLatin::SCRIPT_BLOCK_LENGTH;
+    }
+    int32_t getNumChars() const {
+        return CollationFastLatin::NUM_FAST_CHARS +
+            (blockStart != 0 ? CollationFastLatin::SCRIPT_BLOCK_LENGTH : 0);
+    }
+    /** Index of the mini CE for char index i in the result. */
+    int32_t getMiniCEIndex(int32_t i) const {
+        if(i < CollationFastLatin::NUM_FAST_CHARS) {
+            return headerLength + i;
+        } else {
+            // The script block's mini CEs are at the end of the header.
+            return headerLength - CollationFastLatin::SCRIPT_BLOCK_LENGTH +
+                (i - CollationFastLatin::NUM_FAST_CHARS);
+        }
+    }
 
     void resetCEs();
     void getCEs(const CollationData &data, UErrorCode &errorCode);
@@ -68,7 +105,7 @@ private:
     // temporary "buffer"
     int64_t ce0, ce1;
 
-    int64_t charCEs[CollationFastLatin::NUM_FAST_CHARS][2];
+    int64_t charCEs[CollationFastLatin::NUM_FAST_CHARS + CollationFastLatin::SCRIPT_BLOCK_LENGTH][2];
 
     UVector64 contractionCEs;
     UVector64 uniqueCEs;
@@ -81,6 +118,11 @@ private:
     uint32_t firstDigitPrimary;
     uint32_t firstLatinPrimary;
     uint32_t lastLatinPrimary;
+    // The table's script: Latin, or the script of the script block.
+    int32_t script;
+    UChar32 blockStart;  // 0 for the Latin table
+    uint32_t firstScriptPrimary;
+    uint32_t lastScriptPrimary;
     // This determines the first normal primary weight which is mapped to
     // a short mini primary. It must be >=firstDigitPrimary.
     uint32_t firstShortPrimary;
@@ -227,9 +227,22 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
                                           SortKeyByteSink &sink,
                                           Collation::Level minLevel, LevelCallback &callback,
                                           UBool preflight, UErrorCode &errorCode) {
+    writeSortKeyUpToQuaternary(iter, compressibleBytes, settings, settings.getStrength(),
+                               sink, minLevel, callback, preflight, errorCode);
+}
+
+void
+CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
+                                          const UBool *compressibleBytes,
+                                          const CollationSettings &settings,
+                                          int32_t strength,
+                                          SortKeyByteSink &sink,
+                                          Collation::Level minLevel, LevelCallback &callback,
+                                          UBool preflight, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return; }
 
-    int32_t options = settings.options;
+    int32_t options = (settings.options & ~CollationSettings::STRENGTH_MASK) |
+            (strength << CollationSettings::STRENGTH_SHIFT);
     // Set of levels to process and write.
     uint32_t levels = levelMasks[CollationSettings::getStrength(options)];
     if((options & CollationSettings::CASE_LEVEL) != 0) {
@@ -111,6 +111,18 @@ public:
                                            SortKeyByteSink &sink,
                                            Collation::Level minLevel, LevelCallback &callback,
                                            UBool preflight, UErrorCode &errorCode);
+
+    /**
+     * Same as above, but uses the given strength (UColAttributeValue)
+     * instead of the settings' strength.
+     */
+    static void writeSortKeyUpToQuaternary(CollationIterator &iter,
+                                           const UBool *compressibleBytes,
+                                           const CollationSettings &settings,
+                                           int32_t strength,
+                                           SortKeyByteSink &sink,
+                                           Collation::Level minLevel, LevelCallback &callback,
+                                           UBool preflight, UErrorCode &errorCode);
 private:
     friend struct CollationDataReader;
 
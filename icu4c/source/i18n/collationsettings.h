@@ -108,7 +108,9 @@ struct U_I18N_API CollationSettings : public SharedObject {
               minHighNoReorder(0),
               reorderRanges(NULL), reorderRangesLength(0),
               reorderCodes(NULL), reorderCodesLength(0), reorderCodesCapacity(0),
-              fastLatinOptions(-1) {}
+              fastLatinOptions(-1) {
+        fastScriptOptions[0] = fastScriptOptions[1] = -1;
+    }
 
     CollationSettings(const CollationSettings &other);
     virtual ~CollationSettings();
@@ -258,6 +260,8 @@ struct U_I18N_API CollationSettings : public SharedObject {
     /** Options for CollationFastLatin. Negative if disabled. */
     int32_t fastLatinOptions;
     uint16_t fastLatinPrimaries[0x180];
+    /** Options for the CollationFastLatin script tables. Negative if disabled. */
+    int32_t fastScriptOptions[2];
 
 private:
     void setReorderArrays(const int32_t *codes, int32_t codesLength,
@@ -0,0 +1,342 @@
+/*
+*******************************************************************************
+* Copyright (C) 2016, International Business Machines
+* Corporation and others.  All Rights Reserved.
+*******************************************************************************
+* collationsort.cpp
+*
+* Bulk sorting of string arrays: Radix sort on sort key prefixes,
+* with full comparisons only among strings whose prefixes are equal.
+* Sorted ranges of one array can be merged, for sorting on several threads.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/coll.h"
+#include "unicode/uiter.h"
+#include "cmemory.h"
+#include "uarrsort.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+/** Number of sort key bytes that are radix-sorted. */
+const int32_t PREFIX_LENGTH = 8;
+
+struct SortItem {
+    /** The first PREFIX_LENGTH sort key bytes, big-endian, padded with 00 bytes. */
+    uint64_t prefix;
+    int32_t index;
+};
+
+/**
+ * Sorts the items by their prefixes.
+ * Least-significant-byte-first radix sort, which is stable.
+ * Skips byte positions where all items have the same byte value,
+ * which is common for the low bytes of short sort keys.
+ */
+void radixSort(SortItem *items, SortItem *temp, int32_t count) {
+    int32_t counts[PREFIX_LENGTH][256];
+    uprv_memset(counts, 0, sizeof(counts));
+    for(int32_t i = 0; i < count; ++i) {
+        uint64_t prefix = items[i].prefix;
+        for(int32_t b = 0; b < PREFIX_LENGTH; ++b) {
+            ++counts[b][(prefix >> (b * 8)) & 0xff];
+        }
+    }
+    SortItem *src = items;
+    SortItem *dest = temp;
+    for(int32_t b = 0; b < PREFIX_LENGTH; ++b) {
+        int32_t *c = counts[b];
+        int32_t shift = b * 8;
+        if(c[(src[0].prefix >> shift) & 0xff] == count) { continue; }
+        // Turn the counts into start positions.
+        int32_t start = 0;
+        for(int32_t v = 0; v < 256; ++v) {
+            int32_t n = c[v];
+            c[v] = start;
+            start += n;
+        }
+        for(int32_t i = 0; i < count; ++i) {
+            dest[c[(src[i].prefix >> shift) & 0xff]++] = src[i];
+        }
+        SortItem *t = src;
+        src = dest;
+        dest = t;
+    }
+    if(src != items) {
+        uprv_memcpy(items, src, count * sizeof(SortItem));
+    }
+}
+
+/**
+ * Adapts the UTF-16 or UTF-8 input to the shared sorting code.
+ */
+class StringSorter : public UMemory {
+public:
+    StringSorter(const Collator &c, const int32_t *lens, UBool st, UErrorCode &ec)
+            : coll(c), lengths(lens), stable(st), errorCode(ec) {}
+    virtual ~StringSorter();
+
+    void sort(int32_t start, int32_t limit, int32_t order[]);
+    void merge(const int32_t order1[], int32_t length1,
+               const int32_t order2[], int32_t length2, int32_t dest[]);
+
+    /**
+     * Sets the iterator to string i.
+     */
+    virtual void setIterator(UCharIterator &iter, int32_t i) const = 0;
+    /**
+     * Compares strings i and j in full.
+     */
+    virtual UCollationResult compare(int32_t i, int32_t j) const = 0;
+
+    int32_t length(int32_t i) const { return lengths != NULL ? lengths[i] : -1; }
+
+    const Collator &coll;
+    const int32_t *lengths;
+    UBool stable;
+    UErrorCode &errorCode;
+
+private:
+    UBool setPrefix(SortItem &item);
+};
+
+StringSorter::~StringSorter() {}
+
+U_CDECL_BEGIN
+
+static int32_t U_CALLCONV
+compareItems(const void *context, const void *left, const void *right) {
+    const StringSorter &sorter = *static_cast<const StringSorter *>(context);
+    int32_t i = static_cast<const SortItem *>(left)->index;
+    int32_t j = static_cast<const SortItem *>(right)->index;
+    int32_t result = sorter.compare(i, j);
+    if(result == 0 && sorter.stable) {
+        // Make the quicksort stable.
+        result = i < j ? -1 : i > j;
+    }
+    return result;
+}
+
+U_CDECL_END
+
+UBool
+StringSorter::setPrefix(SortItem &item) {
+    UCharIterator iter;
+    setIterator(iter, item.index);
+    uint32_t state[2] = { 0, 0 };
+    uint8_t bytes[PREFIX_LENGTH];
+    int32_t length = coll.internalNextSortKeyPart(&iter, state, bytes, PREFIX_LENGTH, errorCode);
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    // A sort key contains no 00 bytes except at the end,
+    // so padding with 00 bytes keeps shorter keys before longer ones.
+    uint64_t prefix = 0;
+    for(int32_t k = 0; k < PREFIX_LENGTH; ++k) {
+        prefix = (prefix << 8) | (k < length ? bytes[k] : 0);
+    }
+    item.prefix = prefix;
+    return TRUE;
+}
+
+void
+StringSorter::sort(int32_t start, int32_t limit, int32_t order[]) {
+    int32_t count = limit - start;
+    if(count <= 1) {
+        if(count == 1) { order[0] = start; }
+        return;
+    }
+    LocalMemory<SortItem> items((SortItem *)uprv_malloc(count * 2 * sizeof(SortItem)));
+    if(items.isNull()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    UBool usePrefixes = TRUE;
+    for(int32_t i = 0; i < count; ++i) {
+        items[i].index = start + i;
+        items[i].prefix = 0;
+        if(usePrefixes && !setPrefix(items[i])) {
+            if(errorCode != U_UNSUPPORTED_ERROR) { return; }
+            // Not a RuleBasedCollator: Fall back to comparing everything in full.
+            errorCode = U_ZERO_ERROR;
+            usePrefixes = FALSE;
+            for(int32_t j = 0; j < i; ++j) { items[j].prefix = 0; }
+        }
+    }
+    if(usePrefixes) {
+        radixSort(items.getAlias(), items.getAlias() + count, count);
+    }
+    // Compare strings in full only where their prefixes are equal
+    // and too short to contain the whole sort key.
+    for(int32_t runStart = 0; runStart < count;) {
+        uint64_t prefix = items[runStart].prefix;
+        int32_t runLimit = runStart + 1;
+        while(runLimit < count && items[runLimit].prefix == prefix) { ++runLimit; }
+        if((runLimit - runStart) > 1 && (!usePrefixes || (prefix & 0xff) != 0)) {
+            uprv_sortArray(items.getAlias() + runStart, runLimit - runStart, (int32_t)sizeof(SortItem),
+                           compareItems, this, FALSE, &errorCode);
+            if(U_FAILURE(errorCode)) { return; }
+        }
+        runStart = runLimit;
+    }
+    for(int32_t i = 0; i < count; ++i) {
+        order[i] = items[i].index;
+    }
+}
+
+class UTF16StringSorter : public StringSorter {
+public:
+    UTF16StringSorter(const Collator &c, const UChar *const s[], const int32_t *lens,
+                      UBool st, UErrorCode &ec)
+            : StringSorter(c, lens, st, ec), strings(s) {}
+    virtual ~UTF16StringSorter();
+
+    virtual void setIterator(UCharIterator &iter, int32_t i) const {
+        uiter_setString(&iter, strings[i], length(i));
+    }
+    virtual UCollationResult compare(int32_t i, int32_t j) const {
+        return coll.compare(strings[i], length(i), strings[j], length(j), errorCode);
+    }
+
+private:
+    const UChar *const *strings;
+};
+
+void
+StringSorter::merge(const int32_t order1[], int32_t length1,
+                    const int32_t order2[], int32_t length2, int32_t dest[]) {
+    int32_t i1 = 0, i2 = 0;
+    while(i1 < length1 && i2 < length2) {
+        int32_t i = order1[i1];
+        int32_t j = order2[i2];
+        int32_t result = compare(i, j);
+        if(U_FAILURE(errorCode)) { return; }
+        if(result == 0 && stable) {
+            result = i < j ? -1 : 1;
+        }
+        // Ties take the first input's string first.
+        if(result <= 0) {
+            *dest++ = i;
+            ++i1;
+        } else {
+            *dest++ = j;
+            ++i2;
+        }
+    }
+    while(i1 < length1) { *dest++ = order1[i1++]; }
+    while(i2 < length2) { *dest++ = order2[i2++]; }
+}
+
+UTF16StringSorter::~UTF16StringSorter() {}
+
+class UTF8StringSorter : public StringSorter {
+public:
+    UTF8StringSorter(const Collator &c, const char *const s[], const int32_t *lens,
+                     UBool st, UErrorCode &ec)
+            : StringSorter(c, lens, st, ec), strings(s) {}
+    virtual ~UTF8StringSorter();
+
+    virtual void setIterator(UCharIterator &iter, int32_t i) const {
+        uiter_setUTF8(&iter, strings[i], length(i));
+    }
+    virtual UCollationResult compare(int32_t i, int32_t j) const {
+        return coll.internalCompareUTF8(strings[i], length(i), strings[j], length(j), errorCode);
+    }
+
+private:
+    const char *const *strings;
+};
+
+UTF8StringSorter::~UTF8StringSorter() {}
+
+UBool
+checkSortArgs(const void *strings, const int32_t lengths[], int32_t start, int32_t limit,
+              int32_t order[], UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    int32_t count = limit - start;
+    if(start < 0 || count < 0 || (count > 0 && (strings == NULL || order == NULL)) ||
+            count > (int32_t)(0x7fffffff / (2 * sizeof(SortItem)))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    if(lengths != NULL) {
+        for(int32_t i = start; i < limit; ++i) {
+            if(lengths[i] < -1) {
+                errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+UBool
+checkMergeArgs(const void *strings, const int32_t order1[], int32_t length1,
+               const int32_t order2[], int32_t length2, int32_t dest[],
+               UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(length1 < 0 || length2 < 0 || length1 > 0x7fffffff - length2 ||
+            (length1 > 0 && order1 == NULL) || (length2 > 0 && order2 == NULL) ||
+            ((length1 + length2) > 0 && (strings == NULL || dest == NULL))) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+}  // namespace
+
+void
+Collator::sort(const UChar *const strings[], const int32_t lengths[], int32_t count,
+               int32_t order[], UBool stable, UErrorCode &errorCode) const {
+    sortRange(strings, lengths, 0, count, order, stable, errorCode);
+}
+
+void
+Collator::sortUTF8(const char *const strings[], const int32_t lengths[], int32_t count,
+                   int32_t order[], UBool stable, UErrorCode &errorCode) const {
+    sortRangeUTF8(strings, lengths, 0, count, order, stable, errorCode);
+}
+
+void
+Collator::sortRange(const UChar *const strings[], const int32_t lengths[],
+                    int32_t start, int32_t limit,
+                    int32_t order[], UBool stable, UErrorCode &errorCode) const {
+    if(!checkSortArgs(strings, lengths, start, limit, order, errorCode)) { return; }
+    UTF16StringSorter(*this, strings, lengths, stable, errorCode).sort(start, limit, order);
+}
+
+void
+Collator::sortRangeUTF8(const char *const strings[], const int32_t lengths[],
+                        int32_t start, int32_t limit,
+                        int32_t order[], UBool stable, UErrorCode &errorCode) const {
+    if(!checkSortArgs(strings, lengths, start, limit, order, errorCode)) { return; }
+    UTF8StringSorter(*this, strings, lengths, stable, errorCode).sort(start, limit, order);
+}
+
+void
+Collator::mergeSorted(const UChar *const strings[], const int32_t lengths[],
+                      const int32_t order1[], int32_t length1,
+                      const int32_t order2[], int32_t length2,
+                      int32_t dest[], UBool stable, UErrorCode &errorCode) const {
+    if(!checkMergeArgs(strings, order1, length1, order2, length2, dest, errorCode)) { return; }
+    UTF16StringSorter(*this, strings, lengths, stable, errorCode).merge(
+        order1, length1, order2, length2, dest);
+}
+
+void
+Collator::mergeSortedUTF8(const char *const strings[], const int32_t lengths[],
+                          const int32_t order1[], int32_t length1,
+                          const int32_t order2[], int32_t length2,
+                          int32_t dest[], UBool stable, UErrorCode &errorCode) const {
+    if(!checkMergeArgs(strings, order1, length1, order2, length2, dest, errorCode)) { return; }
+    UTF8StringSorter(*this, strings, lengths, stable, errorCode).merge(
+        order1, length1, order2, length2, dest);
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
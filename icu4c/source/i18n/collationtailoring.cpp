@@ -14,6 +14,7 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/udata.h"
+#include "unicode/uniset.h"
 #include "unicode/unistr.h"
 #include "unicode/ures.h"
 #include "unicode/uversion.h"
@@ -102,10 +103,40 @@ CollationTailoring::getUCAVersion() const {
     return ((int32_t)version[1] << 4) | (version[2] >> 6);
 }
 
+int32_t
+CollationTailoring::getApproximateSize() const {
+    int32_t size = (int32_t)sizeof(*this) + rules.length() * U_SIZEOF_UCHAR +
+        fastScriptTables.length() * U_SIZEOF_UCHAR;
+    if(builder != NULL && ownedData != NULL) {
+        // The builder owns the arrays and the trie.
+        size += ownedData->ce32sLength * 4 + ownedData->cesLength * 8 +
+            ownedData->contextsLength * U_SIZEOF_UCHAR +
+            ownedData->fastLatinTableLength * 2;
+        if(ownedData->trie != NULL) {
+            UErrorCode errorCode = U_ZERO_ERROR;
+            size += utrie2_serialize(ownedData->trie, NULL, 0, &errorCode);
+        }
+    }
+    if(unsafeBackwardSet != NULL) {
+        size += (int32_t)sizeof(UnicodeSet) + unsafeBackwardSet->getRangeCount() * 8;
+    }
+    return size;
+}
+
 CollationCacheEntry::~CollationCacheEntry() {
     SharedObject::clearPtr(tailoring);
 }
 
+int32_t
+CollationCacheEntry::getApproximateSize() const {
+    int32_t size = (int32_t)sizeof(*this);
+    if(tailoring != NULL) {
+        // The cache entry is normally the only owner of its tailoring.
+        size += tailoring->getApproximateSize();
+    }
+    return size;
+}
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
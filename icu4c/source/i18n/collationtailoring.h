@@ -58,6 +58,13 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     void setVersion(const UVersionInfo baseVersion, const UVersionInfo rulesVersion);
     int32_t getUCAVersion() const;
 
+    /**
+     * Counts the rules string, and the mappings data built from rules.
+     * Does not count the shared root data, the settings,
+     * or data loaded from a resource bundle which is usually memory-mapped.
+     */
+    virtual int32_t getApproximateSize() const;
+
     // data for sorting etc.
     const CollationData *data;  // == base data or ownedData
     const CollationSettings *settings;  // reference-counted
@@ -79,6 +86,7 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     UResourceBundle *bundle;
     UTrie2 *trie;
     UnicodeSet *unsafeBackwardSet;
+    UnicodeString fastScriptTables;  // storage for ownedData->fastScriptTables[]
     mutable UHashtable *maxExpansions;
     mutable UInitOnce maxExpansionsInitOnce;
 
@@ -99,6 +107,8 @@ struct CollationCacheEntry : public SharedObject {
     }
     ~CollationCacheEntry();
 
+    virtual int32_t getApproximateSize() const;
+
     Locale validLocale;
     const CollationTailoring *tailoring;
 };
@@ -20,6 +20,7 @@
 #include "unicode/gregocal.h"
 #include "gregoimp.h"
 #include "cmemory.h"
+#include "putilimp.h"
 #include "uassert.h"
 #include "uvector.h"
 #include <float.h> // DBL_MAX
@@ -119,7 +120,7 @@ OlsonTimeZone::OlsonTimeZone(const UResourceBundle* top,
                              const UResourceBundle* res,
                              const UnicodeString& tzid,
                              UErrorCode& ec) :
-  BasicTimeZone(tzid), finalZone(NULL)
+  BasicTimeZone(tzid), finalZone(NULL), lastTransitionIdx(0)
 {
     clearTransitionRules();
     U_DEBUG_TZ_MSG(("OlsonTimeZone(%s)\n", ures_getKey((UResourceBundle*)res)));
@@ -264,7 +265,7 @@ OlsonTimeZone::OlsonTimeZone(const UResourceBundle* top,
  * Copy constructor
  */
 OlsonTimeZone::OlsonTimeZone(const OlsonTimeZone& other) :
-    BasicTimeZone(other), finalZone(0) {
+    BasicTimeZone(other), finalZone(0), lastTransitionIdx(0) {
     *this = other;
 }
 
@@ -285,6 +286,7 @@ OlsonTimeZone& OlsonTimeZone::operator=(const OlsonTimeZone& other) {
     typeCount = other.typeCount;
     typeOffsets = other.typeOffsets;
     typeMapData = other.typeMapData;
+    umtx_storeRelease(lastTransitionIdx, 0);
 
     delete finalZone;
     finalZone = (other.finalZone != 0) ?
@@ -412,6 +414,49 @@ OlsonTimeZone::getOffsetFromLocal(UDate date, int32_t nonExistingTimeOpt, int32_
 }
 
 
+void
+OlsonTimeZone::getOffsets(const UDate dates[], int32_t count,
+                          int32_t rawOffsets[], int32_t dstOffsets[], UErrorCode& ec) const {
+    if (U_FAILURE(ec)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && (dates == NULL || rawOffsets == NULL || dstOffsets == NULL))) {
+        ec = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    int16_t transCount = transitionCount();
+    // The offsets of transIdx apply from intervalStart to intervalLimit.
+    int16_t transIdx = -1;
+    double intervalStart = 0;
+    double intervalLimit = 0;
+    for (int32_t i = 0; i < count;) {
+        UDate date = dates[i];
+        if (finalZone != NULL && date >= finalStartMillis) {
+            // Pass the whole run of dates in the range of the final zone to it.
+            int32_t limit = i + 1;
+            while (limit < count && dates[limit] >= finalStartMillis) {
+                ++limit;
+            }
+            finalZone->getOffsets(dates + i, limit - i, rawOffsets + i, dstOffsets + i, ec);
+            if (U_FAILURE(ec)) {
+                return;
+            }
+            i = limit;
+            continue;
+        }
+        // Same rounding as in getHistoricalOffset().
+        double millis = uprv_floor(date / U_MILLIS_PER_SECOND) * U_MILLIS_PER_SECOND;
+        if (!(intervalStart <= millis && millis < intervalLimit)) {
+            transIdx = findTransitionBefore(millis, TRUE);
+            intervalStart = transIdx >= 0 ? transitionTime(transIdx) : -uprv_getInfinity();
+            intervalLimit = transIdx + 1 < transCount ? transitionTime(transIdx + 1) : uprv_getInfinity();
+        }
+        rawOffsets[i] = rawOffsetAt(transIdx) * U_MILLIS_PER_SECOND;
+        dstOffsets[i] = dstOffsetAt(transIdx) * U_MILLIS_PER_SECOND;
+        ++i;
+    }
+}
+
 /**
  * TimeZone API.
  */
@@ -464,6 +509,46 @@ OlsonTimeZone::transitionTimeInSeconds(int16_t transIdx) const {
         | ((int64_t)((uint32_t)transitionTimesPost32[(transIdx << 1) + 1]));
 }
 
+// Returns TRUE if a transition at t is before time.
+static inline UBool isTransitionBefore(double t, UDate time, UBool inclusive) {
+    return t < time || (inclusive && t == time);
+}
+
+int16_t
+OlsonTimeZone::findTransitionBefore(UDate time, UBool inclusive) const {
+    int16_t transCount = transitionCount();
+    int32_t idx = umtx_loadAcquire(lastTransitionIdx);
+    if (idx < transCount && isTransitionBefore(transitionTime((int16_t)idx), time, inclusive)) {
+        // Nearby times usually fall into the same interval or the next one.
+        if (idx + 1 == transCount ||
+                !isTransitionBefore(transitionTime((int16_t)(idx + 1)), time, inclusive)) {
+            return (int16_t)idx;
+        }
+        ++idx;
+        if (idx + 1 == transCount ||
+                !isTransitionBefore(transitionTime((int16_t)(idx + 1)), time, inclusive)) {
+            umtx_storeRelease(lastTransitionIdx, idx);
+            return (int16_t)idx;
+        }
+    }
+    // Binary search for the first transition that is not before time.
+    int32_t start = 0;
+    int32_t limit = transCount;
+    while (start < limit) {
+        int32_t mid = (start + limit) / 2;
+        if (isTransitionBefore(transitionTime((int16_t)mid), time, inclusive)) {
+            start = mid + 1;
+        } else {
+            limit = mid;
+        }
+    }
+    idx = start - 1;
+    if (idx >= 0) {
+        umtx_storeRelease(lastTransitionIdx, idx);
+    }
+    return (int16_t)idx;
+}
+
 // Maximum absolute offset in seconds (86400 seconds = 1 day)
 // getHistoricalOffset uses this constant as safety margin of
 // quick zone transition checking.
@@ -487,10 +572,17 @@ OlsonTimeZone::getHistoricalOffset(UDate date, UBool local,
             rawoff = initialRawOffset() * U_MILLIS_PER_SECOND;
             dstoff = initialDstOffset() * U_MILLIS_PER_SECOND;
         } else {
-            // Linear search from the end is the fastest approach, since
-            // most lookups will happen at/near the end.
+            // Find the last transition that could apply. When local is true,
+            // the actual transition time depends on the offsets around it,
+            // so continue with a linear search from there.
             int16_t transIdx;
-            for (transIdx = transCount - 1; transIdx >= 0; transIdx--) {
+            if (local) {
+                transIdx = findTransitionBefore(
+                    (sec + MAX_OFFSET_SECONDS) * U_MILLIS_PER_SECOND, TRUE);
+            } else {
+                transIdx = findTransitionBefore(sec * U_MILLIS_PER_SECOND, TRUE);
+            }
+            for (; transIdx >= 0; transIdx--) {
                 int64_t transition = transitionTimeInSeconds(transIdx);
 
                 if (local && (sec >= (transition - MAX_OFFSET_SECONDS))) {
@@ -900,12 +992,9 @@ OlsonTimeZone::getNextTransition(UDate base, UBool inclusive, TimeZoneTransition
     if (historicRules != NULL) {
         // Find a historical transition
         int16_t transCount = transitionCount();
-        int16_t ttidx = transCount - 1;
-        for (; ttidx >= firstTZTransitionIdx; ttidx--) {
-            UDate t = (UDate)transitionTime(ttidx);
-            if (base > t || (!inclusive && base == t)) {
-                break;
-            }
+        int16_t ttidx = findTransitionBefore(base, !inclusive);
+        if (ttidx < firstTZTransitionIdx) {
+            ttidx = firstTZTransitionIdx - 1;
         }
         if (ttidx == transCount - 1)  {
             if (firstFinalTZTransition != NULL) {
@@ -965,12 +1054,9 @@ OlsonTimeZone::getPreviousTransition(UDate base, UBool inclusive, TimeZoneTransi
 
     if (historicRules != NULL) {
         // Find a historical transition
-        int16_t ttidx = transitionCount() - 1;
-        for (; ttidx >= firstTZTransitionIdx; ttidx--) {
-            UDate t = (UDate)transitionTime(ttidx);
-            if (base > t || (inclusive && base == t)) {
-                break;
-            }
+        int16_t ttidx = findTransitionBefore(base, inclusive);
+        if (ttidx < firstTZTransitionIdx) {
+            ttidx = firstTZTransitionIdx - 1;
         }
         if (ttidx < firstTZTransitionIdx) {
             // No more transitions
@@ -188,6 +188,12 @@ class U_I18N_API OlsonTimeZone: public BasicTimeZone {
     virtual void getOffsetFromLocal(UDate date, int32_t nonExistingTimeOpt, int32_t duplicatedTimeOpt,
         int32_t& rawoff, int32_t& dstoff, UErrorCode& ec) const;
 
+    /**
+     * BasicTimeZone API.
+     */
+    virtual void getOffsets(const UDate dates[], int32_t count,
+        int32_t rawOffsets[], int32_t dstOffsets[], UErrorCode& ec) const;
+
     /**
      * TimeZone API.  This method has no effect since objects of this
      * class are quasi-immutable (the base class allows the ID to be
@@ -300,6 +306,15 @@ private:
     int64_t transitionTimeInSeconds(int16_t transIdx) const;
     double transitionTime(int16_t transIdx) const;
 
+    /*
+     * Returns the index of the last transition at or before the given time
+     * in milliseconds, or strictly before it if !inclusive.
+     * Returns -1 if there is no such transition.
+     * Tries the previous result and the one after it first,
+     * then uses binary search.
+     */
+    int16_t findTransitionBefore(UDate time, UBool inclusive) const;
+
     /*
      * Following 3 methods return an offset at the given transition time index.
      * When the index is negative, return the initial offset.
@@ -380,6 +395,13 @@ private:
      */
     const UChar *canonicalID;
 
+    /*
+     * Result of the last findTransitionBefore() call, used as a hint for the
+     * next one. Only a hint: it is validated against the transition times
+     * which are immutable, so it need not be consistent between threads.
+     */
+    mutable u_atomic_int32_t lastTransitionIdx;
+
     /* BasicTimeZone support */
     void clearTransitionRules(void);
     void deleteTransitionRules(void);
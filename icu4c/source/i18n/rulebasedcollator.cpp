@@ -27,6 +27,7 @@
 #include "unicode/uniset.h"
 #include "unicode/unistr.h"
 #include "unicode/usetiter.h"
+#include "unicode/ustring.h"
 #include "unicode/utf8.h"
 #include "unicode/uversion.h"
 #include "bocsu.h"
@@ -85,6 +86,194 @@ FixedSortKeyByteSink::Resize(int32_t /*appendCapacity*/, int32_t /*length*/) {
     return FALSE;
 }
 
+/**
+ * Computes a 64-bit FNV-1a hash of the sort key bytes
+ * without storing the whole sort key.
+ * The bytes are collected in a small internal buffer which is hashed
+ * and reset whenever it fills up.
+ */
+class HashSortKeyByteSink : public SortKeyByteSink {
+public:
+    HashSortKeyByteSink()
+            : SortKeyByteSink(buffer, (int32_t)sizeof(buffer)),
+              hash(UINT64_C(0xcbf29ce484222325)) {}
+    virtual ~HashSortKeyByteSink();
+
+    uint64_t getHash() {
+        addToHash(buffer, appended_);
+        appended_ = 0;
+        return hash;
+    }
+
+private:
+    virtual void AppendBeyondCapacity(const char *bytes, int32_t n, int32_t length);
+    virtual UBool Resize(int32_t appendCapacity, int32_t length);
+
+    void addToHash(const char *bytes, int32_t n) {
+        for(int32_t i = 0; i < n; ++i) {
+            hash = (hash ^ (uint8_t)bytes[i]) * UINT64_C(0x100000001b3);
+        }
+    }
+
+    char buffer[128];
+    uint64_t hash;
+};
+
+HashSortKeyByteSink::~HashSortKeyByteSink() {}
+
+void
+HashSortKeyByteSink::AppendBeyondCapacity(const char *bytes, int32_t n, int32_t length) {
+    addToHash(buffer, length);
+    addToHash(bytes, n);
+    appended_ = 0;
+}
+
+UBool
+HashSortKeyByteSink::Resize(int32_t appendCapacity, int32_t length) {
+    addToHash(buffer, length);
+    appended_ = 0;
+    return appendCapacity <= capacity_;
+}
+
+/**
+ * Writes a compact sort key: All of the primary level,
+ * and at most maxLevelLength bytes of each further level.
+ * The first level that is longer is cut off there and marked with
+ * a TRUNCATION_MARKER byte, and all of the following levels are omitted.
+ *
+ * A sort key contains 00 and 01 bytes only as the terminator and level separators.
+ * The marker sorts after the level separator, and after the terminator,
+ * so that a truncated level sorts after the same bytes as a complete level.
+ *
+ * The bytes are collected in a small internal buffer which is filtered
+ * into the destination whenever it fills up.
+ */
+class CompactSortKeyByteSink : public SortKeyByteSink {
+public:
+    CompactSortKeyByteSink(uint8_t *dest, int32_t destCapacity, int32_t maxLevelLength)
+            : SortKeyByteSink(buffer, (int32_t)sizeof(buffer)),
+              dest_(dest), destCapacity_(destCapacity), destLength_(0),
+              fullLength_(0), maxLevelLength_(maxLevelLength), levelLength_(-1),
+              truncated_(FALSE) {}
+    virtual ~CompactSortKeyByteSink();
+
+    /** Filters the remaining bytes. @return the length of the compact sort key */
+    int32_t finish() {
+        filter(buffer, appended_);
+        appended_ = 0;
+        return destLength_;
+    }
+    /** @return the length of the uncompacted sort key */
+    int32_t getFullLength() const { return fullLength_; }
+    UBool isTruncated() const { return truncated_; }
+
+private:
+    static const uint8_t TRUNCATION_MARKER = 2;
+
+    virtual void AppendBeyondCapacity(const char *bytes, int32_t n, int32_t length);
+    virtual UBool Resize(int32_t appendCapacity, int32_t length);
+
+    void filter(const char *bytes, int32_t n);
+    void put(uint8_t b) {
+        if(destLength_ < destCapacity_) { dest_[destLength_] = b; }
+        ++destLength_;
+    }
+
+    char buffer[128];
+    uint8_t *dest_;
+    int32_t destCapacity_;
+    int32_t destLength_;
+    int32_t fullLength_;
+    int32_t maxLevelLength_;
+    /** Number of bytes written for the current level after the primary level, or -1. */
+    int32_t levelLength_;
+    UBool truncated_;
+};
+
+CompactSortKeyByteSink::~CompactSortKeyByteSink() {}
+
+void
+CompactSortKeyByteSink::AppendBeyondCapacity(const char *bytes, int32_t n, int32_t length) {
+    filter(buffer, length);
+    filter(bytes, n);
+    appended_ = 0;
+}
+
+UBool
+CompactSortKeyByteSink::Resize(int32_t appendCapacity, int32_t length) {
+    filter(buffer, length);
+    appended_ = 0;
+    return appendCapacity <= capacity_;
+}
+
+void
+CompactSortKeyByteSink::filter(const char *bytes, int32_t n) {
+    fullLength_ += n;
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(bytes);
+    const uint8_t *limit = p + n;
+    while(p < limit) {
+        uint8_t b = *p++;
+        if(b <= Collation::LEVEL_SEPARATOR_BYTE) {
+            // Terminator or level separator.
+            if(!truncated_) {
+                put(b);
+                levelLength_ = 0;
+            } else if(b == Collation::TERMINATOR_BYTE) {
+                put(b);
+            }
+            continue;
+        }
+        if(truncated_) { continue; }
+        // Copy the run of level bytes up to the next separator or terminator,
+        // or up to the level length limit.
+        const uint8_t *runStart = p - 1;
+        while(p < limit && *p > Collation::LEVEL_SEPARATOR_BYTE) { ++p; }
+        int32_t runLength = (int32_t)(p - runStart);
+        if(levelLength_ >= 0 && maxLevelLength_ > 0) {
+            if((levelLength_ + runLength) > maxLevelLength_) {
+                runLength = maxLevelLength_ - levelLength_;
+                truncated_ = TRUE;
+            }
+            levelLength_ += runLength;
+        }
+        if(runLength > 0) {
+            int32_t available = destCapacity_ - destLength_;
+            if(available > 0) {
+                uprv_memcpy(dest_ + destLength_, runStart,
+                            runLength <= available ? runLength : available);
+            }
+            destLength_ += runLength;
+        }
+        if(truncated_) { put(TRUNCATION_MARKER); }
+    }
+}
+
+int32_t
+addToStats(int32_t length, int32_t fullLength, UBool truncated,
+           UCollationKeyStats *stats, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(stats != NULL) {
+        ++stats->keyCount;
+        stats->totalLength += length;
+        stats->fullLength += fullLength;
+        if(length > stats->maxLength) {
+            stats->maxLength = length;
+        }
+        if(truncated) {
+            ++stats->truncatedCount;
+        }
+    }
+    return length;
+}
+
+int32_t
+finishCompactSortKey(CompactSortKeyByteSink &sink, UCollationKeyStats *stats,
+                     UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return 0; }
+    int32_t length = sink.finish();
+    return addToStats(length, sink.getFullLength(), sink.isTruncated(), stats, errorCode);
+}
+
 }  // namespace
 
 // Not in an anonymous namespace, so that it can be a friend of CollationKey.
@@ -692,6 +881,9 @@ RuleBasedCollator::setFastLatinOptions(CollationSettings &ownedSettings) const {
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
             data, ownedSettings,
             ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastLatin::getScriptOptions(
+            data, ownedSettings,
+            ownedSettings.fastScriptOptions, UPRV_LENGTHOF(ownedSettings.fastScriptOptions));
 }
 
 UCollationResult
@@ -960,6 +1152,12 @@ UCollationResult compareNFDIter(const Normalizer2Impl &nfcImpl,
     return UCOL_EQUAL;
 }
 
+/**
+ * Passed as the primaries to the CollationFastLatin script tables:
+ * All characters are looked up in the table itself.
+ */
+const uint16_t noFastPrimaries[CollationFastLatin::LATIN_LIMIT] = { 0 };
+
 }  // namespace
 
 UCollationResult
@@ -1017,25 +1215,41 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
         // so that prefix matches back into the equal prefix work.
     }
 
+    // Use the fast Latin table if both strings continue with Latin characters,
+    // otherwise try the script table for the first differing character.
+    int32_t lc = equalPrefixLength == leftLength ? -1 : left[equalPrefixLength];
+    int32_t rc = equalPrefixLength == rightLength ? -1 : right[equalPrefixLength];
+    const uint16_t *fastTable = NULL;
+    const uint16_t *fastPrimaries = NULL;
+    int32_t fastOptions = -1;
+    if(lc <= CollationFastLatin::LATIN_MAX && rc <= CollationFastLatin::LATIN_MAX) {
+        fastTable = data->fastLatinTable;
+        fastPrimaries = settings->fastLatinPrimaries;
+        fastOptions = settings->fastLatinOptions;
+    } else {
+        int32_t i = lc < 0 ? -1 : CollationFastLatin::getScriptTableIndex(lc);
+        if(i < 0 && rc >= 0) { i = CollationFastLatin::getScriptTableIndex(rc); }
+        if(i >= 0) {
+            fastTable = data->fastScriptTables[i];
+            fastPrimaries = noFastPrimaries;
+            fastOptions = settings->fastScriptOptions[i];
+        }
+    }
+
     int32_t result;
-    int32_t fastLatinOptions = settings->fastLatinOptions;
-    if(fastLatinOptions >= 0 &&
-            (equalPrefixLength == leftLength ||
-                left[equalPrefixLength] <= CollationFastLatin::LATIN_MAX) &&
-            (equalPrefixLength == rightLength ||
-                right[equalPrefixLength] <= CollationFastLatin::LATIN_MAX)) {
+    if(fastOptions >= 0) {
         if(leftLength >= 0) {
-            result = CollationFastLatin::compareUTF16(data->fastLatinTable,
-                                                      settings->fastLatinPrimaries,
-                                                      fastLatinOptions,
+            result = CollationFastLatin::compareUTF16(fastTable,
+                                                      fastPrimaries,
+                                                      fastOptions,
                                                       left + equalPrefixLength,
                                                       leftLength - equalPrefixLength,
                                                       right + equalPrefixLength,
                                                       rightLength - equalPrefixLength);
         } else {
-            result = CollationFastLatin::compareUTF16(data->fastLatinTable,
-                                                      settings->fastLatinPrimaries,
-                                                      fastLatinOptions,
+            result = CollationFastLatin::compareUTF16(fastTable,
+                                                      fastPrimaries,
+                                                      fastOptions,
                                                       left + equalPrefixLength, -1,
                                                       right + equalPrefixLength, -1);
         }
@@ -1146,25 +1360,42 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
         // so that prefix matches back into the equal prefix work.
     }
 
+    // Use the fast Latin table if both strings continue with Latin lead bytes,
+    // otherwise try the script table for the first differing lead byte.
+    int32_t lc = equalPrefixLength == leftLength ? -1 : left[equalPrefixLength];
+    int32_t rc = equalPrefixLength == rightLength ? -1 : right[equalPrefixLength];
+    const uint16_t *fastTable = NULL;
+    const uint16_t *fastPrimaries = NULL;
+    int32_t fastOptions = -1;
+    if(lc <= CollationFastLatin::LATIN_MAX_UTF8_LEAD &&
+            rc <= CollationFastLatin::LATIN_MAX_UTF8_LEAD) {
+        fastTable = data->fastLatinTable;
+        fastPrimaries = settings->fastLatinPrimaries;
+        fastOptions = settings->fastLatinOptions;
+    } else {
+        int32_t i = lc < 0 ? -1 : CollationFastLatin::getScriptTableIndexUTF8(lc);
+        if(i < 0 && rc >= 0) { i = CollationFastLatin::getScriptTableIndexUTF8(rc); }
+        if(i >= 0) {
+            fastTable = data->fastScriptTables[i];
+            fastPrimaries = noFastPrimaries;
+            fastOptions = settings->fastScriptOptions[i];
+        }
+    }
+
     int32_t result;
-    int32_t fastLatinOptions = settings->fastLatinOptions;
-    if(fastLatinOptions >= 0 &&
-            (equalPrefixLength == leftLength ||
-                left[equalPrefixLength] <= CollationFastLatin::LATIN_MAX_UTF8_LEAD) &&
-            (equalPrefixLength == rightLength ||
-                right[equalPrefixLength] <= CollationFastLatin::LATIN_MAX_UTF8_LEAD)) {
+    if(fastOptions >= 0) {
         if(leftLength >= 0) {
-            result = CollationFastLatin::compareUTF8(data->fastLatinTable,
-                                                     settings->fastLatinPrimaries,
-                                                     fastLatinOptions,
+            result = CollationFastLatin::compareUTF8(fastTable,
+                                                     fastPrimaries,
+                                                     fastOptions,
                                                      left + equalPrefixLength,
                                                      leftLength - equalPrefixLength,
                                                      right + equalPrefixLength,
                                                      rightLength - equalPrefixLength);
         } else {
-            result = CollationFastLatin::compareUTF8(data->fastLatinTable,
-                                                     settings->fastLatinPrimaries,
-                                                     fastLatinOptions,
+            result = CollationFastLatin::compareUTF8(fastTable,
+                                                     fastPrimaries,
+                                                     fastOptions,
                                                      left + equalPrefixLength, -1,
                                                      right + equalPrefixLength, -1);
         }
@@ -1291,7 +1522,7 @@ RuleBasedCollator::getCollationKey(const UChar *s, int32_t length, CollationKey&
     }
     key.reset();  // resets the "bogus" state
     CollationKeyByteSink sink(key);
-    writeSortKey(s, length, sink, errorCode);
+    writeSortKey(s, length, settings->getStrength(), sink, errorCode);
     if(U_FAILURE(errorCode)) {
         key.setToBogus();
     } else if(key.isBogus()) {
@@ -1322,12 +1553,35 @@ RuleBasedCollator::getSortKey(const UChar *s, int32_t length,
     }
     FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
     UErrorCode errorCode = U_ZERO_ERROR;
-    writeSortKey(s, length, sink, errorCode);
+    writeSortKey(s, length, settings->getStrength(), sink, errorCode);
+    return U_SUCCESS(errorCode) ? sink.NumberOfBytesAppended() : 0;
+}
+
+int32_t
+RuleBasedCollator::getSortKeyUTF8(const char *s, int32_t length,
+                                  uint8_t *dest, int32_t capacity,
+                                  UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if((s == NULL && length != 0) || length < -1 ||
+            capacity < 0 || (dest == NULL && capacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) {
+        dest = noDest;
+    }
+    static const char empty = 0;
+    if(s == NULL) { s = &empty; }
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
+    UnicodeString s16;  // only used for the identical level
+    writeSortKey(reinterpret_cast<const uint8_t *>(s), length, settings->getStrength(), s16,
+                 sink, errorCode);
     return U_SUCCESS(errorCode) ? sink.NumberOfBytesAppended() : 0;
 }
 
 void
-RuleBasedCollator::writeSortKey(const UChar *s, int32_t length,
+RuleBasedCollator::writeSortKey(const UChar *s, int32_t length, int32_t strength,
                                 SortKeyByteSink &sink, UErrorCode &errorCode) const {
     if(U_FAILURE(errorCode)) { return; }
     const UChar *limit = (length >= 0) ? s + length : NULL;
@@ -1336,21 +1590,244 @@ RuleBasedCollator::writeSortKey(const UChar *s, int32_t length,
     if(settings->dontCheckFCD()) {
         UTF16CollationIterator iter(data, numeric, s, s, limit);
         CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
-                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  strength, sink, Collation::PRIMARY_LEVEL,
                                                   callback, TRUE, errorCode);
     } else {
         FCDUTF16CollationIterator iter(data, numeric, s, s, limit);
         CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
-                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  strength, sink, Collation::PRIMARY_LEVEL,
                                                   callback, TRUE, errorCode);
     }
-    if(settings->getStrength() == UCOL_IDENTICAL) {
+    if(strength == UCOL_IDENTICAL) {
         writeIdenticalLevel(s, limit, sink, errorCode);
     }
     static const char terminator = 0;  // TERMINATOR_BYTE
     sink.Append(&terminator, 1);
 }
 
+void
+RuleBasedCollator::writeSortKey(const uint8_t *s, int32_t length, int32_t strength,
+                                UnicodeString &s16,
+                                SortKeyByteSink &sink, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return; }
+    UBool numeric = settings->isNumeric();
+    CollationKeys::LevelCallback callback;
+    if(settings->dontCheckFCD()) {
+        UTF8CollationIterator iter(data, numeric, s, 0, length);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  strength, sink, Collation::PRIMARY_LEVEL,
+                                                  callback, TRUE, errorCode);
+    } else {
+        FCDUTF8CollationIterator iter(data, numeric, s, 0, length);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  strength, sink, Collation::PRIMARY_LEVEL,
+                                                  callback, TRUE, errorCode);
+    }
+    if(strength == UCOL_IDENTICAL) {
+        // The identical level is defined on the NFD form of the UTF-16 string.
+        if(length < 0) {
+            length = (int32_t)uprv_strlen(reinterpret_cast<const char *>(s));
+        }
+        // The UTF-16 string is never longer than the UTF-8 one.
+        UChar *buffer = s16.getBuffer(length > 0 ? length : 1);
+        if(buffer == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        int32_t length16 = 0;
+        u_strFromUTF8WithSub(buffer, s16.getCapacity(), &length16,
+                             reinterpret_cast<const char *>(s), length,
+                             0xfffd, NULL, &errorCode);
+        s16.releaseBuffer(U_SUCCESS(errorCode) ? length16 : 0);
+        if(U_FAILURE(errorCode)) { return; }
+        const UChar *s16Array = s16.getBuffer();
+        writeIdenticalLevel(s16Array, s16Array + s16.length(), sink, errorCode);
+    }
+    static const char terminator = 0;  // TERMINATOR_BYTE
+    sink.Append(&terminator, 1);
+}
+
+int32_t
+RuleBasedCollator::getSortKeys(const UChar *const sources[], const int32_t sourceLengths[],
+                               int32_t count,
+                               uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                               UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(count < 0 || (sources == NULL && count > 0) || offsets == NULL ||
+            resultCapacity < 0 || (result == NULL && resultCapacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(result == NULL) {
+        result = noDest;
+    }
+    // One sink for the whole batch: Each key is appended right after the previous one,
+    // and the sink keeps counting beyond the capacity for preflighting.
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(result), resultCapacity);
+    static const UChar empty = 0;
+    for(int32_t i = 0; i < count; ++i) {
+        const UChar *s = sources[i];
+        int32_t length = sourceLengths != NULL ? sourceLengths[i] : -1;
+        if(s == NULL) {
+            if(length != 0) {
+                errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+                return 0;
+            }
+            s = &empty;
+        }
+        offsets[i] = sink.NumberOfBytesAppended();
+        writeSortKey(s, length, settings->getStrength(), sink, errorCode);
+        if(U_FAILURE(errorCode)) { return 0; }
+    }
+    int32_t totalLength = sink.NumberOfBytesAppended();
+    offsets[count] = totalLength;
+    if(totalLength > resultCapacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return totalLength;
+}
+
+int32_t
+RuleBasedCollator::getSortKeysUTF8(const char *const sources[], const int32_t sourceLengths[],
+                                   int32_t count,
+                                   uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                                   UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(count < 0 || (sources == NULL && count > 0) || offsets == NULL ||
+            resultCapacity < 0 || (result == NULL && resultCapacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(result == NULL) {
+        result = noDest;
+    }
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(result), resultCapacity);
+    UnicodeString s16;
+    static const uint8_t empty = 0;
+    for(int32_t i = 0; i < count; ++i) {
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(sources[i]);
+        int32_t length = sourceLengths != NULL ? sourceLengths[i] : -1;
+        if(s == NULL) {
+            if(length != 0) {
+                errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+                return 0;
+            }
+            s = &empty;
+        }
+        offsets[i] = sink.NumberOfBytesAppended();
+        writeSortKey(s, length, settings->getStrength(), s16, sink, errorCode);
+        if(U_FAILURE(errorCode)) { return 0; }
+    }
+    int32_t totalLength = sink.NumberOfBytesAppended();
+    offsets[count] = totalLength;
+    if(totalLength > resultCapacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return totalLength;
+}
+
+uint64_t
+RuleBasedCollator::getCollationHash(const UChar *s, int32_t length,
+                                    UColAttributeValue strength, UErrorCode &errorCode) const {
+    int32_t effectiveStrength = checkHashArgs(s, length, strength, errorCode);
+    if(U_FAILURE(errorCode)) { return 0; }
+    static const UChar empty = 0;
+    if(s == NULL) { s = &empty; }
+    HashSortKeyByteSink sink;
+    writeSortKey(s, length, effectiveStrength, sink, errorCode);
+    return U_SUCCESS(errorCode) ? sink.getHash() : 0;
+}
+
+uint64_t
+RuleBasedCollator::getCollationHashUTF8(const char *s, int32_t length,
+                                        UColAttributeValue strength, UErrorCode &errorCode) const {
+    int32_t effectiveStrength = checkHashArgs(s, length, strength, errorCode);
+    if(U_FAILURE(errorCode)) { return 0; }
+    static const char empty = 0;
+    if(s == NULL) { s = &empty; }
+    HashSortKeyByteSink sink;
+    UnicodeString s16;
+    writeSortKey(reinterpret_cast<const uint8_t *>(s), length, effectiveStrength, s16,
+                 sink, errorCode);
+    return U_SUCCESS(errorCode) ? sink.getHash() : 0;
+}
+
+int32_t
+RuleBasedCollator::checkHashArgs(const void *s, int32_t length,
+                                 UColAttributeValue strength, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if((s == NULL && length != 0) || length < -1) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if(strength == UCOL_DEFAULT) {
+        return settings->getStrength();
+    }
+    if((UCOL_PRIMARY <= strength && strength <= UCOL_QUATERNARY) ||
+            strength == UCOL_IDENTICAL) {
+        return strength;
+    }
+    errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+    return 0;
+}
+
+int32_t
+RuleBasedCollator::getCompactSortKey(const UChar *s, int32_t length,
+                                     UColAttributeValue strength, int32_t maxLevelLength,
+                                     uint8_t *dest, int32_t capacity,
+                                     UCollationKeyStats *stats, UErrorCode &errorCode) const {
+    int32_t effectiveStrength = checkHashArgs(s, length, strength, errorCode);
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(capacity < 0 || (dest == NULL && capacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    static const UChar empty = 0;
+    if(s == NULL) { s = &empty; }
+    if(maxLevelLength <= 0) {
+        // Nothing to filter.
+        uint8_t noDest[1] = { 0 };
+        FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest != NULL ? dest : noDest), capacity);
+        writeSortKey(s, length, effectiveStrength, sink, errorCode);
+        return addToStats(sink.NumberOfBytesAppended(), sink.NumberOfBytesAppended(), FALSE,
+                          stats, errorCode);
+    }
+    CompactSortKeyByteSink sink(dest, capacity, maxLevelLength);
+    writeSortKey(s, length, effectiveStrength, sink, errorCode);
+    return finishCompactSortKey(sink, stats, errorCode);
+}
+
+int32_t
+RuleBasedCollator::getCompactSortKeyUTF8(const char *s, int32_t length,
+                                         UColAttributeValue strength, int32_t maxLevelLength,
+                                         uint8_t *dest, int32_t capacity,
+                                         UCollationKeyStats *stats, UErrorCode &errorCode) const {
+    int32_t effectiveStrength = checkHashArgs(s, length, strength, errorCode);
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(capacity < 0 || (dest == NULL && capacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    static const char empty = 0;
+    if(s == NULL) { s = &empty; }
+    UnicodeString s16;  // only used for the identical level
+    if(maxLevelLength <= 0) {
+        // Nothing to filter.
+        uint8_t noDest[1] = { 0 };
+        FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest != NULL ? dest : noDest), capacity);
+        writeSortKey(reinterpret_cast<const uint8_t *>(s), length, effectiveStrength, s16,
+                     sink, errorCode);
+        return addToStats(sink.NumberOfBytesAppended(), sink.NumberOfBytesAppended(), FALSE,
+                          stats, errorCode);
+    }
+    CompactSortKeyByteSink sink(dest, capacity, maxLevelLength);
+    writeSortKey(reinterpret_cast<const uint8_t *>(s), length, effectiveStrength, s16,
+                 sink, errorCode);
+    return finishCompactSortKey(sink, stats, errorCode);
+}
+
 void
 RuleBasedCollator::writeIdenticalLevel(const UChar *s, const UChar *limit,
                                        SortKeyByteSink &sink, UErrorCode &errorCode) const {
@@ -1507,6 +1984,35 @@ RuleBasedCollator::internalGetCEs(const UnicodeString &str, UVector64 &ces,
     }
 }
 
+UBool
+RuleBasedCollator::internalIsContextFree(UChar32 c) const {
+    // The unsafe-backward set contains all non-starters of contractions,
+    // and the FCD check excludes characters that may be reordered or decomposed
+    // together with their neighbors.
+    if(data->isUnsafeBackward(c, settings->isNumeric()) || data->getFCD16(c) != 0) {
+        return FALSE;
+    }
+    const CollationData *d = data;
+    uint32_t ce32 = d->getCE32(c);
+    if(ce32 == Collation::FALLBACK_CE32) {
+        d = d->base;
+        ce32 = d->getCE32(c);
+    }
+    if(!Collation::isSpecialCE32(ce32)) { return TRUE; }
+    switch(Collation::tagFromCE32(ce32)) {
+    case Collation::BUILDER_DATA_TAG:
+    case Collation::PREFIX_TAG:
+    case Collation::CONTRACTION_TAG:
+    case Collation::U0000_TAG:
+    case Collation::LEAD_SURROGATE_TAG:
+        return FALSE;
+    case Collation::DIGIT_TAG:
+        return !settings->isNumeric();
+    default:
+        return TRUE;
+    }
+}
+
 namespace {
 
 void appendSubtag(CharString &s, char letter, const char *subtag, int32_t length,
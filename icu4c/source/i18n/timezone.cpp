@@ -85,6 +85,7 @@ static char gStrBuf[256];
 #include "unicode/strenum.h"
 #include "uassert.h"
 #include "zonemeta.h"
+#include "unifiedcache.h"
 
 #define kZONEINFO "zoneinfo64"
 #define kREGIONS  "Regions"
@@ -373,22 +374,86 @@ TimeZone::operator==(const TimeZone& that) const
 
 // -------------------------------------
 
-namespace {
-TimeZone*
-createSystemTimeZone(const UnicodeString& id, UErrorCode& ec) {
+/**
+ * A system time zone loaded from zoneinfo64, shared through the UnifiedCache.
+ * Its transition data aliases the resource bundle data, so a clone
+ * only has to copy a few pointers and the final SimpleTimeZone.
+ */
+class SharedOlsonTimeZone : public SharedObject {
+public:
+    SharedOlsonTimeZone(OlsonTimeZone *tzToAdopt) : ptr(tzToAdopt) { }
+    virtual ~SharedOlsonTimeZone();
+    const OlsonTimeZone *get() const { return ptr; }
+    virtual int32_t getApproximateSize() const {
+        return (int32_t)(sizeof(*this) + sizeof(OlsonTimeZone) + sizeof(SimpleTimeZone));
+    }
+private:
+    OlsonTimeZone *ptr;
+    SharedOlsonTimeZone(const SharedOlsonTimeZone &);
+    SharedOlsonTimeZone &operator=(const SharedOlsonTimeZone &);
+};
+
+SharedOlsonTimeZone::~SharedOlsonTimeZone() {
+    delete ptr;
+}
+
+/**
+ * Cache key for a system time zone: the zone ID as passed to createTimeZone().
+ * The ID is not canonicalized because the resulting time zone keeps it,
+ * and because links like EST5EDT do not always have the same data
+ * as the zone that CLDR maps them to.
+ */
+class SystemTimeZoneKey : public CacheKey<SharedOlsonTimeZone> {
+public:
+    SystemTimeZoneKey(const UnicodeString &id) : fID(id) { }
+    SystemTimeZoneKey(const SystemTimeZoneKey &other)
+            : CacheKey<SharedOlsonTimeZone>(other), fID(other.fID) { }
+    virtual ~SystemTimeZoneKey();
+    virtual int32_t hashCode() const {
+        return 37 * CacheKey<SharedOlsonTimeZone>::hashCode() + fID.hashCode();
+    }
+    virtual UBool operator==(const CacheKeyBase &other) const {
+        if (this == &other) {
+            return TRUE;
+        }
+        if (!CacheKey<SharedOlsonTimeZone>::operator==(other)) {
+            return FALSE;
+        }
+        // We know that this and other are of same class if we get this far.
+        return fID == static_cast<const SystemTimeZoneKey &>(other).fID;
+    }
+    virtual CacheKeyBase *clone() const {
+        return new SystemTimeZoneKey(*this);
+    }
+    virtual char *writeDescription(char *buffer, int32_t bufLen) const {
+        fID.extract(0, fID.length(), buffer, bufLen, US_INV);
+        buffer[bufLen - 1] = 0;
+        return buffer;
+    }
+    virtual const SharedOlsonTimeZone *createObject(
+            const void * /*unused*/, UErrorCode &status) const;
+private:
+    UnicodeString fID;
+};
+
+SystemTimeZoneKey::~SystemTimeZoneKey() { }
+
+const SharedOlsonTimeZone *
+SystemTimeZoneKey::createObject(const void * /*unused*/, UErrorCode &ec) const {
     if (U_FAILURE(ec)) {
         return NULL;
     }
-    TimeZone* z = 0;
+    OlsonTimeZone* z = 0;
     UResourceBundle res;
     ures_initStackObject(&res);
     U_DEBUG_TZ_MSG(("pre-err=%s\n", u_errorName(ec)));
-    UResourceBundle *top = openOlsonResource(id, res, ec);
+    UResourceBundle *top = openOlsonResource(fID, res, ec);
     U_DEBUG_TZ_MSG(("post-err=%s\n", u_errorName(ec)));
     if (U_SUCCESS(ec)) {
-        z = new OlsonTimeZone(top, &res, id, ec);
+        z = new OlsonTimeZone(top, &res, fID, ec);
         if (z == NULL) {
           U_DEBUG_TZ_MSG(("cstz: olson time zone failed to initialize - err %s\n", u_errorName(ec)));
+          ec = U_MEMORY_ALLOCATION_ERROR;
         }
     }
     ures_close(&res);
@@ -396,7 +461,41 @@ createSystemTimeZone(const UnicodeString& id, UErrorCode& ec) {
     if (U_FAILURE(ec)) {
         U_DEBUG_TZ_MSG(("cstz: failed to create, err %s\n", u_errorName(ec)));
         delete z;
-        z = 0;
+        return NULL;
+    }
+    SharedOlsonTimeZone *result = new SharedOlsonTimeZone(z);
+    if (result == NULL) {
+        delete z;
+        ec = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    result->addRef();
+    return result;
+}
+
+namespace {
+/**
+ * Returns a clone of the cached system time zone with this ID,
+ * loading it on a cache miss.
+ */
+TimeZone*
+createSystemTimeZone(const UnicodeString& id, UErrorCode& ec) {
+    if (U_FAILURE(ec)) {
+        return NULL;
+    }
+    const UnifiedCache *cache = UnifiedCache::getInstance(ec);
+    if (U_FAILURE(ec)) {
+        return NULL;
+    }
+    const SharedOlsonTimeZone *shared = NULL;
+    cache->get(SystemTimeZoneKey(id), shared, ec);
+    if (U_FAILURE(ec)) {
+        return NULL;
+    }
+    TimeZone* z = shared->get()->clone();
+    shared->removeRef();
+    if (z == NULL) {
+        ec = U_MEMORY_ALLOCATION_ERROR;
     }
     return z;
 }
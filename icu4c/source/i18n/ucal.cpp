@@ -772,6 +772,28 @@ ucal_getTimeZoneTransitionDate(const UCalendar* cal, UTimeZoneTransitionType typ
     return FALSE;
 }
 
+U_CAPI void U_EXPORT2
+ucal_getTimeZoneOffsets(const UCalendar* cal, const UDate* dates, int32_t count,
+                        int32_t* rawOffsets, int32_t* dstOffsets, UErrorCode* status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    if (count < 0 || (count > 0 && (dates == NULL || rawOffsets == NULL || dstOffsets == NULL))) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const TimeZone& tz = ((const Calendar*)cal)->getTimeZone();
+    const BasicTimeZone * btz = dynamic_cast<const BasicTimeZone *>(&tz);
+    if (btz != NULL) {
+        btz->getOffsets(dates, count, rawOffsets, dstOffsets, *status);
+    } else {
+        for (int32_t i = 0; i < count && U_SUCCESS(*status); ++i) {
+            tz.getOffset(dates[i], FALSE, rawOffsets[i], dstOffsets[i], *status);
+        }
+    }
+}
+
 U_CAPI int32_t U_EXPORT2
 ucal_getWindowsTimeZoneID(const UChar* id, int32_t len, UChar* winid, int32_t winidCapacity, UErrorCode* status) {
     if (U_FAILURE(*status)) {
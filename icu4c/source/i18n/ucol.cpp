@@ -206,6 +206,215 @@ ucol_getSortKey(const    UCollator    *coll,
     return keySize;
 }
 
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeyUTF8(const UCollator *coll,
+                    const char *source, int32_t sourceLength,
+                    uint8_t *result, int32_t resultLength,
+                    UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getSortKeyUTF8(source, sourceLength, result, resultLength, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const sources[], const int32_t sourceLengths[],
+                 int32_t count,
+                 uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                 UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getSortKeys(sources, sourceLengths, count,
+                            result, resultCapacity, offsets, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const sources[], const int32_t sourceLengths[],
+                     int32_t count,
+                     uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                     UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getSortKeysUTF8(sources, sourceLengths, count,
+                                result, resultCapacity, offsets, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar *const strings[], const int32_t lengths[], int32_t count,
+                 int32_t order[], UBool stable,
+                 UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->sort(strings, lengths, count, order, stable, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char *const strings[], const int32_t lengths[], int32_t count,
+                     int32_t order[], UBool stable,
+                     UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->sortUTF8(strings, lengths, count, order, stable, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortStringRange(const UCollator *coll,
+                     const UChar *const strings[], const int32_t lengths[],
+                     int32_t start, int32_t limit,
+                     int32_t order[], UBool stable,
+                     UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->sortRange(strings, lengths, start, limit,
+                                             order, stable, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortStringRangeUTF8(const UCollator *coll,
+                         const char *const strings[], const int32_t lengths[],
+                         int32_t start, int32_t limit,
+                         int32_t order[], UBool stable,
+                         UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->sortRangeUTF8(strings, lengths, start, limit,
+                                                 order, stable, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_mergeSortedPermutations(const UCollator *coll,
+                             const UChar *const strings[], const int32_t lengths[],
+                             const int32_t order1[], int32_t length1,
+                             const int32_t order2[], int32_t length2,
+                             int32_t dest[], UBool stable,
+                             UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->mergeSorted(strings, lengths, order1, length1,
+                                               order2, length2, dest, stable, *status);
+}
+
+U_CAPI void U_EXPORT2
+ucol_mergeSortedPermutationsUTF8(const UCollator *coll,
+                                 const char *const strings[], const int32_t lengths[],
+                                 const int32_t order1[], int32_t length1,
+                                 const int32_t order2[], int32_t length2,
+                                 int32_t dest[], UBool stable,
+                                 UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return;
+    }
+    Collator::fromUCollator(coll)->mergeSortedUTF8(strings, lengths, order1, length1,
+                                                   order2, length2, dest, stable, *status);
+}
+
+U_CAPI uint64_t U_EXPORT2
+ucol_getCollationHash(const UCollator *coll,
+                      const UChar *source, int32_t length,
+                      UColAttributeValue strength,
+                      UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getCollationHash(source, length, strength, *status);
+}
+
+U_CAPI uint64_t U_EXPORT2
+ucol_getCollationHashUTF8(const UCollator *coll,
+                          const char *source, int32_t length,
+                          UColAttributeValue strength,
+                          UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getCollationHashUTF8(source, length, strength, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getCompactSortKey(const UCollator *coll,
+                       const UChar *source, int32_t sourceLength,
+                       UColAttributeValue strength, int32_t maxLevelLength,
+                       uint8_t *result, int32_t resultLength,
+                       UCollationKeyStats *stats, UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getCompactSortKey(source, sourceLength, strength, maxLevelLength,
+                                  result, resultLength, stats, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getCompactSortKeyUTF8(const UCollator *coll,
+                           const char *source, int32_t sourceLength,
+                           UColAttributeValue strength, int32_t maxLevelLength,
+                           uint8_t *result, int32_t resultLength,
+                           UCollationKeyStats *stats, UErrorCode *status)
+{
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getCompactSortKeyUTF8(source, sourceLength, strength, maxLevelLength,
+                                      result, resultLength, stats, *status);
+}
+
 U_CAPI int32_t U_EXPORT2
 ucol_nextSortKeyPart(const UCollator *coll,
                      UCharIterator *iter,
@@ -268,6 +268,42 @@ public:
          */
         int32_t getBucketIndex(const UnicodeString &name, UErrorCode &errorCode) const;
 
+#ifndef U_HIDE_DRAFT_API
+        /**
+         * Creates an immutable index for the specified locale.
+         * Equivalent to AlphabeticIndex(locale, errorCode).buildImmutableIndex(errorCode)
+         * but the bucket structure is computed only once per locale
+         * and shared among the immutable indexes for that locale.
+         *
+         * @param locale the desired locale
+         * @param errorCode Standard ICU error code. Its input value must
+         *                  pass the U_SUCCESS() test, or else the function returns
+         *                  immediately. Check for U_FAILURE() on output or use with
+         *                  function chaining. (See User Guide for details.)
+         * @return an immutable index for the locale; the caller owns it
+         * @draft ICU 57
+         */
+        static ImmutableIndex *createInstance(const Locale &locale, UErrorCode &errorCode);
+
+        /**
+         * Finds the index buckets for an array of names.
+         * Sets indexes[i] to the same value as getBucketIndex(names[i], errorCode).
+         * Faster than calling getBucketIndex() for each name,
+         * especially when the names are sorted.
+         *
+         * @param names the strings to be sorted into index buckets
+         * @param count the number of names
+         * @param indexes output array of count bucket numbers
+         * @param errorCode Standard ICU error code. Its input value must
+         *                  pass the U_SUCCESS() test, or else the function returns
+         *                  immediately. Check for U_FAILURE() on output or use with
+         *                  function chaining. (See User Guide for details.)
+         * @draft ICU 57
+         */
+        void getBucketIndexes(const UnicodeString names[], int32_t count, int32_t indexes[],
+                              UErrorCode &errorCode) const;
+#endif  /* U_HIDE_DRAFT_API */
+
         /**
          * Returns the index-th bucket. Returns NULL if the index is out of range.
          *
@@ -280,10 +316,11 @@ public:
     private:
         friend class AlphabeticIndex;
 
-        ImmutableIndex(BucketList *bucketList, Collator *collatorPrimaryOnly)
+        ImmutableIndex(const BucketList *bucketList, Collator *collatorPrimaryOnly)
                 : buckets_(bucketList), collatorPrimaryOnly_(collatorPrimaryOnly) {}
 
-        BucketList *buckets_;
+        /** Shared; the ImmutableIndex holds one reference. */
+        const BucketList *buckets_;
         Collator *collatorPrimaryOnly_;
     };
 
@@ -682,6 +719,8 @@ private:
      * and sort differently, and that the overall list is small enough.
      */
     void initLabels(UVector &indexCharacters, UErrorCode &errorCode) const;
+    friend class BucketList;
+
     BucketList *createBucketList(UErrorCode &errorCode) const;
     void initBuckets(UErrorCode &errorCode);
     void clearBuckets();
@@ -141,6 +141,23 @@ public:
         AnnualTimeZoneRule*& std, AnnualTimeZoneRule*& dst, UErrorCode& status) const;
 
 
+    /**
+     * Gets the raw and daylight saving time offsets for many dates at once.
+     * The result is the same as calling
+     * <code>getOffset(dates[i], FALSE, rawOffsets[i], dstOffsets[i], status)</code>
+     * for each date, but it is faster when consecutive dates are close
+     * together, especially when they are sorted in ascending order:
+     * dates between two transitions share the offsets looked up for the first one.
+     * @param dates       An array of count dates in UTC, in any order.
+     * @param count       The number of dates.
+     * @param rawOffsets  Receives count raw GMT offsets in milliseconds.
+     * @param dstOffsets  Receives count daylight saving offsets in milliseconds.
+     * @param status      Receives error status code.
+     * @draft ICU 57
+     */
+    virtual void getOffsets(const UDate dates[], int32_t count,
+        int32_t rawOffsets[], int32_t dstOffsets[], UErrorCode& status) const;
+
 #ifndef U_HIDE_INTERNAL_API
     /**
      * The time type option bit flags used by getOffsetFromLocal
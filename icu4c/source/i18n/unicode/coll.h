@@ -1018,6 +1018,147 @@ public:
     virtual int32_t getSortKey(const UChar*source, int32_t sourceLength,
                                uint8_t*result, int32_t resultLength) const = 0;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Sorts an array of strings according to this Collator.
+     * The strings are not moved; instead, order[] receives their indexes
+     * in ascending collation order.
+     *
+     * This is much faster for large arrays than sorting with compare()
+     * as the comparison function:
+     * The strings are first radix-sorted on short sort key prefixes,
+     * and only strings with equal prefixes are compared in full.
+     *
+     * To sort a large array on several threads,
+     * see sortRange() and mergeSorted().
+     *
+     * @param strings array of count strings
+     * @param lengths array of count string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param count number of strings
+     * @param order receives the count string indexes in sorted order
+     * @param stable if TRUE, then strings that compare equal remain
+     *        in the order of their indexes
+     * @param errorCode ICU error code in/out parameter.
+     *        Must fulfill U_SUCCESS before the function call.
+     * @draft ICU 57
+     */
+    void sort(const UChar *const strings[], const int32_t lengths[], int32_t count,
+              int32_t order[], UBool stable, UErrorCode &errorCode) const;
+
+    /**
+     * Sorts an array of UTF-8 strings according to this Collator.
+     * Otherwise the same as the UTF-16 version of sort().
+     *
+     * @param strings array of count UTF-8 strings
+     * @param lengths array of count string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param count number of strings
+     * @param order receives the count string indexes in sorted order
+     * @param stable if TRUE, then strings that compare equal remain
+     *        in the order of their indexes
+     * @param errorCode ICU error code in/out parameter.
+     *        Must fulfill U_SUCCESS before the function call.
+     * @draft ICU 57
+     */
+    void sortUTF8(const char *const strings[], const int32_t lengths[], int32_t count,
+                  int32_t order[], UBool stable, UErrorCode &errorCode) const;
+
+    /**
+     * Sorts the strings with indexes start..limit-1 of an array.
+     * Otherwise the same as sort().
+     * order[] receives limit-start indexes, which are in the range [start, limit[.
+     * Separate ranges can be sorted concurrently and then combined with mergeSorted().
+     *
+     * @param strings array of strings; only strings[start..limit-1] are used
+     * @param lengths array of string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param start index of the first string to be sorted
+     * @param limit index after the last string to be sorted
+     * @param order receives the limit-start string indexes in sorted order
+     * @param stable if TRUE, then strings that compare equal remain
+     *        in the order of their indexes
+     * @param errorCode ICU error code in/out parameter.
+     *        Must fulfill U_SUCCESS before the function call.
+     * @see ucol_sortStringRange
+     * @draft ICU 57
+     */
+    void sortRange(const UChar *const strings[], const int32_t lengths[],
+                   int32_t start, int32_t limit,
+                   int32_t order[], UBool stable, UErrorCode &errorCode) const;
+
+    /**
+     * Sorts the UTF-8 strings with indexes start..limit-1 of an array.
+     * Otherwise the same as the UTF-16 version of sortRange().
+     *
+     * @param strings array of UTF-8 strings; only strings[start..limit-1] are used
+     * @param lengths array of string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param start index of the first string to be sorted
+     * @param limit index after the last string to be sorted
+     * @param order receives the limit-start string indexes in sorted order
+     * @param stable if TRUE, then strings that compare equal remain
+     *        in the order of their indexes
+     * @param errorCode ICU error code in/out parameter.
+     *        Must fulfill U_SUCCESS before the function call.
+     * @draft ICU 57
+     */
+    void sortRangeUTF8(const char *const strings[], const int32_t lengths[],
+                       int32_t start, int32_t limit,
+                       int32_t order[], UBool stable, UErrorCode &errorCode) const;
+
+    /**
+     * Merges two sorted index sequences of one string array,
+     * for example the outputs of sortRange() for two disjoint ranges,
+     * into one sorted sequence.
+     * The same stable setting must be used as for sorting the inputs.
+     *
+     * @param strings array of strings which are indexed by order1[] and order2[]
+     * @param lengths array of string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param order1 first sequence of string indexes in sorted order
+     * @param length1 number of indexes in order1
+     * @param order2 second sequence of string indexes in sorted order;
+     *        must not contain any of the indexes in order1
+     * @param length2 number of indexes in order2
+     * @param dest receives the length1+length2 indexes in sorted order;
+     *        must not overlap order1 or order2
+     * @param stable if TRUE, then strings that compare equal are ordered by their indexes
+     * @param errorCode ICU error code in/out parameter.
+     *        Must fulfill U_SUCCESS before the function call.
+     * @see ucol_sortStringRange
+     * @draft ICU 57
+     */
+    void mergeSorted(const UChar *const strings[], const int32_t lengths[],
+                     const int32_t order1[], int32_t length1,
+                     const int32_t order2[], int32_t length2,
+                     int32_t dest[], UBool stable, UErrorCode &errorCode) const;
+
+    /**
+     * Merges two sorted index sequences of one UTF-8 string array.
+     * Otherwise the same as the UTF-16 version of mergeSorted().
+     *
+     * @param strings array of UTF-8 strings which are indexed by order1[] and order2[]
+     * @param lengths array of string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param order1 first sequence of string indexes in sorted order
+     * @param length1 number of indexes in order1
+     * @param order2 second sequence of string indexes in sorted order;
+     *        must not contain any of the indexes in order1
+     * @param length2 number of indexes in order2
+     * @param dest receives the length1+length2 indexes in sorted order;
+     *        must not overlap order1 or order2
+     * @param stable if TRUE, then strings that compare equal are ordered by their indexes
+     * @param errorCode ICU error code in/out parameter.
+     *        Must fulfill U_SUCCESS before the function call.
+     * @draft ICU 57
+     */
+    void mergeSortedUTF8(const char *const strings[], const int32_t lengths[],
+                         const int32_t order1[], int32_t length1,
+                         const int32_t order2[], int32_t length2,
+                         int32_t dest[], UBool stable, UErrorCode &errorCode) const;
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Produce a bound for a given sortkey and a number of levels.
      * Return value is always the number of bytes needed, regardless of
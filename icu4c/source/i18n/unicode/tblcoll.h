@@ -647,6 +647,203 @@ public:
     virtual int32_t getSortKey(const UChar *source, int32_t sourceLength,
                                uint8_t *result, int32_t resultLength) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Get the sort key as an array of bytes from a UTF-8 string.
+     * The sort key is the same as for the string converted to UTF-16,
+     * with ill-formed sequences treated as U+FFFD,
+     * but it is computed directly from the UTF-8 text.
+     *
+     * Like getSortKey(), this returns the needed length and does not set
+     * an error code if the result buffer is too small;
+     * the buffer contents is then undefined.
+     *
+     * @param source UTF-8 string to be processed.
+     * @param sourceLength length of the string, or -1 if NUL-terminated.
+     * @param result buffer to store result in.
+     *        Can be NULL if resultLength==0 for pure preflighting.
+     * @param resultLength length of the result buffer.
+     * @param errorCode ICU error code in/out parameter.
+     * @return Number of bytes needed for storing the sort key
+     * @draft ICU 57
+     */
+    int32_t getSortKeyUTF8(const char *source, int32_t sourceLength,
+                           uint8_t *result, int32_t resultLength,
+                           UErrorCode &errorCode) const;
+
+    /**
+     * Writes the sort keys for an array of strings into one buffer.
+     * Key i occupies result[offsets[i]..offsets[i+1]-1] and includes its
+     * terminating zero byte, exactly like the output of getSortKey().
+     *
+     * This is faster than calling getSortKey() for each string
+     * because the per-call setup is shared by the whole batch.
+     *
+     * @param sources array of count strings
+     * @param sourceLengths array of count string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param count number of strings
+     * @param result buffer for the concatenated sort keys;
+     *        can be NULL if resultCapacity==0 for pure preflighting
+     * @param resultCapacity capacity of the result buffer
+     * @param offsets array of count+1 offsets into the result buffer,
+     *        set even when the buffer is too small; offsets[count] is the total length
+     * @param errorCode ICU error code in/out parameter.
+     *        Set to U_BUFFER_OVERFLOW_ERROR if the total length exceeds resultCapacity.
+     * @return total length of all sort keys
+     * @see ucol_getSortKeys
+     * @draft ICU 57
+     */
+    int32_t getSortKeys(const UChar *const sources[], const int32_t sourceLengths[],
+                        int32_t count,
+                        uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                        UErrorCode &errorCode) const;
+
+    /**
+     * Writes the sort keys for an array of UTF-8 strings into one buffer.
+     * Otherwise the same as the UTF-16 version of getSortKeys().
+     * Each sort key is the same as for the string converted to UTF-16,
+     * with ill-formed sequences treated as U+FFFD.
+     *
+     * @param sources array of count UTF-8 strings
+     * @param sourceLengths array of count string lengths, each -1 if that
+     *        string is NUL-terminated; or NULL if all strings are NUL-terminated
+     * @param count number of strings
+     * @param result buffer for the concatenated sort keys;
+     *        can be NULL if resultCapacity==0 for pure preflighting
+     * @param resultCapacity capacity of the result buffer
+     * @param offsets array of count+1 offsets into the result buffer,
+     *        set even when the buffer is too small; offsets[count] is the total length
+     * @param errorCode ICU error code in/out parameter.
+     *        Set to U_BUFFER_OVERFLOW_ERROR if the total length exceeds resultCapacity.
+     * @return total length of all sort keys
+     * @draft ICU 57
+     */
+    int32_t getSortKeysUTF8(const char *const sources[], const int32_t sourceLengths[],
+                            int32_t count,
+                            uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                            UErrorCode &errorCode) const;
+
+    /**
+     * Returns a 64-bit hash value for the string which is consistent with
+     * this collator at the given strength:
+     * Strings that compare equal at that strength get the same hash value.
+     * This can be used to put strings into hash tables, or to deduplicate them,
+     * without creating and storing their sort keys.
+     *
+     * The hash is computed from the sort key bytes as they are generated,
+     * without storing them.
+     * Hash values are not stable across ICU versions or collator settings;
+     * they must not be persisted.
+     *
+     * @param s the string
+     * @param length length of the string, or -1 if NUL-terminated
+     * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+     *        or UCOL_DEFAULT for this collator's strength
+     * @param errorCode ICU error code in/out parameter.
+     * @return the hash value
+     * @draft ICU 57
+     */
+    uint64_t getCollationHash(const UChar *s, int32_t length,
+                              UColAttributeValue strength, UErrorCode &errorCode) const;
+
+    /**
+     * Returns a 64-bit hash value for the UTF-8 string which is consistent with
+     * this collator at the given strength.
+     * Same as the UTF-16 version of getCollationHash() for the string
+     * converted to UTF-16, with ill-formed sequences treated as U+FFFD.
+     *
+     * @param s the UTF-8 string
+     * @param length length of the string, or -1 if NUL-terminated
+     * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+     *        or UCOL_DEFAULT for this collator's strength
+     * @param errorCode ICU error code in/out parameter.
+     * @return the hash value
+     * @draft ICU 57
+     */
+    uint64_t getCollationHashUTF8(const char *s, int32_t length,
+                                  UColAttributeValue strength, UErrorCode &errorCode) const;
+
+    /**
+     * Writes a compact sort key for a string, for space-efficient database indexes.
+     * The key contains only the levels up to the given strength.
+     * With maxLevelLength>0, each level after the primary level is limited
+     * to that many bytes; the first longer level is cut off and the key ends there.
+     *
+     * Compact keys compare consistently with this collator at the given strength:
+     * Different keys are in the order of their strings,
+     * and equal keys mean equal strings unless a key was truncated.
+     * See ucol_getCompactSortKey() for details.
+     *
+     * Like getSortKey(), this returns the needed length and does not set
+     * an error code if the result buffer is too small;
+     * the buffer contents is then undefined.
+     *
+     * @param s the string
+     * @param length length of the string, or -1 if NUL-terminated
+     * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+     *        or UCOL_DEFAULT for this collator's strength
+     * @param maxLevelLength maximum number of bytes per level after the primary level,
+     *        or 0 for no limit
+     * @param dest buffer to store the key in.
+     *        Can be NULL if capacity==0 for pure preflighting.
+     * @param capacity length of the dest buffer
+     * @param stats if not NULL, the key's size is added to these statistics
+     * @param errorCode ICU error code in/out parameter.
+     * @return Number of bytes needed for storing the compact sort key
+     * @draft ICU 57
+     */
+    int32_t getCompactSortKey(const UChar *s, int32_t length,
+                              UColAttributeValue strength, int32_t maxLevelLength,
+                              uint8_t *dest, int32_t capacity,
+                              UCollationKeyStats *stats, UErrorCode &errorCode) const;
+
+    /**
+     * Writes a compact sort key for a UTF-8 string.
+     * Otherwise the same as the UTF-16 version of getCompactSortKey().
+     *
+     * @param s the UTF-8 string
+     * @param length length of the string, or -1 if NUL-terminated
+     * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+     *        or UCOL_DEFAULT for this collator's strength
+     * @param maxLevelLength maximum number of bytes per level after the primary level,
+     *        or 0 for no limit
+     * @param dest buffer to store the key in.
+     *        Can be NULL if capacity==0 for pure preflighting.
+     * @param capacity length of the dest buffer
+     * @param stats if not NULL, the key's size is added to these statistics
+     * @param errorCode ICU error code in/out parameter.
+     * @return Number of bytes needed for storing the compact sort key
+     * @draft ICU 57
+     */
+    int32_t getCompactSortKeyUTF8(const char *s, int32_t length,
+                                  UColAttributeValue strength, int32_t maxLevelLength,
+                                  uint8_t *dest, int32_t capacity,
+                                  UCollationKeyStats *stats, UErrorCode &errorCode) const;
+
+    /**
+     * Returns a 64-bit key for a persistent cache of collators built from rules.
+     * A caller can store the output of cloneBinary() under this key,
+     * in memory or in a directory of files, and later reload it with
+     * ucol_openBinary() instead of building the collator from the rules again.
+     * See ucol_getRulesCacheKey() for how the key is computed.
+     *
+     * @param rules the collation rules
+     * @param strength the strength argument for building the collator,
+     *        or UCOL_DEFAULT
+     * @param decompositionMode the decomposition mode argument for building the collator,
+     *        or UCOL_DEFAULT
+     * @param errorCode ICU error code in/out parameter.
+     * @return the cache key
+     * @see ucol_getRulesCacheKey
+     * @draft ICU 57
+     */
+    static uint64_t U_EXPORT2 getRulesCacheKey(const UnicodeString &rules,
+                                               UColAttributeValue strength,
+                                               UColAttributeValue decompositionMode,
+                                               UErrorCode &errorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Retrieves the reordering codes for this collator.
      * @param dest The array to fill with the script ordering.
@@ -787,6 +984,14 @@ public:
      * @internal for tests & tools
      */
     void internalGetCEs(const UnicodeString &str, UVector64 &ces, UErrorCode &errorCode) const;
+
+    /**
+     * Returns TRUE if c always yields the same CEs regardless of the surrounding text:
+     * It is not part of any contraction or prefix mapping,
+     * and it is not normalized together with adjacent characters.
+     * @internal for StringSearch
+     */
+    UBool internalIsContextFree(UChar32 c) const;
 #endif  // U_HIDE_INTERNAL_API
 
 protected:
@@ -825,7 +1030,14 @@ private:
                                const uint8_t *right, int32_t rightLength,
                                UErrorCode &errorCode) const;
 
-    void writeSortKey(const UChar *s, int32_t length,
+    /** @return the effective strength for getCollationHash() and getCompactSortKey() */
+    int32_t checkHashArgs(const void *s, int32_t length,
+                          UColAttributeValue strength, UErrorCode &errorCode) const;
+    // strength is usually settings->getStrength().
+    void writeSortKey(const UChar *s, int32_t length, int32_t strength,
+                      SortKeyByteSink &sink, UErrorCode &errorCode) const;
+    // s16 is a scratch buffer for the identical level.
+    void writeSortKey(const uint8_t *s, int32_t length, int32_t strength, UnicodeString &s16,
                       SortKeyByteSink &sink, UErrorCode &errorCode) const;
 
     void writeIdenticalLevel(const UChar *s, const UChar *limit,
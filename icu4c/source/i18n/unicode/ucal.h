@@ -1495,6 +1495,27 @@ U_STABLE UBool U_EXPORT2
 ucal_getTimeZoneTransitionDate(const UCalendar* cal, UTimeZoneTransitionType type,
                                UDate* transition, UErrorCode* status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+* Get the raw and daylight saving time offsets for many dates at once,
+* in the time zone to which the calendar is currently set.
+* The result is the same as setting the calendar to each date and getting
+* its UCAL_ZONE_OFFSET and UCAL_DST_OFFSET fields, but much faster,
+* especially when the dates are sorted in ascending order.
+* The calendar itself is not modified.
+* @param cal The UCalendar whose time zone is used.
+* @param dates An array of count dates in UTC, in any order.
+* @param count The number of dates.
+* @param rawOffsets Receives count raw GMT offsets in milliseconds.
+* @param dstOffsets Receives count daylight saving offsets in milliseconds.
+* @param status A pointer to a UErrorCode to receive any errors.
+* @draft ICU 57
+*/
+U_DRAFT void U_EXPORT2
+ucal_getTimeZoneOffsets(const UCalendar* cal, const UDate* dates, int32_t count,
+                        int32_t* rawOffsets, int32_t* dstOffsets, UErrorCode* status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
 * Converts a system time zone ID to an equivalent Windows time zone ID. For example,
 * Windows time zone ID "Pacific Standard Time" is returned for input "America/Los_Angeles".
@@ -1008,6 +1008,408 @@ ucol_getSortKey(const    UCollator    *coll,
         uint8_t        *result,
         int32_t        resultLength);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Get a sort key for a UTF-8 string from a UCollator.
+ * The sort key is the same as for the string converted to UTF-16,
+ * with ill-formed sequences treated as U+FFFD,
+ * but it is computed directly from the UTF-8 text,
+ * which is faster than ucol_nextSortKeyPart() with a UTF-8 UCharIterator.
+ *
+ * Like ucol_getSortKey(), this returns the needed length and does not set
+ * an error code if the result buffer is too small;
+ * the buffer contents is then undefined.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param source The UTF-8 string to transform.
+ * @param sourceLength The length of source, or -1 if null-terminated.
+ * @param result A pointer to a buffer to receive the sort key.
+ *      Can be NULL if resultLength==0 for pure preflighting.
+ * @param resultLength The maximum size of result.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ *      U_UNSUPPORTED_ERROR if the collator is not a RuleBasedCollator.
+ * @return The size needed to fully store the sort key.
+ * @see ucol_getSortKey
+ * @draft ICU 57
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeyUTF8(const UCollator *coll,
+                    const char *source, int32_t sourceLength,
+                    uint8_t *result, int32_t resultLength,
+                    UErrorCode *status);
+
+/**
+ * Get the sort keys for an array of strings, concatenated in one buffer.
+ * Key i occupies result[offsets[i]..offsets[i+1]-1] and includes its
+ * terminating zero byte, exactly like the output of ucol_getSortKey().
+ *
+ * This is faster than calling ucol_getSortKey() for each string.
+ * A UCollator may be used concurrently from several threads,
+ * so large batches can be partitioned into ranges of strings,
+ * each written into its own buffer by a separate worker thread.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param sources Array of count strings.
+ * @param sourceLengths Array of count string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param count The number of strings.
+ * @param result Buffer for the concatenated sort keys;
+ *      can be NULL if resultCapacity==0 for pure preflighting.
+ * @param resultCapacity The capacity of the result buffer.
+ * @param offsets Array of count+1 offsets into the result buffer,
+ *      set even when the buffer is too small. offsets[count] is the total length.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ *      Set to U_BUFFER_OVERFLOW_ERROR if the total length exceeds resultCapacity.
+ * @return The total length of all sort keys.
+ * @see ucol_getSortKey
+ * @draft ICU 57
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const sources[], const int32_t sourceLengths[],
+                 int32_t count,
+                 uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                 UErrorCode *status);
+
+/**
+ * Get the sort keys for an array of UTF-8 strings, concatenated in one buffer.
+ * Otherwise the same as ucol_getSortKeys().
+ * Each sort key is the same as for the string converted to UTF-16,
+ * with ill-formed sequences treated as U+FFFD.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param sources Array of count UTF-8 strings.
+ * @param sourceLengths Array of count string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param count The number of strings.
+ * @param result Buffer for the concatenated sort keys;
+ *      can be NULL if resultCapacity==0 for pure preflighting.
+ * @param resultCapacity The capacity of the result buffer.
+ * @param offsets Array of count+1 offsets into the result buffer,
+ *      set even when the buffer is too small. offsets[count] is the total length.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ *      Set to U_BUFFER_OVERFLOW_ERROR if the total length exceeds resultCapacity.
+ * @return The total length of all sort keys.
+ * @see ucol_getSortKeys
+ * @draft ICU 57
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const sources[], const int32_t sourceLengths[],
+                     int32_t count,
+                     uint8_t *result, int32_t resultCapacity, int32_t offsets[],
+                     UErrorCode *status);
+
+/**
+ * Sorts an array of strings according to the collator.
+ * The strings are not moved; instead, order[] receives their indexes
+ * in ascending collation order.
+ *
+ * This is much faster for large arrays than sorting with ucol_strcoll()
+ * as the comparison function:
+ * The strings are first radix-sorted on short sort key prefixes,
+ * and only strings with equal prefixes are compared in full.
+ *
+ * To sort a large array on several threads,
+ * see ucol_sortStringRange() and ucol_mergeSortedPermutations().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings Array of count strings.
+ * @param lengths Array of count string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param count The number of strings.
+ * @param order Receives the count string indexes in sorted order.
+ * @param stable If TRUE, then strings that compare equal remain
+ *      in the order of their indexes.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @see ucol_strcoll
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar *const strings[], const int32_t lengths[], int32_t count,
+                 int32_t order[], UBool stable,
+                 UErrorCode *status);
+
+/**
+ * Sorts an array of UTF-8 strings according to the collator.
+ * Otherwise the same as ucol_sortStrings().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings Array of count UTF-8 strings.
+ * @param lengths Array of count string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param count The number of strings.
+ * @param order Receives the count string indexes in sorted order.
+ * @param stable If TRUE, then strings that compare equal remain
+ *      in the order of their indexes.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @see ucol_strcollUTF8
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char *const strings[], const int32_t lengths[], int32_t count,
+                     int32_t order[], UBool stable,
+                     UErrorCode *status);
+
+/**
+ * Sorts the strings with indexes start..limit-1 of an array.
+ * Otherwise the same as ucol_sortStrings().
+ * order[] receives limit-start indexes, which are in the range [start, limit[.
+ *
+ * The library does not create any threads.
+ * To sort a large array on several threads, split it into contiguous ranges,
+ * sort each range with this function on its own thread and into its own part
+ * of an order array, and then combine pairs of sorted ranges with
+ * ucol_mergeSortedPermutations(), which can also run on separate threads.
+ * The collator may be used concurrently from all of these threads.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings Array of strings; only strings[start..limit-1] are used.
+ * @param lengths Array of string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param start The index of the first string to be sorted.
+ * @param limit The index after the last string to be sorted.
+ * @param order Receives the limit-start string indexes in sorted order.
+ * @param stable If TRUE, then strings that compare equal remain
+ *      in the order of their indexes.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @see ucol_sortStrings
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStringRange(const UCollator *coll,
+                     const UChar *const strings[], const int32_t lengths[],
+                     int32_t start, int32_t limit,
+                     int32_t order[], UBool stable,
+                     UErrorCode *status);
+
+/**
+ * Sorts the UTF-8 strings with indexes start..limit-1 of an array.
+ * Otherwise the same as ucol_sortStringRange().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings Array of UTF-8 strings; only strings[start..limit-1] are used.
+ * @param lengths Array of string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param start The index of the first string to be sorted.
+ * @param limit The index after the last string to be sorted.
+ * @param order Receives the limit-start string indexes in sorted order.
+ * @param stable If TRUE, then strings that compare equal remain
+ *      in the order of their indexes.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @see ucol_sortStringRange
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStringRangeUTF8(const UCollator *coll,
+                         const char *const strings[], const int32_t lengths[],
+                         int32_t start, int32_t limit,
+                         int32_t order[], UBool stable,
+                         UErrorCode *status);
+
+/**
+ * Merges two sorted index sequences of one string array,
+ * for example the outputs of ucol_sortStringRange() for two disjoint ranges,
+ * into one sorted sequence.
+ * The same stable setting must be used as for sorting the inputs.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings Array of strings which are indexed by order1[] and order2[].
+ * @param lengths Array of string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param order1 First sequence of string indexes in sorted order.
+ * @param length1 The number of indexes in order1.
+ * @param order2 Second sequence of string indexes in sorted order;
+ *      must not contain any of the indexes in order1.
+ * @param length2 The number of indexes in order2.
+ * @param dest Receives the length1+length2 indexes in sorted order;
+ *      must not overlap order1 or order2.
+ * @param stable If TRUE, then strings that compare equal are ordered by their indexes.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @see ucol_sortStringRange
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+ucol_mergeSortedPermutations(const UCollator *coll,
+                             const UChar *const strings[], const int32_t lengths[],
+                             const int32_t order1[], int32_t length1,
+                             const int32_t order2[], int32_t length2,
+                             int32_t dest[], UBool stable,
+                             UErrorCode *status);
+
+/**
+ * Merges two sorted index sequences of one UTF-8 string array.
+ * Otherwise the same as ucol_mergeSortedPermutations().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings Array of UTF-8 strings which are indexed by order1[] and order2[].
+ * @param lengths Array of string lengths, each -1 if that string
+ *      is NUL-terminated; or NULL if all strings are NUL-terminated.
+ * @param order1 First sequence of string indexes in sorted order.
+ * @param length1 The number of indexes in order1.
+ * @param order2 Second sequence of string indexes in sorted order;
+ *      must not contain any of the indexes in order1.
+ * @param length2 The number of indexes in order2.
+ * @param dest Receives the length1+length2 indexes in sorted order;
+ *      must not overlap order1 or order2.
+ * @param stable If TRUE, then strings that compare equal are ordered by their indexes.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @see ucol_mergeSortedPermutations
+ * @draft ICU 57
+ */
+U_DRAFT void U_EXPORT2
+ucol_mergeSortedPermutationsUTF8(const UCollator *coll,
+                                 const char *const strings[], const int32_t lengths[],
+                                 const int32_t order1[], int32_t length1,
+                                 const int32_t order2[], int32_t length2,
+                                 int32_t dest[], UBool stable,
+                                 UErrorCode *status);
+
+/**
+ * Returns a 64-bit hash value for the string which is consistent with
+ * the collator at the given strength:
+ * Strings that compare equal at that strength get the same hash value.
+ * This is faster than hashing a sort key because the sort key bytes
+ * are hashed as they are generated, without storing them.
+ * Hash values are not stable across ICU versions or collator settings.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param source The string.
+ * @param length The length of the string, or -1 if NUL-terminated.
+ * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+ *      or UCOL_DEFAULT for the collator's strength.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The hash value.
+ * @see ucol_getSortKey
+ * @draft ICU 57
+ */
+U_DRAFT uint64_t U_EXPORT2
+ucol_getCollationHash(const UCollator *coll,
+                      const UChar *source, int32_t length,
+                      UColAttributeValue strength,
+                      UErrorCode *status);
+
+/**
+ * Returns a 64-bit hash value for the UTF-8 string which is consistent with
+ * the collator at the given strength.
+ * Otherwise the same as ucol_getCollationHash().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param source The UTF-8 string.
+ * @param length The length of the string, or -1 if NUL-terminated.
+ * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+ *      or UCOL_DEFAULT for the collator's strength.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The hash value.
+ * @draft ICU 57
+ */
+U_DRAFT uint64_t U_EXPORT2
+ucol_getCollationHashUTF8(const UCollator *coll,
+                          const char *source, int32_t length,
+                          UColAttributeValue strength,
+                          UErrorCode *status);
+
+/**
+ * Size statistics for compact sort keys.
+ * Initialize all fields to 0, then pass a pointer to it to
+ * ucol_getCompactSortKey() for each key; each call adds to the counts.
+ * @see ucol_getCompactSortKey
+ * @draft ICU 57
+ */
+typedef struct UCollationKeyStats {
+    /** Number of keys. @draft ICU 57 */
+    int64_t keyCount;
+    /** Total length of the compact keys. @draft ICU 57 */
+    int64_t totalLength;
+    /**
+     * Total length of the same keys without level truncation,
+     * as ucol_getSortKey() would return them with the same strength.
+     * @draft ICU 57
+     */
+    int64_t fullLength;
+    /** Number of keys with a truncated level. @draft ICU 57 */
+    int64_t truncatedCount;
+    /** Length of the longest compact key. @draft ICU 57 */
+    int32_t maxLength;
+} UCollationKeyStats;
+
+/**
+ * Get a compact sort key for a string, for space-efficient database indexes.
+ * The key contains only the levels up to the given strength,
+ * so for example UCOL_SECONDARY yields case-insensitive keys
+ * even if the collator's strength is tertiary.
+ *
+ * With maxLevelLength>0, each level after the primary level
+ * is limited to that many bytes. The first longer level is cut off,
+ * and the key ends there; the primary level is never truncated.
+ * The keys are NUL-terminated like those from ucol_getSortKey()
+ * and are compared with strcmp() or memcmp() in the same way.
+ *
+ * Ordering contract, for two strings a and b compared at the given strength:
+ * - If key(a)<key(b) then a<b.
+ * - If a<b then key(a)<=key(b).
+ * - If the keys are equal and neither key was truncated, then a==b.
+ *   Otherwise the strings need to be compared with the collator.
+ * Without truncation, the key is the same as from ucol_getSortKey() with
+ * the strength attribute set to the given strength.
+ *
+ * Like ucol_getSortKey(), this returns the needed length and does not set
+ * an error code if the result buffer is too small;
+ * the buffer contents is then undefined.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param source The string.
+ * @param sourceLength The length of the string, or -1 if NUL-terminated.
+ * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+ *      or UCOL_DEFAULT for the collator's strength.
+ * @param maxLevelLength The maximum number of bytes per level after the primary level,
+ *      or 0 for no limit.
+ * @param result A pointer to a buffer to receive the sort key.
+ *      Can be NULL if resultLength==0 for pure preflighting.
+ * @param resultLength The maximum size of result.
+ * @param stats If not NULL, the key's size is added to these statistics.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The size needed to fully store the compact sort key.
+ * @see ucol_getSortKey
+ * @draft ICU 57
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getCompactSortKey(const UCollator *coll,
+                       const UChar *source, int32_t sourceLength,
+                       UColAttributeValue strength, int32_t maxLevelLength,
+                       uint8_t *result, int32_t resultLength,
+                       UCollationKeyStats *stats, UErrorCode *status);
+
+/**
+ * Get a compact sort key for a UTF-8 string.
+ * Otherwise the same as ucol_getCompactSortKey().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param source The UTF-8 string.
+ * @param sourceLength The length of the string, or -1 if NUL-terminated.
+ * @param strength UCOL_PRIMARY..UCOL_QUATERNARY or UCOL_IDENTICAL,
+ *      or UCOL_DEFAULT for the collator's strength.
+ * @param maxLevelLength The maximum number of bytes per level after the primary level,
+ *      or 0 for no limit.
+ * @param result A pointer to a buffer to receive the sort key.
+ *      Can be NULL if resultLength==0 for pure preflighting.
+ * @param resultLength The maximum size of result.
+ * @param stats If not NULL, the key's size is added to these statistics.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The size needed to fully store the compact sort key.
+ * @see ucol_getCompactSortKey
+ * @draft ICU 57
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getCompactSortKeyUTF8(const UCollator *coll,
+                           const char *source, int32_t sourceLength,
+                           UColAttributeValue strength, int32_t maxLevelLength,
+                           uint8_t *result, int32_t resultLength,
+                           UCollationKeyStats *stats, UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 
 /** Gets the next count bytes of a sort key. Caller needs
  *  to preserve state array between calls and to provide
@@ -1474,6 +1876,46 @@ ucol_openBinary(const uint8_t *bin, int32_t length,
                 const UCollator *base, 
                 UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Returns a 64-bit key for a persistent cache of collators built from rules.
+ * A caller can store the output of ucol_cloneBinary() for a collator
+ * from ucol_openRules() under this key, in memory or in a directory of files,
+ * and later reload it with ucol_openBinary() instead of building
+ * the collator from the rules again.
+ * ICU itself shares collators built from the same rules only within one process.
+ *
+ * The key is the 64-bit FNV-1a hash (offset basis 0xcbf29ce484222325,
+ * prime 0x100000001b3) of the following bytes, in this order:
+ * - the four bytes of the root collator's version, as returned by ucol_getVersion(),
+ *   which changes with the root collation data and with the collation runtime
+ * - 1 on big-endian platforms, otherwise 0, because binary images are not portable
+ * - the low byte of strength
+ * - the low byte of normalizationMode
+ * - each UTF-16 code unit of the rules, low byte first
+ *
+ * So the key changes when any of these inputs change, including an ICU upgrade
+ * with different root collation data, after which stale images must not be loaded.
+ * Different inputs can still hash to the same key, although that is very unlikely;
+ * a cache may additionally store the rules and compare them.
+ *
+ * @param rules The collation rules, as for ucol_openRules().
+ * @param rulesLength The length of rules, or -1 if null-terminated.
+ * @param normalizationMode The normalization mode argument for ucol_openRules().
+ * @param strength The strength argument for ucol_openRules().
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The cache key.
+ * @see ucol_openRules
+ * @see ucol_cloneBinary
+ * @see ucol_openBinary
+ * @draft ICU 57
+ */
+U_DRAFT uint64_t U_EXPORT2
+ucol_getRulesCacheKey(const UChar *rules, int32_t rulesLength,
+                      UColAttributeValue normalizationMode, UCollationStrength strength,
+                      UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 
 #endif /* #if !UCONFIG_NO_COLLATION */
 
@@ -758,6 +758,123 @@ U_STABLE int32_t U_EXPORT2 usearch_previous(UStringSearch *strsrch,
 */
 U_STABLE void U_EXPORT2 usearch_reset(UStringSearch *strsrch);
 
+#ifndef U_HIDE_DRAFT_API
+
+/* multiple patterns ---------------------------------------------------- */
+
+struct UMultiStringSearch;
+/**
+* Data structure for searching for many patterns at once.
+* @draft ICU 57
+*/
+typedef struct UMultiStringSearch UMultiStringSearch;
+
+/**
+* Creates a search for any of several patterns in one pass over the text.
+* The patterns are compiled into an automaton over collation elements,
+* so that the search time depends on the length of the text
+* but hardly on the number of patterns.
+*
+* Two strings match if their collation elements are equal
+* according to the collator's strength and other attributes at the time
+* this function is called, as with <tt>usearch_search()</tt> and the
+* standard element comparison.
+* Match boundaries obey the same rules as for <tt>UStringSearch</tt>.
+* All matches are found, including overlapping ones and matches of
+* different patterns at the same position.
+*
+* The patterns, the text, the collator and the break iterator are aliased,
+* not copied, and must remain valid until the search is closed.
+* @param patterns array of patterns
+* @param patternLengths array of pattern lengths, each -1 for null-termination;
+*                       or NULL if all patterns are null-terminated
+* @param patternCount number of patterns, must be positive
+* @param text text string
+* @param textlength length of the text string, -1 for null-termination
+* @param collator used for the language rules
+* @param breakiter A BreakIterator that is used to restrict the points at which
+*                  matches are detected, or NULL
+* @param status for errors if any occurs.
+*               U_ILLEGAL_ARGUMENT_ERROR if a pattern is empty
+*               or has only ignorable collation elements.
+* @return a multi-pattern search, or NULL if an error occurred
+* @see usearch_nextMulti
+* @draft ICU 57
+*/
+U_DRAFT UMultiStringSearch * U_EXPORT2 usearch_openMulti(
+                                  const UChar *const    patterns[],
+                                  const int32_t         patternLengths[],
+                                        int32_t         patternCount,
+                                  const UChar          *text,
+                                        int32_t         textlength,
+                                  const UCollator      *collator,
+                                        UBreakIterator *breakiter,
+                                        UErrorCode     *status);
+
+/**
+* Destroys a multi-pattern search.
+* @param msearch the search to close
+* @draft ICU 57
+*/
+U_DRAFT void U_EXPORT2 usearch_closeMulti(UMultiStringSearch *msearch);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUMultiStringSearchPointer
+ * "Smart pointer" class, closes a UMultiStringSearch via usearch_closeMulti().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 57
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUMultiStringSearchPointer, UMultiStringSearch, usearch_closeMulti);
+
+U_NAMESPACE_END
+
+#endif
+
+/**
+* Sets the text to be searched, and restarts the search at its beginning.
+* @param msearch the multi-pattern search
+* @param text new text string
+* @param textlength length of the text string, -1 for null-termination
+* @param status for errors if any occurs. If text is NULL, or textlength is 0
+*               then an U_ILLEGAL_ARGUMENT_ERROR is returned.
+* @draft ICU 57
+*/
+U_DRAFT void U_EXPORT2 usearch_setMultiText(UMultiStringSearch *msearch,
+                                            const UChar        *text,
+                                            int32_t             textlength,
+                                            UErrorCode         *status);
+
+/**
+* Returns the next match of any of the patterns.
+* Matches are returned in the order in which they end in the text.
+* Matches which end at the same point are returned longest first,
+* and matches of patterns with the same collation elements
+* in the order of the patterns.
+* @param msearch the multi-pattern search
+* @param patternIndex receives the index of the matching pattern; can be NULL
+* @param matchStart receives the start index of the match, or -1 if there is none;
+*                   can be NULL
+* @param matchLimit receives the limit index of the match, or -1 if there is none;
+*                   can be NULL
+* @param status for errors if any occurs. No further match is not an error.
+* @return TRUE if a match was found, FALSE at the end of the text
+* @draft ICU 57
+*/
+U_DRAFT UBool U_EXPORT2 usearch_nextMulti(UMultiStringSearch *msearch,
+                                          int32_t            *patternIndex,
+                                          int32_t            *matchStart,
+                                          int32_t            *matchLimit,
+                                          UErrorCode         *status);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_INTERNAL_API
 /**
   *  Simple forward search for the pattern, starting at a specified index,
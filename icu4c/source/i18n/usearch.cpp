@@ -15,12 +15,14 @@
 #include "unicode/ustring.h"
 #include "unicode/uchar.h"
 #include "unicode/utf16.h"
+#include "unicode/tblcoll.h"
 #include "normalizer2impl.h"
 #include "usrchimp.h"
 #include "cmemory.h"
 #include "ucln_in.h"
 #include "uassert.h"
 #include "ustr_imp.h"
+#include "uvectr64.h"
 
 U_NAMESPACE_USE
 
@@ -461,6 +463,7 @@ inline int16_t initializePattern(UStringSearch *strsrch, UErrorCode *status)
 
         strsrch->pattern.pces = NULL;
     }
+    strsrch->pattern.skipState = 0;
 
     // since intializePattern is an internal method status is a success.
     return initializePatternCETable(strsrch, status);
@@ -1063,15 +1066,19 @@ inline UBool isOutOfBounds(int32_t textlength, int32_t offset)
 }
 
 /**
-* Checks for identical match
+* Checks for identical match with a given pattern
 * @param strsrch string search data
 * @param start offset of possible match
 * @param end offset of possible match
+* @param pattern the pattern text
+* @param patternLength the pattern length
 * @return TRUE if identical match is found
 */
 static
 inline UBool checkIdentical(const UStringSearch *strsrch, int32_t start,
-                                  int32_t    end)
+                                  int32_t    end,
+                            const UChar     *pattern,
+                                  int32_t    patternLength)
 {
     if (strsrch->strength != UCOL_IDENTICAL) {
         return TRUE;
@@ -1084,11 +1091,26 @@ inline UBool checkIdentical(const UStringSearch *strsrch, int32_t start,
     strsrch->nfd->normalize(
         UnicodeString(FALSE, strsrch->search->text + start, end - start), t2, status);
     strsrch->nfd->normalize(
-        UnicodeString(FALSE, strsrch->pattern.text, strsrch->pattern.textLength), p2, status);
+        UnicodeString(FALSE, pattern, patternLength), p2, status);
     // return FALSE if NFD failed
     return U_SUCCESS(status) && t2 == p2;
 }
 
+/**
+* Checks for identical match
+* @param strsrch string search data
+* @param start offset of possible match
+* @param end offset of possible match
+* @return TRUE if identical match is found
+*/
+static
+inline UBool checkIdentical(const UStringSearch *strsrch, int32_t start,
+                                  int32_t    end)
+{
+    return checkIdentical(strsrch, start, end,
+                          strsrch->pattern.text, strsrch->pattern.textLength);
+}
+
 #if BOYER_MOORE
 /**
 * Checks to see if the match is repeated
@@ -2710,6 +2732,7 @@ U_CAPI UStringSearch * U_EXPORT2 usearch_openFromCollator(
         result->pattern.textLength = patternlength;
         result->pattern.ces         = NULL;
         result->pattern.pces        = NULL;
+        result->pattern.skipState   = 0;
 
         result->search->breakIter  = breakiter;
 #if !UCONFIG_NO_BREAK_ITERATION
@@ -3462,7 +3485,7 @@ namespace {
 #define   MAX_TARGET_IGNORABLES_PER_PAT_JAMO_L 8
 #define   MAX_TARGET_IGNORABLES_PER_PAT_OTHER 3
 #define   MIGHT_BE_JAMO_L(c) ((c >= 0x1100 && c <= 0x115E) || (c >= 0x3131 && c <= 0x314E) || (c >= 0x3165 && c <= 0x3186))
-struct CEIBuffer {
+struct CEIBuffer : public UMemory {
     CEI                  defBuf[DEFAULT_CEBUFFER_SIZE];
     CEI                 *buf;
     int32_t              bufSize;
@@ -3831,43 +3854,123 @@ UChar32 codePointBefore(const USearch &search, int32_t index) {
 
 }  // namespace
 
-U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
-                                       int32_t        startIdx,
-                                       int32_t        *matchStart,
-                                       int32_t        *matchLimit,
-                                       UErrorCode     *status)
+/**
+ * Checks whether a match in CE space corresponds to an acceptable range of text.
+ * The match runs from firstCEI to lastCEI, nextCEI is the CE after the match,
+ * minLimit and maxLimit bound the end of the match in the text.
+ * Does not check for an identical match.
+ * @return TRUE if the match is acceptable, with its text limit in *matchLimit
+ */
+static UBool checkMatchBounds(UStringSearch *strsrch,
+                              const CEI *firstCEI, const CEI *lastCEI, const CEI *nextCEI,
+                              int32_t minLimit, int32_t maxLimit,
+                              int32_t *matchLimit)
 {
-    if (U_FAILURE(*status)) {
+    int32_t mStart = firstCEI->lowIndex;
+
+    // Check for the start of the match being within a combining sequence.
+    //   This can happen if the pattern itself begins with a combining char, and
+    //   the match found combining marks in the target text that were attached
+    //    to something else.
+    //   This type of match should be rejected for not completely consuming a
+    //   combining sequence.
+    if (!isBreakBoundary(strsrch, mStart)) {
         return FALSE;
     }
 
-    // TODO:  reject search patterns beginning with a combining char.
+    // Check for the start of the match being within an Collation Element Expansion,
+    //   meaning that the first char of the match is only partially matched.
+    //   With exapnsions, the first CE will report the index of the source
+    //   character, and all subsequent (expansions) CEs will report the source index of the
+    //    _following_ character.
+    int32_t secondIx = firstCEI->highIndex;
+    if (mStart == secondIx) {
+        return FALSE;
+    }
 
-#ifdef USEARCH_DEBUG
-    if (getenv("USEARCH_DEBUG") != NULL) {
-        printf("Pattern CEs\n");
-        for (int ii=0; ii<strsrch->pattern.cesLength; ii++) {
-            printf(" %8x", strsrch->pattern.ces[ii]);
+    // Allow matches to end in the middle of a grapheme cluster if the following
+    // conditions are met; this is needed to make prefix search work properly in
+    // Indic, see #11750
+    // * the default breakIter is being used
+    // * the next collation element after this combining sequence
+    //   - has non-zero primary weight
+    //   - corresponds to a separate character following the one at end of the current match
+    //   (the second of these conditions, and perhaps both, may be redundant given the
+    //   subsequent check for normalization boundary; however they are likely much faster
+    //   tests in any case)
+    // * the match limit is a normalization boundary
+    UBool allowMidclusterMatch = FALSE;
+    if (strsrch->search->text != NULL && strsrch->search->textLength > maxLimit) {
+        allowMidclusterMatch =
+                strsrch->search->breakIter == NULL &&
+                nextCEI != NULL && (((nextCEI->ce) >> 32) & 0xFFFF0000UL) != 0 &&
+                maxLimit >= lastCEI->highIndex && nextCEI->highIndex > maxLimit &&
+                (strsrch->nfd->hasBoundaryBefore(codePointAt(*strsrch->search, maxLimit)) ||
+                    strsrch->nfd->hasBoundaryAfter(codePointBefore(*strsrch->search, maxLimit)));
+    }
+    // If those conditions are met, then:
+    // * do NOT advance the candidate match limit (mLimit) to a break boundary; however
+    //   the match limit may be backed off to a previous break boundary. This handles
+    //   cases in which mLimit includes target characters that are ignorable with current
+    //   settings (such as space) and which extend beyond the pattern match.
+    // * do NOT require that end of the combining sequence not extend beyond the match in CE space
+    // * do NOT require that match limit be on a breakIter boundary
+
+    //  Advance the match end position to the first acceptable match boundary.
+    //    This advances the index over any combining charcters.
+    int32_t mLimit = maxLimit;
+    if (minLimit < maxLimit) {
+        // When the last CE's low index is same with its high index, the CE is likely
+        // a part of expansion. In this case, the index is located just after the
+        // character corresponding to the CEs compared above. If the index is right
+        // at the break boundary, move the position to the next boundary will result
+        // incorrect match length when there are ignorable characters exist between
+        // the position and the next character produces CE(s). See ticket#8482.
+        if (minLimit == lastCEI->highIndex && isBreakBoundary(strsrch, minLimit)) {
+            mLimit = minLimit;
+        } else {
+            int32_t nba = nextBoundaryAfter(strsrch, minLimit);
+            // Note that we can have nba < maxLimit && nba >= minLImit, in which
+            // case we want to set mLimit to nba regardless of allowMidclusterMatch
+            // (i.e. we back off mLimit to the previous breakIterator boundary).
+            if (nba >= lastCEI->highIndex && (!allowMidclusterMatch || nba < maxLimit)) {
+                mLimit = nba;
+            }
         }
-        printf("\n");
     }
 
-#endif
-    // Input parameter sanity check.
-    //  TODO:  should input indicies clip to the text length
-    //         in the same way that UText does.
-    if(strsrch->pattern.cesLength == 0         ||
-       startIdx < 0                           ||
-       startIdx > strsrch->search->textLength ||
-       strsrch->pattern.ces == NULL) {
-           *status = U_ILLEGAL_ARGUMENT_ERROR;
-           return FALSE;
+#ifdef USEARCH_DEBUG
+    if (getenv("USEARCH_DEBUG") != NULL) {
+        printf("minLimit, maxLimit, mLimit = %d, %d, %d\n", minLimit, maxLimit, mLimit);
     }
+#endif
 
-    if (strsrch->pattern.pces == NULL) {
-        initializePatternPCETable(strsrch, status);
+    if (!allowMidclusterMatch) {
+        // If advancing to the end of a combining sequence in character indexing space
+        //   advanced us beyond the end of the match in CE space, reject this match.
+        if (mLimit > maxLimit) {
+            return FALSE;
+        }
+
+        if (!isBreakBoundary(strsrch, mLimit)) {
+            return FALSE;
+        }
     }
+    *matchLimit = mLimit;
+    return TRUE;
+}
 
+/**
+ * Forward search in CE space, the core of usearch_search().
+ * If limitIdx >= 0, then only matches that start before limitIdx are found.
+ */
+static UBool searchForward(UStringSearch  *strsrch,
+                           int32_t        startIdx,
+                           int32_t        limitIdx,
+                           int32_t        *matchStart,
+                           int32_t        *matchLimit,
+                           UErrorCode     *status)
+{
     ucol_setOffset(strsrch->textIter, startIdx, status);
     CEIBuffer ceb(strsrch, status);
 
@@ -3914,6 +4017,11 @@ U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
             found = FALSE;
             break;
         }
+        if (limitIdx >= 0 && firstCEI->lowIndex >= limitIdx) {
+            // Matches from here on are left to the caller.
+            found = FALSE;
+            break;
+        }
         
         for (patIx=0; patIx<strsrch->pattern.pcesLength; patIx++) {
             patCE = strsrch->pattern.pces[patIx];
@@ -4004,96 +4112,12 @@ U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
         }
 
 
-        // Check for the start of the match being within a combining sequence.
-        //   This can happen if the pattern itself begins with a combining char, and
-        //   the match found combining marks in the target text that were attached
-        //    to something else.
-        //   This type of match should be rejected for not completely consuming a
-        //   combining sequence.
-        if (!isBreakBoundary(strsrch, mStart)) {
+        if (found &&
+                !checkMatchBounds(strsrch, firstCEI, lastCEI, nextCEI, minLimit, maxLimit, &mLimit)) {
             found = FALSE;
         }
 
-        // Check for the start of the match being within an Collation Element Expansion,
-        //   meaning that the first char of the match is only partially matched.
-        //   With exapnsions, the first CE will report the index of the source
-        //   character, and all subsequent (expansions) CEs will report the source index of the
-        //    _following_ character.
-        int32_t secondIx = firstCEI->highIndex;
-        if (mStart == secondIx) {
-            found = FALSE;
-        }
-
-        // Allow matches to end in the middle of a grapheme cluster if the following
-        // conditions are met; this is needed to make prefix search work properly in
-        // Indic, see #11750
-        // * the default breakIter is being used
-        // * the next collation element after this combining sequence
-        //   - has non-zero primary weight
-        //   - corresponds to a separate character following the one at end of the current match
-        //   (the second of these conditions, and perhaps both, may be redundant given the
-        //   subsequent check for normalization boundary; however they are likely much faster
-        //   tests in any case)
-        // * the match limit is a normalization boundary
-        UBool allowMidclusterMatch = FALSE;
-        if (strsrch->search->text != NULL && strsrch->search->textLength > maxLimit) {
-            allowMidclusterMatch =
-                    strsrch->search->breakIter == NULL &&
-                    nextCEI != NULL && (((nextCEI->ce) >> 32) & 0xFFFF0000UL) != 0 &&
-                    maxLimit >= lastCEI->highIndex && nextCEI->highIndex > maxLimit &&
-                    (strsrch->nfd->hasBoundaryBefore(codePointAt(*strsrch->search, maxLimit)) ||
-                        strsrch->nfd->hasBoundaryAfter(codePointBefore(*strsrch->search, maxLimit)));
-        }
-        // If those conditions are met, then:
-        // * do NOT advance the candidate match limit (mLimit) to a break boundary; however
-        //   the match limit may be backed off to a previous break boundary. This handles
-        //   cases in which mLimit includes target characters that are ignorable with current
-        //   settings (such as space) and which extend beyond the pattern match.
-        // * do NOT require that end of the combining sequence not extend beyond the match in CE space
-        // * do NOT require that match limit be on a breakIter boundary
-
-        //  Advance the match end position to the first acceptable match boundary.
-        //    This advances the index over any combining charcters.
-        mLimit = maxLimit;
-        if (minLimit < maxLimit) {
-            // When the last CE's low index is same with its high index, the CE is likely
-            // a part of expansion. In this case, the index is located just after the
-            // character corresponding to the CEs compared above. If the index is right
-            // at the break boundary, move the position to the next boundary will result
-            // incorrect match length when there are ignorable characters exist between
-            // the position and the next character produces CE(s). See ticket#8482.
-            if (minLimit == lastCEI->highIndex && isBreakBoundary(strsrch, minLimit)) {
-                mLimit = minLimit;
-            } else {
-                int32_t nba = nextBoundaryAfter(strsrch, minLimit);
-                // Note that we can have nba < maxLimit && nba >= minLImit, in which
-                // case we want to set mLimit to nba regardless of allowMidclusterMatch
-                // (i.e. we back off mLimit to the previous breakIterator boundary).
-                if (nba >= lastCEI->highIndex && (!allowMidclusterMatch || nba < maxLimit)) {
-                    mLimit = nba;
-                }
-            }
-        }
-
-    #ifdef USEARCH_DEBUG
-        if (getenv("USEARCH_DEBUG") != NULL) {
-            printf("minLimit, maxLimit, mLimit = %d, %d, %d\n", minLimit, maxLimit, mLimit);
-        }
-    #endif
-
-        if (!allowMidclusterMatch) {
-            // If advancing to the end of a combining sequence in character indexing space
-            //   advanced us beyond the end of the match in CE space, reject this match.
-            if (mLimit > maxLimit) {
-                found = FALSE;
-            }
-
-            if (!isBreakBoundary(strsrch, mLimit)) {
-                found = FALSE;
-            }
-        }
-
-        if (! checkIdentical(strsrch, mStart, mLimit)) {
+        if (found && ! checkIdentical(strsrch, mStart, mLimit)) {
             found = FALSE;
         }
 
@@ -4131,6 +4155,215 @@ U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
     return found;
 }
 
+namespace {
+
+// Values for UPattern.skipState.
+const int8_t SKIP_UNKNOWN = 0;
+const int8_t SKIP_NEVER = 1;
+const int8_t SKIP_OK = 2;
+
+// Skipping does not pay off for shorter patterns.
+const int32_t SKIP_MIN_PATTERN_LENGTH = 3;
+
+inline int hashFromPCE(int64_t pce) {
+    // primary & secondary weights
+    return hashFromCE32((uint32_t)((uint64_t)pce >> 32));
+}
+
+/**
+ * Returns the processed CE of a text code unit if the unit is "simple":
+ * It yields exactly one processed CE with a non-zero primary weight,
+ * independent of the surrounding text. Returns 0 for any other code unit.
+ * The results are cached in the UPattern.
+ */
+int64_t getSimplePCE(UStringSearch *strsrch, const RuleBasedCollator &rbc, UChar c,
+                     UErrorCode *status) {
+    UPattern &pattern = strsrch->pattern;
+    int32_t i = (c ^ (c >> 8)) & (SKIP_CACHE_SIZE_ - 1);
+    if (pattern.skipCacheChars[i] == c) {
+        return pattern.skipCachePCEs[i];
+    }
+    int64_t pce = 0;
+    if (!U16_IS_SURROGATE(c) && rbc.internalIsContextFree(c)) {
+        ucol_setText(strsrch->utilIter, &c, 1, status);
+        UCollationPCE iter(strsrch->utilIter);
+        pce = iter.nextProcessed(NULL, NULL, status);
+        // A processed CE with primary 0 depends on the preceding CE
+        // when the alternate handling is shifted (see UCollationPCE::processCE()).
+        if (pce == UCOL_PROCESSED_NULLORDER || ((uint64_t)pce >> 48) == 0 ||
+                iter.nextProcessed(NULL, NULL, status) != UCOL_PROCESSED_NULLORDER) {
+            pce = 0;
+        }
+    }
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    pattern.skipCacheChars[i] = c;
+    pattern.skipCachePCEs[i] = pce;
+    return pce;
+}
+
+/**
+ * Decides whether usearch_search() can skip over the text for the current pattern,
+ * and if so builds the shift table.
+ * This requires that every pattern code unit is simple (see getSimplePCE()),
+ * so that a window of simple text units matches the pattern
+ * if and only if the units' processed CEs equal the pattern's.
+ */
+void initializeSkipping(UStringSearch *strsrch, UErrorCode *status) {
+    UPattern &pattern = strsrch->pattern;
+    pattern.skipState = SKIP_NEVER;
+    for (int32_t i = 0; i < SKIP_CACHE_SIZE_; ++i) {
+        // U+FFFF is not simple, so this also works for a lookup of U+FFFF.
+        pattern.skipCacheChars[i] = 0xffff;
+        pattern.skipCachePCEs[i] = 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(strsrch->collator);
+    int32_t length = pattern.pcesLength;
+    if (rbc == NULL || length < SKIP_MIN_PATTERN_LENGTH || length != pattern.textLength ||
+            length > INT16_MAX) {
+        return;
+    }
+    for (int32_t i = 0; i < length; ++i) {
+        if (getSimplePCE(strsrch, *rbc, pattern.text[i], status) != pattern.pces[i]) {
+            return;
+        }
+    }
+    // Horspool: Shift so that the last pattern occurrence of the processed CE
+    // of the text unit at the end of the current window lines up with it.
+    // Hash collisions only make shifts shorter.
+    for (int32_t i = 0; i < MAX_TABLE_SIZE_; ++i) {
+        pattern.skipShift[i] = (int16_t)length;
+    }
+    for (int32_t i = 0; i < length - 1; ++i) {
+        pattern.skipShift[hashFromPCE(pattern.pces[i])] = (int16_t)(length - 1 - i);
+    }
+    pattern.skipState = SKIP_OK;
+}
+
+/**
+ * Forward search which skips over text that cannot contain the start of a match.
+ * Windows of simple text units (see getSimplePCE()) are checked and shifted
+ * Horspool-style via their cached processed CEs.
+ * Starting positions near units that are not simple,
+ * and candidate matches, are handed to the CE-based searchForward().
+ */
+UBool searchWithSkipping(UStringSearch *strsrch, const RuleBasedCollator &rbc,
+                         int32_t startIdx, int32_t *matchStart, int32_t *matchLimit,
+                         UErrorCode *status) {
+    const UPattern &pattern = strsrch->pattern;
+    const UChar *text = strsrch->search->text;
+    int32_t textLength = strsrch->search->textLength;
+    int32_t patternLength = pattern.pcesLength;
+    const int64_t *pces = pattern.pces;
+    int64_t lastPCE = pces[patternLength - 1];
+    int32_t start = startIdx;
+    // All text units before scanLimit have been classified,
+    // and lastNotSimple is the index of the last one that is not simple.
+    int32_t scanLimit = startIdx;
+    int32_t lastNotSimple = -1;
+    while (start + patternLength <= textLength) {
+        int32_t last = start + patternLength - 1;  // end of the current window
+        for (; scanLimit <= last; ++scanLimit) {
+            if (getSimplePCE(strsrch, rbc, text[scanLimit], status) == 0) {
+                lastNotSimple = scanLimit;
+            }
+        }
+        if (U_FAILURE(*status)) {
+            return FALSE;
+        }
+        if (lastNotSimple >= start) {
+            // A match starting in this window might contain units which are not simple.
+            // Use the CE-based search for starts up to and including the run of such units.
+            int32_t limit = lastNotSimple + 1;
+            while (limit < textLength && getSimplePCE(strsrch, rbc, text[limit], status) == 0) {
+                ++limit;
+            }
+            if (limit > scanLimit) {
+                scanLimit = limit;
+                lastNotSimple = limit - 1;
+            }
+            if (searchForward(strsrch, start, limit, matchStart, matchLimit, status) ||
+                    U_FAILURE(*status)) {
+                return U_SUCCESS(*status);
+            }
+            start = limit;
+            continue;
+        }
+        int64_t pce = getSimplePCE(strsrch, rbc, text[last], status);
+        if (pce == lastPCE) {
+            int32_t i = patternLength - 2;
+            while (i >= 0 && getSimplePCE(strsrch, rbc, text[start + i], status) == pces[i]) {
+                --i;
+            }
+            // Matching CEs: Let the CE-based search check the match boundaries etc.
+            if (i < 0 && (searchForward(strsrch, start, start + 1,
+                                        matchStart, matchLimit, status) ||
+                          U_FAILURE(*status))) {
+                return U_SUCCESS(*status);
+            }
+        }
+        start += pattern.skipShift[hashFromPCE(pce)];
+    }
+    // The remaining text is shorter than the pattern.
+    return searchForward(strsrch, start, -1, matchStart, matchLimit, status);
+}
+
+}  // namespace
+
+U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
+                                       int32_t        startIdx,
+                                       int32_t        *matchStart,
+                                       int32_t        *matchLimit,
+                                       UErrorCode     *status)
+{
+    if (U_FAILURE(*status)) {
+        return FALSE;
+    }
+
+    // TODO:  reject search patterns beginning with a combining char.
+
+#ifdef USEARCH_DEBUG
+    if (getenv("USEARCH_DEBUG") != NULL) {
+        printf("Pattern CEs\n");
+        for (int ii=0; ii<strsrch->pattern.cesLength; ii++) {
+            printf(" %8x", strsrch->pattern.ces[ii]);
+        }
+        printf("\n");
+    }
+
+#endif
+    // Input parameter sanity check.
+    //  TODO:  should input indicies clip to the text length
+    //         in the same way that UText does.
+    if(strsrch->pattern.cesLength == 0         ||
+       startIdx < 0                           ||
+       startIdx > strsrch->search->textLength ||
+       strsrch->pattern.ces == NULL) {
+           *status = U_ILLEGAL_ARGUMENT_ERROR;
+           return FALSE;
+    }
+
+    if (strsrch->pattern.pces == NULL) {
+        initializePatternPCETable(strsrch, status);
+    }
+    if (strsrch->pattern.skipState == SKIP_UNKNOWN) {
+        initializeSkipping(strsrch, status);
+        if (U_FAILURE(*status)) {
+            return FALSE;
+        }
+    }
+
+    // Skipping relies on exact CE comparisons.
+    if (strsrch->pattern.skipState == SKIP_OK &&
+            strsrch->search->elementComparisonType == 0 &&
+            strsrch->search->text != NULL) {
+        const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(strsrch->collator);
+        return searchWithSkipping(strsrch, *rbc, startIdx, matchStart, matchLimit, status);
+    }
+    return searchForward(strsrch, startIdx, -1, matchStart, matchLimit, status);
+}
+
 U_CAPI UBool U_EXPORT2 usearch_searchBackwards(UStringSearch  *strsrch,
                                                 int32_t        startIdx,
                                                 int32_t        *matchStart,
@@ -4943,4 +5176,447 @@ UBool usearch_handlePreviousCanonical(UStringSearch *strsrch,
 #endif
 }
 
+// multi-pattern search --------------------------------------------------
+
+/**
+ * Transition of the Aho-Corasick automaton over processed CEs.
+ * The transitions are stored in an open-addressing hash table
+ * keyed on the source state and the CE.
+ */
+struct MultiSearchEdge {
+    int64_t ce;
+    int32_t from;
+    int32_t to;  // -1 for an empty slot
+};
+
+struct UMultiStringSearch {
+    // Provides the text, collator and break iterators.
+    // Its pattern is the one with the most CEs, which sizes the CEIBuffer.
+    UStringSearch      *strsrch;
+    int32_t             patternCount;
+    const UChar       **patterns;
+    int32_t            *patternLengths;
+    int32_t            *patternCELengths;
+    // automaton; state 0 is the start state
+    MultiSearchEdge    *edges;
+    int32_t             edgeMask;
+    int32_t            *failures;      // failure transition of each state
+    int32_t            *outputLinks;   // nearest suffix state with outputs, or -1
+    int32_t            *outputStarts;  // per state, indexes into outputs; stateCount+1 entries
+    int32_t            *outputs;       // pattern indexes
+    // iteration
+    CEIBuffer          *ceb;
+    int32_t             ceIndex;
+    int32_t             state;
+    int32_t             outputState;
+    int32_t             outputIndex;
+};
+
+static inline int32_t hashMultiSearchEdge(int32_t from, int64_t ce) {
+    uint32_t h = (uint32_t)((uint64_t)ce >> 32) * 0x9e3779b1u;
+    h ^= (uint32_t)ce ^ ((uint32_t)from * 0x85ebca6bu);
+    return (int32_t)(h ^ (h >> 16));
+}
+
+/** @return the state after from with ce, or -1 if there is no such transition */
+static int32_t findMultiSearchEdge(const UMultiStringSearch *msearch, int32_t from, int64_t ce) {
+    int32_t i = hashMultiSearchEdge(from, ce) & msearch->edgeMask;
+    for (;;) {
+        const MultiSearchEdge &e = msearch->edges[i];
+        if (e.to < 0) {
+            return -1;
+        }
+        if (e.from == from && e.ce == ce) {
+            return e.to;
+        }
+        i = (i + 1) & msearch->edgeMask;
+    }
+}
+
+static void addMultiSearchEdge(UMultiStringSearch *msearch, int32_t from, int64_t ce, int32_t to) {
+    int32_t i = hashMultiSearchEdge(from, ce) & msearch->edgeMask;
+    while (msearch->edges[i].to >= 0) {
+        i = (i + 1) & msearch->edgeMask;
+    }
+    MultiSearchEdge &e = msearch->edges[i];
+    e.ce = ce;
+    e.from = from;
+    e.to = to;
+}
+
+/**
+ * Builds the automaton from the patterns' processed CEs.
+ * @param pces the CEs of all patterns, concatenated
+ * @param totalLength the number of pces
+ */
+static void buildMultiSearchAutomaton(UMultiStringSearch *msearch,
+                                      const int64_t *pces, int32_t totalLength,
+                                      UErrorCode *status) {
+    // At most one state per pattern CE, plus the start state.
+    int32_t maxStateCount = totalLength + 1;
+    int32_t capacity = 16;
+    while (capacity < 2 * maxStateCount) {
+        capacity <<= 1;
+    }
+    msearch->edges = (MultiSearchEdge *)uprv_malloc(capacity * sizeof(MultiSearchEdge));
+    msearch->edgeMask = capacity - 1;
+    msearch->failures = (int32_t *)uprv_malloc(maxStateCount * sizeof(int32_t));
+    msearch->outputLinks = (int32_t *)uprv_malloc(maxStateCount * sizeof(int32_t));
+    msearch->outputStarts = (int32_t *)uprv_malloc((maxStateCount + 1) * sizeof(int32_t));
+    msearch->outputs = (int32_t *)uprv_malloc(msearch->patternCount * sizeof(int32_t));
+    // Temporary per-state data.
+    LocalMemory<int32_t> parents((int32_t *)uprv_malloc(maxStateCount * sizeof(int32_t)));
+    LocalMemory<int32_t> depths((int32_t *)uprv_malloc(maxStateCount * sizeof(int32_t)));
+    LocalMemory<int64_t> lastCEs((int64_t *)uprv_malloc(maxStateCount * sizeof(int64_t)));
+    LocalMemory<int32_t> order((int32_t *)uprv_malloc(maxStateCount * sizeof(int32_t)));
+    LocalMemory<int32_t> terminals((int32_t *)uprv_malloc(msearch->patternCount * sizeof(int32_t)));
+    if (msearch->edges == NULL || msearch->failures == NULL || msearch->outputLinks == NULL ||
+            msearch->outputStarts == NULL || msearch->outputs == NULL ||
+            parents.isNull() || depths.isNull() || lastCEs.isNull() || order.isNull() ||
+            terminals.isNull()) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < capacity; ++i) {
+        msearch->edges[i].to = -1;
+    }
+
+    // Build the trie of the patterns.
+    int32_t stateCount = 1;
+    depths[0] = 0;
+    const int64_t *p = pces;
+    for (int32_t i = 0; i < msearch->patternCount; ++i) {
+        int32_t state = 0;
+        for (int32_t j = 0; j < msearch->patternCELengths[i]; ++j) {
+            int64_t ce = *p++;
+            int32_t next = findMultiSearchEdge(msearch, state, ce);
+            if (next < 0) {
+                next = stateCount++;
+                addMultiSearchEdge(msearch, state, ce, next);
+                parents[next] = state;
+                depths[next] = depths[state] + 1;
+                lastCEs[next] = ce;
+            }
+            state = next;
+        }
+        terminals[i] = state;
+    }
+    U_ASSERT(p == pces + totalLength);
+
+    // Outputs: the patterns ending in each state, in pattern order.
+    uprv_memset(msearch->outputStarts, 0, (stateCount + 1) * sizeof(int32_t));
+    for (int32_t i = 0; i < msearch->patternCount; ++i) {
+        ++msearch->outputStarts[terminals[i] + 1];
+    }
+    for (int32_t s = 0; s < stateCount; ++s) {
+        msearch->outputStarts[s + 1] += msearch->outputStarts[s];
+    }
+    {
+        // Use the failures array temporarily for the fill positions.
+        int32_t *fill = msearch->failures;
+        uprv_memcpy(fill, msearch->outputStarts, stateCount * sizeof(int32_t));
+        for (int32_t i = 0; i < msearch->patternCount; ++i) {
+            msearch->outputs[fill[terminals[i]]++] = i;
+        }
+    }
+
+    // Visit the states in breadth-first order (by depth),
+    // so that each state's failure is computed before those of deeper states.
+    int32_t maxDepth = 0;
+    for (int32_t s = 0; s < stateCount; ++s) {
+        if (depths[s] > maxDepth) { maxDepth = depths[s]; }
+    }
+    {
+        LocalMemory<int32_t> depthStarts((int32_t *)uprv_malloc((maxDepth + 2) * sizeof(int32_t)));
+        if (depthStarts.isNull()) {
+            *status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        uprv_memset(depthStarts.getAlias(), 0, (maxDepth + 2) * sizeof(int32_t));
+        for (int32_t s = 0; s < stateCount; ++s) {
+            ++depthStarts[depths[s] + 1];
+        }
+        for (int32_t d = 0; d <= maxDepth; ++d) {
+            depthStarts[d + 1] += depthStarts[d];
+        }
+        for (int32_t s = 0; s < stateCount; ++s) {
+            order[depthStarts[depths[s]]++] = s;
+        }
+    }
+    msearch->failures[0] = 0;
+    msearch->outputLinks[0] = -1;
+    for (int32_t k = 1; k < stateCount; ++k) {
+        int32_t s = order[k];
+        int32_t parent = parents[s];
+        int32_t failure = 0;
+        if (parent != 0) {
+            // The longest proper suffix of this state's CEs that is a trie state.
+            int64_t ce = lastCEs[s];
+            int32_t f = msearch->failures[parent];
+            int32_t next;
+            while ((next = findMultiSearchEdge(msearch, f, ce)) < 0 && f != 0) {
+                f = msearch->failures[f];
+            }
+            if (next >= 0) {
+                failure = next;
+            }
+        }
+        msearch->failures[s] = failure;
+        msearch->outputLinks[s] =
+            msearch->outputStarts[failure] < msearch->outputStarts[failure + 1] ?
+                failure : msearch->outputLinks[failure];
+    }
+}
+
+/**
+ * Checks the match of pattern patternIndex which ends with the last CE consumed.
+ * @return TRUE if the match is acceptable, with its bounds in *mStart and *mLimit
+ */
+static UBool checkMultiMatch(UMultiStringSearch *msearch, int32_t patternIndex,
+                             int32_t *mStart, int32_t *mLimit) {
+    CEIBuffer &ceb = *msearch->ceb;
+    int32_t lastIx = msearch->ceIndex - 1;
+    const CEI *firstCEI = ceb.get(lastIx - msearch->patternCELengths[patternIndex] + 1);
+    const CEI *lastCEI = ceb.get(lastIx);
+    const CEI *nextCEI = ceb.get(lastIx + 1);
+    if (firstCEI == NULL || lastCEI == NULL || nextCEI == NULL) {
+        return FALSE;
+    }
+    // Reject a match which ends inside an expansion, as in searchForward().
+    if (nextCEI->lowIndex == nextCEI->highIndex && nextCEI->ce != UCOL_PROCESSED_NULLORDER) {
+        return FALSE;
+    }
+    UStringSearch *strsrch = msearch->strsrch;
+    *mStart = firstCEI->lowIndex;
+    return checkMatchBounds(strsrch, firstCEI, lastCEI, nextCEI,
+                            lastCEI->lowIndex, nextCEI->lowIndex, mLimit) &&
+        checkIdentical(strsrch, *mStart, *mLimit,
+                       msearch->patterns[patternIndex], msearch->patternLengths[patternIndex]);
+}
+
+U_CAPI UMultiStringSearch * U_EXPORT2 usearch_openMulti(
+                                  const UChar *const    patterns[],
+                                  const int32_t         patternLengths[],
+                                        int32_t         patternCount,
+                                  const UChar          *text,
+                                        int32_t         textlength,
+                                  const UCollator      *collator,
+                                        UBreakIterator *breakiter,
+                                        UErrorCode     *status)
+{
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (patterns == NULL || patternCount <= 0) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    for (int32_t i = 0; i < patternCount; ++i) {
+        if (patterns[i] == NULL || (patternLengths != NULL && patternLengths[i] < -1)) {
+            *status = U_ILLEGAL_ARGUMENT_ERROR;
+            return NULL;
+        }
+    }
+    UMultiStringSearch *msearch = (UMultiStringSearch *)uprv_malloc(sizeof(UMultiStringSearch));
+    if (msearch == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    uprv_memset(msearch, 0, sizeof(UMultiStringSearch));
+    msearch->patternCount = patternCount;
+    LocalUMultiStringSearchPointer result(msearch);
+
+    msearch->patterns = (const UChar **)uprv_malloc(patternCount * sizeof(const UChar *));
+    msearch->patternLengths = (int32_t *)uprv_malloc(patternCount * sizeof(int32_t));
+    msearch->patternCELengths = (int32_t *)uprv_malloc(patternCount * sizeof(int32_t));
+    if (msearch->patterns == NULL || msearch->patternLengths == NULL ||
+            msearch->patternCELengths == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    for (int32_t i = 0; i < patternCount; ++i) {
+        int32_t length = patternLengths != NULL ? patternLengths[i] : -1;
+        if (length < 0) {
+            length = u_strlen(patterns[i]);
+        }
+        if (length == 0) {
+            *status = U_ILLEGAL_ARGUMENT_ERROR;
+            return NULL;
+        }
+        msearch->patterns[i] = patterns[i];
+        msearch->patternLengths[i] = length;
+    }
+    msearch->strsrch = usearch_openFromCollator(patterns[0], msearch->patternLengths[0],
+                                                text, textlength, collator, breakiter, status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    UStringSearch *strsrch = msearch->strsrch;
+
+    // Collect the processed CEs of all patterns.
+    UVector64 pces(*status);
+    int32_t longest = 0;
+    for (int32_t i = 0; i < patternCount && U_SUCCESS(*status); ++i) {
+        ucol_setText(strsrch->utilIter, patterns[i], msearch->patternLengths[i], status);
+        UCollationPCE iter(strsrch->utilIter);
+        int32_t start = pces.size();
+        int64_t pce;
+        while ((pce = iter.nextProcessed(NULL, NULL, status)) != UCOL_PROCESSED_NULLORDER &&
+                U_SUCCESS(*status)) {
+            pces.addElement(pce, *status);
+        }
+        int32_t ceLength = pces.size() - start;
+        if (ceLength == 0) {
+            // Such a pattern would match everywhere.
+            *status = U_ILLEGAL_ARGUMENT_ERROR;
+        }
+        msearch->patternCELengths[i] = ceLength;
+        if (ceLength > msearch->patternCELengths[longest]) {
+            longest = i;
+        }
+    }
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (longest != 0) {
+        usearch_setPattern(strsrch, patterns[longest], msearch->patternLengths[longest], status);
+    }
+    initializePatternPCETable(strsrch, status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    U_ASSERT(strsrch->pattern.pcesLength == msearch->patternCELengths[longest]);
+
+    buildMultiSearchAutomaton(msearch, pces.getBuffer(), pces.size(), status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    return result.orphan();
+}
+
+U_CAPI void U_EXPORT2 usearch_closeMulti(UMultiStringSearch *msearch)
+{
+    if (msearch == NULL) {
+        return;
+    }
+    delete msearch->ceb;
+    usearch_close(msearch->strsrch);
+    uprv_free(msearch->patterns);
+    uprv_free(msearch->patternLengths);
+    uprv_free(msearch->patternCELengths);
+    uprv_free(msearch->edges);
+    uprv_free(msearch->failures);
+    uprv_free(msearch->outputLinks);
+    uprv_free(msearch->outputStarts);
+    uprv_free(msearch->outputs);
+    uprv_free(msearch);
+}
+
+U_CAPI void U_EXPORT2 usearch_setMultiText(UMultiStringSearch *msearch,
+                                           const UChar        *text,
+                                           int32_t             textlength,
+                                           UErrorCode         *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    if (msearch == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    usearch_setText(msearch->strsrch, text, textlength, status);
+    if (U_SUCCESS(*status)) {
+        // Restart with the next usearch_nextMulti().
+        delete msearch->ceb;
+        msearch->ceb = NULL;
+    }
+}
+
+U_CAPI UBool U_EXPORT2 usearch_nextMulti(UMultiStringSearch *msearch,
+                                         int32_t            *patternIndex,
+                                         int32_t            *matchStart,
+                                         int32_t            *matchLimit,
+                                         UErrorCode         *status)
+{
+    if (matchStart != NULL) {
+        *matchStart = -1;
+    }
+    if (matchLimit != NULL) {
+        *matchLimit = -1;
+    }
+    if (U_FAILURE(*status)) {
+        return FALSE;
+    }
+    if (msearch == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    if (msearch->ceb == NULL) {
+        ucol_setOffset(msearch->strsrch->textIter, 0, status);
+        msearch->ceb = new CEIBuffer(msearch->strsrch, status);
+        if (msearch->ceb == NULL) {
+            *status = U_MEMORY_ALLOCATION_ERROR;
+        }
+        if (U_FAILURE(*status)) {
+            delete msearch->ceb;
+            msearch->ceb = NULL;
+            return FALSE;
+        }
+        msearch->ceIndex = 0;
+        msearch->state = 0;
+        msearch->outputState = -1;
+        msearch->outputIndex = 0;
+    }
+    for (;;) {
+        // Report the patterns which end with the last CE,
+        // walking from the current state through shorter suffixes.
+        while (msearch->outputState >= 0) {
+            int32_t outputLimit = msearch->outputStarts[msearch->outputState + 1];
+            while (msearch->outputIndex < outputLimit) {
+                int32_t p = msearch->outputs[msearch->outputIndex++];
+                int32_t start, limit;
+                if (checkMultiMatch(msearch, p, &start, &limit)) {
+                    if (patternIndex != NULL) {
+                        *patternIndex = p;
+                    }
+                    if (matchStart != NULL) {
+                        *matchStart = start;
+                    }
+                    if (matchLimit != NULL) {
+                        *matchLimit = limit;
+                    }
+                    return TRUE;
+                }
+            }
+            msearch->outputState = msearch->outputLinks[msearch->outputState];
+            if (msearch->outputState >= 0) {
+                msearch->outputIndex = msearch->outputStarts[msearch->outputState];
+            }
+        }
+
+        const CEI *cei = msearch->ceb->get(msearch->ceIndex);
+        if (cei == NULL) {
+            *status = U_INTERNAL_PROGRAM_ERROR;
+            return FALSE;
+        }
+        if (cei->ce == UCOL_PROCESSED_NULLORDER) {
+            return FALSE;
+        }
+        ++msearch->ceIndex;
+        int32_t state = msearch->state;
+        int32_t next;
+        while ((next = findMultiSearchEdge(msearch, state, cei->ce)) < 0 && state != 0) {
+            state = msearch->failures[state];
+        }
+        state = next >= 0 ? next : 0;
+        msearch->state = state;
+        msearch->outputState =
+            msearch->outputStarts[state] < msearch->outputStarts[state + 1] ?
+                state : msearch->outputLinks[state];
+        if (msearch->outputState >= 0) {
+            msearch->outputIndex = msearch->outputStarts[msearch->outputState];
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
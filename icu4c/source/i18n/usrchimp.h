@@ -126,6 +126,7 @@ U_NAMESPACE_END
 
 #define INITIAL_ARRAY_SIZE_       256
 #define MAX_TABLE_SIZE_           257
+#define SKIP_CACHE_SIZE_          256
 
 struct USearch {
     // required since collation element iterator does not have a getText API
@@ -161,6 +162,14 @@ struct UPattern {
           int16_t             defaultShiftSize;
           int16_t             shift[MAX_TABLE_SIZE_];
           int16_t             backShift[MAX_TABLE_SIZE_];
+          // Forward search skipping over the text, see usearch_search().
+          // skipState is 0 until initialized for the current pces,
+          // skipShift[] is the Horspool shift table keyed on processed CEs,
+          // and the cache maps text code units to their processed CEs.
+          int8_t              skipState;
+          int16_t             skipShift[MAX_TABLE_SIZE_];
+          UChar               skipCacheChars[SKIP_CACHE_SIZE_];
+          int64_t             skipCachePCEs[SKIP_CACHE_SIZE_];
 };
 
 struct UStringSearch {
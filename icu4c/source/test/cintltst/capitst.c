@@ -87,6 +87,10 @@ void addCollAPITest(TestNode** root)
     addTest(root, &TestBengaliSortKey, "tscoll/capitst/TestBengaliSortKey");
     addTest(root, &TestGetKeywordValuesForLocale, "tscoll/capitst/TestGetKeywordValuesForLocale");
     addTest(root, &TestStrcollNull, "tscoll/capitst/TestStrcollNull");
+    addTest(root, &TestGetSortKeys, "tscoll/capitst/TestGetSortKeys");
+    addTest(root, &TestSortStrings, "tscoll/capitst/TestSortStrings");
+    addTest(root, &TestCollationHash, "tscoll/capitst/TestCollationHash");
+    addTest(root, &TestCompactSortKey, "tscoll/capitst/TestCompactSortKey");
 }
 
 void TestGetSetAttr(void) {
@@ -2558,4 +2562,171 @@ static void TestStrcollNull(void) {
     ucol_close(coll);
 }
 
+static void TestGetSortKeys(void) {
+    static const UChar a[] = { 0x61, 0 };
+    static const UChar aUmlaut[] = { 0xe4, 0x62, 0 };
+    static const UChar han[] = { 0x4e00, 0x31, 0 };
+    static const UChar *const sources[] = { a, aUmlaut, han };
+    static const char *const sources8[] = { "a", "\xC3\xA4" "b", "\xE4\xB8\x80" "1" };
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &status);
+    uint8_t keys[200], keys8[200], key[100], key8[100];
+    int32_t offsets[4], offsets8[4];
+    int32_t i, length, length8;
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(en) failed - %s\n", u_errorName(status));
+        return;
+    }
+    length = ucol_getSortKeys(coll, sources, NULL, 3, NULL, 0, offsets, &status);
+    if (status != U_BUFFER_OVERFLOW_ERROR || length != offsets[3] || length > UPRV_LENGTHOF(keys)) {
+        log_err("ucol_getSortKeys() preflighting failed - %s\n", u_errorName(status));
+        ucol_close(coll);
+        return;
+    }
+    status = U_ZERO_ERROR;
+    length = ucol_getSortKeys(coll, sources, NULL, 3, keys, UPRV_LENGTHOF(keys), offsets, &status);
+    length8 = ucol_getSortKeysUTF8(coll, sources8, NULL, 3,
+                                   keys8, UPRV_LENGTHOF(keys8), offsets8, &status);
+    if (U_FAILURE(status) || length != length8) {
+        log_err("ucol_getSortKeys()/ucol_getSortKeysUTF8() failed - %s\n", u_errorName(status));
+        ucol_close(coll);
+        return;
+    }
+    for (i = 0; i < 3; ++i) {
+        int32_t keyLength = ucol_getSortKey(coll, sources[i], -1, key, UPRV_LENGTHOF(key));
+        if (offsets[i + 1] - offsets[i] != keyLength ||
+                uprv_memcmp(keys + offsets[i], key, keyLength) != 0) {
+            log_err("ucol_getSortKeys()[%d] != ucol_getSortKey()\n", (int)i);
+        }
+        if (offsets8[i] != offsets[i] || uprv_memcmp(keys8 + offsets8[i], key, keyLength) != 0) {
+            log_err("ucol_getSortKeysUTF8()[%d] != ucol_getSortKey()\n", (int)i);
+        }
+        length8 = ucol_getSortKeyUTF8(coll, sources8[i], -1, key8, UPRV_LENGTHOF(key8), &status);
+        if (U_FAILURE(status) || length8 != keyLength || uprv_memcmp(key8, key, keyLength) != 0) {
+            log_err("ucol_getSortKeyUTF8(%d) != ucol_getSortKey() - %s\n",
+                    (int)i, u_errorName(status));
+        }
+    }
+    ucol_close(coll);
+}
+
+static void TestSortStrings(void) {
+    /* "b", "\\u00E4", "a", "A", "b", "ab" */
+    static const UChar b[] = { 0x62, 0 };
+    static const UChar aUmlaut[] = { 0xe4, 0 };
+    static const UChar a[] = { 0x61, 0 };
+    static const UChar capitalA[] = { 0x41, 0 };
+    static const UChar ab[] = { 0x61, 0x62, 0 };
+    static const UChar *const strings[] = { b, aUmlaut, a, capitalA, b, ab };
+    static const char *const strings8[] = { "b", "\xC3\xA4", "a", "A", "b", "ab" };
+    static const int32_t expected[] = { 2, 3, 1, 5, 0, 4 };
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &status);
+    int32_t order[6], parts[6];
+    int32_t i;
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(en) failed - %s\n", u_errorName(status));
+        return;
+    }
+    ucol_sortStrings(coll, strings, NULL, 6, order, TRUE, &status);
+    if (U_FAILURE(status) || uprv_memcmp(order, expected, sizeof(expected)) != 0) {
+        log_err("ucol_sortStrings() failed - %s\n", u_errorName(status));
+        for (i = 0; i < 6; ++i) {
+            log_verbose("order[%d]=%d\n", (int)i, (int)order[i]);
+        }
+    }
+    uprv_memset(order, 0, sizeof(order));
+    ucol_sortStringsUTF8(coll, strings8, NULL, 6, order, TRUE, &status);
+    if (U_FAILURE(status) || uprv_memcmp(order, expected, sizeof(expected)) != 0) {
+        log_err("ucol_sortStringsUTF8() failed - %s\n", u_errorName(status));
+    }
+    /* Sort two halves separately, then merge them. */
+    ucol_sortStringRange(coll, strings, NULL, 0, 3, parts, TRUE, &status);
+    ucol_sortStringRangeUTF8(coll, strings8, NULL, 3, 6, parts + 3, TRUE, &status);
+    uprv_memset(order, 0, sizeof(order));
+    ucol_mergeSortedPermutations(coll, strings, NULL, parts, 3, parts + 3, 3, order, TRUE, &status);
+    if (U_FAILURE(status) || uprv_memcmp(order, expected, sizeof(expected)) != 0) {
+        log_err("ucol_sortStringRange() + ucol_mergeSortedPermutations() failed - %s\n",
+                u_errorName(status));
+    }
+    uprv_memset(order, 0, sizeof(order));
+    ucol_mergeSortedPermutationsUTF8(coll, strings8, NULL, parts + 3, 3, parts, 3, order, TRUE, &status);
+    if (U_FAILURE(status) || uprv_memcmp(order, expected, sizeof(expected)) != 0) {
+        log_err("ucol_mergeSortedPermutationsUTF8() failed - %s\n", u_errorName(status));
+    }
+    ucol_close(coll);
+}
+
+static void TestCollationHash(void) {
+    static const UChar a[] = { 0x61, 0 };
+    static const UChar capitalA[] = { 0x41, 0 };
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &status);
+    uint64_t hashA, hashCapitalA;
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(en) failed - %s\n", u_errorName(status));
+        return;
+    }
+    hashA = ucol_getCollationHash(coll, a, -1, UCOL_PRIMARY, &status);
+    hashCapitalA = ucol_getCollationHash(coll, capitalA, 1, UCOL_PRIMARY, &status);
+    if (U_FAILURE(status) || hashA != hashCapitalA ||
+            hashA != ucol_getCollationHashUTF8(coll, "A", -1, UCOL_PRIMARY, &status)) {
+        log_err("ucol_getCollationHash(PRIMARY) differs for a/A - %s\n", u_errorName(status));
+    }
+    hashA = ucol_getCollationHash(coll, a, -1, UCOL_DEFAULT, &status);
+    hashCapitalA = ucol_getCollationHashUTF8(coll, "A", 1, UCOL_DEFAULT, &status);
+    if (U_FAILURE(status) || hashA == hashCapitalA) {
+        log_err("ucol_getCollationHash(UCOL_DEFAULT) is the same for a/A - %s\n",
+                u_errorName(status));
+    }
+    ucol_close(coll);
+}
+
+static void TestCompactSortKey(void) {
+    static const UChar cote[] = { 0x63, 0x6f, 0x74, 0x65, 0 };
+    static const UChar coteAccents[] = { 0x43, 0xf4, 0x74, 0xe9, 0 };
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &status);
+    UCollationKeyStats stats;
+    uint8_t key[50], key2[50], fullKey[50];
+    int32_t length, length2, fullLength;
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(en) failed - %s\n", u_errorName(status));
+        return;
+    }
+    uprv_memset(&stats, 0, sizeof(stats));
+    /* Without truncation, the same as ucol_getSortKey(). */
+    length = ucol_getCompactSortKey(coll, cote, -1, UCOL_DEFAULT, 0,
+                                    key, UPRV_LENGTHOF(key), &stats, &status);
+    fullLength = ucol_getSortKey(coll, cote, -1, fullKey, UPRV_LENGTHOF(fullKey));
+    if (U_FAILURE(status) || length != fullLength || uprv_memcmp(key, fullKey, length) != 0) {
+        log_err("ucol_getCompactSortKey(no limit) != ucol_getSortKey() - %s\n", u_errorName(status));
+    }
+    /* Secondary strength ignores case. */
+    length = ucol_getCompactSortKey(coll, coteAccents, -1, UCOL_SECONDARY, 0,
+                                    key, UPRV_LENGTHOF(key), &stats, &status);
+    length2 = ucol_getCompactSortKeyUTF8(coll, "c\xc3\xb4t\xc3\xa9", -1, UCOL_SECONDARY, 0,
+                                         key2, UPRV_LENGTHOF(key2), &stats, &status);
+    if (U_FAILURE(status) || length != length2 || uprv_memcmp(key, key2, length) != 0) {
+        log_err("ucol_getCompactSortKey(SECONDARY) differs for C\\u00F4t\\u00E9/c\\u00F4t\\u00E9 - %s\n",
+                u_errorName(status));
+    }
+    /* A truncated secondary level sorts after the unaccented string. */
+    length = ucol_getCompactSortKey(coll, coteAccents, -1, UCOL_SECONDARY, 1,
+                                    key, UPRV_LENGTHOF(key), &stats, &status);
+    length2 = ucol_getCompactSortKey(coll, cote, -1, UCOL_SECONDARY, 1,
+                                     key2, UPRV_LENGTHOF(key2), &stats, &status);
+    if (U_FAILURE(status) || uprv_strcmp((const char *)key2, (const char *)key) >= 0) {
+        log_err("ucol_getCompactSortKey(truncated) is out of order - %s\n", u_errorName(status));
+    }
+    if (stats.keyCount != 5 || stats.truncatedCount != 1 || stats.totalLength >= stats.fullLength) {
+        log_err("ucol_getCompactSortKey() collected unexpected statistics\n");
+    }
+    ucol_getCompactSortKey(coll, cote, -1, UCOL_ON, 0, key, UPRV_LENGTHOF(key), NULL, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_getCompactSortKey(strength=UCOL_ON) did not fail - %s\n", u_errorName(status));
+    }
+    ucol_close(coll);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -135,6 +135,27 @@
      */
     static void TestStrcollNull(void);
 
+    /**
+     * Test ucol_getSortKeys(), ucol_getSortKeysUTF8() and ucol_getSortKeyUTF8()
+     */
+    static void TestGetSortKeys(void);
+
+    /**
+     * Test ucol_sortStrings(), ucol_sortStringRange(), ucol_mergeSortedPermutations()
+     * and their UTF-8 versions
+     */
+    static void TestSortStrings(void);
+
+    /**
+     * Test ucol_getCollationHash() and ucol_getCollationHashUTF8()
+     */
+    static void TestCollationHash(void);
+
+    /**
+     * Test ucol_getCompactSortKey() and ucol_getCompactSortKeyUTF8()
+     */
+    static void TestCompactSortKey(void);
+
 #endif /* #if !UCONFIG_NO_COLLATION */
 
 #endif
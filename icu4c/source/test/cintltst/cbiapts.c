@@ -50,6 +50,7 @@ static void TestBreakIteratorTailoring(void);
 static void TestBreakIteratorRefresh(void);
 static void TestBug11665(void);
 static void TestBreakIteratorSuppressions(void);
+static void TestBreakIteratorGetBoundaries(void);
 
 void addBrkIterAPITest(TestNode** root);
 
@@ -67,6 +68,7 @@ void addBrkIterAPITest(TestNode** root)
     addTest(root, &TestBreakIteratorRefresh, "tstxtbd/cbiapts/TestBreakIteratorRefresh");
     addTest(root, &TestBug11665, "tstxtbd/cbiapts/TestBug11665");
     addTest(root, &TestBreakIteratorSuppressions, "tstxtbd/cbiapts/TestBreakIteratorSuppressions");
+    addTest(root, &TestBreakIteratorGetBoundaries, "tstxtbd/cbiapts/TestBreakIteratorGetBoundaries");
 }
 
 #define CLONETEST_ITERATOR_COUNT 2
@@ -1063,4 +1065,51 @@ static void TestBreakIteratorSuppressions(void) {
 }
 
 
+static void TestBreakIteratorGetBoundaries(void) {
+    /* "The quick (\"brown\") fox can't jump 32.3 feet, right?" */
+    static const char text[] = "The quick (\"brown\") fox can't jump 32.3 feet, right?";
+    UChar testStr[60];
+    int32_t expected[40];
+    int32_t expectedStatuses[40];
+    int32_t boundaries[40];
+    int32_t statuses[40];
+    int32_t expectedLength = 0, length = 0, n, pos;
+    UErrorCode status = U_ZERO_ERROR;
+    UBreakIterator *bi = ubrk_open(UBRK_WORD, "en_US", NULL, 0, &status);
+    if (U_FAILURE(status)) {
+        log_data_err("FAIL: ubrk_open(UBRK_WORD) status %s (Are you missing data?)\n", u_errorName(status));
+        return;
+    }
+    u_uastrcpy(testStr, text);
+    ubrk_setText(bi, testStr, -1, &status);
+    TEST_ASSERT_SUCCESS(status);
+
+    ubrk_first(bi);
+    while ((pos = ubrk_next(bi)) != UBRK_DONE) {
+        expected[expectedLength] = pos;
+        expectedStatuses[expectedLength++] = ubrk_getRuleStatus(bi);
+    }
+
+    /* Three boundaries at a time. */
+    do {
+        n = ubrk_getBoundaries(bi, length == 0 ? 0 : boundaries[length - 1],
+                               boundaries + length, statuses + length, 3, &status);
+        length += n;
+    } while (n == 3 && U_SUCCESS(status) && length + 3 <= UPRV_LENGTHOF(boundaries));
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(length == expectedLength);
+    TEST_ASSERT(uprv_memcmp(boundaries, expected, length * sizeof(int32_t)) == 0);
+    TEST_ASSERT(uprv_memcmp(statuses, expectedStatuses, length * sizeof(int32_t)) == 0);
+    TEST_ASSERT(ubrk_current(bi) == u_strlen(testStr));
+
+    /* All at once, without the status values. */
+    n = ubrk_getBoundaries(bi, 10, boundaries, NULL, UPRV_LENGTHOF(boundaries), &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(n == expectedLength - 4 && boundaries[0] == 11);
+
+    n = ubrk_getBoundaries(bi, 0, boundaries, NULL, -1, &status);
+    TEST_ASSERT(n == 0 && status == U_ILLEGAL_ARGUMENT_ERROR);
+    ubrk_close(bi);
+}
+
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
@@ -34,6 +34,7 @@ void TestGregorianChange(void);
 void TestFieldDifference(void);
 void TestAddRollEra0AndEraBounds(void);
 void TestGetTZTransition(void);
+void TestGetTimeZoneOffsets(void);
 
 void TestGetWindowsTimeZoneID(void);
 void TestGetTimeZoneIDByWindowsID(void);
@@ -57,6 +58,7 @@ void addCalTest(TestNode** root)
     addTest(root, &TestAmbiguousWallTime, "tsformat/ccaltst/TestAmbiguousWallTime");
     addTest(root, &TestAddRollEra0AndEraBounds, "tsformat/ccaltst/TestAddRollEra0AndEraBounds");
     addTest(root, &TestGetTZTransition, "tsformat/ccaltst/TestGetTZTransition");
+    addTest(root, &TestGetTimeZoneOffsets, "tsformat/ccaltst/TestGetTimeZoneOffsets");
     addTest(root, &TestGetWindowsTimeZoneID, "tsformat/ccaltst/TestGetWindowsTimeZoneID");
     addTest(root, &TestGetTimeZoneIDByWindowsID, "tsformat/ccaltst/TestGetTimeZoneIDByWindowsID");
 }
@@ -2358,6 +2360,54 @@ void TestGetTZTransition() {
     }
 }
 
+void TestGetTimeZoneOffsets() {
+    enum { DATE_COUNT = 2000 };
+    UErrorCode status = U_ZERO_ERROR;
+    UDate dates[DATE_COUNT];
+    int32_t rawOffsets[DATE_COUNT], dstOffsets[DATE_COUNT];
+    UDate start;
+    int32_t i;
+    UCalendar * ucal = ucal_open(zoneUSPacific, -1, "en", UCAL_GREGORIAN, &status);
+    if ( U_FAILURE(status) ) {
+        log_data_err("FAIL setup: ucal_open status %s\n", u_errorName(status));
+        return;
+    }
+    ucal_setDateTime(ucal, 1995, UCAL_JANUARY, 1, 0, 0, 0, &status);
+    start = ucal_getMillis(ucal, &status);
+    /* Ascending dates every 17 hours for about 4 years, then the same dates descending. */
+    for (i = 0; i < DATE_COUNT / 2; i++) {
+        dates[i] = start + i * 17.0 * 60 * 60 * 1000;
+        dates[DATE_COUNT - 1 - i] = dates[i];
+    }
+    ucal_getTimeZoneOffsets(ucal, dates, DATE_COUNT, rawOffsets, dstOffsets, &status);
+    if ( U_FAILURE(status) ) {
+        log_err("FAIL: ucal_getTimeZoneOffsets status %s\n", u_errorName(status));
+        ucal_close(ucal);
+        return;
+    }
+    if (ucal_getMillis(ucal, &status) != start) {
+        log_err("FAIL: ucal_getTimeZoneOffsets modified the calendar\n");
+    }
+    for (i = 0; i < DATE_COUNT; i++) {
+        int32_t raw, dst;
+        ucal_setMillis(ucal, dates[i], &status);
+        raw = ucal_get(ucal, UCAL_ZONE_OFFSET, &status);
+        dst = ucal_get(ucal, UCAL_DST_OFFSET, &status);
+        if ( U_FAILURE(status) || raw != rawOffsets[i] || dst != dstOffsets[i] ) {
+            log_err("FAIL: ucal_getTimeZoneOffsets at %.1f returned %d/%d, expected %d/%d (status %s)\n",
+                    dates[i], rawOffsets[i], dstOffsets[i], raw, dst, u_errorName(status));
+            break;
+        }
+    }
+
+    status = U_ZERO_ERROR;
+    ucal_getTimeZoneOffsets(ucal, NULL, 1, rawOffsets, dstOffsets, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("FAIL: ucal_getTimeZoneOffsets(NULL dates) status %s\n", u_errorName(status));
+    }
+    ucal_close(ucal);
+}
+
 static const UChar winEastern[] = /* Eastern Standard Time */
     {0x45,0x61,0x73,0x74,0x65,0x72,0x6E,0x20,0x53,0x74,0x61,0x6E,0x64,0x61,0x72,0x64,0x20,0x54,0x69,0x6D,0x65,0x00};
 
@@ -63,6 +63,8 @@ TestGetRawDecomposition(void);
 
 static void TestAppendRestoreMiddle(void);
 static void TestGetEasyToUseInstance(void);
+static void TestNormalizeStream(void);
+static void TestNormalizeBatch(void);
 
 static const char* const canonTests[][3] = {
     /* Input*/                    /*Decomposed*/                /*Composed*/
@@ -154,6 +156,8 @@ void addNormTest(TestNode** root)
     addTest(root, &TestGetRawDecomposition, "tsnorm/cnormtst/TestGetRawDecomposition");
     addTest(root, &TestAppendRestoreMiddle, "tsnorm/cnormtst/TestAppendRestoreMiddle");
     addTest(root, &TestGetEasyToUseInstance, "tsnorm/cnormtst/TestGetEasyToUseInstance");
+    addTest(root, &TestNormalizeStream, "tsnorm/cnormtst/TestNormalizeStream");
+    addTest(root, &TestNormalizeBatch, "tsnorm/cnormtst/TestNormalizeBatch");
 }
 
 static const char* const modeStrings[]={
@@ -1686,4 +1690,123 @@ TestGetEasyToUseInstance() {
     }
 }
 
+static void
+TestNormalizeStream() {
+    static const UChar in[]={
+        0x41, 0x30a, 0x327, 0x20, 0x1100, 0x1161, 0x11a8, 0xd834, 0xdd5e, 0xd834, 0xdd65,
+        0x61, 0x301, 0x2e, 0x1e0a, 0x323, 0x307
+    };
+    UChar expected[40], out[40];
+    UChar *target;
+    const UChar *source;
+    int32_t expectedLength, chunkLength, start, limit, capacity;
+    UNormalizer2Stream *stream;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    const UNormalizer2 *n2=unorm2_getNFCInstance(&errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "unorm2_getNFCInstance() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    expectedLength=unorm2_normalize(n2, in, UPRV_LENGTHOF(in), expected, UPRV_LENGTHOF(expected), &errorCode);
+    stream=unorm2_openStream(n2, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("unorm2_openStream() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    /* Feed the input in chunks, with a small target buffer to test the overflow handling. */
+    for(chunkLength=1; chunkLength<=UPRV_LENGTHOF(in); ++chunkLength) {
+        target=out;
+        capacity=3;
+        for(start=0; start<UPRV_LENGTHOF(in) && U_SUCCESS(errorCode); start=limit) {
+            limit=start+chunkLength;
+            if(limit>UPRV_LENGTHOF(in)) {
+                limit=UPRV_LENGTHOF(in);
+            }
+            source=in+start;
+            for(;;) {
+                unorm2_normalizeStream(stream, &target, target+capacity, &source, in+limit,
+                                       (UBool)(limit==UPRV_LENGTHOF(in)), &errorCode);
+                if(errorCode!=U_BUFFER_OVERFLOW_ERROR) {
+                    break;
+                }
+                errorCode=U_ZERO_ERROR;
+            }
+        }
+        if(U_FAILURE(errorCode)) {
+            log_err("unorm2_normalizeStream(chunks of %d) failed: %s\n",
+                    (int)chunkLength, u_errorName(errorCode));
+            break;
+        }
+        if((target-out)!=expectedLength || 0!=u_memcmp(out, expected, expectedLength)) {
+            log_err("unorm2_normalizeStream(chunks of %d) differs from unorm2_normalize()\n",
+                    (int)chunkLength);
+        }
+    }
+
+    /* Held-back text is discarded by unorm2_resetStream(). */
+    target=out;
+    source=in;
+    unorm2_normalizeStream(stream, &target, out+UPRV_LENGTHOF(out), &source, in+2, FALSE, &errorCode);
+    unorm2_resetStream(stream);
+    unorm2_normalizeStream(stream, &target, out+UPRV_LENGTHOF(out), &source, source, TRUE, &errorCode);
+    if(U_FAILURE(errorCode) || source!=in+2 || target!=out) {
+        log_err("unorm2_resetStream() did not discard the held-back text\n");
+    }
+    unorm2_closeStream(stream);
+
+    errorCode=U_ZERO_ERROR;
+    stream=unorm2_openStream(NULL, &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR || stream!=NULL) {
+        log_err("unorm2_openStream(NULL) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+}
+
+static void
+TestNormalizeBatch() {
+    static const UChar s0[]={ 0x61, 0x62, 0x63, 0 };               /* unchanged */
+    static const UChar s1[]={ 0x41, 0x30a, 0x327, 0 };             /* -> 0xc5 0x327 */
+    static const UChar s2[]={ 0x1100, 0x1161, 0x11a8, 0x2e, 0 };    /* -> 0xac01 0x2e */
+    static const UChar s3[]={ 0xc5, 0 };                            /* unchanged */
+    static const UChar *const srcs[]={ s0, s1, s2, s3 };
+    static const int32_t srcLengths[]={ 3, -1, 4, -1 };
+    static const UChar expectedDest[]={ 0xc5, 0x327, 0xac01, 0x2e };
+    static const int32_t expectedStarts[]={ -1, 0, 2, -1 };
+    static const int32_t expectedLengths[]={ 3, 2, 2, 1 };
+    UChar dest[8];
+    int32_t destStarts[4], destLengths[4];
+    int32_t i, length;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    const UNormalizer2 *n2=unorm2_getNFCInstance(&errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "unorm2_getNFCInstance() failed: %s\n", u_errorName(errorCode));
+        return;
+    }
+    /* preflighting */
+    length=unorm2_normalizeBatch(n2, srcs, srcLengths, 4, NULL, 0, destStarts, destLengths, &errorCode);
+    if(errorCode!=U_BUFFER_OVERFLOW_ERROR || length!=UPRV_LENGTHOF(expectedDest)) {
+        log_err("unorm2_normalizeBatch(preflighting) failed: %s length %d\n",
+                u_errorName(errorCode), (int)length);
+    }
+    errorCode=U_ZERO_ERROR;
+    length=unorm2_normalizeBatch(n2, srcs, srcLengths, 4, dest, UPRV_LENGTHOF(dest),
+                                 destStarts, destLengths, &errorCode);
+    if(U_FAILURE(errorCode) || length!=UPRV_LENGTHOF(expectedDest) ||
+            0!=u_memcmp(dest, expectedDest, length)) {
+        log_err("unorm2_normalizeBatch() failed: %s length %d\n", u_errorName(errorCode), (int)length);
+    }
+    for(i=0; i<4; ++i) {
+        if(destStarts[i]!=expectedStarts[i] || destLengths[i]!=expectedLengths[i]) {
+            log_err("unorm2_normalizeBatch() string %d: start %d length %d (expected %d %d)\n",
+                    (int)i, (int)destStarts[i], (int)destLengths[i],
+                    (int)expectedStarts[i], (int)expectedLengths[i]);
+        }
+    }
+    errorCode=U_ZERO_ERROR;
+    unorm2_normalizeBatch(n2, srcs, srcLengths, -1, dest, UPRV_LENGTHOF(dest),
+                          destStarts, destLengths, &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("unorm2_normalizeBatch(count=-1) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
@@ -764,6 +764,23 @@ static const SearchData INDICPREFIXMATCH[] = {
     {NULL, NULL, NULL, UCOL_TERTIARY, USEARCH_STANDARD_ELEMENT_COMPARISON, NULL, {-1}, {0}}
 };
 
+/* Forward searches which skip over the text, with matches next to characters that prevent skipping. */
+static const SearchData SKIPPING[] = {
+    {"abcd abc\\u0301d abcd\\u0301 abcde ABCD xabcd abcd", "abcd", NULL, UCOL_TERTIARY, USEARCH_STANDARD_ELEMENT_COMPARISON, NULL,
+     {0, 17, 29, 34, -1}, {4, 4, 4, 4}},
+    {"abcd abc\\u0301d abcd\\u0301 abcde ABCD xabcd abcd", "abcd", NULL, UCOL_PRIMARY, USEARCH_STANDARD_ELEMENT_COMPARISON, NULL,
+     {0, 5, 11, 17, 23, 29, 34, -1}, {4, 5, 5, 4, 4, 4, 4}},
+    {"abcd abc\\u0301d abcd\\u0301 abcde ABCD xabcd abcd", "abcd", NULL, UCOL_PRIMARY, USEARCH_STANDARD_ELEMENT_COMPARISON, "wordbreaker",
+     {0, 5, 11, 23, 34, -1}, {4, 5, 5, 4, 4}},
+    {"Die Stra\\u00DFe und die strasse", "strasse", "de", UCOL_PRIMARY, USEARCH_STANDARD_ELEMENT_COMPARISON, NULL,
+     {4, 19, -1}, {6, 7}},
+    {"\\u00E9abcd \\u00E9\\u00E9abcd\\u00E9 abcabcabcd", "abcd", NULL, UCOL_TERTIARY, USEARCH_STANDARD_ELEMENT_COMPARISON, NULL,
+     {1, 8, 20, -1}, {4, 4, 4}},
+    {"\\u043C\\u0438\\u0440 \\u041C\\u0418\\u0420\\u0430 \\u043C\\u0438\\u0440\\u0301", "\\u043C\\u0438\\u0440", NULL, UCOL_PRIMARY, USEARCH_STANDARD_ELEMENT_COMPARISON, NULL,
+     {0, 4, 9, -1}, {3, 3, 4}},
+    {NULL, NULL, NULL, UCOL_TERTIARY, USEARCH_STANDARD_ELEMENT_COMPARISON, NULL, {-1}, {0}}
+};
+
 #endif /* #if !UCONFIG_NO_COLLATION */
 
 #endif
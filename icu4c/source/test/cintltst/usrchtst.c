@@ -3005,6 +3005,210 @@ static void TestIndicPrefixMatch(void)
     close();
 }
 
+/*
+ * With shifted alternate handling at quaternary strength, a completely ignorable
+ * character after a variable one is ignored, so the forward search
+ * must not skip over it as if it were a simple character.
+ */
+static void TestSkippingShiftedIgnorables(void)
+{
+    /* 40 units of filler, then "a." U+200B "d" at offset 40 and more text */
+    static const char *textChars =
+        "xyz abc dcb zyx bcd cba yxz cbd dab bad "
+        "a.\\u200Bdc\\u2126";
+    static const char *patternChars = "a.d";
+    UChar text[64];
+    UChar pattern[8];
+    int32_t textLength, patternLength, match, matchLength;
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll;
+    UStringSearch *usearch;
+
+    textLength = u_unescape(textChars, text, UPRV_LENGTHOF(text));
+    patternLength = u_unescape(patternChars, pattern, UPRV_LENGTHOF(pattern));
+    coll = ucol_open("cs", &status);
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(cs) failed - %s\n", u_errorName(status));
+        return;
+    }
+    ucol_setStrength(coll, UCOL_QUATERNARY);
+    ucol_setAttribute(coll, UCOL_CASE_LEVEL, UCOL_ON, &status);
+    ucol_setAttribute(coll, UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, &status);
+    usearch = usearch_openFromCollator(pattern, patternLength, text, textLength,
+                                       coll, NULL, &status);
+    if (U_FAILURE(status)) {
+        log_err("usearch_openFromCollator() failed - %s\n", u_errorName(status));
+        ucol_close(coll);
+        return;
+    }
+    match = usearch_first(usearch, &status);
+    matchLength = usearch_getMatchedLength(usearch);
+    if (U_FAILURE(status) || match != 40 || matchLength != 4) {
+        log_err("usearch_first(\"a.d\") in shifted cs text: %s, match %d length %d (expected 40 4)\n",
+                u_errorName(status), (int)match, (int)matchLength);
+    }
+    usearch_close(usearch);
+    ucol_close(coll);
+}
+
+typedef struct {
+    int32_t patternIndex;
+    int32_t start;
+    int32_t limit;
+} MultiSearchMatch;
+
+static void TestMultiSearch(void)
+{
+    static const char *const patternStrings[] = { "peche", "pecheur", "un", "che" };
+    static const MultiSearchMatch expected[] = {
+        { 2, 0, 2 }, { 0, 3, 8 }, { 3, 5, 8 }, { 2, 10, 12 }, { 0, 14, 19 }, { 3, 16, 19 },
+        { 2, 23, 25 }, { 0, 26, 31 }, { 3, 28, 31 }, { 1, 26, 33 }
+    };
+    const int32_t patternCount = UPRV_LENGTHOF(patternStrings);
+    const int32_t expectedCount = UPRV_LENGTHOF(expected);
+    UChar text[64];
+    UChar patternBuffers[UPRV_LENGTHOF(patternStrings)][16];
+    const UChar *patterns[UPRV_LENGTHOF(patternStrings)];
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll;
+    UMultiStringSearch *msearch;
+    int32_t i, pass;
+
+    coll = ucol_open("en", &status);
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(en) failed - %s\n", u_errorName(status));
+        return;
+    }
+    ucol_setStrength(coll, UCOL_PRIMARY);
+    u_unescape("Un p\\u00E9ch\\u00E9, une p\\u00EAche et un p\\u00E9cheur.", text, UPRV_LENGTHOF(text));
+    for (i = 0; i < patternCount; ++i) {
+        u_unescape(patternStrings[i], patternBuffers[i], UPRV_LENGTHOF(patternBuffers[i]));
+        patterns[i] = patternBuffers[i];
+    }
+    msearch = usearch_openMulti(patterns, NULL, patternCount, text, -1, coll, NULL, &status);
+    if (U_FAILURE(status)) {
+        log_err("usearch_openMulti() failed - %s\n", u_errorName(status));
+        ucol_close(coll);
+        return;
+    }
+    /* The second pass checks that setting the text restarts the search. */
+    for (pass = 0; pass < 2; ++pass) {
+        int32_t patternIndex, start, limit;
+        int32_t count = 0;
+        if (pass > 0) {
+            usearch_setMultiText(msearch, text, -1, &status);
+        }
+        while (usearch_nextMulti(msearch, &patternIndex, &start, &limit, &status)) {
+            if (count >= expectedCount) {
+                log_err("usearch_nextMulti() found too many matches\n");
+                break;
+            }
+            if (patternIndex != expected[count].patternIndex ||
+                    start != expected[count].start || limit != expected[count].limit) {
+                log_err("usearch_nextMulti() match %d: pattern %d [%d, %d[ expected pattern %d [%d, %d[\n",
+                        count, patternIndex, start, limit,
+                        expected[count].patternIndex, expected[count].start, expected[count].limit);
+            }
+            ++count;
+        }
+        if (U_FAILURE(status)) {
+            log_err("usearch_nextMulti() failed - %s\n", u_errorName(status));
+        } else if (count != expectedCount || start != -1 || limit != -1) {
+            log_err("usearch_nextMulti() found %d matches, expected %d\n", count, expectedCount);
+        }
+    }
+    usearch_closeMulti(msearch);
+
+    /* An ignorable pattern cannot be searched for. */
+    patterns[1] = patternBuffers[1];
+    u_unescape("\\u0301", patternBuffers[1], UPRV_LENGTHOF(patternBuffers[1]));
+    msearch = usearch_openMulti(patterns, NULL, patternCount, text, -1, coll, NULL, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR || msearch != NULL) {
+        log_err("usearch_openMulti(ignorable pattern) - %s instead of U_ILLEGAL_ARGUMENT_ERROR\n",
+                u_errorName(status));
+    }
+    usearch_closeMulti(msearch);
+    ucol_close(coll);
+}
+
+/*
+ * Compares usearch_nextMulti() with single-pattern searches
+ * that find overlapping matches.
+ */
+static void TestMultiSearchVsSingle(void)
+{
+    static const char *const patternStrings[] = {
+        "peche", "p\\u00E9che", "ch", "che", "\\u00E9", "e", "un p", "CHE"
+    };
+    static const UCollationStrength strengths[] = { UCOL_PRIMARY, UCOL_SECONDARY, UCOL_TERTIARY };
+    const int32_t patternCount = UPRV_LENGTHOF(patternStrings);
+    UChar text[256];
+    UChar patternBuffers[UPRV_LENGTHOF(patternStrings)][16];
+    const UChar *patterns[UPRV_LENGTHOF(patternStrings)];
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll;
+    int32_t i, s;
+
+    coll = ucol_open("fr", &status);
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(fr) failed - %s\n", u_errorName(status));
+        return;
+    }
+    u_unescape(PECHE_WITH_ACCENTS, text, UPRV_LENGTHOF(text));
+    for (i = 0; i < patternCount; ++i) {
+        u_unescape(patternStrings[i], patternBuffers[i], UPRV_LENGTHOF(patternBuffers[i]));
+        patterns[i] = patternBuffers[i];
+    }
+    for (s = 0; s < UPRV_LENGTHOF(strengths); ++s) {
+        UMultiStringSearch *msearch;
+        ucol_setStrength(coll, strengths[s]);
+        msearch = usearch_openMulti(patterns, NULL, patternCount, text, -1, coll, NULL, &status);
+        if (U_FAILURE(status)) {
+            log_err("usearch_openMulti() failed - %s\n", u_errorName(status));
+            break;
+        }
+        for (i = 0; i < patternCount; ++i) {
+            UStringSearch *usearch =
+                usearch_openFromCollator(patterns[i], -1, text, -1, coll, NULL, &status);
+            int32_t patternIndex, start, limit, match;
+            usearch_setAttribute(usearch, USEARCH_OVERLAP, USEARCH_ON, &status);
+            /* Walk the multi-pattern matches of pattern i along with the single-pattern ones. */
+            usearch_setMultiText(msearch, text, -1, &status);
+            match = usearch_first(usearch, &status);
+            for (;;) {
+                UBool found;
+                while ((found = usearch_nextMulti(msearch, &patternIndex, &start, &limit, &status)) &&
+                        patternIndex != i) {}
+                if (U_FAILURE(status)) {
+                    log_err("search failed - %s\n", u_errorName(status));
+                    break;
+                }
+                if (!found) {
+                    if (match != USEARCH_DONE) {
+                        log_err("strength %d pattern %d: usearch_nextMulti() misses the match at %d\n",
+                                strengths[s], i, match);
+                    }
+                    break;
+                }
+                if (match == USEARCH_DONE) {
+                    log_err("strength %d pattern %d: extra usearch_nextMulti() match at %d\n",
+                            strengths[s], i, start);
+                    break;
+                }
+                if (start != match || limit != match + usearch_getMatchedLength(usearch)) {
+                    log_err("strength %d pattern %d: usearch_nextMulti() [%d, %d[ but usearch [%d, %d[\n",
+                            strengths[s], i, start, limit, match, match + usearch_getMatchedLength(usearch));
+                    break;
+                }
+                match = usearch_next(usearch, &status);
+            }
+            usearch_close(usearch);
+        }
+        usearch_closeMulti(msearch);
+    }
+    ucol_close(coll);
+}
+
 /**
 * addSearchTest
 */
@@ -3068,6 +3272,9 @@ void addSearchTest(TestNode** root)
     addTest(root, &TestPCEBuffer_2surr, "tscoll/usrchtst/TestPCEBuffer/2_dfff");
     addTest(root, &TestMatchFollowedByIgnorables, "tscoll/usrchtst/TestMatchFollowedByIgnorables");
     addTest(root, &TestIndicPrefixMatch, "tscoll/usrchtst/TestIndicPrefixMatch");
+    addTest(root, &TestSkippingShiftedIgnorables, "tscoll/usrchtst/TestSkippingShiftedIgnorables");
+    addTest(root, &TestMultiSearch, "tscoll/usrchtst/TestMultiSearch");
+    addTest(root, &TestMultiSearchVsSingle, "tscoll/usrchtst/TestMultiSearchVsSingle");
 }
 
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -64,6 +64,8 @@ void AlphabeticIndexTest::runIndexedTest( int32_t index, UBool exec, const char*
     TESTCASE_AUTO(TestChineseZhuyin);
     TESTCASE_AUTO(TestJapaneseKanji);
     TESTCASE_AUTO(TestChineseUnihan);
+    TESTCASE_AUTO(TestCreateImmutableIndex);
+    TESTCASE_AUTO(TestGetBucketIndexes);
     TESTCASE_AUTO_END;
 }
 
@@ -722,4 +724,143 @@ void AlphabeticIndexTest::TestChineseUnihan() {
     assertEquals("getBucketIndex(U+7527)", 101, bucketIndex);
 }
 
+namespace {
+
+const char *const indexTestNames[] = {
+    "\\u0645\\u062D\\u0645\\u062F",  // Arabic
+    "Zacharias", "Adelbert", "\\u00C6sculap", "Aesthet", "schiller", "Schiller",
+    "Steiff", "Stuttgart", "Sultan", "thomas", "\\u00DFtraum",
+    "\\u4E00", "\\u4E8C", "\\u4E09", "\\u5F20", "\\u738B", "\\u9F99",  // Han
+    "\\u3042", "\\u30AB", "\\u3055", "\\uAC00", "\\uD55C",  // kana, Hangul
+    "\\u0410\\u043D\\u043D\\u0430", "\\u0416\\u0443\\u043A", "\\u03A9\\u03BC\\u03AD\\u03B3\\u03B1",
+    "", " ", "1234", "$", "\\U00020000", "\\uFFFF"
+};
+
+/**
+ * Sets indexes[n] to the bucket of names[n] as assigned to records by the index,
+ * which compares names with the bucket boundaries via the collator rather than sort keys.
+ */
+void getBucketIndexesViaRecords(AlphabeticIndex &index, const UnicodeString names[], int32_t count,
+                                int32_t indexes[], UErrorCode &status) {
+    index.clearRecords(status);
+    for (int32_t n = 0; n < count; ++n) {
+        index.addRecord(names[n], names + n, status);
+        indexes[n] = -1;
+    }
+    index.resetBucketIterator(status);
+    while (index.nextBucket(status)) {
+        while (index.nextRecord(status)) {
+            const UnicodeString *name = static_cast<const UnicodeString *>(index.getRecordData());
+            indexes[name - names] = index.getBucketIndex();
+        }
+    }
+    index.clearRecords(status);
+}
+
+}  // namespace
+
+void AlphabeticIndexTest::TestCreateImmutableIndex() {
+    static const char *const localeIDs[] = {
+        "en", "de", "ja", "ko", "ru", "el", "ar", "zh", "zh_Hant", "zh@collation=zhuyin"
+    };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(localeIDs); ++i) {
+        Locale locale(localeIDs[i]);
+        UErrorCode status = U_ZERO_ERROR;
+        AlphabeticIndex index(locale, status);
+        LocalPointer<AlphabeticIndex::ImmutableIndex> builtIndex(index.buildImmutableIndex(status));
+        // Create twice: The second one should come from the cache.
+        LocalPointer<AlphabeticIndex::ImmutableIndex> immIndex(
+            AlphabeticIndex::ImmutableIndex::createInstance(locale, status));
+        LocalPointer<AlphabeticIndex::ImmutableIndex> immIndex2(
+            AlphabeticIndex::ImmutableIndex::createInstance(locale, status));
+        if (U_FAILURE(status)) {
+            dataerrln("%s: unable to create an ImmutableIndex - %s", localeIDs[i], u_errorName(status));
+            continue;
+        }
+        int32_t bucketCount = builtIndex->getBucketCount();
+        assertEquals(UnicodeString(localeIDs[i]) + " getBucketCount()",
+                     bucketCount, immIndex->getBucketCount());
+        assertEquals(UnicodeString(localeIDs[i]) + " cached getBucketCount()",
+                     bucketCount, immIndex2->getBucketCount());
+        for (int32_t b = 0; b < bucketCount && b < immIndex->getBucketCount(); ++b) {
+            const AlphabeticIndex::Bucket *bucket = immIndex->getBucket(b);
+            assertEquals(UnicodeString(localeIDs[i]) + " label",
+                         builtIndex->getBucket(b)->getLabel(), bucket->getLabel());
+            assertTrue("cached index shares the buckets", bucket == immIndex2->getBucket(b));
+        }
+        UnicodeString names[UPRV_LENGTHOF(indexTestNames)];
+        int32_t expected[UPRV_LENGTHOF(indexTestNames)];
+        for (int32_t n = 0; n < UPRV_LENGTHOF(indexTestNames); ++n) {
+            names[n] = UnicodeString(indexTestNames[n], -1, US_INV).unescape();
+        }
+        getBucketIndexesViaRecords(index, names, UPRV_LENGTHOF(names), expected, status);
+        for (int32_t n = 0; n < UPRV_LENGTHOF(indexTestNames); ++n) {
+            assertEquals(UnicodeString(localeIDs[i]) + " getBucketIndex(" + indexTestNames[n] + ")",
+                         expected[n], immIndex->getBucketIndex(names[n], status));
+            assertEquals(UnicodeString(localeIDs[i]) + " built getBucketIndex(" + indexTestNames[n] + ")",
+                         expected[n], builtIndex->getBucketIndex(names[n], status));
+        }
+        TEST_CHECK_STATUS;
+    }
+}
+
+void AlphabeticIndexTest::TestGetBucketIndexes() {
+    static const char *const localeIDs[] = { "en", "de", "ja", "ru", "zh", "zh_Hant" };
+    UnicodeString names[UPRV_LENGTHOF(indexTestNames)];
+    for (int32_t n = 0; n < UPRV_LENGTHOF(indexTestNames); ++n) {
+        names[n] = UnicodeString(indexTestNames[n], -1, US_INV).unescape();
+    }
+    for (int32_t i = 0; i < UPRV_LENGTHOF(localeIDs); ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        AlphabeticIndex index(localeIDs[i], status);
+        index.addLabels(UnicodeSet("[\\u00C6{Sch*}{St*}]", status), status);
+        LocalPointer<AlphabeticIndex::ImmutableIndex> immIndex(index.buildImmutableIndex(status));
+        if (U_FAILURE(status)) {
+            dataerrln("%s: unable to build an ImmutableIndex - %s", localeIDs[i], u_errorName(status));
+            continue;
+        }
+        // Unsorted, then sorted by bucket, then in reverse order.
+        int32_t indexes[UPRV_LENGTHOF(names)];
+        immIndex->getBucketIndexes(names, UPRV_LENGTHOF(names), indexes, status);
+        int32_t expected[UPRV_LENGTHOF(names)];
+        getBucketIndexesViaRecords(index, names, UPRV_LENGTHOF(names), expected, status);
+        TEST_CHECK_STATUS;
+        UnicodeString sorted[UPRV_LENGTHOF(names)];
+        int32_t sortedCount = 0;
+        for (int32_t b = 0; b < immIndex->getBucketCount(); ++b) {
+            for (int32_t n = 0; n < UPRV_LENGTHOF(names); ++n) {
+                assertEquals(UnicodeString(localeIDs[i]) + " getBucketIndexes(" + indexTestNames[n] + ")",
+                             expected[n], indexes[n]);
+                if (indexes[n] == b) {
+                    sorted[sortedCount++] = names[n];
+                }
+            }
+        }
+        assertEquals("all names sorted", (int32_t)UPRV_LENGTHOF(names), sortedCount);
+        immIndex->getBucketIndexes(sorted, sortedCount, indexes, status);
+        TEST_CHECK_STATUS;
+        for (int32_t n = 0; n < sortedCount; ++n) {
+            assertEquals(UnicodeString(localeIDs[i]) + " sorted getBucketIndexes()",
+                         immIndex->getBucketIndex(sorted[n], status), indexes[n]);
+            TEST_ASSERT(n == 0 || indexes[n - 1] <= indexes[n]);
+        }
+        UnicodeString reversed[UPRV_LENGTHOF(names)];
+        for (int32_t n = 0; n < sortedCount; ++n) {
+            reversed[n] = sorted[sortedCount - 1 - n];
+        }
+        immIndex->getBucketIndexes(reversed, sortedCount, indexes, status);
+        TEST_CHECK_STATUS;
+        for (int32_t n = 0; n < sortedCount; ++n) {
+            assertEquals(UnicodeString(localeIDs[i]) + " reversed getBucketIndexes()",
+                         immIndex->getBucketIndex(reversed[n], status), indexes[n]);
+        }
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<AlphabeticIndex::ImmutableIndex> immIndex(
+        AlphabeticIndex::ImmutableIndex::createInstance(Locale::getEnglish(), status));
+    TEST_CHECK_STATUS;
+    immIndex->getBucketIndexes(NULL, 1, NULL, status);
+    assertEquals("getBucketIndexes(NULL)", (int32_t)U_ILLEGAL_ARGUMENT_ERROR, (int32_t)status);
+}
+
 #endif
@@ -47,6 +47,14 @@ public:
     void TestChineseZhuyin();
     void TestJapaneseKanji();
     void TestChineseUnihan();
+    /**
+     * ImmutableIndex::createInstance() must yield the same index as buildImmutableIndex().
+     */
+    void TestCreateImmutableIndex();
+    /**
+     * getBucketIndexes() must yield the same bucket numbers as getBucketIndex().
+     */
+    void TestGetBucketIndexes();
 };
 
 #endif
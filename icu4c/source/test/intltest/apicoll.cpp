@@ -43,7 +43,9 @@
 #include "unicode/ucol.h"
 
 #include "sfwdchit.h"
+#include "charstr.h"
 #include "cmemory.h"
+#include "cstring.h"
 #include <stdlib.h>
 
 void
@@ -2451,6 +2453,545 @@ void CollationAPITest::TestBadKeywords() {
     }
 }
 
+void CollationAPITest::TestGetSortKeys() {
+    IcuTestErrorCode errorCode(*this, "TestGetSortKeys");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getGerman(), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(de)")) {
+        return;
+    }
+    const RuleBasedCollator *rbc = dynamic_cast<const RuleBasedCollator *>(coll.getAlias());
+    if(rbc == NULL) {
+        errln("German collator is not a RuleBasedCollator");
+        return;
+    }
+    static const char *const strings8[] = {
+        "", "abc", "\xC3\xA4" "bc", "Abc", "A\xCC\x88" "bc",
+        "\xE4\xB8\x80" "1", "ab\xFF" "c", "\xF0\x9F\x98\x80" "x"
+    };
+    const int32_t count = UPRV_LENGTHOF(strings8);
+    UnicodeString strings16[UPRV_LENGTHOF(strings8)];
+    const UChar *sources16[UPRV_LENGTHOF(strings8)];
+    int32_t lengths16[UPRV_LENGTHOF(strings8)];
+    int32_t lengths8[UPRV_LENGTHOF(strings8)];
+    for(int32_t i = 0; i < count; ++i) {
+        strings16[i] = UnicodeString::fromUTF8(strings8[i]);
+        sources16[i] = strings16[i].getTerminatedBuffer();
+        lengths16[i] = strings16[i].length();
+        lengths8[i] = (int32_t)uprv_strlen(strings8[i]);
+    }
+    for(int32_t strength = 0; strength < 2; ++strength) {
+        if(strength == 1) {
+            // The identical level takes a different code path for UTF-8 input.
+            coll->setStrength(Collator::IDENTICAL);
+        }
+        // Preflight, then write into a buffer of exactly the right size.
+        int32_t offsets[UPRV_LENGTHOF(strings8) + 1];
+        int32_t length = rbc->getSortKeys(sources16, lengths16, count, NULL, 0, offsets, errorCode);
+        if(errorCode.get() != U_BUFFER_OVERFLOW_ERROR || length != offsets[count]) {
+            errln("getSortKeys() preflighting failed - %s", errorCode.errorName());
+            return;
+        }
+        errorCode.reset();
+        LocalArray<uint8_t> keys(new uint8_t[length]);
+        int32_t offsets8[UPRV_LENGTHOF(strings8) + 1];
+        LocalArray<uint8_t> keys8(new uint8_t[length]);
+        uint8_t key[200], key8[200];
+        for(int32_t variant = 0; variant < 2; ++variant) {
+            const int32_t *lengths = variant != 0 ? lengths16 : NULL;
+            const int32_t *lengthsUTF8 = variant != 0 ? lengths8 : NULL;
+            if(rbc->getSortKeys(sources16, lengths, count, keys.getAlias(), length,
+                                offsets, errorCode) != length ||
+                    rbc->getSortKeysUTF8(strings8, lengthsUTF8, count, keys8.getAlias(), length,
+                                         offsets8, errorCode) != length) {
+                errln("getSortKeys() or getSortKeysUTF8() returned a wrong length");
+                return;
+            }
+            if(errorCode.logIfFailureAndReset("getSortKeys()/getSortKeysUTF8()")) {
+                return;
+            }
+            for(int32_t i = 0; i < count; ++i) {
+                int32_t keyLength = coll->getSortKey(strings16[i], key, UPRV_LENGTHOF(key));
+                if(offsets[i + 1] - offsets[i] != keyLength ||
+                        uprv_memcmp(keys.getAlias() + offsets[i], key, keyLength) != 0) {
+                    errln("getSortKeys()[%d] != getSortKey() at strength %d", (int)i, (int)strength);
+                }
+                if(offsets8[i] != offsets[i] ||
+                        uprv_memcmp(keys8.getAlias() + offsets8[i], key, keyLength) != 0) {
+                    errln("getSortKeysUTF8()[%d] != getSortKey() at strength %d",
+                          (int)i, (int)strength);
+                }
+                int32_t length8 = lengthsUTF8 != NULL ? lengths8[i] : -1;
+                int32_t keyLength8 = rbc->getSortKeyUTF8(strings8[i], length8,
+                                                         key8, UPRV_LENGTHOF(key8), errorCode);
+                if(keyLength8 != keyLength || uprv_memcmp(key8, key, keyLength) != 0) {
+                    errln("getSortKeyUTF8(%d) != getSortKey() at strength %d",
+                          (int)i, (int)strength);
+                }
+                if(rbc->getSortKeyUTF8(strings8[i], -1, NULL, 0, errorCode) != keyLength) {
+                    errln("getSortKeyUTF8(%d) preflighting returned a wrong length", (int)i);
+                }
+                errorCode.logIfFailureAndReset("getSortKeyUTF8()");
+            }
+        }
+        // A buffer that is too small still yields all offsets.
+        rbc->getSortKeys(sources16, lengths16, count, keys.getAlias(), length - 1,
+                         offsets8, errorCode);
+        if(errorCode.get() != U_BUFFER_OVERFLOW_ERROR ||
+                uprv_memcmp(offsets, offsets8, (count + 1) * (int32_t)sizeof(int32_t)) != 0) {
+            errln("getSortKeys(capacity too small) failed - %s", errorCode.errorName());
+        }
+        errorCode.reset();
+    }
+    // Illegal arguments.
+    int32_t offsets[2];
+    static const int32_t badLength[] = { 3 };
+    static const UChar *const nullString[] = { NULL };
+    rbc->getSortKeys(nullString, badLength, 1, NULL, 0, offsets, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("getSortKeys(NULL string with length 3) did not fail");
+    }
+    rbc->getSortKeys(sources16, NULL, 1, NULL, 0, NULL, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("getSortKeys(offsets=NULL) did not fail");
+    }
+    if(rbc->getSortKeys(nullString, NULL, 0, NULL, 0, offsets, errorCode) != 0 ||
+            offsets[0] != 0) {
+        errln("getSortKeys(count=0) did not return 0");
+    }
+    errorCode.logIfFailureAndReset("getSortKeys(count=0)");
+    rbc->getSortKeyUTF8(NULL, 3, NULL, 0, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("getSortKeyUTF8(NULL string with length 3) did not fail");
+    }
+}
+
+void CollationAPITest::TestSort() {
+    IcuTestErrorCode errorCode(*this, "TestSort");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getGerman(), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(de)")) {
+        return;
+    }
+    // Mix of short strings, equal strings, and strings with long common prefixes
+    // so that some prefixes tie and need full comparisons.
+    static const char *const pieces[] = {
+        "a", "\xC3\xA4", "A", "b", "ss", "\xC3\x9F", "-", "1", "\xE4\xB8\x80", "\xF0\x9F\x98\x80"
+    };
+    const int32_t count = 300;
+    UnicodeString strings16[count];
+    CharString strings8[count];
+    const UChar *sources16[count];
+    const char *sources8[count];
+    int32_t lengths16[count];
+    uint32_t seed = 1;
+    for(int32_t i = 0; i < count; ++i) {
+        seed = seed * 1103515245 + 12345;
+        CharString &s = strings8[i];
+        if((seed >> 20) % 3 == 0) {
+            s.append("Wiederherstellungsmannschaft", errorCode);
+        }
+        int32_t length = (int32_t)((seed >> 16) % 6);
+        for(int32_t j = 0; j < length; ++j) {
+            seed = seed * 1103515245 + 12345;
+            s.append(pieces[(seed >> 16) % UPRV_LENGTHOF(pieces)], errorCode);
+        }
+        strings16[i] = UnicodeString::fromUTF8(s.toStringPiece());
+        sources16[i] = strings16[i].getTerminatedBuffer();
+        sources8[i] = s.data();
+        lengths16[i] = strings16[i].length();
+    }
+    int32_t order[count];
+    for(int32_t variant = 0; variant < 4; ++variant) {
+        UBool stable = (variant & 1) != 0;
+        if((variant & 2) == 0) {
+            coll->sort(sources16, (variant & 1) != 0 ? lengths16 : NULL, count,
+                       order, stable, errorCode);
+        } else {
+            coll->sortUTF8(sources8, NULL, count, order, stable, errorCode);
+        }
+        if(errorCode.logIfFailureAndReset("sort() variant %d", (int)variant)) {
+            return;
+        }
+        UBool seen[count] = { FALSE };
+        for(int32_t k = 0; k < count; ++k) {
+            int32_t i = order[k];
+            if(i < 0 || i >= count || seen[i]) {
+                errln("sort() variant %d: order[] is not a permutation at %d", (int)variant, (int)k);
+                return;
+            }
+            seen[i] = TRUE;
+            if(k == 0) { continue; }
+            int32_t prev = order[k - 1];
+            UCollationResult result = coll->compare(strings16[prev], strings16[i], errorCode);
+            if(result == UCOL_GREATER || (stable && result == UCOL_EQUAL && prev > i)) {
+                errln("sort() variant %d: strings %d and %d out of order",
+                      (int)variant, (int)prev, (int)i);
+            }
+        }
+    }
+    // Sorting two ranges and merging them must yield the same stable order
+    // as sorting the whole array.
+    int32_t parts[count], merged[count];
+    coll->sort(sources16, lengths16, count, order, TRUE, errorCode);
+    for(int32_t variant = 0; variant < 2; ++variant) {
+        const int32_t middle = 120;
+        if(variant == 0) {
+            coll->sortRange(sources16, lengths16, middle, count, parts + middle, TRUE, errorCode);
+            coll->sortRange(sources16, lengths16, 0, middle, parts, TRUE, errorCode);
+            coll->mergeSorted(sources16, lengths16, parts + middle, count - middle,
+                              parts, middle, merged, TRUE, errorCode);
+        } else {
+            coll->sortRangeUTF8(sources8, NULL, 0, middle, parts, TRUE, errorCode);
+            coll->sortRangeUTF8(sources8, NULL, middle, count, parts + middle, TRUE, errorCode);
+            coll->mergeSortedUTF8(sources8, NULL, parts, middle,
+                                  parts + middle, count - middle, merged, TRUE, errorCode);
+        }
+        if(errorCode.logIfFailureAndReset("sortRange()+mergeSorted() variant %d", (int)variant)) {
+            return;
+        }
+        for(int32_t k = 0; k < middle; ++k) {
+            if(parts[k] >= middle) {
+                errln("sortRange() variant %d: index %d out of range", (int)variant, (int)parts[k]);
+                break;
+            }
+        }
+        if(uprv_memcmp(merged, order, sizeof(order)) != 0) {
+            errln("sortRange()+mergeSorted() variant %d differs from sort()", (int)variant);
+        }
+    }
+    coll->mergeSorted(sources16, NULL, parts, -1, parts, 1, merged, FALSE, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("mergeSorted(length1=-1) did not fail");
+    }
+    coll->sortRange(sources16, NULL, 5, 4, parts, FALSE, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("sortRange(start>limit) did not fail");
+    }
+    // Identical strength adds a level that only full comparisons see.
+    coll->setStrength(Collator::IDENTICAL);
+    coll->sort(sources16, lengths16, count, order, TRUE, errorCode);
+    for(int32_t k = 1; k < count; ++k) {
+        if(coll->compare(strings16[order[k - 1]], strings16[order[k]], errorCode) == UCOL_GREATER) {
+            errln("sort(identical strength): strings %d and %d out of order",
+                  (int)order[k - 1], (int)order[k]);
+        }
+    }
+    errorCode.logIfFailureAndReset("sort(identical strength)");
+    // Trivial and illegal arguments.
+    coll->sort(NULL, NULL, 0, NULL, FALSE, errorCode);
+    errorCode.logIfFailureAndReset("sort(count=0)");
+    coll->sort(sources16, NULL, -1, order, FALSE, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("sort(count=-1) did not fail");
+    }
+}
+
+void CollationAPITest::TestRulesCache() {
+    IcuTestErrorCode errorCode(*this, "TestRulesCache");
+    UnicodeString rules("&a<x<<<X &c<<ch<<<cH<<<Ch<<<CH", -1, US_INV);
+    RuleBasedCollator coll1(rules, errorCode);
+    if(errorCode.logDataIfFailureAndReset("RuleBasedCollator(rules)")) {
+        return;
+    }
+    // The second collator shares the tailoring built for the first one,
+    // but the strength argument must still apply to it alone.
+    RuleBasedCollator coll2(rules, Collator::PRIMARY, errorCode);
+    errorCode.logIfFailureAndReset("RuleBasedCollator(same rules, PRIMARY)");
+    if(coll1.getRules() != coll2.getRules()) {
+        errln("collators from the same rules return different rule strings");
+    }
+    UnicodeString x("x", -1, US_INV), capitalX("X", -1, US_INV), b("b", -1, US_INV);
+    if(coll1.compare(x, capitalX, errorCode) != UCOL_LESS ||
+            coll2.compare(x, capitalX, errorCode) != UCOL_EQUAL ||
+            coll2.compare(x, b, errorCode) != UCOL_LESS) {
+        errln("collators from the same rules with different strengths compare incorrectly");
+    }
+    if(coll1.getStrength() != Collator::TERTIARY) {
+        errln("building a PRIMARY collator from cached rules changed another collator's strength");
+    }
+    errorCode.logIfFailureAndReset("compare()");
+
+    // Invalid rules must report the same parse error every time,
+    // even if the failure is remembered.
+    UnicodeString badRules("&a<b<<<", -1, US_INV);
+    int32_t firstOffset = -1;
+    for(int32_t i = 0; i < 2; ++i) {
+        UParseError parseError;
+        UnicodeString reason;
+        RuleBasedCollator bad(badRules, parseError, reason, errorCode);
+        if(i == 0) {
+            firstOffset = parseError.offset;
+        }
+        if(errorCode.reset() != U_INVALID_FORMAT_ERROR ||
+                parseError.offset < 0 || parseError.offset != firstOffset || reason.isEmpty()) {
+            errln(UnicodeString("RuleBasedCollator(bad rules) attempt ") + i +
+                  ": offset " + parseError.offset + ", reason \"" + reason + "\"");
+        }
+    }
+    // A successful build after a failure resets the parse error.
+    UParseError parseError;
+    UnicodeString reason;
+    RuleBasedCollator coll3(rules, parseError, reason, errorCode);
+    if(errorCode.logIfFailureAndReset("RuleBasedCollator(rules, parseError)") ||
+            parseError.offset != -1 || !reason.isEmpty()) {
+        errln("RuleBasedCollator(cached rules) did not reset the parse error");
+    }
+
+    // A caller-side persistent cache: Binary images keyed by getRulesCacheKey().
+    uint64_t key = RuleBasedCollator::getRulesCacheKey(rules, UCOL_PRIMARY, UCOL_DEFAULT, errorCode);
+    errorCode.logIfFailureAndReset("getRulesCacheKey()");
+    if(key != RuleBasedCollator::getRulesCacheKey(rules, UCOL_PRIMARY, UCOL_DEFAULT, errorCode)) {
+        errln("getRulesCacheKey() is not deterministic");
+    }
+    if(key == RuleBasedCollator::getRulesCacheKey(rules, UCOL_DEFAULT, UCOL_DEFAULT, errorCode) ||
+            key == RuleBasedCollator::getRulesCacheKey(rules, UCOL_PRIMARY, UCOL_ON, errorCode) ||
+            key == RuleBasedCollator::getRulesCacheKey(badRules, UCOL_PRIMARY, UCOL_DEFAULT, errorCode)) {
+        errln("getRulesCacheKey() does not distinguish strength, decomposition mode and rules");
+    }
+    errorCode.logIfFailureAndReset("getRulesCacheKey(variants)");
+    const UChar *rulesBuffer = rules.getTerminatedBuffer();
+    if(key != ucol_getRulesCacheKey(rulesBuffer, -1, UCOL_DEFAULT, UCOL_PRIMARY, errorCode) ||
+            key != ucol_getRulesCacheKey(rulesBuffer, rules.length(), UCOL_DEFAULT, UCOL_PRIMARY, errorCode)) {
+        errln("ucol_getRulesCacheKey() differs from RuleBasedCollator::getRulesCacheKey()");
+    }
+    errorCode.logIfFailureAndReset("ucol_getRulesCacheKey()");
+    uint8_t image[20000];
+    int32_t imageLength = coll2.cloneBinary(image, UPRV_LENGTHOF(image), errorCode);
+    errorCode.logIfFailureAndReset("cloneBinary()");
+    // Later: Look up the image by the key of the same rules and settings, and reload it.
+    if(ucol_getRulesCacheKey(rulesBuffer, -1, UCOL_DEFAULT, UCOL_PRIMARY, errorCode) == key) {
+        LocalUCollatorPointer root(ucol_open("", errorCode));
+        LocalUCollatorPointer reloaded(ucol_openBinary(image, imageLength, root.getAlias(), errorCode));
+        if(errorCode.logIfFailureAndReset("ucol_openBinary(cached image)")) {
+            return;
+        }
+        const Collator *c = Collator::fromUCollator(reloaded.getAlias());
+        if(c->compare(x, capitalX, errorCode) != UCOL_EQUAL ||
+                c->compare(x, b, errorCode) != UCOL_LESS ||
+                c->getStrength() != Collator::PRIMARY) {
+            errln("collator reloaded from a cached image differs from the one built from rules");
+        }
+        errorCode.logIfFailureAndReset("compare(reloaded)");
+    }
+}
+
+void CollationAPITest::TestCollationHash() {
+    IcuTestErrorCode errorCode(*this, "TestCollationHash");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getEnglish(), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(English)")) {
+        return;
+    }
+    RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+    if(rbc == NULL) {
+        errln("Collator::createInstance(English) did not return a RuleBasedCollator");
+        return;
+    }
+    UnicodeString a("a", -1, US_INV), capitalA("A", -1, US_INV);
+    UnicodeString aUmlaut((UChar)0xe4), aCombining("a\\u0308", -1, US_INV);
+    aCombining = aCombining.unescape();
+    // Strings that are equal at a strength must hash equal at that strength.
+    if(rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_PRIMARY, errorCode) !=
+            rbc->getCollationHash(capitalA.getBuffer(), capitalA.length(), UCOL_PRIMARY, errorCode) ||
+            rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_SECONDARY, errorCode) !=
+            rbc->getCollationHash(capitalA.getBuffer(), capitalA.length(), UCOL_SECONDARY, errorCode) ||
+            rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_PRIMARY, errorCode) !=
+            rbc->getCollationHash(aUmlaut.getBuffer(), aUmlaut.length(), UCOL_PRIMARY, errorCode)) {
+        errln("getCollationHash() differs for strings that are equal at the given strength");
+    }
+    if(rbc->getCollationHash(aUmlaut.getBuffer(), aUmlaut.length(), UCOL_IDENTICAL, errorCode) !=
+            rbc->getCollationHash(aCombining.getBuffer(), aCombining.length(),
+                                  UCOL_IDENTICAL, errorCode)) {
+        errln("getCollationHash(IDENTICAL) differs for canonically equivalent strings");
+    }
+    // These should differ; a collision here would be very unlikely.
+    if(rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_TERTIARY, errorCode) ==
+            rbc->getCollationHash(capitalA.getBuffer(), capitalA.length(), UCOL_TERTIARY, errorCode) ||
+            rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_SECONDARY, errorCode) ==
+            rbc->getCollationHash(aUmlaut.getBuffer(), aUmlaut.length(), UCOL_SECONDARY, errorCode)) {
+        errln("getCollationHash() is the same for strings that differ at the given strength");
+    }
+    // UCOL_DEFAULT uses the collator's strength.
+    if(rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_DEFAULT, errorCode) !=
+            rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_TERTIARY, errorCode)) {
+        errln("getCollationHash(UCOL_DEFAULT) != getCollationHash(collator strength)");
+    }
+    errorCode.logIfFailureAndReset("getCollationHash()");
+
+    // A long string produces a sort key larger than the hash sink's internal buffer.
+    // The UTF-8 and UTF-16 hashes must agree at every strength.
+    UnicodeString s;
+    for(int32_t i = 0; i < 200; ++i) {
+        s.append((UChar)(0x41 + i % 26)).append((UChar)(0x3b1 + i % 20)).append((UChar)0xe9);
+    }
+    char s8[2000];
+    int32_t length8;
+    u_strToUTF8(s8, UPRV_LENGTHOF(s8), &length8, s.getBuffer(), s.length(), errorCode);
+    static const UColAttributeValue strengths[] = {
+        UCOL_PRIMARY, UCOL_SECONDARY, UCOL_TERTIARY, UCOL_QUATERNARY, UCOL_IDENTICAL
+    };
+    for(int32_t i = 0; i < UPRV_LENGTHOF(strengths); ++i) {
+        uint64_t hash = rbc->getCollationHash(s.getBuffer(), s.length(), strengths[i], errorCode);
+        uint64_t hash8 = rbc->getCollationHashUTF8(s8, length8,
+                                                   strengths[i], errorCode);
+        if(errorCode.logIfFailureAndReset("getCollationHash(long string)")) { return; }
+        if(hash != hash8) {
+            errln("getCollationHash() != getCollationHashUTF8() at strength %d", (int)strengths[i]);
+        }
+        UnicodeString t(s);
+        t.setCharAt(400, (UChar)0x61);
+        if(hash == rbc->getCollationHash(t.getBuffer(), t.length(), strengths[i], errorCode)) {
+            errln("getCollationHash() unchanged for a different long string at strength %d",
+                  (int)strengths[i]);
+        }
+    }
+
+    rbc->getCollationHash(a.getBuffer(), a.length(), UCOL_ON, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("getCollationHash(strength=UCOL_ON) did not fail with U_ILLEGAL_ARGUMENT_ERROR");
+    }
+}
+
+void CollationAPITest::TestCompactSortKey() {
+    IcuTestErrorCode errorCode(*this, "TestCompactSortKey");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getFrench(), errorCode));
+    if(errorCode.logDataIfFailureAndReset("Collator::createInstance(French)")) {
+        return;
+    }
+    RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+    if(rbc == NULL) {
+        errln("Collator::createInstance(French) did not return a RuleBasedCollator");
+        return;
+    }
+    static const char *const strings[] = {
+        "cote", "cot\\u00E9", "c\\u00F4te", "c\\u00F4t\\u00E9", "Cote", "COTE", "C\\u00F4te",
+        "co-op", "coop", "co op", "cot", "cotes", "c\\u00F4tes", "Cotes", "ab", "aB", "Ab",
+        "\\u00E9l\\u00E8ve", "\\u00C9L\\u00C8VE", "eleve", "el\\u00E8ve", "\\u00E9leve",
+        "\\u00E9l\\u00E8v\\u00E9\\u00E9\\u00E9", "\\u00C9l\\u00E8veS", "\\u00E9l\\u00E8veS\\u00E9",
+        "a\\u0308\\u0301bc", "\\u00E4bc", "\\u00C4BC", "", "-", "1", "\\u0430\\u0431",
+        "\\u0410\\u0431\\u0432\\u0413\\u0434\\u0415"
+    };
+    UnicodeString s[UPRV_LENGTHOF(strings)];
+    for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+        s[i] = UnicodeString(strings[i], -1, US_INV).unescape();
+    }
+    static const UColAttributeValue strengths[] = {
+        UCOL_PRIMARY, UCOL_SECONDARY, UCOL_TERTIARY, UCOL_QUATERNARY, UCOL_IDENTICAL
+    };
+    uint8_t keys[UPRV_LENGTHOF(strings)][100];
+    UBool truncated[UPRV_LENGTHOF(strings)];
+    uint8_t fullKey[100];
+    for(int32_t si = 0; si < UPRV_LENGTHOF(strengths); ++si) {
+        UColAttributeValue strength = strengths[si];
+        LocalPointer<Collator> strengthColl(rbc->clone());
+        strengthColl->setAttribute(UCOL_STRENGTH, strength, errorCode);
+        // Alternate=shifted makes the quaternary level interesting.
+        strengthColl->setAttribute(UCOL_ALTERNATE_HANDLING,
+                                   strength == UCOL_QUATERNARY ? UCOL_SHIFTED : UCOL_NON_IGNORABLE,
+                                   errorCode);
+        RuleBasedCollator *strengthRBC = static_cast<RuleBasedCollator *>(strengthColl.getAlias());
+        for(int32_t maxLevelLength = 0; maxLevelLength <= 3; ++maxLevelLength) {
+            UCollationKeyStats stats = { 0, 0, 0, 0, 0 };
+            int64_t fullLength = 0;
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                int64_t truncatedCount = stats.truncatedCount;
+                int32_t length = strengthRBC->getCompactSortKey(
+                    s[i].getBuffer(), s[i].length(), UCOL_DEFAULT, maxLevelLength,
+                    keys[i], UPRV_LENGTHOF(keys[i]), &stats, errorCode);
+                truncated[i] = stats.truncatedCount != truncatedCount;
+                int32_t fullKeyLength = strengthRBC->getSortKey(s[i], fullKey, UPRV_LENGTHOF(fullKey));
+                fullLength += fullKeyLength;
+                if(maxLevelLength == 0 &&
+                        (length != fullKeyLength || uprv_memcmp(keys[i], fullKey, length) != 0)) {
+                    errln("strength %d: getCompactSortKey(%s, no limit) != getSortKey()",
+                          (int)strength, strings[i]);
+                }
+                if(length <= 0 || keys[i][length - 1] != 0 || (int32_t)uprv_strlen((char *)keys[i]) != length - 1) {
+                    errln("strength %d max %d: compact key for %s is not NUL-terminated",
+                          (int)strength, (int)maxLevelLength, strings[i]);
+                }
+                // UTF-8 and UTF-16 keys must be the same.
+                char s8[100];
+                int32_t s8Length;
+                u_strToUTF8(s8, UPRV_LENGTHOF(s8), &s8Length, s[i].getBuffer(), s[i].length(),
+                            errorCode);
+                uint8_t key8[100];
+                int32_t length8 = strengthRBC->getCompactSortKeyUTF8(
+                    s8, s8Length, UCOL_DEFAULT, maxLevelLength,
+                    key8, UPRV_LENGTHOF(key8), NULL, errorCode);
+                if(length8 != length || uprv_memcmp(key8, keys[i], length) != 0) {
+                    errln("strength %d max %d: getCompactSortKeyUTF8(%s) != getCompactSortKey()",
+                          (int)strength, (int)maxLevelLength, strings[i]);
+                }
+                // Same key with the strength argument instead of the collator's strength.
+                uint8_t key2[100];
+                int32_t length2 = rbc->getCompactSortKey(
+                    s[i].getBuffer(), s[i].length(), strength, maxLevelLength,
+                    key2, UPRV_LENGTHOF(key2), NULL, errorCode);
+                if(strength != UCOL_QUATERNARY &&
+                        (length2 != length || uprv_memcmp(key2, keys[i], length) != 0)) {
+                    errln("strength %d max %d: getCompactSortKey(%s, strength) differs",
+                          (int)strength, (int)maxLevelLength, strings[i]);
+                }
+            }
+            if(errorCode.logIfFailureAndReset("getCompactSortKey()")) { return; }
+            if(stats.keyCount != UPRV_LENGTHOF(strings) || stats.fullLength != fullLength ||
+                    stats.totalLength > stats.fullLength ||
+                    (maxLevelLength == 0 && (stats.totalLength != fullLength || stats.truncatedCount != 0))) {
+                errln("strength %d max %d: unexpected UCollationKeyStats",
+                      (int)strength, (int)maxLevelLength);
+            }
+            logln("strength %d max %d: %ld compact key bytes (%ld truncated keys) vs. %ld full key bytes",
+                  (int)strength, (int)maxLevelLength,
+                  (long)stats.totalLength, (long)stats.truncatedCount, (long)stats.fullLength);
+            // The ordering contract.
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                for(int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                    int32_t order = strengthColl->compare(s[i], s[j], errorCode);
+                    int32_t keyOrder = uprv_strcmp((const char *)keys[i], (const char *)keys[j]);
+                    if(keyOrder < 0 ? order >= 0 :
+                            keyOrder > 0 ? order <= 0 :
+                            (order != 0 && !truncated[i] && !truncated[j])) {
+                        errln("strength %d max %d: compact keys for %s and %s "
+                              "are ordered %d but the strings %d",
+                              (int)strength, (int)maxLevelLength, strings[i], strings[j],
+                              (int)keyOrder, (int)order);
+                    }
+                }
+            }
+        }
+    }
+
+    // A long string produces a sort key larger than the sink's internal buffer.
+    UnicodeString longString;
+    for(int32_t i = 0; i < 200; ++i) {
+        longString.append((UChar)(0x41 + i % 26)).append((UChar)0xe9);
+    }
+    UCollationKeyStats stats = { 0, 0, 0, 0, 0 };
+    int32_t fullKeyLength = rbc->getSortKey(longString, NULL, 0);
+    int32_t length = rbc->getCompactSortKey(longString.getBuffer(), longString.length(),
+                                            UCOL_TERTIARY, 4, NULL, 0, &stats, errorCode);
+    LocalArray<uint8_t> key(new uint8_t[length]);
+    LocalArray<uint8_t> fullSortKey(new uint8_t[fullKeyLength]);
+    rbc->getCompactSortKey(longString.getBuffer(), longString.length(),
+                           UCOL_TERTIARY, 4, key.getAlias(), length, NULL, errorCode);
+    rbc->getSortKey(longString, fullSortKey.getAlias(), fullKeyLength);
+    errorCode.logIfFailureAndReset("getCompactSortKey(long string)");
+    // All of the primary level plus 01, 4 secondary bytes, the 02 marker and the 00 terminator.
+    int32_t primaryLength = 0;
+    while(primaryLength < fullKeyLength && fullSortKey[primaryLength] > 1) { ++primaryLength; }
+    if(stats.fullLength != fullKeyLength || stats.truncatedCount != 1 || stats.maxLength != length ||
+            length != primaryLength + 7 ||
+            uprv_memcmp(key.getAlias(), fullSortKey.getAlias(), primaryLength + 5) != 0 ||
+            key[length - 2] != 2 || key[length - 1] != 0) {
+        errln("getCompactSortKey(long string) yields an unexpected key");
+    }
+
+    rbc->getCompactSortKey(longString.getBuffer(), longString.length(), UCOL_ON, 0,
+                           NULL, 0, NULL, errorCode);
+    if(errorCode.reset() != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("getCompactSortKey(strength=UCOL_ON) did not fail with U_ILLEGAL_ARGUMENT_ERROR");
+    }
+}
+
  void CollationAPITest::dump(UnicodeString msg, RuleBasedCollator* c, UErrorCode& status) {
     const char* bigone = "One";
     const char* littleone = "one";
@@ -2492,6 +3033,11 @@ void CollationAPITest::runIndexedTest( int32_t index, UBool exec, const char* &n
     TESTCASE_AUTO(TestCloneBinary);
     TESTCASE_AUTO(TestIterNumeric);
     TESTCASE_AUTO(TestBadKeywords);
+    TESTCASE_AUTO(TestGetSortKeys);
+    TESTCASE_AUTO(TestSort);
+    TESTCASE_AUTO(TestRulesCache);
+    TESTCASE_AUTO(TestCollationHash);
+    TESTCASE_AUTO(TestCompactSortKey);
     TESTCASE_AUTO_END;
 }
 
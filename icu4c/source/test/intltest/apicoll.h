@@ -170,6 +170,11 @@ public:
     void TestCloneBinary();
     void TestIterNumeric();
     void TestBadKeywords();
+    void TestGetSortKeys();
+    void TestSort();
+    void TestRulesCache();
+    void TestCollationHash();
+    void TestCompactSortKey();
 
 private:
     // If this is too small for the test data, just increase it.
@@ -30,10 +30,12 @@
 #include "cmemory.h"
 #include "collation.h"
 #include "collationdata.h"
+#include "collationfastlatin.h"
 #include "collationfcd.h"
 #include "collationiterator.h"
 #include "collationroot.h"
 #include "collationrootelements.h"
+#include "collationsettings.h"
 #include "collationruleparser.h"
 #include "collationweights.h"
 #include "cstring.h"
@@ -74,6 +76,7 @@ public:
     void TestCollationWeights();
     void TestRootElements();
     void TestTailoredElements();
+    void TestFastScripts();
     void TestDataDriven();
 
 private:
@@ -144,6 +147,7 @@ void CollationTest::runIndexedTest(int32_t index, UBool exec, const char *&name,
     TESTCASE_AUTO(TestCollationWeights);
     TESTCASE_AUTO(TestRootElements);
     TESTCASE_AUTO(TestTailoredElements);
+    TESTCASE_AUTO(TestFastScripts);
     TESTCASE_AUTO(TestDataDriven);
     TESTCASE_AUTO_END;
 }
@@ -944,6 +948,105 @@ void CollationTest::TestTailoredElements() {
     uhash_close(prevLocales);
 }
 
+void CollationTest::TestFastScripts() {
+    IcuTestErrorCode errorCode(*this, "TestFastScripts");
+    const CollationData *root = CollationRoot::getData(errorCode);
+    const CollationSettings *rootSettings = CollationRoot::getSettings(errorCode);
+    if(errorCode.logDataIfFailureAndReset("CollationRoot::getData()")) {
+        return;
+    }
+    int32_t options[CollationFastLatin::NUM_SCRIPT_TABLES];
+    CollationFastLatin::getScriptOptions(root, *rootSettings, options, UPRV_LENGTHOF(options));
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        if(root->fastScriptTables[i] == NULL || options[i] < 0) {
+            errln("root collation data has no usable fast script table %d", (int)i);
+            return;
+        }
+    }
+    // Simple Greek & Cyrillic words must not bail out of the script tables.
+    static const UChar alpha[] = { 0x3b1, 0x3bb, 0x3c6, 0x3b1 };  // alfa
+    static const UChar alphaAcute[] = { 0x3ac, 0x3bb, 0x3c6, 0x3b1 };
+    static const UChar da[] = { 0x434, 0x430 };
+    static const UChar dva[] = { 0x434, 0x432, 0x430 };
+    static const uint16_t noPrimaries[CollationFastLatin::LATIN_LIMIT] = { 0 };
+    int32_t result = CollationFastLatin::compareUTF16(root->fastScriptTables[0], noPrimaries,
+                                                       options[0], alpha, 4, alphaAcute, 4);
+    if(result != UCOL_LESS) {
+        errln("fast Greek table: compare(\\u03B1\\u03BB\\u03C6\\u03B1, \\u03AC\\u03BB\\u03C6\\u03B1) = %d, expected -1", (int)result);
+    }
+    result = CollationFastLatin::compareUTF16(root->fastScriptTables[1], noPrimaries, options[1],
+                                              da, 2, dva, 3);
+    if(result != UCOL_LESS) {
+        errln("fast Cyrillic table: compare(da, dva) = %d, expected -1", (int)result);
+    }
+
+    // Compare the fast paths with the iterator-based slow path.
+    static const UChar pool[] = {
+        0x3b1, 0x3b2, 0x3b5, 0x3b9, 0x3bf, 0x3c2, 0x3c3, 0x3c9, 0x391, 0x3a3,
+        0x386, 0x3ac, 0x3ad, 0x3af, 0x3ca, 0x390, 0x3cc,
+        0x430, 0x431, 0x435, 0x438, 0x439, 0x43e, 0x44a, 0x44c, 0x44f, 0x410, 0x415,
+        0x401, 0x451, 0x419, 0x456, 0x457, 0x491, 0x45e, 0x4e9,
+        0x301, 0x308, 0x306, 0x20, 0x2d, 0x2e, 0x2019, 0x31, 0x61, 0x65
+    };
+    static const char *const locales[] = {
+        "root", "ru", "uk", "el", "sr", "bg", "be", "de"
+    };
+    uint32_t random = 1;
+    for(int32_t l = 0; l < UPRV_LENGTHOF(locales); ++l) {
+        LocalPointer<Collator> coll(Collator::createInstance(locales[l], errorCode));
+        if(errorCode.logDataIfFailureAndReset("Collator::createInstance(%s)", locales[l])) {
+            continue;
+        }
+        for(int32_t variant = 0; variant < 4; ++variant) {
+            coll->setAttribute(UCOL_STRENGTH,
+                               variant == 1 ? UCOL_PRIMARY :
+                                   variant == 2 ? UCOL_QUATERNARY : UCOL_TERTIARY,
+                               errorCode);
+            coll->setAttribute(UCOL_ALTERNATE_HANDLING,
+                               variant == 2 ? UCOL_SHIFTED : UCOL_NON_IGNORABLE, errorCode);
+            coll->setAttribute(UCOL_CASE_FIRST,
+                               variant == 3 ? UCOL_UPPER_FIRST : UCOL_OFF, errorCode);
+            errorCode.assertSuccess();
+            for(int32_t n = 0; n < 500; ++n) {
+                UnicodeString s, t;
+                int32_t length = 1 + (int32_t)((random >> 16) % 6);
+                for(int32_t i = 0; i < length; ++i) {
+                    random = random * 1103515245 + 12345;
+                    s.append(pool[(random >> 16) % UPRV_LENGTHOF(pool)]);
+                }
+                // Usually vary only one character, to get long common prefixes.
+                t = s;
+                random = random * 1103515245 + 12345;
+                int32_t index = (int32_t)((random >> 16) % (length + 1));
+                random = random * 1103515245 + 12345;
+                UChar c = pool[(random >> 16) % UPRV_LENGTHOF(pool)];
+                if(index == length) {
+                    t.append(c);
+                } else {
+                    t.setCharAt(index, c);
+                }
+                UCharIterator si, ti;
+                uiter_setString(&si, s.getBuffer(), s.length());
+                uiter_setString(&ti, t.getBuffer(), t.length());
+                UCollationResult expected = coll->compare(si, ti, errorCode);
+                UCollationResult order = coll->compare(s, t, errorCode);
+                std::string s8, t8;
+                s.toUTF8String(s8);
+                t.toUTF8String(t8);
+                UCollationResult order8 = coll->compareUTF8(s8, t8, errorCode);
+                if(errorCode.logIfFailureAndReset("compare()")) { return; }
+                if(order != expected || order8 != expected) {
+                    errln("%s variant %d: compare(UTF-16)=%d compare(UTF-8)=%d "
+                          "but compare(iterators)=%d for",
+                          locales[l], (int)variant, (int)order, (int)order8, (int)expected);
+                    infoln(prettify(s));
+                    infoln(prettify(t));
+                }
+            }
+        }
+    }
+}
+
 UnicodeString CollationTest::printSortKey(const uint8_t *p, int32_t length) {
     UnicodeString s;
     for(int32_t i = 0; i < length; ++i) {
@@ -11,6 +11,8 @@
 
 #include "unicode/uchar.h"
 #include "unicode/normlzr.h"
+#include "unicode/normalizer2.h"
+#include "unicode/bytestream.h"
 #include "unicode/uniset.h"
 #include "unicode/putil.h"
 #include "cstring.h"
@@ -352,6 +354,12 @@ UBool NormalizerConformanceTest::checkConformance(const UnicodeString* field,
     }
     compare(field[1],field[2]);
     compare(field[0],field[1]);
+#if U_HAVE_STD_STRING
+    // test the UTF-8 API, which does not support the old options
+    if(options==0) {
+        pass &= checkUTF8(field, status);
+    }
+#endif
     // test quick checks
     if(UNORM_NO == Normalizer::quickCheck(field[1], UNORM_NFC, options, status)) {
         errln("Normalizer error: quickCheck(NFC(s), UNORM_NFC) is UNORM_NO");
@@ -443,6 +451,95 @@ UBool NormalizerConformanceTest::checkConformance(const UnicodeString* field,
     return pass;
 }
 
+#if U_HAVE_STD_STRING
+
+/**
+ * Verify that the Normalizer2 UTF-8 functions give the same results
+ * as the UTF-16 functions for the given line.
+ * @param field the 5 columns
+ * @return true if the test passes
+ */
+UBool NormalizerConformanceTest::checkUTF8(const UnicodeString* field,
+                                           UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(status);
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(status);
+    const Normalizer2 *nfkc = Normalizer2::getNFKCInstance(status);
+    const Normalizer2 *nfkd = Normalizer2::getNFKDInstance(status);
+    const Normalizer2 *fcd = Normalizer2::getInstance(NULL, "nfc", UNORM2_FCD, status);
+    if (U_FAILURE(status)) {
+        dataerrln("Error getting Normalizer2 instances: %s", u_errorName(status));
+        return FALSE;
+    }
+    UBool pass = TRUE;
+    UnicodeString exp;
+    for (int32_t i=0; i<FIELD_COUNT; ++i) {
+        int32_t fieldNum = i+1;
+        if (i<3) {
+            pass &= checkUTF8(*nfc, "C(UTF-8)", field[i], field[1], "c2!=C(c", fieldNum);
+            pass &= checkUTF8(*nfd, "D(UTF-8)", field[i], field[2], "c3!=D(c", fieldNum);
+        }
+        pass &= checkUTF8(*nfkc, "KC(UTF-8)", field[i], field[3], "c4!=KC(c", fieldNum);
+        pass &= checkUTF8(*nfkd, "KD(UTF-8)", field[i], field[4], "c5!=KD(c", fieldNum);
+        fcd->normalize(field[i], exp, status);
+        pass &= checkUTF8(*fcd, "FCD(UTF-8)", field[i], exp, "FCD(c", fieldNum);
+    }
+    if (U_FAILURE(status)) {
+        dataerrln("Normalizer2 UTF-8 functions returned error status: %s", u_errorName(status));
+        pass = FALSE;
+    }
+    return pass;
+}
+
+/**
+ * @param norm2 normalizer to be tested
+ * @param op name of normalization form, e.g., "KC(UTF-8)"
+ * @param s string being normalized
+ * @param exp expected UTF-16 normalization result
+ * @param msg description of this test
+ * @param return true if the UTF-8 results match the UTF-16 ones
+ */
+UBool NormalizerConformanceTest::checkUTF8(const Normalizer2 &norm2,
+                                           const char *op,
+                                           const UnicodeString& s,
+                                           const UnicodeString& exp,
+                                           const char *msg,
+                                           int32_t field) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    std::string s8, out8;
+    s.toUTF8String(s8);
+    if (UnicodeString::fromUTF8(s8) != s) {
+        return TRUE;  // unpaired surrogates are not representable in UTF-8
+    }
+    StringByteSink<std::string> sink(&out8);
+    norm2.normalizeUTF8(s8, sink, errorCode);
+    if (U_FAILURE(errorCode)) {
+        errln("    %s%d)%s failed: %s", msg, field, op, u_errorName(errorCode));
+        return FALSE;
+    }
+    UBool pass = assertEqual(op, s, UnicodeString::fromUTF8(out8), exp, msg, field);
+    if (norm2.isNormalizedUTF8(s8, errorCode) != norm2.isNormalized(s, errorCode)) {
+        errln("    %s%d)%s isNormalizedUTF8() != isNormalized()", msg, field, op);
+        pass = FALSE;
+    }
+    int32_t span16 = norm2.spanQuickCheckYes(s, errorCode);
+    std::string yes8;
+    UnicodeString(s, 0, span16).toUTF8String(yes8);
+    if (norm2.spanQuickCheckYesUTF8(s8, errorCode) != (int32_t)yes8.length()) {
+        errln("    %s%d)%s spanQuickCheckYesUTF8() != spanQuickCheckYes()", msg, field, op);
+        pass = FALSE;
+    }
+    if (U_FAILURE(errorCode)) {
+        errln("    %s%d)%s failed: %s", msg, field, op, u_errorName(errorCode));
+        pass = FALSE;
+    }
+    return pass;
+}
+
+#endif
+
 /**
  * Do a normalization using the iterative API in the given direction.
  * @param dir either +1 or -1
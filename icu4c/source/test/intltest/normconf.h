@@ -13,6 +13,7 @@
 #if !UCONFIG_NO_NORMALIZATION
 
 #include "unicode/normlzr.h"
+#include "unicode/normalizer2.h"
 #include "intltest.h"
 
 typedef struct _FileStream FileStream;
@@ -61,6 +62,17 @@ class NormalizerConformanceTest : public IntlTest {
                            int32_t options,
                            UErrorCode &status);
 
+#if U_HAVE_STD_STRING
+    UBool checkUTF8(const UnicodeString* field, UErrorCode &status);
+
+    UBool checkUTF8(const Normalizer2 &norm2,
+                    const char *op,
+                    const UnicodeString& s,
+                    const UnicodeString& exp,
+                    const char *msg,
+                    int32_t field);
+#endif
+
     void iterativeNorm(const UnicodeString& str,
                        UNormalizationMode mode, int32_t options,
                        UnicodeString& result,
@@ -16,6 +16,7 @@
 #include "unicode/rbbi.h"
 #include "unicode/schriter.h"
 #include "rbbiapts.h"
+#include "rbbitst.h"
 #include "rbbidata.h"
 #include "cstring.h"
 #include "ubrkimpl.h"
@@ -23,6 +24,7 @@
 #include "unicode/ustring.h"
 #include "unicode/utext.h"
 #include "cmemory.h"
+#include "unicode/brkpool.h"
 #if !UCONFIG_NO_BREAK_ITERATION && U_HAVE_STD_STRING
 #include "unicode/filteredbrk.h"
 #include <stdio.h> // for sprintf
@@ -1179,6 +1181,158 @@ void RBBIAPITest::TestRefreshInputText() {
 
 }
 
+//
+//  TestGetBoundaries   getBoundaries() must return the same boundaries and status values
+//                      as next() and getRuleStatus(), also when called repeatedly with
+//                      a small array.
+//
+void RBBIAPITest::TestGetBoundaries() {
+    UnicodeString text = UnicodeString(
+        "Hello, world! 123.45 \\u0E01\\u0E32\\u0E23\\u0E17\\u0E14\\u0E2A\\u0E2D\\u0E1A"
+        "\\u0E20\\u0E32\\u0E29\\u0E32\\u0E44\\u0E17\\u0E22 \\u30A2\\u30C3\\u30D7\\u30EB "
+        "\\U0001D7F2x.  Next sentence?").unescape();
+    static const int32_t capacities[] = { 1, 2, 5, 100 };
+
+    for (int32_t type = UBRK_CHARACTER; type <= UBRK_SENTENCE; ++type) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<BreakIterator> bi(RBBITest::createIterator(type, Locale("th"), status));
+        LocalPointer<BreakIterator> ref(RBBITest::createIterator(type, Locale("th"), status));
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d Error creating break iterator - %s", __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+
+        int32_t expected[200], expectedStatuses[200];
+        int32_t expectedLength = 0;
+        ref->setText(text);
+        for (int32_t pos = ref->first(); (pos = ref->next()) != BreakIterator::DONE;) {
+            expected[expectedLength] = pos;
+            expectedStatuses[expectedLength++] = ref->getRuleStatus();
+        }
+
+        for (int32_t c = 0; c < UPRV_LENGTHOF(capacities); ++c) {
+            int32_t capacity = capacities[c];
+            UBool withStatuses = (c & 1) == 0;
+            int32_t boundaries[200], statuses[200];
+            int32_t length = 0;
+            bi->setText(text);
+            for (;;) {
+                int32_t start = length == 0 ? 0 : boundaries[length - 1];
+                int32_t n = bi->getBoundaries(start, boundaries + length,
+                                              withStatuses ? statuses + length : NULL,
+                                              capacity, status);
+                TEST_ASSERT_SUCCESS(status);
+                if (U_FAILURE(status) || length + n > expectedLength) {
+                    break;
+                }
+                length += n;
+                if (n > 0) {
+                    TEST_ASSERT(bi->current() == boundaries[length - 1]);
+                }
+                if (n < capacity) {
+                    break;
+                }
+            }
+            if (length != expectedLength) {
+                errln("%s:%d type %d capacity %d: getBoundaries() found %d boundaries, expected %d",
+                      __FILE__, __LINE__, type, capacity, length, expectedLength);
+                continue;
+            }
+            for (int32_t i = 0; i < length; ++i) {
+                if (boundaries[i] != expected[i] ||
+                        (withStatuses && statuses[i] != expectedStatuses[i])) {
+                    errln("%s:%d type %d capacity %d: boundary %d is %d with status %d, expected %d, %d",
+                          __FILE__, __LINE__, type, capacity, i, boundaries[i],
+                          withStatuses ? statuses[i] : -1, expected[i], expectedStatuses[i]);
+                    break;
+                }
+            }
+            // Iteration continues after the stored boundaries.
+            TEST_ASSERT(bi->next() == BreakIterator::DONE);
+        }
+
+        // Random access and iteration continue to work after bulk iteration.
+        int32_t k = expectedLength / 2;
+        int32_t boundaries[3];
+        int32_t n = bi->getBoundaries(0, boundaries, NULL, UPRV_LENGTHOF(boundaries), status);
+        TEST_ASSERT(n == UPRV_LENGTHOF(boundaries) || n == expectedLength);
+        TEST_ASSERT(bi->preceding(expected[k] + 1) == expected[k]);
+        TEST_ASSERT(bi->previous() == (k > 0 ? expected[k - 1] : 0));
+
+        status = U_ZERO_ERROR;
+        bi->getBoundaries(0, boundaries, NULL, -1, status);
+        TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+    }
+}
+
+//
+//  TestBreakIteratorPool   Iterators from a BreakIteratorPool must behave like newly created ones,
+//                          also when they are reused after being released with some text set.
+//
+void RBBIAPITest::TestBreakIteratorPool() {
+    UErrorCode status = U_ZERO_ERROR;
+    BreakIteratorPool pool(2, status);
+    TEST_ASSERT_SUCCESS(status);
+    UnicodeString text("Hello, world! Second sentence.");
+    LocalPointer<BreakIterator> ref(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    BreakIterator *bi = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d Error acquiring break iterator - %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    TEST_ASSERT(*bi == *ref);
+    bi->setText(text);
+    TEST_ASSERT(bi->following(3) == 5);
+    pool.release(bi);
+    TEST_ASSERT(pool.countIdle() == 1);
+
+    // The released iterator is reused, without the previous text.
+    BreakIterator *bi2 = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(bi2 == bi);
+    TEST_ASSERT(pool.countIdle() == 0);
+    TEST_ASSERT(bi2->current() == 0);
+    TEST_ASSERT(bi2->next() == BreakIterator::DONE);
+    ref->setText(text);
+    bi2->setText(text);
+    for (int32_t p = ref->first(); p != BreakIterator::DONE; p = ref->next()) {
+        TEST_ASSERT(bi2->current() == p);
+        TEST_ASSERT(bi2->getRuleStatus() == ref->getRuleStatus());
+        bi2->next();
+    }
+
+    // Each key has its own iterators, and concurrently acquired ones are distinct.
+    BreakIterator *bi3 = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    BreakIterator *sent = pool.acquire(UBRK_SENTENCE, Locale::getEnglish(), status);
+    BreakIterator *thWord = pool.acquire(UBRK_WORD, Locale("th"), status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(bi3 != bi2 && sent != bi2 && thWord != bi2);
+    sent->setText(text);
+    TEST_ASSERT(sent->next() == 14);
+
+    // At most maxIdlePerKey iterators are kept per key.
+    BreakIterator *bi4 = pool.acquire(UBRK_WORD, Locale::getEnglish(), status);
+    TEST_ASSERT_SUCCESS(status);
+    pool.release(bi2);
+    pool.release(bi3);
+    pool.release(bi4);
+    TEST_ASSERT(pool.countIdle() == 2);
+    pool.release(sent);
+    pool.release(thWord);
+    TEST_ASSERT(pool.countIdle() == 4);
+
+    // Iterators that did not come from the pool are deleted, not pooled.
+    pool.release(ref.orphan());
+    pool.release(NULL);
+    TEST_ASSERT(pool.countIdle() == 4);
+
+    TEST_ASSERT(pool.acquire((UBreakIteratorType)UBRK_COUNT, Locale::getEnglish(), status) == NULL);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+    status = U_ZERO_ERROR;
+    BreakIteratorPool badPool(-1, status);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+}
+
 #if !UCONFIG_NO_BREAK_ITERATION && U_HAVE_STD_STRING && !UCONFIG_NO_FILTERED_BREAK_ITERATION
 static void prtbrks(BreakIterator* brk, const UnicodeString &ustr, IntlTest &it) {
   static const UChar PILCROW=0x00B6, CHSTR=0x3010, CHEND=0x3011; // lenticular brackets
@@ -1459,6 +1613,8 @@ void RBBIAPITest::runIndexedTest( int32_t index, UBool exec, const char* &name,
 #else
     case 15: name="skip"; break;
 #endif
+        case 16: name = "TestGetBoundaries"; if (exec) TestGetBoundaries(); break;
+        case 17: name = "TestBreakIteratorPool"; if (exec) TestBreakIteratorPool(); break;
         default: name = ""; break; // needed to end loop
     }
 }
@@ -89,6 +89,10 @@ public:
 
     void TestRefreshInputText();
 
+    void TestGetBoundaries();
+
+    void TestBreakIteratorPool();
+
     /**
      *Internal subroutines
      **/
@@ -19,6 +19,7 @@
 #include "unicode/brkiter.h"
 #include "unicode/rbbi.h"
 #include "unicode/uchar.h"
+#include "unicode/utf8.h"
 #include "unicode/utf16.h"
 #include "unicode/ucnv.h"
 #include "unicode/schriter.h"
@@ -153,6 +154,12 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
             if (exec) TestDictRules();                         break;
         case 24: name = "TestBug5532";
             if (exec) TestBug5532();                           break;
+        case 25: name = "TestBoundaryCache";
+            if (exec) TestBoundaryCache();                     break;
+        case 26: name = "TestUTF8AndUTF16Input";
+            if (exec) TestUTF8AndUTF16Input();                 break;
+        case 27: name = "TestDictionaryWorkspace";
+            if (exec) TestDictionaryWorkspace();               break;
         default: name = ""; break; //needed to end loop
     }
 }
@@ -4487,6 +4494,297 @@ void RBBITest::TestBug9983(void)  {
 }
 
 
+//  Creates a break iterator of any UBreakIteratorType, including UBRK_TITLE.
+BreakIterator *RBBITest::createIterator(int32_t type, const Locale &locale, UErrorCode &status) {
+    switch (type) {
+    case UBRK_CHARACTER:
+        return BreakIterator::createCharacterInstance(locale, status);
+    case UBRK_WORD:
+        return BreakIterator::createWordInstance(locale, status);
+    case UBRK_LINE:
+        return BreakIterator::createLineInstance(locale, status);
+    case UBRK_SENTENCE:
+        return BreakIterator::createSentenceInstance(locale, status);
+    case UBRK_TITLE:
+        return BreakIterator::createTitleInstance(locale, status);
+    default:
+        if (U_SUCCESS(status)) {
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+        }
+        return NULL;
+    }
+}
+
+
+//
+//  TestBoundaryCache   Mixes random access and iteration on one iterator, which reuses
+//                      the boundaries it found before, and checks every result against
+//                      an iterator that starts over for each call.
+//
+void RBBITest::TestBoundaryCache() {
+    UnicodeString text = UnicodeString(
+        "Hello, world! 123.45 \\u0E01\\u0E32\\u0E23\\u0E17\\u0E14\\u0E2A\\u0E2D\\u0E1A"
+        "\\u0E20\\u0E32\\u0E29\\u0E32\\u0E44\\u0E17\\u0E22 \\u30A2\\u30C3\\u30D7\\u30EB "
+        "\\u65E5\\u672C\\u8A9E\\u3067\\u3059\\u3002 \\U0001D7F2x.  Next sentence?\\n"
+        "\\u0E02\\u0E2D\\u0E1A\\u0E04\\u0E38\\u0E13 can't stop.", -1, US_INV).unescape();
+    int32_t length = text.length();
+
+    for (int32_t type = UBRK_CHARACTER; type <= UBRK_SENTENCE; ++type) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<BreakIterator> bi(createIterator(type, Locale("th"), status));
+        LocalPointer<BreakIterator> ref(createIterator(type, Locale("th"), status));
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d Error creating break iterator - %s", __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+        RuleBasedBreakIterator *rbbi = static_cast<RuleBasedBreakIterator *>(bi.getAlias());
+        RuleBasedBreakIterator *rbbiRef = static_cast<RuleBasedBreakIterator *>(ref.getAlias());
+        bi->setText(text);
+
+        uint32_t seed = 1;
+        for (int32_t i = 0; i < 3000; ++i) {
+            seed = seed * 1103515245 + 12345;
+            int32_t op = (int32_t)((seed >> 16) % 6);
+            seed = seed * 1103515245 + 12345;
+            int32_t offset = (int32_t)((seed >> 16) % (length + 3)) - 1;
+            int32_t pos = bi->current();
+            int32_t actual, expected;
+            const char *opName;
+            ref->setText(text);
+            switch (op) {
+            case 0:
+                opName = "following";
+                actual = bi->following(offset);
+                expected = ref->following(offset);
+                break;
+            case 1:
+                opName = "preceding";
+                actual = bi->preceding(offset);
+                expected = ref->preceding(offset);
+                break;
+            case 2:
+                opName = "isBoundary";
+                actual = bi->isBoundary(offset);
+                expected = ref->isBoundary(offset);
+                break;
+            case 3:
+            case 4:
+                opName = "next";
+                offset = pos;
+                actual = bi->next();
+                expected = ref->following(pos);
+                break;
+            default:
+                opName = "previous";
+                offset = pos;
+                actual = bi->previous();
+                expected = ref->preceding(pos);
+                break;
+            }
+            if (actual != expected || bi->current() != ref->current()) {
+                errln("%s:%d type %d, call %d: %s(%d) = %d, current() = %d; expected %d, %d",
+                      __FILE__, __LINE__, type, i, opName, offset,
+                      actual, bi->current(), expected, ref->current());
+                break;
+            }
+            if (rbbi->getRuleStatus() != rbbiRef->getRuleStatus()) {
+                errln("%s:%d type %d, call %d: %s(%d) rule status %d, expected %d",
+                      __FILE__, __LINE__, type, i, opName, offset,
+                      rbbi->getRuleStatus(), rbbiRef->getRuleStatus());
+                break;
+            }
+        }
+    }
+
+    // Boundaries found by previous() and then revisited with next()
+    // must have the rule status from forward iteration.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<BreakIterator> bi(createIterator(UBRK_SENTENCE, Locale::getEnglish(), status));
+    LocalPointer<BreakIterator> ref(createIterator(UBRK_SENTENCE, Locale::getEnglish(), status));
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d Error creating break iterator - %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    UnicodeString sentences("Hi.\r\nThere.");
+    bi->setText(sentences);
+    ref->setText(sentences);
+    bi->last();
+    bi->previous();
+    bi->previous();
+    int32_t pos = bi->next();
+    int32_t expectedPos = ref->next();
+    int32_t ruleStatus = static_cast<RuleBasedBreakIterator *>(bi.getAlias())->getRuleStatus();
+    int32_t expectedStatus = static_cast<RuleBasedBreakIterator *>(ref.getAlias())->getRuleStatus();
+    if (pos != expectedPos || ruleStatus != expectedStatus) {
+        errln("%s:%d last(), previous(), previous(), next() = %d with rule status %d; expected %d, %d",
+              __FILE__, __LINE__, pos, ruleStatus, expectedPos, expectedStatus);
+    }
+}
+
+
+//
+//  TestUTF8AndUTF16Input   The forward break loop reads contiguous UTF-16 and
+//                          UTF-8 text directly, and other text through the UText.
+//                          Check that all three find the same boundaries and
+//                          rule statuses, including for ill-formed UTF-8.
+//
+void RBBITest::TestUTF8AndUTF16Input() {
+    static const char utf8[] =
+        "Hello, world! 123.45 can't \xE0\xB8\x81\xE0\xB8\xB2\xE0\xB8\xA3\xE0\xB8\x97"
+        "\xE0\xB8\x94\xE0\xB8\xAA\xE0\xB8\xAD\xE0\xB8\x9A\xE0\xB8\xA0\xE0\xB8\xB2"
+        "\xE0\xB8\xA9\xE0\xB8\xB2\xE0\xB9\x84\xE0\xB8\x97\xE0\xB8\xA2 "
+        "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xA7\xE3\x81\x99\xE3\x80\x82 "
+        "\xF0\x9D\x9F\xB2x. \xF0\xA0\x80\x80\xF0\xA0\x80\x81 e\xCC\x81t\xC3\xA9.\r\n"
+        // Ill-formed sequences: non-shortest form, truncated, out of range,
+        // lone trail byte, surrogate code point.
+        "a\xC0\x80" "b\xE0\xB8" "c \xF4\x90\x80\x80 \x80\x80x \xED\xA0\x80y?  Next sentence!";
+    int32_t length8 = (int32_t)strlen(utf8);
+
+    // Decode the way the UTF-8 UText does, and map UTF-16 indexes to UTF-8 offsets.
+    UnicodeString text;
+    int32_t nativeIndex[UPRV_LENGTHOF(utf8) * 2];
+    for (int32_t i = 0; i < length8;) {
+        UChar32 c;
+        int32_t start = i;
+        U8_NEXT_OR_FFFD((const uint8_t *)utf8, i, length8, c);
+        nativeIndex[text.length()] = start;
+        if (c > 0xffff) {
+            nativeIndex[text.length() + 1] = start;
+        }
+        text.append(c);
+    }
+    nativeIndex[text.length()] = length8;
+
+    for (int32_t type = UBRK_CHARACTER; type <= UBRK_SENTENCE; ++type) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<BreakIterator> bi16(createIterator(type, Locale("th"), status));
+        LocalPointer<BreakIterator> bi8, biIter;
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d Error creating break iterator - %s", __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+        bi8.adoptInstead(bi16->clone());
+        biIter.adoptInstead(bi16->clone());
+        if (bi8.isNull() || biIter.isNull()) {
+            errln("%s:%d clone() failed", __FILE__, __LINE__);
+            return;
+        }
+        RuleBasedBreakIterator *rbbi16 = static_cast<RuleBasedBreakIterator *>(bi16.getAlias());
+        RuleBasedBreakIterator *rbbi8 = static_cast<RuleBasedBreakIterator *>(bi8.getAlias());
+        RuleBasedBreakIterator *rbbiIter = static_cast<RuleBasedBreakIterator *>(biIter.getAlias());
+
+        bi16->setText(text);
+        // A CharacterIterator is read in small chunks, through the UText functions.
+        biIter->adoptText(new StringCharacterIterator(text));
+        UText ut = UTEXT_INITIALIZER;
+        utext_openUTF8(&ut, utf8, length8, &status);
+        bi8->setText(&ut, status);
+        if (U_FAILURE(status)) {
+            errln("%s:%d Error setting UTF-8 text - %s", __FILE__, __LINE__, u_errorName(status));
+            utext_close(&ut);
+            return;
+        }
+
+        int32_t b16 = bi16->first(), b8 = bi8->first(), bIter = biIter->first();
+        for (int32_t count = 0; b16 != BreakIterator::DONE; ++count) {
+            b16 = bi16->next();
+            b8 = bi8->next();
+            bIter = biIter->next();
+            int32_t expected8 = b16 == BreakIterator::DONE ? BreakIterator::DONE : nativeIndex[b16];
+            if (b8 != expected8 || bIter != b16) {
+                errln("%s:%d type %d, boundary %d: UTF-16 %d, UTF-8 %d (expected %d), CharacterIterator %d",
+                      __FILE__, __LINE__, type, count, b16, b8, expected8, bIter);
+                break;
+            }
+            if (rbbi8->getRuleStatus() != rbbi16->getRuleStatus() ||
+                    rbbiIter->getRuleStatus() != rbbi16->getRuleStatus()) {
+                errln("%s:%d type %d, boundary %d at %d: rule status UTF-16 %d, UTF-8 %d, CharacterIterator %d",
+                      __FILE__, __LINE__, type, count, b16, rbbi16->getRuleStatus(),
+                      rbbi8->getRuleStatus(), rbbiIter->getRuleStatus());
+                break;
+            }
+        }
+        utext_close(&ut);
+    }
+}
+
+//
+//  TestDictionaryWorkspace   A break iterator keeps the scratch buffers of the
+//                            dictionary break engines from one text to the next.
+//                            Segment texts of different lengths and kinds with one
+//                            iterator and compare with a new iterator for each text.
+//
+void RBBITest::TestDictionaryWorkspace() {
+    static const char *const texts[] = {
+        // Long Japanese run, needs no normalization.
+        "\\u79C1\\u9054\\u306B\\u4E00\\u3007\\u3007\\u3007\\u306E\\u30B3\\u30F3\\u30D4\\u30E5"
+        "\\u30FC\\u30BF\\u304C\\u3042\\u308B\\u3002\\u5948\\u3005\\u306F\\u30EF\\u30FC\\u30C9"
+        "\\u3067\\u3042\\u308B\\u3002\\u4ECA\\u65E5\\u306F\\u3044\\u3044\\u5929\\u6C17\\u3067"
+        "\\u3059\\u306D\\u3002",
+        // Short run.
+        "\\u4ECA\\u65E5",
+        // Halfwidth katakana and compatibility ideographs, changed by NFKC,
+        // and supplementary ideographs.
+        "\\U00020000\\U0002000B\\u5B57\\u3067\\u3059\\uFF76\\uFF9E\\uFF72\\uFF7A\\uFF78\\uFF9E"
+        "\\uFF9D\\uF900\\uF901\\u6F22\\u5B57 \\u4E2D\\u534E\\u4EBA\\u6C11\\u5171\\u548C\\u56FD",
+        // Korean and Thai.
+        "\\uD55C\\uAD6D\\uC5B4 \\uBC14\\uC774 \\u0E01\\u0E32\\u0E23\\u0E17\\u0E14\\u0E2A\\u0E2D\\u0E1A",
+        // Chinese.
+        "\\u4E2D\\u534E\\u4EBA\\u6C11\\u5171\\u548C\\u56FD\\u6210\\u7ACB\\u4E86\\u3002"
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<BreakIterator> bi(BreakIterator::createWordInstance(Locale::getJapanese(), status));
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d Error creating break iterator - %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    // Go through the texts twice, the second time with UTF-8 input,
+    // which the engines copy into the workspace rather than reading in place.
+    for (int32_t i = 0; i < 2 * UPRV_LENGTHOF(texts); ++i) {
+        UnicodeString text = UnicodeString(texts[i % UPRV_LENGTHOF(texts)], -1, US_INV).unescape();
+        char utf8[200];
+        int32_t length8 = 0;
+        u_strToUTF8(utf8, UPRV_LENGTHOF(utf8), &length8, text.getBuffer(), text.length(), &status);
+        LocalPointer<BreakIterator> fresh(bi->clone());
+        if (fresh.isNull()) {
+            errln("%s:%d clone() failed", __FILE__, __LINE__);
+            return;
+        }
+        fresh->setText(text);
+        UText ut = UTEXT_INITIALIZER;
+        if (i < UPRV_LENGTHOF(texts)) {
+            bi->setText(text);
+        } else {
+            utext_openUTF8(&ut, utf8, length8, &status);
+            bi->setText(&ut, status);
+        }
+        if (U_FAILURE(status)) {
+            errln("%s:%d Error setting text - %s", __FILE__, __LINE__, u_errorName(status));
+            utext_close(&ut);
+            return;
+        }
+        int32_t expected = fresh->first();
+        int32_t actual = bi->first();
+        for (;;) {
+            if (i >= UPRV_LENGTHOF(texts) && expected != BreakIterator::DONE) {
+                // Compare UTF-8 boundaries as UTF-16 indexes.
+                actual = actual == BreakIterator::DONE ? actual :
+                    UnicodeString::fromUTF8(StringPiece(utf8, actual)).length();
+            }
+            if (actual != expected) {
+                errln("%s:%d text %d: boundary %d, expected %d", __FILE__, __LINE__, i, actual, expected);
+                break;
+            }
+            if (expected == BreakIterator::DONE) {
+                break;
+            }
+            expected = fresh->next();
+            actual = bi->next();
+        }
+        utext_close(&ut);
+    }
+}
+
 //
 //  TestDebug    -  A place-holder test for debugging purposes.
 //                  For putting in fragments of other tests that can be invoked
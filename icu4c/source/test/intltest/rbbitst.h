@@ -17,6 +17,7 @@
 
 #include "intltest.h"
 #include "unicode/brkiter.h"
+#include "unicode/rbbi.h"
 
 
 class  Enumeration;
@@ -72,10 +73,19 @@ public:
     void TestDictRules();
     void TestBug5532();
     void TestBug9983();
+    void TestBoundaryCache();
+    void TestUTF8AndUTF16Input();
+    void TestDictionaryWorkspace();
 
     void TestDebug();
     void TestProperties();
 
+    /**
+     * Creates a break iterator of the given UBreakIteratorType,
+     * for tests that loop over the types. Also used by other test classes.
+     **/
+    static BreakIterator *createIterator(int32_t type, const Locale &locale, UErrorCode &status);
+
 /***********************/
 private:
     /**
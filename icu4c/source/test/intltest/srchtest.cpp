@@ -167,6 +167,7 @@ void StringSearchTest::runIndexedTest(int32_t index, UBool exec,
         CASE(34, TestSubclass)
         CASE(35, TestCoverage)
         CASE(36, TestDiacriticMatch)
+        CASE(37, TestSkipping)
         default: name = ""; break;
     }
 #else
@@ -1706,6 +1707,17 @@ void StringSearchTest::TestDiacriticMatch()
     
 }
  
+void StringSearchTest::TestSkipping()
+{
+    int count = 0;
+    while (SKIPPING[count].text != NULL) {
+        if (!assertEqual(&SKIPPING[count])) {
+            infoln("Error at test number %d", count);
+        }
+        count ++;
+    }
+}
+
 void StringSearchTest::TestCanonical()
 {
     int count = 0;
@@ -89,6 +89,7 @@ private:
     void TestSubclass();
     void TestCoverage();
     void TestDiacriticMatch();
+    void TestSkipping();
 #endif
 };
 
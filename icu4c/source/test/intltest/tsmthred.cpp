@@ -22,6 +22,8 @@
 #include "tsmthred.h"
 #include "unicode/ushape.h"
 #include "unicode/translit.h"
+#include "unicode/brkpool.h"
+#include "rbbitst.h"
 #include "sharedobject.h"
 #include "unifiedcache.h"
 #include "uassert.h"
@@ -132,6 +134,14 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
         }
         break;
 #endif
+    case 10:
+        name = "TestBreakIteratorPool";
+#if !UCONFIG_NO_BREAK_ITERATION
+        if (exec) {
+            TestBreakIteratorPool();
+        }
+#endif
+        break;
     default:
         name = "";
         break; //needed to end loop
@@ -1570,3 +1580,99 @@ void MultithreadTest::TestBreakTranslit() {
 }
 
 #endif /* !UCONFIG_NO_TRANSLITERATION */
+
+
+#if !UCONFIG_NO_BREAK_ITERATION
+//
+//  BreakIteratorPool Threading Test
+//     Threads concurrently acquire, use and release iterators of several types
+//     from one shared pool, and check their boundaries against precomputed ones.
+//
+
+static BreakIteratorPool *gBreakIteratorPool;
+static const UnicodeString *gPoolText;
+static const char *const gPoolLocales[] = { "en", "th", "ja", "en@ss=standard" };
+// Boundaries for [type][locale], terminated by BreakIterator::DONE.
+static int32_t gPoolBoundaries[UBRK_SENTENCE + 1][UPRV_LENGTHOF(gPoolLocales)][200];
+
+class BreakIteratorPoolThread: public SimpleThread {
+  public:
+    BreakIteratorPoolThread(int32_t seed) : fSeed(seed) {};
+    ~BreakIteratorPoolThread() {};
+    void run();
+  private:
+    int32_t fSeed;
+};
+
+void BreakIteratorPoolThread::run() {
+    for (int32_t i=0; i<200; i++) {
+        int32_t type = (fSeed + i) % (UBRK_SENTENCE + 1);
+        int32_t loc = (fSeed + i / 3) % UPRV_LENGTHOF(gPoolLocales);
+        UErrorCode status = U_ZERO_ERROR;
+        BreakIterator *bi = gBreakIteratorPool->acquire(
+            (UBreakIteratorType)type, Locale(gPoolLocales[loc]), status);
+        if (U_FAILURE(status)) {
+            IntlTest::gTest->errln("%s:%d acquire() failed - %s", __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+        if (bi->next() != BreakIterator::DONE) {
+            IntlTest::gTest->errln("%s:%d Acquired iterator is not reset.", __FILE__, __LINE__);
+        }
+        bi->setText(*gPoolText);
+        const int32_t *expected = gPoolBoundaries[type][loc];
+        int32_t k = 0;
+        for (int32_t p = bi->first(); p != BreakIterator::DONE; p = bi->next()) {
+            if (p != expected[k++]) {
+                IntlTest::gTest->errln("%s:%d BreakIteratorPool threading failure.", __FILE__, __LINE__);
+                break;
+            }
+        }
+        gBreakIteratorPool->release(bi);
+    }
+}
+
+void MultithreadTest::TestBreakIteratorPool() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString text(
+        "Hello, world! \\u0E42\\u0E14\\u0E22\\u0E1E\\u0E37\\u0E49\\u0E19\\u0E10\\u0E32\\u0E19 "
+        "\\u65E5\\u672C\\u8A9E\\u3067\\u3059\\u3002 Mr. Smith went home.", -1, US_INV);
+    text = text.unescape();
+    gPoolText = &text;
+
+    for (int32_t type=0; type<=UBRK_SENTENCE; ++type) {
+        for (int32_t loc=0; loc<UPRV_LENGTHOF(gPoolLocales); ++loc) {
+            LocalPointer<BreakIterator> bi(
+                RBBITest::createIterator(type, Locale(gPoolLocales[loc]), status));
+            if (U_FAILURE(status)) {
+                dataerrln("%s:%d Error creating break iterator - %s", __FILE__, __LINE__, u_errorName(status));
+                return;
+            }
+            bi->setText(text);
+            int32_t k = 0;
+            for (int32_t p = bi->first(); p != BreakIterator::DONE && k < 199; p = bi->next()) {
+                gPoolBoundaries[type][loc][k++] = p;
+            }
+            gPoolBoundaries[type][loc][k] = BreakIterator::DONE;
+        }
+    }
+
+    BreakIteratorPool pool(2, status);
+    TSMTHREAD_ASSERT_SUCCESS(status);
+    gBreakIteratorPool = &pool;
+
+    BreakIteratorPoolThread *threads[8];
+    for (int32_t i=0; i<UPRV_LENGTHOF(threads); ++i) {
+        threads[i] = new BreakIteratorPoolThread(i);
+        threads[i]->start();
+    }
+    for (int32_t i=0; i<UPRV_LENGTHOF(threads); ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+    TSMTHREAD_ASSERT(pool.countIdle() <= 2 * (UBRK_SENTENCE + 1) * UPRV_LENGTHOF(gPoolLocales));
+
+    gBreakIteratorPool = NULL;
+    gPoolText = NULL;
+}
+
+#endif /* !UCONFIG_NO_BREAK_ITERATION */
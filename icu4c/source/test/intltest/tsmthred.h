@@ -50,6 +50,7 @@ public:
     void TestConditionVariables();
     void TestUnifiedCache();
     void TestBreakTranslit();
+    void TestBreakIteratorPool();
 
 };
 
@@ -9,6 +9,7 @@
 #if !UCONFIG_NO_NORMALIZATION
 
 #include "unicode/uchar.h"
+#include "unicode/bytestream.h"
 #include "unicode/errorcode.h"
 #include "unicode/normlzr.h"
 #include "unicode/uniset.h"
@@ -57,6 +58,9 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
         CASE(18,TestCustomFCC);
 #endif
         CASE(19,TestFilteredNormalizer2Coverage);
+        CASE(20,TestNormalizeUTF8);
+        CASE(21,TestNormalizer2Stream);
+        CASE(22,TestNormalizeBatch);
         default: name = ""; break;
     }
 }
@@ -1522,4 +1526,229 @@ BasicNormalizerTest::TestFilteredNormalizer2Coverage() {
     }
 }
 
+void
+BasicNormalizerTest::TestNormalizeUTF8() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizeUTF8");
+    const Normalizer2 *nfc=Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd=Normalizer2::getNFDInstance(errorCode);
+    if(errorCode.logDataIfFailureAndReset("Normalizer2::getNFC/NFDInstance()")) {
+        return;
+    }
+    static const struct {
+        UBool compose;
+        const char *src, *expected;
+    } cases[]={
+        { TRUE, "plain ASCII", "plain ASCII" },
+        { TRUE, "A\xCC\x8A Stra\xC3\x9F" "e", "\xC3\x85 Stra\xC3\x9F" "e" },
+        { FALSE, "\xC3\x85 Stra\xC3\x9F" "e", "A\xCC\x8A Stra\xC3\x9F" "e" },
+        // ill-formed sequences are copied unchanged
+        { TRUE, "\xFF" "A\xCC\x8A\x80", "\xFF\xC3\x85\x80" },
+        { FALSE, "\xC3\xA5\xC3", "a\xCC\x8A\xC3" },
+        { TRUE, "a\xCC\x88\xED\xA0\x80\xCC\x88", "\xC3\xA4\xED\xA0\x80\xCC\x88" },
+        // reordering across a segment
+        { FALSE, "a\xCC\x9B\xCC\xA3\xE1\xBB\xB1", "a\xCC\x9B\xCC\xA3u\xCC\x9B\xCC\xA3" },
+        { TRUE, "\xE1\x84\x80\xE1\x85\xA1\xE1\x86\xA8", "\xEA\xB0\x81" }
+    };
+    char buffer[100];
+    for(int32_t i=0; i<UPRV_LENGTHOF(cases); ++i) {
+        const Normalizer2 *norm2= cases[i].compose ? nfc : nfd;
+        const char *src=cases[i].src;
+        const char *expected=cases[i].expected;
+        CheckedArrayByteSink sink(buffer, UPRV_LENGTHOF(buffer));
+        norm2->normalizeUTF8(src, sink, errorCode);
+        if(errorCode.logIfFailureAndReset("case %d normalizeUTF8()", (int)i)) {
+            continue;
+        }
+        int32_t expectedLength=(int32_t)uprv_strlen(expected);
+        if(sink.NumberOfBytesAppended()!=expectedLength ||
+                uprv_memcmp(buffer, expected, expectedLength)!=0) {
+            errln("case %d %s.normalizeUTF8() wrong result", (int)i, cases[i].compose ? "NFC" : "NFD");
+        }
+        UBool isNormalized=uprv_strcmp(src, expected)==0;
+        if(norm2->isNormalizedUTF8(src, errorCode)!=isNormalized) {
+            errln("case %d isNormalizedUTF8()!=%d", (int)i, isNormalized);
+        }
+        if(!norm2->isNormalizedUTF8(StringPiece(buffer, expectedLength), errorCode)) {
+            errln("case %d isNormalizedUTF8(normalized)==FALSE", (int)i);
+        }
+        int32_t span=norm2->spanQuickCheckYesUTF8(src, errorCode);
+        int32_t span16=norm2->spanQuickCheckYes(UnicodeString::fromUTF8(src), errorCode);
+        UnicodeString prefix16=UnicodeString::fromUTF8(StringPiece(src, span));
+        if(prefix16.length()!=span16) {
+            errln("case %d spanQuickCheckYesUTF8()=%d does not match the UTF-16 span %d",
+                  (int)i, (int)span, (int)span16);
+        }
+        errorCode.logIfFailureAndReset("case %d", (int)i);
+    }
+
+    // Text outside the filter set is copied or skipped.
+    UnicodeSet filter(UNICODE_STRING_SIMPLE("[^\\u00e5]"), errorCode);
+    FilteredNormalizer2 fn2(*nfd, filter);
+    CheckedArrayByteSink sink(buffer, UPRV_LENGTHOF(buffer));
+    fn2.normalizeUTF8("\xC3\xA5\xC3\xA4", sink, errorCode);
+    if(errorCode.logIfFailureAndReset("FilteredNormalizer2.normalizeUTF8()")) {
+        return;
+    }
+    if(sink.NumberOfBytesAppended()!=5 || uprv_memcmp(buffer, "\xC3\xA5" "a\xCC\x88", 5)!=0) {
+        errln("FilteredNormalizer2(NFD, [^\\u00e5]).normalizeUTF8() wrong result");
+    }
+    if( fn2.isNormalizedUTF8("\xC3\xA5\xC3\xA4", errorCode) ||
+        !fn2.isNormalizedUTF8("\xC3\xA5" "a\xCC\x88", errorCode) ||
+        fn2.spanQuickCheckYesUTF8("\xC3\xA5\xC3\xA4", errorCode)!=2
+    ) {
+        errln("FilteredNormalizer2(NFD, [^\\u00e5]) UTF-8 quick check failed");
+    }
+    errorCode.logIfFailureAndReset("FilteredNormalizer2 UTF-8");
+}
+
+void
+BasicNormalizerTest::TestNormalizer2Stream() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizer2Stream");
+    const Normalizer2 *n2s[]={
+        Normalizer2::getNFCInstance(errorCode),
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCInstance(errorCode),
+        Normalizer2::getInstance(NULL, "nfc", UNORM2_FCD, errorCode)
+    };
+    if(errorCode.logDataIfFailureAndReset("Normalizer2::getInstance()")) {
+        return;
+    }
+    static const char *const strings[]={
+        "plain ASCII text. ",
+        "A\\u030A\\u0327 \\u1E0A\\u0323\\u0307 a\\u0301\\u0302\\u0303\\u0304",
+        // Hangul Jamo compose across chunks
+        "\\u1100\\u1161\\u11A8 \\uAC00\\u11A8\\u11A8",
+        // supplementary code points split across chunks
+        "\\U0001D15E\\U0001D165x\\U00011099\\U000110BA\\uFB2C",
+        "\\u0B47\\u0300\\u0B3E\\u0F73\\u0F75\\u0F81"
+    };
+    for(int32_t i=0; i<UPRV_LENGTHOF(strings); ++i) {
+        UnicodeString s=UnicodeString(strings[i], -1, US_INV).unescape();
+        for(int32_t j=0; j<UPRV_LENGTHOF(n2s); ++j) {
+            UnicodeString expected=n2s[j]->normalize(s, errorCode);
+            for(int32_t chunkLength=1; chunkLength<=s.length(); ++chunkLength) {
+                Normalizer2Stream stream(*n2s[j]);
+                UnicodeString result;
+                for(int32_t start=0; start<s.length(); start+=chunkLength) {
+                    stream.normalizeChunk(s.tempSubString(start, chunkLength), result, errorCode);
+                }
+                stream.finish(result, errorCode);
+                if(errorCode.logIfFailureAndReset("string %d normalizer %d chunks of %d",
+                                                  (int)i, (int)j, (int)chunkLength)) {
+                    break;
+                }
+                if(result!=expected || stream.getPendingLength()!=0) {
+                    errln("Normalizer2Stream: string %d normalizer %d with chunks of %d "
+                          "differs from normalizing the whole string",
+                          (int)i, (int)j, (int)chunkLength);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Only the end of the text is held back.
+    Normalizer2Stream stream(*n2s[0]);
+    UnicodeString result;
+    stream.normalizeChunk(UNICODE_STRING_SIMPLE("ab"), result, errorCode);
+    if(result!=UNICODE_STRING_SIMPLE("a") || stream.getPendingLength()!=1) {
+        errln("NFC Normalizer2Stream should hold back only \"b\" from \"ab\"");
+    }
+    stream.normalizeChunk(UNICODE_STRING_SIMPLE("\\u0308 ").unescape(), result, errorCode);
+    if(result!=UNICODE_STRING_SIMPLE("ab\\u0308 ").unescape() || stream.getPendingLength()!=0) {
+        errln("NFC Normalizer2Stream should hold back nothing after a space");
+    }
+    stream.normalizeChunk(UNICODE_STRING_SIMPLE("x"), result, errorCode);
+    stream.reset();
+    stream.finish(result, errorCode);
+    if(result!=UNICODE_STRING_SIMPLE("ab\\u0308 ").unescape()) {
+        errln("Normalizer2Stream.reset() should discard held-back text");
+    }
+    errorCode.logIfFailureAndReset("Normalizer2Stream");
+}
+
+void
+BasicNormalizerTest::TestNormalizeBatch() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizeBatch");
+    const Normalizer2 *nfc=Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfkc_cf=Normalizer2::getNFKCCasefoldInstance(errorCode);
+    if(errorCode.logDataIfFailureAndReset("Normalizer2::getNFC/NFKCCasefoldInstance()")) {
+        return;
+    }
+    UnicodeSet filter(UNICODE_STRING_SIMPLE("[^\\u00c5]"), errorCode);
+    FilteredNormalizer2 fn2(*nfc, filter);
+    const Normalizer2 *n2s[]={ nfc, nfkc_cf, &fn2 };
+    UnicodeString strings[]={
+        UNICODE_STRING_SIMPLE("user_name"),
+        UNICODE_STRING_SIMPLE("A\\u030A"),
+        UnicodeString(),
+        UNICODE_STRING_SIMPLE("\\u00C5ngstr\\u00F6m"),
+        UNICODE_STRING_SIMPLE("\\u1100\\u1161 \\uFB01 Stra\\u00DFe"),
+        UNICODE_STRING_SIMPLE("a\\u0301\\u0327"),
+        // Neither reordering nor composition across string boundaries.
+        UNICODE_STRING_SIMPLE("\\u0316\\u0300b\\u0308\\u0301"),
+        UNICODE_STRING_SIMPLE("\\u0323\\u1100"),
+        UNICODE_STRING_SIMPLE("\\u1161"),
+        UNICODE_STRING_SIMPLE("\\u00AD")  // NFKC_Casefold removes the soft hyphen
+    };
+    const int32_t count=UPRV_LENGTHOF(strings);
+    const UChar *srcs[UPRV_LENGTHOF(strings)];
+    int32_t srcLengths[UPRV_LENGTHOF(strings)];
+    int32_t destStarts[UPRV_LENGTHOF(strings)], destLengths[UPRV_LENGTHOF(strings)];
+    for(int32_t i=0; i<count; ++i) {
+        strings[i]=strings[i].unescape();
+        srcs[i]=strings[i].getTerminatedBuffer();
+        srcLengths[i]= (i&1)==0 ? strings[i].length() : -1;
+    }
+    UnicodeString dest;
+    for(int32_t j=0; j<UPRV_LENGTHOF(n2s); ++j) {
+        n2s[j]->normalizeBatch(srcs, srcLengths, count, dest, destStarts, destLengths, errorCode);
+        if(errorCode.logIfFailureAndReset("normalizer %d normalizeBatch()", (int)j)) {
+            continue;
+        }
+        for(int32_t i=0; i<count; ++i) {
+            UnicodeString expected=n2s[j]->normalize(strings[i], errorCode);
+            UnicodeString result;
+            if(destStarts[i]<0) {
+                if(srcLengths[i]>=0 && destLengths[i]!=srcLengths[i]) {
+                    errln("normalizer %d normalizeBatch() string %d: wrong unchanged length",
+                          (int)j, (int)i);
+                }
+                result.setTo(FALSE, srcs[i], destLengths[i]);
+            } else {
+                result=dest.tempSubString(destStarts[i], destLengths[i]);
+            }
+            if(result!=expected) {
+                errln("normalizer %d normalizeBatch() string %d differs from normalize()",
+                      (int)j, (int)i);
+            }
+        }
+    }
+    // Already-normalized strings are not copied.
+    nfc->normalizeBatch(srcs, srcLengths, 1, dest, destStarts, destLengths, errorCode);
+    if(destStarts[0]!=-1 || destLengths[0]!=9 || !dest.isEmpty()) {
+        errln("NFC.normalizeBatch(\"user_name\") should not copy the string");
+    }
+    // A (NULL, 0) entry is an empty string.
+    const UChar *emptySrcs[]={ srcs[1], NULL, srcs[4] };
+    const int32_t emptySrcLengths[]={ -1, 0, -1 };
+    for(int32_t j=0; j<UPRV_LENGTHOF(n2s); ++j) {
+        n2s[j]->normalizeBatch(emptySrcs, emptySrcLengths, 3, dest, destStarts, destLengths, errorCode);
+        if(errorCode.logIfFailureAndReset("normalizer %d normalizeBatch(NULL, 0)", (int)j)) {
+            continue;
+        }
+        if(destStarts[1]!=-1 || destLengths[1]!=0) {
+            errln("normalizer %d normalizeBatch() (NULL, 0) entry is not an empty result", (int)j);
+        }
+        UnicodeString result=dest.tempSubString(destStarts[2], destLengths[2]);
+        if(destStarts[2]<0 || result!=n2s[j]->normalize(strings[4], errorCode)) {
+            errln("normalizer %d normalizeBatch() wrong result after a (NULL, 0) entry", (int)j);
+        }
+    }
+    nfc->normalizeBatch(NULL, NULL, 1, dest, destStarts, destLengths, errorCode);
+    if(errorCode.reset()!=U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("normalizeBatch(srcs=NULL) did not set U_ILLEGAL_ARGUMENT_ERROR");
+    }
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
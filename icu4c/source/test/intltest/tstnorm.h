@@ -45,6 +45,9 @@ public:
     void TestCustomComp();
     void TestCustomFCC();
     void TestFilteredNormalizer2Coverage();
+    void TestNormalizeUTF8();
+    void TestNormalizer2Stream();
+    void TestNormalizeBatch();
 
 private:
     UnicodeString canonTests[24][3];
@@ -26,6 +26,7 @@
 #include "ztrans.h"
 #include "vzone.h"
 #include "cmemory.h"
+#include "uvector.h"
 
 #define CASE(id,test) case id: name = #test; if (exec) { logln(#test "---"); logln((UnicodeString)""); test(); } break
 #define HOUR (60*60*1000)
@@ -139,6 +140,7 @@ void TimeZoneRuleTest::runIndexedTest( int32_t index, UBool exec, const char* &n
         CASE(15, TestT6669);
         CASE(16, TestVTimeZoneWrapper);
         CASE(17, TestT8943);
+        CASE(18, TestGetOffsets);
         default: name = ""; break;
     }
 }
@@ -2659,6 +2661,103 @@ TimeZoneRuleTest::TestT8943(void) {
     delete rbtz;
 }
 
+/*
+ * Compare BasicTimeZone::getOffsets() with getOffset() for each date,
+ * for dates in ascending order, right around transitions, and in random order.
+ */
+void
+TimeZoneRuleTest::TestGetOffsets(void) {
+    UErrorCode status = U_ZERO_ERROR;
+    static const char *const ids[] = {
+        "America/New_York", "Europe/London", "Australia/Lord_Howe", "Pacific/Apia", "Asia/Tokyo", "Etc/GMT+5"
+    };
+    UVector zones(status);
+    zones.setDeleter(uprv_deleteUObject);
+    for (int32_t i = 0; i < UPRV_LENGTHOF(ids); i++) {
+        zones.addElement(TimeZone::createTimeZone(ids[i]), status);
+        zones.addElement(VTimeZone::createVTimeZoneByID(ids[i]), status);
+    }
+    zones.addElement(new SimpleTimeZone(-5*HOUR, "US_Eastern",
+        UCAL_MARCH, 8, -UCAL_SUNDAY, 2*HOUR, UCAL_NOVEMBER, 1, -UCAL_SUNDAY, 2*HOUR, status), status);
+    if (U_FAILURE(status)) {
+        dataerrln("FAIL: Failed to create the time zones - %s", u_errorName(status));
+        return;
+    }
+
+    const int32_t STEPS = 20000;
+    UDate start = getUTCMillis(1890, UCAL_JANUARY, 1);
+    UDate end = getUTCMillis(2040, UCAL_JANUARY, 1);
+    double step = (end - start) / STEPS;
+    LocalArray<UDate> dates(new UDate[STEPS]);
+    for (int32_t i = 0; i < STEPS; i++) {
+        dates[i] = start + i * step;
+    }
+    LocalArray<UDate> shuffled(new UDate[STEPS]);
+    for (int32_t i = 0; i < STEPS; i++) {
+        shuffled[i] = dates[(int32_t)(((int64_t)i * 7919) % STEPS)];
+    }
+    const int32_t MAX_BOUNDARIES = 3000;
+    LocalArray<UDate> boundaries(new UDate[MAX_BOUNDARIES]);
+
+    for (int32_t z = 0; z < zones.size(); z++) {
+        const BasicTimeZone *tz = (const BasicTimeZone *)zones.elementAt(z);
+        verifyOffsets(*tz, dates.getAlias(), STEPS, "ascending");
+        verifyOffsets(*tz, shuffled.getAlias(), STEPS, "shuffled");
+
+        int32_t count = 0;
+        TimeZoneTransition tzt;
+        UDate t = start;
+        while (count + 3 <= MAX_BOUNDARIES && tz->getNextTransition(t, FALSE, tzt) && tzt.getTime() < end) {
+            t = tzt.getTime();
+            boundaries[count++] = t - 1;
+            boundaries[count++] = t;
+            boundaries[count++] = t + 1;
+        }
+        verifyOffsets(*tz, boundaries.getAlias(), count, "around transitions");
+    }
+
+    // Argument checking.
+    int32_t raw, dst;
+    const TimeZone *tz = (const TimeZone *)zones.elementAt(0);
+    ((const BasicTimeZone *)tz)->getOffsets(NULL, 1, &raw, &dst, status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("FAIL: getOffsets(NULL dates) should fail with U_ILLEGAL_ARGUMENT_ERROR - %s", u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    ((const BasicTimeZone *)tz)->getOffsets(NULL, 0, NULL, NULL, status);
+    if (U_FAILURE(status)) {
+        errln("FAIL: getOffsets(count=0) failed - %s", u_errorName(status));
+    }
+}
+
+void
+TimeZoneRuleTest::verifyOffsets(const BasicTimeZone& tz, const UDate dates[], int32_t count,
+                                const char *order) {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString id;
+    tz.getID(id);
+    LocalArray<int32_t> rawOffsets(new int32_t[count + 1]);
+    LocalArray<int32_t> dstOffsets(new int32_t[count + 1]);
+    tz.getOffsets(dates, count, rawOffsets.getAlias(), dstOffsets.getAlias(), status);
+    if (U_FAILURE(status)) {
+        errln(UnicodeString("FAIL: getOffsets failed for ") + id + " - " + u_errorName(status));
+        return;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        int32_t raw, dst;
+        tz.getOffset(dates[i], FALSE, raw, dst, status);
+        if (U_FAILURE(status)) {
+            errln(UnicodeString("FAIL: getOffset failed for ") + id + " - " + u_errorName(status));
+            return;
+        }
+        if (raw != rawOffsets[i] || dst != dstOffsets[i]) {
+            errln(UnicodeString("FAIL: getOffsets for ") + id + ", " + order + ", at " + dates[i] +
+                " returned " + rawOffsets[i] + "/" + dstOffsets[i] + ", expected " + raw + "/" + dst);
+            return;
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
 
 //eof
@@ -38,8 +38,11 @@ public:
     void TestT6669(void);
     void TestVTimeZoneWrapper(void);
     void TestT8943(void);
+    void TestGetOffsets(void);
 
 private:
+    void verifyOffsets(const BasicTimeZone& tz, const UDate dates[], int32_t count,
+        const char *order);
     void verifyTransitions(BasicTimeZone& icutz, UDate start, UDate end);
     void compareTransitionsAscending(BasicTimeZone& z1, BasicTimeZone& z2,
         UDate start, UDate end, UBool inclusive);
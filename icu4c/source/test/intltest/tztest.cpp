@@ -72,6 +72,7 @@ void TimeZoneTest::runIndexedTest( int32_t index, UBool exec, const char* &name,
     TESTCASE_AUTO(TestGetUnknown);
     TESTCASE_AUTO(TestGetWindowsID);
     TESTCASE_AUTO(TestGetIDForWindowsID);
+    TESTCASE_AUTO(TestCreateTimeZoneShared);
     TESTCASE_AUTO_END;
 }
 
@@ -2392,6 +2393,35 @@ void TimeZoneTest::TestGetUnknown() {
     assertFalse("getUnknown() uses DST", unknown.useDaylightTime());
 }
 
+// System time zones are loaded once and then cloned from the UnifiedCache.
+// Each instance must still be independent and keep the ID it was created with.
+void TimeZoneTest::TestCreateTimeZoneShared() {
+    LocalPointer<TimeZone> ny1(TimeZone::createTimeZone("America/New_York"));
+    LocalPointer<TimeZone> ny2(TimeZone::createTimeZone("America/New_York"));
+    LocalPointer<TimeZone> eastern(TimeZone::createTimeZone("US/Eastern"));
+    UnicodeString id;
+    if (ny1->getID(id) != UNICODE_STRING_SIMPLE("America/New_York")) {
+        dataerrln("Could not load America/New_York");
+        return;
+    }
+    assertTrue("separate instances", ny1.getAlias() != ny2.getAlias());
+    assertTrue("equal instances", *ny1 == *ny2);
+    assertEquals("alias keeps its ID", UNICODE_STRING_SIMPLE("US/Eastern"), eastern->getID(id));
+    assertTrue("alias has the same rules", ny1->hasSameRules(*eastern));
+
+    ny1->setID(UNICODE_STRING_SIMPLE("Custom"));
+    LocalPointer<TimeZone> ny3(TimeZone::createTimeZone("America/New_York"));
+    assertEquals("changing one instance does not change others",
+                 UNICODE_STRING_SIMPLE("America/New_York"), ny3->getID(id));
+    assertTrue("equal to the first one", *ny2 == *ny3);
+
+    // Unknown IDs are remembered as failures but still fall back to Etc/Unknown.
+    for (int32_t i = 0; i < 2; ++i) {
+        LocalPointer<TimeZone> bogus(TimeZone::createTimeZone("Bogus/Zone"));
+        assertEquals("unknown zone", UNICODE_STRING_SIMPLE("Etc/Unknown"), bogus->getID(id));
+    }
+}
+
 void TimeZoneTest::TestGetWindowsID(void) {
     static const struct {
         const char *id;
@@ -100,6 +100,7 @@ public:
 
     void TestGetWindowsID(void);
     void TestGetIDForWindowsID(void);
+    void TestCreateTimeZoneShared(void);
 
     static const UDate INTERVAL;
 
@@ -8,6 +8,7 @@
 *
 ********************************************************************************
 */
+#include "charstr.h"
 #include "cstring.h"
 #include "intltest.h"
 #include "unifiedcache.h"
@@ -22,6 +23,9 @@ class UCTItem : public SharedObject {
     virtual ~UCTItem() {
         uprv_free(value);
     }
+    virtual int32_t getApproximateSize() const {
+        return 1000;
+    }
 };
 
 class UCTItem2 : public SharedObject {
@@ -75,6 +79,8 @@ private:
     void TestError();
     void TestHashEquals();
     void TestEvictionUnderStress();
+    void TestStats();
+    void TestMemoryBudget();
 };
 
 void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
@@ -85,6 +91,8 @@ void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &na
   TESTCASE_AUTO(TestError);
   TESTCASE_AUTO(TestHashEquals);
   TESTCASE_AUTO(TestEvictionUnderStress);
+  TESTCASE_AUTO(TestStats);
+  TESTCASE_AUTO(TestMemoryBudget);
   TESTCASE_AUTO_END;
 }
 
@@ -394,6 +402,118 @@ void UnifiedCacheTest::TestHashEquals() {
     assertTrue("", diffKey1 != diffKey2);
 }
 
+void UnifiedCacheTest::TestStats() {
+    UErrorCode status = U_ZERO_ERROR;
+    // See TestEvictionPolicy() about the local cache instance.
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("", status);
+    cache.setStatsEnabled(TRUE);
+
+    const UCTItem *en = NULL;
+    const UCTItem *enUs = NULL;
+    cache.get(LocaleCacheKey<UCTItem>("en"), &cache, en, status);
+    // Creating en_US looks up en again.
+    cache.get(LocaleCacheKey<UCTItem>("en_US"), &cache, enUs, status);
+    cache.get(LocaleCacheKey<UCTItem>("en"), &cache, en, status);
+    assertSuccess("", status);
+
+    UnifiedCacheStats stats;
+    int32_t count = cache.getStats(NULL, 0, status);
+    assertEquals("preflighting", U_BUFFER_OVERFLOW_ERROR, status);
+    assertEquals("one key type", 1, count);
+    status = U_ZERO_ERROR;
+    cache.getStats(&stats, 1, status);
+    assertSuccess("", status);
+    assertEquals("key type", typeid(LocaleCacheKey<UCTItem>).name(), stats.keyType);
+    assertEquals("lookups", 4, (int32_t) stats.lookups);
+    assertEquals("hits", 2, (int32_t) stats.hits);
+    assertEquals("misses", 2, (int32_t) stats.misses);
+    assertEquals("waits", 0, (int32_t) stats.inProgressWaits);
+    assertEquals("evictions", 0, (int32_t) stats.evictions);
+    assertEquals("entries", 2, stats.entryCount);
+    // en_US shares the value of en.
+    assertEquals("bytes", 1000, (int32_t) stats.byteCount);
+    assertTrue("creation time", stats.creationMillis >= 0.0);
+
+    CharString snapshot;
+    cache.getSnapshot(snapshot, status);
+    assertSuccess("", status);
+    if (uprv_strstr(snapshot.data(), "\ten\tU_ZERO_ERROR\t") == NULL ||
+            uprv_strstr(snapshot.data(), "\ten_US\t") == NULL ||
+            uprv_strstr(snapshot.data(), "\tmaster\t1000\n") == NULL) {
+        errln("Unexpected cache snapshot: %s", snapshot.data());
+    }
+
+    // Unused entries get evicted as soon as possible.
+    cache.setEvictionPolicy(0, 0, status);
+    SharedObject::clearPtr(enUs);
+    SharedObject::clearPtr(en);
+    cache.getStats(&stats, 1, status);
+    assertTrue("evictions", stats.evictions > 0);
+    assertEquals("evicted or still there", 2, (int32_t) stats.evictions + stats.entryCount);
+
+    cache.flush();
+    cache.resetStats();
+    count = cache.getStats(&stats, 1, status);
+    assertSuccess("", status);
+    assertEquals("no statistics after reset", 0, count);
+}
+
+void UnifiedCacheTest::TestMemoryBudget() {
+    UErrorCode status = U_ZERO_ERROR;
+    // See TestEvictionPolicy() about the local cache instance.
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("", status);
+
+    cache.setMemoryBudget(-1, status);
+    assertEquals("negative budget", U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+
+    static const char *locales[] = {"1", "2", "3", "4"};
+    const UCTItem *items[] = {NULL, NULL, NULL, NULL};
+    for (int32_t i = 0; i < UPRV_LENGTHOF(items); ++i) {
+        cache.get(LocaleCacheKey<UCTItem>(locales[i]), &cache, items[i], status);
+    }
+    assertSuccess("", status);
+    assertEquals("bytes", 4000, cache.byteCount());
+
+    // Values in use are never evicted.
+    cache.setMemoryBudget(2500, status);
+    assertSuccess("", status);
+    const UCTItem *item = NULL;
+    cache.get(LocaleCacheKey<UCTItem>("1"), &cache, item, status);
+    SharedObject::clearPtr(item);
+    assertEquals("over budget while in use", 4000, cache.byteCount());
+
+    // Releasing the values makes room, but the entry used last stays.
+    for (int32_t i = 0; i < UPRV_LENGTHOF(items); ++i) {
+        SharedObject::clearPtr(items[i]);
+    }
+    assertTrue("within budget", cache.byteCount() <= 2500);
+    CharString snapshot;
+    cache.getSnapshot(snapshot, status);
+    assertSuccess("", status);
+    if (uprv_strstr(snapshot.data(), "\t4\t") == NULL) {
+        errln("Recently used entry was evicted: %s", snapshot.data());
+    }
+
+    // Without a budget, the count-based policy is the only limit.
+    cache.setMemoryBudget(0, status);
+    cache.flush();
+    for (int32_t i = 0; i < UPRV_LENGTHOF(items); ++i) {
+        cache.get(LocaleCacheKey<UCTItem>(locales[i]), &cache, items[i], status);
+    }
+    for (int32_t i = 0; i < UPRV_LENGTHOF(items); ++i) {
+        SharedObject::clearPtr(items[i]);
+    }
+    assertSuccess("", status);
+    assertEquals("no budget", 4000, cache.byteCount());
+    cache.flush();
+    assertEquals("flushed", 0, cache.byteCount());
+}
+
 extern IntlTest *createUnifiedCacheTest() {
     return new UnifiedCacheTest();
 }
@@ -56,6 +56,12 @@ UPerfFunction* DateFormatPerfTest::runIndexedTest(int32_t index, UBool exec,cons
         TESTCASE(22,DateFmtCopy10000);
         TESTCASE(23,DateFmtCreate250);
         TESTCASE(24,DateFmtCreate10000);
+        TESTCASE(25, TimeZoneOffsetSequential10000);
+        TESTCASE(26, TimeZoneOffsetRandom10000);
+        TESTCASE(27, TimeZoneOffsetsSequential10000);
+        TESTCASE(28, TimeZoneOffsetsRandom10000);
+        TESTCASE(29, TimeZoneOffsetRecent10000);
+        TESTCASE(30, TimeZoneOffsetsRecent10000);
 
 
         default: 
@@ -140,6 +146,30 @@ UPerfFunction *DateFormatPerfTest::TimeZoneCreate10000() {
     return new TimeZoneCreateFunction(10000, locale);
 }
 
+UPerfFunction *DateFormatPerfTest::TimeZoneOffsetSequential10000() {
+    return new TimeZoneOffsetFunction(10000, TRUE);
+}
+
+UPerfFunction *DateFormatPerfTest::TimeZoneOffsetRandom10000() {
+    return new TimeZoneOffsetFunction(10000, FALSE);
+}
+
+UPerfFunction *DateFormatPerfTest::TimeZoneOffsetsSequential10000() {
+    return new TimeZoneOffsetFunction(10000, TRUE, TRUE);
+}
+
+UPerfFunction *DateFormatPerfTest::TimeZoneOffsetsRandom10000() {
+    return new TimeZoneOffsetFunction(10000, FALSE, TRUE);
+}
+
+UPerfFunction *DateFormatPerfTest::TimeZoneOffsetRecent10000() {
+    return new TimeZoneOffsetFunction(10000, TRUE, FALSE, TRUE);
+}
+
+UPerfFunction *DateFormatPerfTest::TimeZoneOffsetsRecent10000() {
+    return new TimeZoneOffsetFunction(10000, TRUE, TRUE, TRUE);
+}
+
 UPerfFunction *DateFormatPerfTest::DTPatternGeneratorCreate250() {
     return new DTPatternGeneratorCreateFunction(250, locale);
 }
@@ -18,6 +18,7 @@
 #include "unicode/utypes.h"
 #include "unicode/datefmt.h"
 #include "unicode/calendar.h"
+#include "unicode/basictz.h"
 #include "unicode/uclean.h"
 #include "unicode/brkiter.h"
 #include "unicode/numfmt.h"
@@ -412,6 +413,73 @@ public:
 
 };
 
+class TimeZoneOffsetFunction : public UPerfFunction
+{
+
+private:
+	int num;
+	UBool sequential;
+	UBool batch;
+	TimeZone *tz;
+	UDate *dates;
+	int32_t *rawOffsets;
+	int32_t *dstOffsets;
+public:
+
+	// Computes the offsets for num dates in the historical range of
+	// America/New_York (1900..2006), either in steps of one hour
+	// or in pseudo-random order, one date at a time or with
+	// BasicTimeZone::getOffsets().
+	// With recent=TRUE, the hourly steps start in 2016 instead of 1950,
+	// where the offsets come from the zone's final rules.
+	TimeZoneOffsetFunction(int a, UBool seq, UBool bat = FALSE, UBool recent = FALSE)
+	{
+		num = a;
+		sequential = seq;
+		batch = bat;
+		tz = TimeZone::createTimeZone("America/New_York");
+		dates = new UDate[num];
+		rawOffsets = new int32_t[num];
+		dstOffsets = new int32_t[num];
+		const UDate start = -2208988800000.0;  // 1900-01-01
+		const UDate range = 107.0 * 365.25 * U_MILLIS_PER_DAY;
+		uint32_t seed = 12345;
+		for(int j = 0; j < num; j++) {
+			if (sequential) {
+				dates[j] = start + (recent ? 116.0 : 50.0) * 365.25 * U_MILLIS_PER_DAY + j * (double)U_MILLIS_PER_HOUR;
+			} else {
+				seed = seed * 1103515245 + 12345;
+				dates[j] = start + (seed >> 8) * (range / (1 << 24));
+			}
+		}
+	}
+
+	~TimeZoneOffsetFunction()
+	{
+		delete tz;
+		delete[] dates;
+		delete[] rawOffsets;
+		delete[] dstOffsets;
+	}
+
+	virtual void call(UErrorCode* status)
+	{
+		if (batch) {
+			((BasicTimeZone *)tz)->getOffsets(dates, num, rawOffsets, dstOffsets, *status);
+			return;
+		}
+		int32_t rawOffset, dstOffset;
+		for(int j = 0; j < num; j++) {
+			tz->getOffset(dates[j], FALSE, rawOffset, dstOffset, *status);
+		}
+	}
+
+	virtual long getOperationsPerIteration()
+	{
+		return num;
+	}
+};
+
 class DTPatternGeneratorCreateFunction : public UPerfFunction
 {
 
@@ -834,6 +902,12 @@ public:
     UPerfFunction* DIFCreate10000();
     UPerfFunction* TimeZoneCreate250();
     UPerfFunction* TimeZoneCreate10000();
+    UPerfFunction* TimeZoneOffsetSequential10000();
+    UPerfFunction* TimeZoneOffsetRandom10000();
+    UPerfFunction* TimeZoneOffsetsSequential10000();
+    UPerfFunction* TimeZoneOffsetsRandom10000();
+    UPerfFunction* TimeZoneOffsetRecent10000();
+    UPerfFunction* TimeZoneOffsetsRecent10000();
     UPerfFunction* DTPatternGeneratorCreate250();
     UPerfFunction* DTPatternGeneratorCreate10000();
     UPerfFunction* DTPatternGeneratorCopy250();
@@ -16,6 +16,8 @@
 #include "uarrsort.h"
 #include "uoptions.h"
 #include "ustr_imp.h"
+#include <thread>
+#include <vector>
 
 #define COMPACT_ARRAY(CompactArrays, UNIT) \
 struct CompactArrays{\
@@ -324,6 +326,221 @@ long GetSortKey::getOperationsPerIteration()
     return source->count;
 }
 
+//
+// Test case taking a single test data array, calling ucol_getSortKeyUTF8 by loop
+//
+class GetSortKeyUTF8 : public UPerfFunction
+{
+public:
+    GetSortKeyUTF8(const UCollator* coll, const CA_char* source)
+        :   coll(coll), source(source) {}
+    ~GetSortKeyUTF8() {}
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration() { return source->count; }
+
+private:
+    const UCollator *coll;
+    const CA_char *source;
+};
+
+void GetSortKeyUTF8::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    uint8_t key[KEY_BUF_SIZE];
+    for (int32_t i = 0; i < source->count; i++) {
+        ucol_getSortKeyUTF8(coll, source->dataOf(i), source->lengthOf(i), key, KEY_BUF_SIZE, status);
+    }
+}
+
+//
+// Test case taking a single test data array, calling ucol_getCollationHash by loop
+//
+class GetCollationHash : public UPerfFunction
+{
+public:
+    GetCollationHash(const UCollator* coll, const CA_uchar* source)
+        :   coll(coll), source(source), hash(0) {}
+    ~GetCollationHash() {}
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration() { return source->count; }
+
+private:
+    const UCollator *coll;
+    const CA_uchar *source;
+    uint64_t hash;
+};
+
+void GetCollationHash::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    for (int32_t i = 0; i < source->count; i++) {
+        hash ^= ucol_getCollationHash(coll, source->dataOf(i), source->lengthOf(i),
+                                      UCOL_DEFAULT, status);
+    }
+}
+
+//
+// Test case taking a single test data array, calling ucol_getCompactSortKey by loop.
+// Prints the compact vs. full key sizes when done.
+//
+class GetCompactSortKey : public UPerfFunction
+{
+public:
+    GetCompactSortKey(const UCollator* coll, const CA_uchar* source,
+                      UColAttributeValue strength, int32_t maxLevelLength)
+        :   coll(coll), source(source), strength(strength), maxLevelLength(maxLevelLength) {
+        memset(&stats, 0, sizeof(stats));
+    }
+    ~GetCompactSortKey();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration() { return source->count; }
+
+private:
+    const UCollator *coll;
+    const CA_uchar *source;
+    UColAttributeValue strength;
+    int32_t maxLevelLength;
+    UCollationKeyStats stats;
+};
+
+GetCompactSortKey::~GetCompactSortKey()
+{
+    if (stats.keyCount > 0) {
+        fprintf(stdout, "compact sort keys: %.2f bytes/key (max %d, %.1f%% truncated) "
+                "vs. %.2f bytes/key without truncation\n",
+                (double)stats.totalLength / stats.keyCount, (int)stats.maxLength,
+                100. * stats.truncatedCount / stats.keyCount,
+                (double)stats.fullLength / stats.keyCount);
+    }
+}
+
+void GetCompactSortKey::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    uint8_t key[KEY_BUF_SIZE];
+    for (int32_t i = 0; i < source->count; i++) {
+        ucol_getCompactSortKey(coll, source->dataOf(i), source->lengthOf(i),
+                               strength, maxLevelLength, key, KEY_BUF_SIZE, &stats, status);
+    }
+}
+
+//
+// Test case taking a single test data array, calling ucol_getSortKeys or ucol_getSortKeysUTF8
+// for the whole batch, optionally split into contiguous ranges for several worker threads.
+// Each range is preflighted once so that all keys go into one arena.
+//
+template<typename CA, typename UNIT>
+class GetSortKeys : public UPerfFunction
+{
+public:
+    GetSortKeys(const UCollator* coll, const CA* source, int32_t workerCount, UErrorCode &status);
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration();
+
+private:
+    void getRange(int32_t worker, UErrorCode* status);
+    int32_t getKeys(int32_t start, int32_t limit, uint8_t *dest, int32_t capacity,
+                    int32_t *offsets, UErrorCode* status);
+
+    const UCollator *coll;
+    const CA *source;
+    int32_t workerCount;
+    std::vector<const UNIT *> sources;
+    std::vector<int32_t> lengths;
+    std::vector<int32_t> rangeStarts;  // workerCount+1 string indexes
+    std::vector<int32_t> arenaStarts;  // workerCount+1 arena offsets
+    std::vector<int32_t> offsets;  // count+workerCount: each range has its own end offset
+    std::vector<uint8_t> arena;
+};
+
+template<typename CA, typename UNIT>
+GetSortKeys<CA, UNIT>::GetSortKeys(const UCollator* coll, const CA* source, int32_t workerCount,
+                                   UErrorCode &status)
+    :   coll(coll),
+        source(source),
+        workerCount(workerCount)
+{
+    if (U_FAILURE(status)) return;
+    for (int32_t i = 0; i < source->count; i++) {
+        sources.push_back(source->dataOf(i));
+        lengths.push_back(source->lengthOf(i));
+    }
+    offsets.resize(source->count + workerCount);
+    rangeStarts.push_back(0);
+    arenaStarts.push_back(0);
+    for (int32_t w = 0; w < workerCount; w++) {
+        int32_t start = rangeStarts[w];
+        int32_t limit = (int32_t)(((int64_t)source->count * (w + 1)) / workerCount);
+        UErrorCode preflightStatus = U_ZERO_ERROR;
+        int32_t length = getKeys(start, limit, NULL, 0, &offsets[start + w], &preflightStatus);
+        if (U_FAILURE(preflightStatus) && preflightStatus != U_BUFFER_OVERFLOW_ERROR) {
+            status = preflightStatus;
+            return;
+        }
+        rangeStarts.push_back(limit);
+        arenaStarts.push_back(arenaStarts[w] + length);
+    }
+    arena.resize(arenaStarts[workerCount] + 1);
+}
+
+template<>
+int32_t GetSortKeys<CA_uchar, UChar>::getKeys(int32_t start, int32_t limit,
+                                              uint8_t *dest, int32_t capacity,
+                                              int32_t *offsets, UErrorCode* status)
+{
+    return ucol_getSortKeys(coll, &sources[0] + start, &lengths[0] + start, limit - start,
+                            dest, capacity, offsets, status);
+}
+
+template<>
+int32_t GetSortKeys<CA_char, char>::getKeys(int32_t start, int32_t limit,
+                                            uint8_t *dest, int32_t capacity,
+                                            int32_t *offsets, UErrorCode* status)
+{
+    return ucol_getSortKeysUTF8(coll, &sources[0] + start, &lengths[0] + start, limit - start,
+                                dest, capacity, offsets, status);
+}
+
+template<typename CA, typename UNIT>
+void GetSortKeys<CA, UNIT>::getRange(int32_t worker, UErrorCode* status)
+{
+    int32_t arenaStart = arenaStarts[worker];
+    getKeys(rangeStarts[worker], rangeStarts[worker + 1],
+            &arena[0] + arenaStart, arenaStarts[worker + 1] - arenaStart,
+            &offsets[rangeStarts[worker] + worker], status);
+}
+
+template<typename CA, typename UNIT>
+void GetSortKeys<CA, UNIT>::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    if (workerCount == 1) {
+        getRange(0, status);
+        return;
+    }
+    std::vector<std::thread> threads;
+    std::vector<UErrorCode> statuses(workerCount, U_ZERO_ERROR);
+    for (int32_t w = 0; w < workerCount; w++) {
+        threads.push_back(std::thread(&GetSortKeys::getRange, this, w, &statuses[w]));
+    }
+    for (int32_t w = 0; w < workerCount; w++) {
+        threads[w].join();
+        if (U_FAILURE(statuses[w])) {
+            *status = statuses[w];
+        }
+    }
+}
+
+template<typename CA, typename UNIT>
+long GetSortKeys<CA, UNIT>::getOperationsPerIteration()
+{
+    return source->count;
+}
+
 //
 // Test case taking a single test data array in UTF-16, calling ucol_nextSortKeyPart for each for the
 // given buffer size
@@ -946,6 +1163,189 @@ void StringPieceSortC::call(UErrorCode* status) {
     ops = cc.counter;
 }
 
+//
+// Test case sorting an array of UTF-16 strings with ucol_sortStrings().
+//
+class SortStrings : public CollPerfFunction {
+public:
+    SortStrings(const Collator& coll, const UCollator *ucoll, const CA_uchar* data16)
+            : CollPerfFunction(coll, ucoll), d16(data16),
+              source(new const UChar*[d16->count]), lengths(new int32_t[d16->count]),
+              order(new int32_t[d16->count]) {
+        for (int32_t i = 0; i < d16->count; ++i) {
+            source[i] = d16->dataOf(i);
+            lengths[i] = d16->lengthOf(i);
+        }
+    }
+    virtual ~SortStrings();
+    virtual void call(UErrorCode* status);
+
+private:
+    const CA_uchar* d16;
+    const UChar** source;
+    int32_t* lengths;
+    int32_t* order;
+};
+
+SortStrings::~SortStrings() {
+    delete[] source;
+    delete[] lengths;
+    delete[] order;
+}
+
+void SortStrings::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    ucol_sortStrings(ucoll, source, lengths, d16->count, order, TRUE, status);
+    ops = d16->count;
+}
+
+//
+// Test case sorting an array of UTF-8 strings with ucol_sortStringsUTF8().
+//
+class SortStringsUTF8 : public CollPerfFunction {
+public:
+    SortStringsUTF8(const Collator& coll, const UCollator *ucoll, const CA_char* data8)
+            : CollPerfFunction(coll, ucoll), d8(data8),
+              source(new const char*[d8->count]), lengths(new int32_t[d8->count]),
+              order(new int32_t[d8->count]) {
+        for (int32_t i = 0; i < d8->count; ++i) {
+            source[i] = d8->dataOf(i);
+            lengths[i] = d8->lengthOf(i);
+        }
+    }
+    virtual ~SortStringsUTF8();
+    virtual void call(UErrorCode* status);
+
+private:
+    const CA_char* d8;
+    const char** source;
+    int32_t* lengths;
+    int32_t* order;
+};
+
+SortStringsUTF8::~SortStringsUTF8() {
+    delete[] source;
+    delete[] lengths;
+    delete[] order;
+}
+
+void SortStringsUTF8::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    ucol_sortStringsUTF8(ucoll, source, lengths, d8->count, order, TRUE, status);
+    ops = d8->count;
+}
+
+//
+// Test case sorting one array with ucol_sortStringRange() or ucol_sortStringRangeUTF8()
+// on several worker threads, one contiguous range each,
+// and then combining pairs of sorted ranges with ucol_mergeSortedPermutations()
+// or ucol_mergeSortedPermutationsUTF8(), again one thread per pair.
+//
+template<typename CA, typename UNIT>
+class ParallelSortStrings : public CollPerfFunction {
+public:
+    ParallelSortStrings(const Collator& coll, const UCollator *ucoll, const CA* data,
+                        int32_t workerCount)
+            : CollPerfFunction(coll, ucoll), data(data), workerCount(workerCount),
+              order(data->count), temp(data->count) {
+        for (int32_t i = 0; i < data->count; ++i) {
+            sources.push_back(data->dataOf(i));
+            lengths.push_back(data->lengthOf(i));
+        }
+        for (int32_t w = 0; w <= workerCount; ++w) {
+            rangeStarts.push_back((int32_t)(((int64_t)data->count * w) / workerCount));
+        }
+    }
+    virtual ~ParallelSortStrings() {}
+    virtual void call(UErrorCode* status);
+
+private:
+    void sortRange(int32_t worker, UErrorCode* status);
+    void merge(const int32_t *src, int32_t *dest, int32_t start, int32_t middle, int32_t limit,
+               UErrorCode* status);
+
+    const CA* data;
+    int32_t workerCount;
+    std::vector<const UNIT *> sources;
+    std::vector<int32_t> lengths;
+    std::vector<int32_t> rangeStarts;  // workerCount+1 string indexes
+    std::vector<int32_t> order;
+    std::vector<int32_t> temp;
+};
+
+template<>
+void ParallelSortStrings<CA_uchar, UChar>::sortRange(int32_t worker, UErrorCode* status) {
+    int32_t start = rangeStarts[worker];
+    ucol_sortStringRange(ucoll, &sources[0], &lengths[0], start, rangeStarts[worker + 1],
+                         &order[0] + start, TRUE, status);
+}
+
+template<>
+void ParallelSortStrings<CA_char, char>::sortRange(int32_t worker, UErrorCode* status) {
+    int32_t start = rangeStarts[worker];
+    ucol_sortStringRangeUTF8(ucoll, &sources[0], &lengths[0], start, rangeStarts[worker + 1],
+                             &order[0] + start, TRUE, status);
+}
+
+template<>
+void ParallelSortStrings<CA_uchar, UChar>::merge(const int32_t *src, int32_t *dest,
+                                                int32_t start, int32_t middle, int32_t limit,
+                                                UErrorCode* status) {
+    ucol_mergeSortedPermutations(ucoll, &sources[0], &lengths[0],
+                                 src + start, middle - start, src + middle, limit - middle,
+                                 dest + start, TRUE, status);
+}
+
+template<>
+void ParallelSortStrings<CA_char, char>::merge(const int32_t *src, int32_t *dest,
+                                              int32_t start, int32_t middle, int32_t limit,
+                                              UErrorCode* status) {
+    ucol_mergeSortedPermutationsUTF8(ucoll, &sources[0], &lengths[0],
+                                     src + start, middle - start, src + middle, limit - middle,
+                                     dest + start, TRUE, status);
+}
+
+template<typename CA, typename UNIT>
+void ParallelSortStrings<CA, UNIT>::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    std::vector<std::thread> threads;
+    std::vector<UErrorCode> statuses(workerCount, U_ZERO_ERROR);
+    for (int32_t w = 0; w < workerCount; w++) {
+        threads.push_back(std::thread(&ParallelSortStrings::sortRange, this, w, &statuses[w]));
+    }
+    for (int32_t w = 0; w < workerCount; w++) {
+        threads[w].join();
+    }
+    // Merge pairs of adjacent runs, doubling the run width each round.
+    int32_t *src = &order[0];
+    int32_t *dest = &temp[0];
+    for (int32_t width = 1; width < workerCount; width *= 2) {
+        threads.clear();
+        for (int32_t w = 0; w < workerCount; w += 2 * width) {
+            int32_t start = rangeStarts[w];
+            int32_t middle = rangeStarts[w + width < workerCount ? w + width : workerCount];
+            int32_t limit = rangeStarts[w + 2 * width < workerCount ? w + 2 * width : workerCount];
+            threads.push_back(std::thread(&ParallelSortStrings::merge, this, src, dest,
+                                          start, middle, limit, &statuses[w]));
+        }
+        for (size_t t = 0; t < threads.size(); t++) {
+            threads[t].join();
+        }
+        int32_t *swap = src;
+        src = dest;
+        dest = swap;
+    }
+    for (int32_t w = 0; w < workerCount; w++) {
+        if (U_FAILURE(statuses[w])) {
+            *status = statuses[w];
+        }
+    }
+    ops = data->count;
+}
+
 //
 // Test case performing binary searches in a sorted array of UnicodeString pointers.
 //
@@ -1089,6 +1489,17 @@ private:
 
     UPerfFunction* TestGetSortKey();
     UPerfFunction* TestGetSortKeyNull();
+    UPerfFunction* TestGetSortKeyUTF8();
+
+    UPerfFunction* TestGetSortKeys();
+    UPerfFunction* TestGetSortKeys_4Threads();
+    UPerfFunction* TestGetSortKeysUTF8();
+    UPerfFunction* TestGetSortKeysUTF8_4Threads();
+
+    UPerfFunction* TestGetCollationHash();
+
+    UPerfFunction* TestGetCompactSortKey();
+    UPerfFunction* TestGetCompactSortKey_Secondary4();
 
     UPerfFunction* TestNextSortKeyPart_4All();
     UPerfFunction* TestNextSortKeyPart_4x2();
@@ -1118,6 +1529,10 @@ private:
     UPerfFunction* TestUniStrSort();
     UPerfFunction* TestStringPieceSortCpp();
     UPerfFunction* TestStringPieceSortC();
+    UPerfFunction* TestSortStrings();
+    UPerfFunction* TestSortStringsUTF8();
+    UPerfFunction* TestSortStrings_4Threads();
+    UPerfFunction* TestSortStringsUTF8_4Threads();
 
     UPerfFunction* TestUniStrBinSearch();
     UPerfFunction* TestStringPieceBinSearchCpp();
@@ -1398,6 +1813,17 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
 
     TESTCASE_AUTO(TestGetSortKey);
     TESTCASE_AUTO(TestGetSortKeyNull);
+    TESTCASE_AUTO(TestGetSortKeyUTF8);
+
+    TESTCASE_AUTO(TestGetSortKeys);
+    TESTCASE_AUTO(TestGetSortKeys_4Threads);
+    TESTCASE_AUTO(TestGetSortKeysUTF8);
+    TESTCASE_AUTO(TestGetSortKeysUTF8_4Threads);
+
+    TESTCASE_AUTO(TestGetCollationHash);
+
+    TESTCASE_AUTO(TestGetCompactSortKey);
+    TESTCASE_AUTO(TestGetCompactSortKey_Secondary4);
 
     TESTCASE_AUTO(TestNextSortKeyPart_4All);
     TESTCASE_AUTO(TestNextSortKeyPart_4x4);
@@ -1425,6 +1851,10 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestUniStrSort);
     TESTCASE_AUTO(TestStringPieceSortCpp);
     TESTCASE_AUTO(TestStringPieceSortC);
+    TESTCASE_AUTO(TestSortStrings);
+    TESTCASE_AUTO(TestSortStringsUTF8);
+    TESTCASE_AUTO(TestSortStrings_4Threads);
+    TESTCASE_AUTO(TestSortStringsUTF8_4Threads);
 
     TESTCASE_AUTO(TestUniStrBinSearch);
     TESTCASE_AUTO(TestStringPieceBinSearchCpp);
@@ -1524,6 +1954,98 @@ UPerfFunction* CollPerf2Test::TestGetSortKeyNull()
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestGetSortKeyUTF8()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetSortKeyUTF8 *testCase = new GetSortKeyUTF8(coll, getData8(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestGetSortKeys()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetSortKeys<CA_uchar, UChar> *testCase =
+        new GetSortKeys<CA_uchar, UChar>(coll, getData16(status), 1 /* workerCount */, status);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestGetSortKeys_4Threads()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetSortKeys<CA_uchar, UChar> *testCase =
+        new GetSortKeys<CA_uchar, UChar>(coll, getData16(status), 4 /* workerCount */, status);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestGetSortKeysUTF8()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetSortKeys<CA_char, char> *testCase =
+        new GetSortKeys<CA_char, char>(coll, getData8(status), 1 /* workerCount */, status);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestGetSortKeysUTF8_4Threads()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetSortKeys<CA_char, char> *testCase =
+        new GetSortKeys<CA_char, char>(coll, getData8(status), 4 /* workerCount */, status);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestGetCollationHash()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetCollationHash *testCase = new GetCollationHash(coll, getData16(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestGetCompactSortKey()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetCompactSortKey *testCase = new GetCompactSortKey(coll, getData16(status), UCOL_DEFAULT, 0);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestGetCompactSortKey_Secondary4()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    GetCompactSortKey *testCase = new GetCompactSortKey(coll, getData16(status), UCOL_SECONDARY, 4);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
 UPerfFunction* CollPerf2Test::TestNextSortKeyPart_4All()
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -1752,6 +2274,48 @@ UPerfFunction* CollPerf2Test::TestStringPieceSortC() {
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestSortStrings() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new SortStrings(*collObj, coll, getRandomData16(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestSortStringsUTF8() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new SortStringsUTF8(*collObj, coll, getRandomData8(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestSortStrings_4Threads() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new ParallelSortStrings<CA_uchar, UChar>(
+        *collObj, coll, getRandomData16(status), 4 /* workerCount */);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestSortStringsUTF8_4Threads() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new ParallelSortStrings<CA_char, char>(
+        *collObj, coll, getRandomData8(status), 4 /* workerCount */);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
 UPerfFunction* CollPerf2Test::TestUniStrBinSearch() {
     UErrorCode status = U_ZERO_ERROR;
     UPerfFunction *testCase = new UniStrBinSearch(*collObj, coll, getSortedData16(status));
@@ -62,6 +62,33 @@ UPerfFunction* NormalizerPerformanceTest::runIndexedTest(int32_t index, UBool ex
         TESTCASE(31,TestIsNormalized_FCD_NFC_Text);
         TESTCASE(32,TestIsNormalized_FCD_Orig_Text);
 
+        TESTCASE(33,TestUTF8_NFC_NFD_Text);
+        TESTCASE(34,TestUTF8_NFC_NFC_Text);
+        TESTCASE(35,TestUTF8_NFC_Orig_Text);
+
+        TESTCASE(36,TestUTF8_NFD_NFD_Text);
+        TESTCASE(37,TestUTF8_NFD_NFC_Text);
+        TESTCASE(38,TestUTF8_NFD_Orig_Text);
+
+        TESTCASE(39,TestUTF8IsNormalized_NFC_NFD_Text);
+        TESTCASE(40,TestUTF8IsNormalized_NFC_NFC_Text);
+        TESTCASE(41,TestUTF8IsNormalized_NFC_Orig_Text);
+
+        TESTCASE(42,TestICU_NFC_ASCII_Text);
+        TESTCASE(43,TestICU_NFC_Latin1_Text);
+        TESTCASE(44,TestICU_NFD_ASCII_Text);
+        TESTCASE(45,TestICU_FCD_Latin1_Text);
+        TESTCASE(46,TestIsNormalized_NFC_ASCII_Text);
+        TESTCASE(47,TestIsNormalized_NFC_Latin1_Text);
+
+        TESTCASE(48,TestSingle_NFC_NFD_Text);
+        TESTCASE(49,TestSingle_NFC_NFC_Text);
+        TESTCASE(50,TestSingle_NFC_Orig_Text);
+
+        TESTCASE(51,TestBatch_NFC_NFD_Text);
+        TESTCASE(52,TestBatch_NFC_NFC_Text);
+        TESTCASE(53,TestBatch_NFC_Orig_Text);
+
         default: 
             name = ""; 
             return NULL;
@@ -108,6 +135,24 @@ UChar* NormalizerPerformanceTest::normalizeInput(int32_t& len, const UChar* src
     return dest;
 }
 
+// Builds a long, NUL-terminated run of text with code points up to maxChar,
+// which is already in NFC.
+UChar* NormalizerPerformanceTest::makeLatinInput(int32_t& len, UChar maxChar){
+    static const char sample[] = "The quick brown fox jumps over the lazy dog. ";
+    const int32_t sampleLen = (int32_t)(sizeof(sample) - 1);
+    len = 64*1024;
+    UChar* dest = new UChar[len+1];
+    for(int32_t i=0; i<len; i++){
+        UChar c = (UChar)sample[i%sampleLen];
+        if(maxChar>0x7f && c!=0x20 && (i%7)==3){
+            c = (UChar)(0xe0 + (i%(maxChar-0xe0+1)));  // a-grave..y-diaeresis
+        }
+        dest[i] = c;
+    }
+    dest[len] = 0;
+    return dest;
+}
+
 static UOption cmdLineOptions[]={
     UOPTION_DEF("options", 'o', UOPT_OPTIONAL_ARG)
 };
@@ -120,6 +165,8 @@ NormalizerPerformanceTest::NormalizerPerformanceTest(int32_t argc, const char* a
     NFCBufferLen = 0;
     NFDFileLines = NULL;
     NFCFileLines = NULL;
+    ASCIIBuffer = makeLatinInput(ASCIIBufferLen, 0x7f);
+    Latin1Buffer = makeLatinInput(Latin1BufferLen, 0xff);
 
     if(status== U_ILLEGAL_ARGUMENT_ERROR){
        fprintf(stderr,gUsageString, "normperf");
@@ -172,6 +219,8 @@ NormalizerPerformanceTest::~NormalizerPerformanceTest(){
     delete[] NFCFileLines;
     delete[] NFDBuffer;
     delete[] NFCBuffer;
+    delete[] ASCIIBuffer;
+    delete[] Latin1Buffer;
 }
 
 // Test NFC Performance
@@ -490,6 +539,114 @@ UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_FCD_Orig_Text(){
     }
 }
 
+// Test Performance on long ASCII / Latin-1 runs
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFC_ASCII_Text(){
+    return new NormPerfFunction(ICUNormNFC, options,ASCIIBuffer,ASCIIBufferLen, uselen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFC_Latin1_Text(){
+    return new NormPerfFunction(ICUNormNFC, options,Latin1Buffer,Latin1BufferLen, uselen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFD_ASCII_Text(){
+    return new NormPerfFunction(ICUNormNFD, options,ASCIIBuffer,ASCIIBufferLen, uselen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_FCD_Latin1_Text(){
+    return new NormPerfFunction(ICUNormFCD, options,Latin1Buffer,Latin1BufferLen, uselen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_NFC_ASCII_Text(){
+    return new QuickCheckPerfFunction(ICUIsNormalized,ASCIIBuffer,ASCIIBufferLen, UNORM_NFC, options,uselen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_NFC_Latin1_Text(){
+    return new QuickCheckPerfFunction(ICUIsNormalized,Latin1Buffer,Latin1BufferLen, UNORM_NFC, options,uselen);
+}
+
+// Test Normalizer2 UTF-8 API Performance
+UPerfFunction* NormalizerPerformanceTest::createUTF8Function(const icu::Normalizer2* norm2, UBool checkOnly,
+                                                             ULine* srcLines, const UChar* src, int32_t srcLen){
+    if(norm2==NULL){
+        return NULL;
+    }
+    if(line_mode){
+        return new UTF8NormPerfFunction(norm2, checkOnly, srcLines, numLines);
+    }else{
+        return new UTF8NormPerfFunction(norm2, checkOnly, src, srcLen);
+    }
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFC_NFD_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFCInstance(status), FALSE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFC_NFC_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFCInstance(status), FALSE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFC_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFCInstance(status), FALSE, lines, buffer, bufferLen);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFD_NFD_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFDInstance(status), FALSE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFD_NFC_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFDInstance(status), FALSE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFD_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFDInstance(status), FALSE, lines, buffer, bufferLen);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestUTF8IsNormalized_NFC_NFD_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFCInstance(status), TRUE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8IsNormalized_NFC_NFC_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFCInstance(status), TRUE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8IsNormalized_NFC_Orig_Text(){
+    UErrorCode status = U_ZERO_ERROR;
+    return createUTF8Function(icu::Normalizer2::getNFCInstance(status), TRUE, lines, buffer, bufferLen);
+}
+
+// Test Normalizer2 per-string vs. batch Performance
+// Meaningful in line mode (-l), where each input line is one short string.
+UPerfFunction* NormalizerPerformanceTest::createBatchFunction(UBool batch, ULine* srcLines,
+                                                              const UChar* src, int32_t srcLen){
+    UErrorCode status = U_ZERO_ERROR;
+    const icu::Normalizer2* norm2 = icu::Normalizer2::getNFCInstance(status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    if(line_mode){
+        return new BatchNormPerfFunction(norm2, batch, srcLines, numLines);
+    }else{
+        return new BatchNormPerfFunction(norm2, batch, src, srcLen);
+    }
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestSingle_NFC_NFD_Text(){
+    return createBatchFunction(FALSE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestSingle_NFC_NFC_Text(){
+    return createBatchFunction(FALSE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestSingle_NFC_Orig_Text(){
+    return createBatchFunction(FALSE, lines, buffer, bufferLen);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestBatch_NFC_NFD_Text(){
+    return createBatchFunction(TRUE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestBatch_NFC_NFC_Text(){
+    return createBatchFunction(TRUE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestBatch_NFC_Orig_Text(){
+    return createBatchFunction(TRUE, lines, buffer, bufferLen);
+}
+
 int main(int argc, const char* argv[]){
     UErrorCode status = U_ZERO_ERROR;
     NormalizerPerformanceTest test(argc, argv, status);
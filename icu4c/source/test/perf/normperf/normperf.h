@@ -10,6 +10,8 @@
 
 #include "unicode/unorm.h"
 #include "unicode/ustring.h"
+#include "unicode/normalizer2.h"
+#include "unicode/bytestream.h"
 
 #include "unicode/uperf.h"
 #include <stdlib.h>
@@ -172,6 +174,144 @@ public:
     }
 };
 
+// Normalizer2 UTF-8 API. The input is converted to UTF-8 up front so that
+// only the normalization itself is timed.
+class UTF8NormPerfFunction : public UPerfFunction{
+private:
+    const icu::Normalizer2* norm2;
+    UBool checkOnly;
+    char** src8;
+    int32_t* src8Len;
+    int32_t numStrings;
+    char* dest;
+    int32_t destCapacity;
+    long numChars;
+    int32_t retVal;
+
+    void init(const ULine* srcLines, int32_t srcNumLines){
+        numStrings = srcNumLines;
+        src8 = new char*[numStrings];
+        src8Len = new int32_t[numStrings];
+        numChars = 0;
+        int32_t maxLen = 0;
+        for(int32_t i = 0; i< numStrings; i++){
+            UErrorCode status = U_ZERO_ERROR;
+            int32_t len = 0;
+            u_strToUTF8(NULL, 0, &len, srcLines[i].name, srcLines[i].len, &status);
+            status = U_ZERO_ERROR;
+            src8[i] = new char[len+1];
+            u_strToUTF8(src8[i], len+1, &len, srcLines[i].name, srcLines[i].len, &status);
+            src8Len[i] = len;
+            numChars += srcLines[i].len;
+            if(len>maxLen){
+                maxLen = len;
+            }
+        }
+        destCapacity = maxLen*4+16;
+        dest = new char[destCapacity];
+    }
+
+public:
+    virtual void call(UErrorCode* status){
+        for(int32_t i = 0; i< numStrings; i++){
+            icu::StringPiece s(src8[i], src8Len[i]);
+            if(checkOnly){
+                retVal = norm2->isNormalizedUTF8(s, *status);
+            }else{
+                icu::CheckedArrayByteSink sink(dest, destCapacity);
+                norm2->normalizeUTF8(s, sink, *status);
+                retVal = sink.NumberOfBytesAppended();
+            }
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return numChars;
+    }
+    UTF8NormPerfFunction(const icu::Normalizer2* n2, UBool _checkOnly, ULine* srcLines, int32_t srcNumLines)
+            : norm2(n2), checkOnly(_checkOnly), retVal(0) {
+        init(srcLines, srcNumLines);
+    }
+    UTF8NormPerfFunction(const icu::Normalizer2* n2, UBool _checkOnly, const UChar* source, int32_t sourceLen)
+            : norm2(n2), checkOnly(_checkOnly), retVal(0) {
+        ULine line;
+        line.name = (UChar*)source;
+        line.len = sourceLen;
+        init(&line, 1);
+    }
+    ~UTF8NormPerfFunction(){
+        for(int32_t i = 0; i< numStrings; i++){
+            delete[] src8[i];
+        }
+        delete[] src8;
+        delete[] src8Len;
+        delete[] dest;
+    }
+};
+
+
+// Normalizer2 on many short strings: one normalize() call per string
+// vs. one normalizeBatch() call for all of them.
+class BatchNormPerfFunction : public UPerfFunction{
+private:
+    const icu::Normalizer2* norm2;
+    UBool batch;
+    const UChar** srcs;
+    int32_t* srcLens;
+    int32_t numStrings;
+    int32_t* destStarts;
+    int32_t* destLens;
+    icu::UnicodeString dest;
+    long numChars;
+    int32_t retVal;
+
+    void init(const ULine* srcLines, int32_t srcNumLines){
+        numStrings = srcNumLines;
+        srcs = new const UChar*[numStrings];
+        srcLens = new int32_t[numStrings];
+        destStarts = new int32_t[numStrings];
+        destLens = new int32_t[numStrings];
+        numChars = 0;
+        for(int32_t i = 0; i< numStrings; i++){
+            srcs[i] = srcLines[i].name;
+            srcLens[i] = srcLines[i].len;
+            numChars += srcLines[i].len;
+        }
+    }
+
+public:
+    virtual void call(UErrorCode* status){
+        if(batch){
+            norm2->normalizeBatch(srcs, srcLens, numStrings, dest, destStarts, destLens, *status);
+            retVal = dest.length();
+        }else{
+            for(int32_t i = 0; i< numStrings; i++){
+                icu::UnicodeString s(FALSE, srcs[i], srcLens[i]);
+                norm2->normalize(s, dest, *status);
+                retVal = dest.length();
+            }
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return numChars;
+    }
+    BatchNormPerfFunction(const icu::Normalizer2* n2, UBool _batch, ULine* srcLines, int32_t srcNumLines)
+            : norm2(n2), batch(_batch), retVal(0) {
+        init(srcLines, srcNumLines);
+    }
+    BatchNormPerfFunction(const icu::Normalizer2* n2, UBool _batch, const UChar* source, int32_t sourceLen)
+            : norm2(n2), batch(_batch), retVal(0) {
+        ULine line;
+        line.name = (UChar*)source;
+        line.len = sourceLen;
+        init(&line, 1);
+    }
+    ~BatchNormPerfFunction(){
+        delete[] srcs;
+        delete[] srcLens;
+        delete[] destStarts;
+        delete[] destLens;
+    }
+};
 
 
 class  NormalizerPerformanceTest : public UPerfTest{
@@ -182,12 +322,17 @@ private:
     UChar* NFCBuffer;
     UChar* origBuffer;
     int32_t origBufferLen;
+    UChar* ASCIIBuffer;
+    UChar* Latin1Buffer;
+    int32_t ASCIIBufferLen;
+    int32_t Latin1BufferLen;
     int32_t NFDBufferLen;
     int32_t NFCBufferLen;
     int32_t options;
 
     void normalizeInput(ULine* dest,const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
     UChar* normalizeInput(int32_t& len, const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
+    UChar* makeLatinInput(int32_t& len, UChar maxChar);
 
 public:
 
@@ -245,6 +390,40 @@ public:
     UPerfFunction* TestIsNormalized_FCD_NFC_Text();
     UPerfFunction* TestIsNormalized_FCD_Orig_Text();
 
+    /* long runs of ASCII / Latin-1 text, independent of the input file */
+    UPerfFunction* TestICU_NFC_ASCII_Text();
+    UPerfFunction* TestICU_NFC_Latin1_Text();
+    UPerfFunction* TestICU_NFD_ASCII_Text();
+    UPerfFunction* TestICU_FCD_Latin1_Text();
+    UPerfFunction* TestIsNormalized_NFC_ASCII_Text();
+    UPerfFunction* TestIsNormalized_NFC_Latin1_Text();
+
+    /* Normalizer2 UTF-8 API performance */
+    UPerfFunction* TestUTF8_NFC_NFD_Text();
+    UPerfFunction* TestUTF8_NFC_NFC_Text();
+    UPerfFunction* TestUTF8_NFC_Orig_Text();
+
+    UPerfFunction* TestUTF8_NFD_NFD_Text();
+    UPerfFunction* TestUTF8_NFD_NFC_Text();
+    UPerfFunction* TestUTF8_NFD_Orig_Text();
+
+    UPerfFunction* TestUTF8IsNormalized_NFC_NFD_Text();
+    UPerfFunction* TestUTF8IsNormalized_NFC_NFC_Text();
+    UPerfFunction* TestUTF8IsNormalized_NFC_Orig_Text();
+
+    /* Normalizer2 per-string vs. batch performance */
+    UPerfFunction* TestSingle_NFC_NFD_Text();
+    UPerfFunction* TestSingle_NFC_NFC_Text();
+    UPerfFunction* TestSingle_NFC_Orig_Text();
+
+    UPerfFunction* TestBatch_NFC_NFD_Text();
+    UPerfFunction* TestBatch_NFC_NFC_Text();
+    UPerfFunction* TestBatch_NFC_Orig_Text();
+
+private:
+    UPerfFunction* createUTF8Function(const icu::Normalizer2* norm2, UBool checkOnly,
+                                      ULine* srcLines, const UChar* src, int32_t srcLen);
+    UPerfFunction* createBatchFunction(UBool batch, ULine* srcLines, const UChar* src, int32_t srcLen);
 };
 
 //---------------------------------------------------------------------------------------
@@ -15,7 +15,11 @@ StringSearchPerformanceTest::StringSearchPerformanceTest(int32_t argc, const cha
 :UPerfTest(argc,argv,status){
     int32_t start, end;
     srch = NULL;
+    srchPrimary = NULL;
     pttrn = NULL;
+    words = NULL;
+    multiPttrnCount = 0;
+    msrch = NULL;
     if(status== U_ILLEGAL_ARGUMENT_ERROR || line_mode){
        fprintf(stderr,gUsageString, "strsrchperf");
        return;
@@ -66,22 +70,87 @@ StringSearchPerformanceTest::StringSearchPerformanceTest(int32_t argc, const cha
         fprintf(stderr, "FAILED to create UPerfTest object. Error: %s\n", u_errorName(status));
         return;
     }
+
+    /* Same search, but ignoring case and accents. */
+    srchPrimary = usearch_open(pttrn, pttrnLen, src, srcLen, locale, NULL, &status);
+    if(U_SUCCESS(status)){
+        ucol_setStrength(usearch_getCollator(srchPrimary), UCOL_PRIMARY);
+        usearch_reset(srchPrimary);
+    }
+
+    if(U_FAILURE(status)){
+        fprintf(stderr, "FAILED to create UPerfTest object. Error: %s\n", u_errorName(status));
+        return;
+    }
+
+    /* Patterns for the multi-pattern search: The first pattern and words spread over the text. */
+    multiPttrns[0] = pttrn;
+    multiPttrnLens[0] = pttrnLen;
+    multiPttrnCount = 1;
+    words = (UChar*)malloc(sizeof(UChar)*srcLen);
+    int32_t wordsLen = 0;
+    int32_t wordCount = 0;
+    for (int32_t i = pttrnLen; i < srcLen && multiPttrnCount < MULTI_PATTERN_COUNT;) {
+        int32_t wordStart = i;
+        while (i < srcLen && u_isalpha(src[i])) {
+            ++i;
+        }
+        if ((i - wordStart) >= 5 && (++wordCount % 200) == 0) {
+            multiPttrns[multiPttrnCount] = words + wordsLen;
+            multiPttrnLens[multiPttrnCount++] = i - wordStart;
+            while (wordStart < i) {
+                words[wordsLen++] = src[wordStart++];
+            }
+        }
+        if (i == wordStart) {
+            ++i;
+        }
+    }
+    UCollator* primaryColl = usearch_getCollator(srchPrimary);
+    msrch = usearch_openMulti(multiPttrns, multiPttrnLens, multiPttrnCount, src, srcLen, primaryColl, NULL, &status);
+    for (int32_t i = 0; i < multiPttrnCount; ++i) {
+        multiSrchs[i] = usearch_openFromCollator(multiPttrns[i], multiPttrnLens[i], src, srcLen, primaryColl, NULL, &status);
+    }
+
+    if(U_FAILURE(status)){
+        fprintf(stderr, "FAILED to create UPerfTest object. Error: %s\n", u_errorName(status));
+        return;
+    }
     
 }
 
 StringSearchPerformanceTest::~StringSearchPerformanceTest() {
+    /* Close these before srchPrimary which owns their collator. */
+    if (msrch != NULL) {
+        usearch_closeMulti(msrch);
+    }
+    for (int32_t i = 0; i < multiPttrnCount; ++i) {
+        if (multiSrchs[i] != NULL) {
+            usearch_close(multiSrchs[i]);
+        }
+    }
+    if (words != NULL) {
+        free(words);
+    }
     if (pttrn != NULL) {
         free(pttrn);
     }
     if (srch != NULL) {
         usearch_close(srch);
     }
+    if (srchPrimary != NULL) {
+        usearch_close(srchPrimary);
+    }
 }
 
 UPerfFunction* StringSearchPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char *&name, char *par) {
     switch (index) {
         TESTCASE(0,Test_ICU_Forward_Search);
         TESTCASE(1,Test_ICU_Backward_Search);
+        TESTCASE(2,Test_ICU_Forward_Search_Primary);
+        TESTCASE(3,Test_ICU_Backward_Search_Primary);
+        TESTCASE(4,Test_ICU_Multi_Search);
+        TESTCASE(5,Test_ICU_Forward_Search_Each);
 
         default: 
             name = ""; 
@@ -100,6 +169,26 @@ UPerfFunction* StringSearchPerformanceTest::Test_ICU_Backward_Search(){
     return func;
 }
 
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Forward_Search_Primary(){
+    StringSearchPerfFunction* func = new StringSearchPerfFunction(ICUForwardSearch, srchPrimary, src, srcLen, pttrn, pttrnLen);
+    return func;
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Backward_Search_Primary(){
+    StringSearchPerfFunction* func = new StringSearchPerfFunction(ICUBackwardSearch, srchPrimary, src, srcLen, pttrn, pttrnLen);
+    return func;
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Multi_Search(){
+    MultiSearchPerfFunction* func = new MultiSearchPerfFunction(msrch, NULL, 0, src, srcLen);
+    return func;
+}
+
+UPerfFunction* StringSearchPerformanceTest::Test_ICU_Forward_Search_Each(){
+    MultiSearchPerfFunction* func = new MultiSearchPerfFunction(NULL, multiSrchs, multiPttrnCount, src, srcLen);
+    return func;
+}
+
 int main (int argc, const char* argv[]) {
     UErrorCode status = U_ZERO_ERROR;
     StringSearchPerformanceTest test(argc, argv, status);
@@ -7,6 +7,7 @@
 #define _STRSRCHPERF_H
 
 #include "unicode/usearch.h"
+#include "unicode/uchar.h"
 #include "unicode/uperf.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -41,6 +42,50 @@ public:
     }
 };
 
+/* Number of patterns for the multi-pattern search tests. */
+#define MULTI_PATTERN_COUNT 20
+
+/*
+ * Searches for all of several patterns, either with one multi-pattern search
+ * or with one search per pattern.
+ */
+class MultiSearchPerfFunction : public UPerfFunction {
+private:
+    UMultiStringSearch* msrch;
+    UStringSearch** srchs;
+    int32_t srchCount;
+    const UChar* src;
+    int32_t srcLen;
+
+public:
+    virtual void call(UErrorCode* status) {
+        if (msrch != NULL) {
+            usearch_setMultiText(msrch, src, srcLen, status);
+            while (usearch_nextMulti(msrch, NULL, NULL, NULL, status)) {}
+        } else {
+            for (int32_t i = 0; i < srchCount; ++i) {
+                int32_t match = usearch_first(srchs[i], status);
+                while (match != USEARCH_DONE) {
+                    match = usearch_next(srchs[i], status);
+                }
+            }
+        }
+    }
+
+    virtual long getOperationsPerIteration() {
+        return (long) srcLen;
+    }
+
+    MultiSearchPerfFunction(UMultiStringSearch* multiSearch, UStringSearch** searches, int32_t searchCount,
+                            const UChar* source, int32_t sourceLen) {
+        msrch = multiSearch;
+        srchs = searches;
+        srchCount = searchCount;
+        src = source;
+        srcLen = sourceLen;
+    }
+};
+
 class StringSearchPerformanceTest : public UPerfTest {
 private:
     const UChar* src;
@@ -48,6 +93,14 @@ private:
     UChar* pttrn;
     int32_t pttrnLen;
     UStringSearch* srch;
+    UStringSearch* srchPrimary;
+    /* Words from the text, searched for at primary strength. */
+    UChar* words;
+    const UChar* multiPttrns[MULTI_PATTERN_COUNT];
+    int32_t multiPttrnLens[MULTI_PATTERN_COUNT];
+    int32_t multiPttrnCount;
+    UMultiStringSearch* msrch;
+    UStringSearch* multiSrchs[MULTI_PATTERN_COUNT];
     
 public:
     StringSearchPerformanceTest(int32_t argc, const char *argv[], UErrorCode &status);
@@ -55,6 +108,10 @@ public:
     virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char *&name, char *par = NULL);
     UPerfFunction* Test_ICU_Forward_Search();
     UPerfFunction* Test_ICU_Backward_Search();
+    UPerfFunction* Test_ICU_Forward_Search_Primary();
+    UPerfFunction* Test_ICU_Backward_Search_Primary();
+    UPerfFunction* Test_ICU_Multi_Search();
+    UPerfFunction* Test_ICU_Forward_Search_Each();
 };
 
 
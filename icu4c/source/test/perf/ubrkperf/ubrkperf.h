@@ -11,6 +11,8 @@
 #include "unicode/uperf.h"
 
 #include <unicode/brkiter.h>
+#include <unicode/ustring.h>
+#include <unicode/utext.h>
 
 class ICUBreakFunction : public UPerfFunction {
 protected:
@@ -103,6 +105,71 @@ public:
   }
 };
 
+class ICUBulkForward : public ICUBreakFunction {
+private:
+  int32_t m_boundaries_[1000];
+  int32_t m_statuses_[1000];
+  // The iterator keeps a reference to its text, so the string must outlive it.
+  UnicodeString m_text_;
+public:
+  ICUBulkForward(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_text_(FALSE, m_file_, m_fileLen_)
+  {
+    m_brkIt_->setText(m_text_);
+    UErrorCode status = U_ZERO_ERROR;
+    call(&status);
+  }
+  virtual void call(UErrorCode *status) 
+  {
+    m_noBreaks_ = 0;
+    int32_t start = 0;
+    int32_t n;
+    do {
+      n = m_brkIt_->getBoundaries(start, m_boundaries_, m_statuses_, 1000, *status);
+      m_noBreaks_ += n;
+      if (n > 0) {
+        start = m_boundaries_[n - 1];
+      }
+    } while (n == 1000);
+  }
+};
+
+class ICUForwardUTF8 : public ICUBreakFunction {
+private:
+  char *m_utf8_;
+  UText m_text_;
+public:
+  ICUForwardUTF8(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_utf8_(NULL)
+  {
+    UText initText = UTEXT_INITIALIZER;
+    m_text_ = initText;
+    int32_t utf8Len = 0;
+    UErrorCode status = U_ZERO_ERROR;
+    u_strToUTF8(NULL, 0, &utf8Len, m_file_, m_fileLen_, &status);
+    status = U_ZERO_ERROR;
+    m_utf8_ = new char[utf8Len + 1];
+    u_strToUTF8(m_utf8_, utf8Len + 1, NULL, m_file_, m_fileLen_, &m_status_);
+    utext_openUTF8(&m_text_, m_utf8_, utf8Len, &m_status_);
+    m_brkIt_->setText(&m_text_, m_status_);
+    call(&status);
+  }
+  ~ICUForwardUTF8() {
+    utext_close(&m_text_);
+    delete[] m_utf8_;
+  }
+  virtual void call(UErrorCode * /* status */)
+  {
+    m_noBreaks_ = 0;
+    m_brkIt_->first();
+    while(m_brkIt_->next() != BreakIterator::DONE) {
+      m_noBreaks_++;
+    }
+  }
+};
+
 class DarwinBreakFunction : public UPerfFunction {
 public:
   virtual void call(UErrorCode *status) {};
@@ -123,6 +190,8 @@ public:
 
   UPerfFunction* TestICUForward();
   UPerfFunction* TestICUIsBound();
+  UPerfFunction* TestICUBulkForward();
+  UPerfFunction* TestICUForwardUTF8();
 
   UPerfFunction* TestDarwinForward();
   UPerfFunction* TestDarwinIsBound();
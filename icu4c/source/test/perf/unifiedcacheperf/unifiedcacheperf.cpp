@@ -0,0 +1,148 @@
+/*
+ **********************************************************************
+ * Copyright (c) 2016, International Business Machines
+ * Corporation and others.  All Rights Reserved.
+ **********************************************************************
+ */
+/*
+ * Measures how UnifiedCache lookups scale with the number of threads.
+ * Each thread repeatedly looks up already-cached values by locale,
+ * as when formatters are created for each request on a server.
+ *
+ * Usage: unifiedcacheperf [ -t maxThreads ] [ -n lookupsPerThread ] [ -k keyCount ]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "unicode/utypes.h"
+#include "unicode/locid.h"
+#include "unicode/utimer.h"
+#include "unifiedcache.h"
+
+U_NAMESPACE_USE
+
+class CachePerfItem : public SharedObject {
+};
+
+U_NAMESPACE_BEGIN
+
+template<> U_EXPORT
+const CachePerfItem *LocaleCacheKey<CachePerfItem>::createObject(
+        const void * /*unused*/, UErrorCode &status) const {
+    CachePerfItem *result = new CachePerfItem();
+    if (result == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    result->addRef();
+    return result;
+}
+
+U_NAMESPACE_END
+
+static const Locale *gLocales = NULL;
+static int32_t gKeyCount = 0;
+
+static void lookUp(int32_t threadIndex, int32_t lookupCount, UErrorCode *pErrorCode) {
+    UErrorCode status = U_ZERO_ERROR;
+    const UnifiedCache *cache = UnifiedCache::getInstance(status);
+    const CachePerfItem *item = NULL;
+    // Start each thread at a different key.
+    int32_t keyIndex = (threadIndex * 7) % gKeyCount;
+    for (int32_t i = 0; i < lookupCount && U_SUCCESS(status); ++i) {
+        cache->get(LocaleCacheKey<CachePerfItem>(gLocales[keyIndex]), item, status);
+        if (++keyIndex == gKeyCount) {
+            keyIndex = 0;
+        }
+    }
+    SharedObject::clearPtr(item);
+    *pErrorCode = status;
+}
+
+int main(int argc, const char *argv[]) {
+    int32_t maxThreads = (int32_t) std::thread::hardware_concurrency();
+    int32_t lookupCount = 200000;
+    int32_t keyCount = 100;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-t") == 0) {
+            maxThreads = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-n") == 0) {
+            lookupCount = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-k") == 0) {
+            keyCount = atoi(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if (maxThreads <= 0) {
+        maxThreads = 1;
+    }
+
+    int32_t localeCount = 0;
+    gLocales = Locale::getAvailableLocales(localeCount);
+    gKeyCount = keyCount < localeCount ? keyCount : localeCount;
+    if (gKeyCount <= 0 || lookupCount <= 0) {
+        fprintf(stderr,
+                "Usage: %s [ -t maxThreads ] [ -n lookupsPerThread ] [ -k keyCount ]\n",
+                argv[0]);
+        return 1;
+    }
+
+    // Populate the cache, and hold on to the values so that
+    // they are not evicted while we measure.
+    UErrorCode status = U_ZERO_ERROR;
+    const UnifiedCache *cache = UnifiedCache::getInstance(status);
+    std::vector<const CachePerfItem *> items(gKeyCount, (const CachePerfItem *) NULL);
+    for (int32_t i = 0; i < gKeyCount && U_SUCCESS(status); ++i) {
+        cache->get(LocaleCacheKey<CachePerfItem>(gLocales[i]), items[i], status);
+    }
+    if (U_FAILURE(status)) {
+        fprintf(stderr, "Error populating the cache: %s\n", u_errorName(status));
+        return 1;
+    }
+
+    printf("%d keys, %d lookups per thread\n", (int) gKeyCount, (int) lookupCount);
+    printf("threads\tseconds\tlookups/s\tper thread\tspeedup\n");
+    double singleRate = 0.0;
+    for (int32_t threadCount = 1;; threadCount *= 2) {
+        if (threadCount > maxThreads) {
+            threadCount = maxThreads;
+        }
+        std::vector<std::thread> threads;
+        std::vector<UErrorCode> errorCodes(threadCount, U_ZERO_ERROR);
+        UTimer start;
+        utimer_getTime(&start);
+        for (int32_t i = 0; i < threadCount; ++i) {
+            threads.push_back(std::thread(lookUp, i, lookupCount, &errorCodes[i]));
+        }
+        for (int32_t i = 0; i < threadCount; ++i) {
+            threads[i].join();
+        }
+        double seconds = utimer_getElapsedSeconds(&start);
+        for (int32_t i = 0; i < threadCount; ++i) {
+            if (U_FAILURE(errorCodes[i])) {
+                fprintf(stderr, "Error in thread %d: %s\n", (int) i, u_errorName(errorCodes[i]));
+                return 1;
+            }
+        }
+        double rate = (double) threadCount * lookupCount / seconds;
+        if (threadCount == 1) {
+            singleRate = rate;
+        }
+        printf("%d\t%.3f\t%.0f\t%.0f\t%.2f\n",
+               (int) threadCount, seconds, rate, rate / threadCount,
+               rate / singleRate);
+        if (threadCount == maxThreads) {
+            break;
+        }
+    }
+
+    for (int32_t i = 0; i < gKeyCount; ++i) {
+        SharedObject::clearPtr(items[i]);
+    }
+    return 0;
+}